@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "batchexport.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace cli {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BatchExport::BatchExport(const QList<FilePath>& projectFiles,
+                         const ProjectExportJob::Options_t& options, int maxWorkers) noexcept :
+    mProjectFiles(projectFiles), mOptions(options), mMaxWorkers(qMax(maxWorkers, 1))
+{
+}
+
+BatchExport::~BatchExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QJsonArray BatchExport::run() const noexcept
+{
+    QVector<QJsonObject> reports(mProjectFiles.count());
+    int nextIndex = 0;
+    int runningWorkers = 0;
+    QEventLoop loop;
+
+    std::function<void()> startWorkers = [&]() {
+        while ((runningWorkers < mMaxWorkers) && (nextIndex < mProjectFiles.count())) {
+            int index = nextIndex++;
+            QProcess* process = new QProcess(&loop);
+            process->setProcessChannelMode(QProcess::ForwardedErrorChannel); // log output
+            QObject::connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+                             &QProcess::finished), [&, index, process](int exitCode,
+                                                                      QProcess::ExitStatus status) {
+                QString error;
+                if (status != QProcess::NormalExit) {
+                    error = tr("The worker process crashed.");
+                } else if (exitCode > 1) {
+                    error = QString(tr("The worker process failed with exit code %1."))
+                            .arg(exitCode);
+                }
+                reports[index] = parseWorkerOutput(index, process->readAllStandardOutput(), error);
+                process->deleteLater();
+                --runningWorkers;
+                startWorkers();
+                if (runningWorkers == 0) loop.quit();
+            });
+            process->start(QCoreApplication::applicationFilePath(), getWorkerArguments(index));
+            if (process->waitForStarted()) {
+                ++runningWorkers;
+            } else {
+                reports[index] = parseWorkerOutput(index, QByteArray(), process->errorString());
+                delete process;
+            }
+        }
+    };
+
+    startWorkers();
+    if (runningWorkers > 0) loop.exec();
+
+    QJsonArray array;
+    foreach (const QJsonObject& report, reports) {
+        array.append(report);
+    }
+    return array;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QStringList BatchExport::getWorkerArguments(int index) const noexcept
+{
+    const FilePath& projectFile = mProjectFiles.at(index);
+    QStringList args("--worker");
+    if (mOptions.exportGerber) args << "--gerber";
+    if (mOptions.exportPdf) args << "--pdf";
+    if (mOptions.runErc) args << "--erc";
+    if (!mOptions.imageFormat.isEmpty()) {
+        args << ("--" % mOptions.imageFormat) << "--dpi" << QString::number(mOptions.imageDpi);
+    }
+    if (!mOptions.boardLayers.isEmpty()) {
+        QStringList layers;
+        foreach (int id, mOptions.boardLayers) layers.append(QString::number(id));
+        args << "--layers" << layers.join(',');
+    }
+    if (mOptions.outputDir.isValid()) {
+        // every project gets its own subdirectory, named like the project file
+        QString dirName = projectFile.getCompleteBasename();
+        int count = 0;
+        foreach (const FilePath& fp, mProjectFiles) {
+            if (fp.getCompleteBasename() == dirName) ++count;
+        }
+        if (count > 1) dirName.append(QString("_%1").arg(index + 1)); // make it unique
+        args << "--output-dir" << mOptions.outputDir.getPathTo(dirName).toStr();
+    }
+    if (mOptions.cacheDir.isValid()) {
+        args << "--cache-dir" << mOptions.cacheDir.toStr(); // shared by all projects
+    }
+    args << projectFile.toStr();
+    return args;
+}
+
+QJsonObject BatchExport::parseWorkerOutput(int index, const QByteArray& output,
+                                           const QString& error) const noexcept
+{
+    QJsonDocument doc = QJsonDocument::fromJson(output);
+    if (error.isEmpty() && doc.isObject()) {
+        return doc.object();
+    }
+
+    // the worker did not create a report, so create it here
+    QJsonObject report;
+    report.insert("project", mProjectFiles.at(index).toNative());
+    report.insert("errors", QJsonArray({error.isEmpty() ? tr("Invalid worker output.") : error}));
+    report.insert("success", false);
+    return report;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace cli
+} // namespace librepcb
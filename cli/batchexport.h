@@ -0,0 +1,99 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CLI_BATCHEXPORT_H
+#define LIBREPCB_CLI_BATCHEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/fileio/filepath.h>
+#include "projectexportjob.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace cli {
+
+/*****************************************************************************************
+ *  Class BatchExport
+ ****************************************************************************************/
+
+/**
+ * @brief The BatchExport class exports many projects in parallel worker processes
+ *
+ * Every project is exported by a separate process of the same executable (started with
+ * the "--worker" option), which runs a ProjectExportJob and writes its report as JSON to
+ * stdout. Separate processes are used because the projects are not thread-safe, and
+ * because a crash while exporting one project must not abort the whole batch.
+ *
+ * The reports are returned in the same order as the projects, independent of the order
+ * in which the workers finish.
+ */
+class BatchExport final
+{
+        Q_DECLARE_TR_FUNCTIONS(BatchExport)
+
+    public:
+
+        // Constructors / Destructor
+        BatchExport() = delete;
+        BatchExport(const BatchExport& other) = delete;
+        BatchExport(const QList<FilePath>& projectFiles,
+                    const ProjectExportJob::Options_t& options, int maxWorkers) noexcept;
+        ~BatchExport() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Export all projects and wait until all workers are finished
+         *
+         * @return The reports of all projects (see ProjectExportJob#run())
+         */
+        QJsonArray run() const noexcept;
+
+        // Operator Overloadings
+        BatchExport& operator=(const BatchExport& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        QStringList getWorkerArguments(int index) const noexcept;
+        QJsonObject parseWorkerOutput(int index, const QByteArray& output,
+                                      const QString& error) const noexcept;
+
+
+        // Private Member Variables
+        QList<FilePath> mProjectFiles;
+        ProjectExportJob::Options_t mOptions;
+        int mMaxWorkers;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace cli
+} // namespace librepcb
+
+#endif // LIBREPCB_CLI_BATCHEXPORT_H
@@ -0,0 +1,57 @@
+#-------------------------------------------------
+#
+# Headless command line interface for batch exports
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = librepcb-cli
+
+# Set the path for the generated binary
+GENERATED_DIR = ../generated
+
+# Use common project definitions
+include(../common.pri)
+
+QT += core widgets xml printsupport sql
+
+CONFIG += console
+CONFIG -= app_bundle
+
+exists(../.git):DEFINES += GIT_BRANCH=\\\"master\\\"
+
+unix:!macx {
+    # Linux/UNIX-specific configurations
+    target.path = $${PREFIX}/bin
+    INSTALLS += target
+}
+
+# Note: The order of the libraries is very important for the linker!
+# Another order could end up in "undefined reference" errors!
+LIBS += \
+    -L$${DESTDIR} \
+    -llibrepcbproject \
+    -llibrepcblibrary \
+    -llibrepcbcommon
+
+INCLUDEPATH += \
+    ../libs
+
+DEPENDPATH += \
+    ../libs/librepcbproject \
+    ../libs/librepcblibrary \
+    ../libs/librepcbcommon
+
+PRE_TARGETDEPS += \
+    $${DESTDIR}/liblibrepcbproject.a \
+    $${DESTDIR}/liblibrepcblibrary.a \
+    $${DESTDIR}/liblibrepcbcommon.a
+
+SOURCES += \
+    main.cpp \
+    batchexport.cpp \
+    projectexportjob.cpp
+
+HEADERS += \
+    batchexport.h \
+    projectexportjob.h
@@ -0,0 +1,210 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include <librepcbcommon/application.h>
+#include <librepcbcommon/debug.h>
+#include <librepcbcommon/fileio/filepath.h>
+#include "projectexportjob.h"
+#include "batchexport.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+using namespace librepcb;
+using namespace librepcb::cli;
+
+/*****************************************************************************************
+ *  Function Prototypes
+ ****************************************************************************************/
+
+static void setApplicationMetadata() noexcept;
+static bool writeReport(const QJsonDocument& report, const QString& filepath) noexcept;
+
+/*****************************************************************************************
+ *  main()
+ ****************************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    // The schematics and boards are rendered with QGraphicsScene, which needs a
+    // QApplication. But the command line interface must also work without any display
+    // (e.g. on a build server), so the "offscreen" platform is used by default.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    Application app(argc, argv);
+    setApplicationMetadata();
+    Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Warning);
+
+    // parse the command line arguments
+    QCommandLineParser parser;
+    parser.setApplicationDescription(Application::translate("CLI",
+        "Exports the Gerber/Excellon files, schematic PDFs and images of LibrePCB projects "
+        "and writes a JSON report including all ERC messages."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption gerberOption("gerber", Application::translate("CLI",
+        "Export the Gerber/Excellon files of all boards."));
+    QCommandLineOption pdfOption("pdf", Application::translate("CLI",
+        "Export the schematics as PDF."));
+    QCommandLineOption pngOption("png", Application::translate("CLI",
+        "Export all boards and schematics as PNG images."));
+    QCommandLineOption tiffOption("tiff", Application::translate("CLI",
+        "Export all boards and schematics as TIFF images."));
+    QCommandLineOption dpiOption("dpi", Application::translate("CLI",
+        "The resolution of exported images (default: 600)."), "dpi", "600");
+    QCommandLineOption layersOption("layers", Application::translate("CLI",
+        "Comma separated IDs of the layers in board images (default: the visible "
+        "layers, air wires are never exported)."), "ids");
+    QCommandLineOption ercOption("erc", Application::translate("CLI",
+        "Add the ERC messages to the report."));
+    QCommandLineOption outputDirOption("output-dir", Application::translate("CLI",
+        "Write the output files to a subdirectory of <dir> for every project instead of "
+        "the \"generated\" directory of the project."), "dir");
+    QCommandLineOption cacheDirOption("cache-dir", Application::translate("CLI",
+        "Skip regenerating unchanged Gerber/Excellon files, using the cache in <dir>."),
+        "dir");
+    QCommandLineOption reportOption("report", Application::translate("CLI",
+        "Write the JSON report to <file> instead of stdout."), "file");
+    QCommandLineOption jobsOption(QStringList{"j", "jobs"}, Application::translate("CLI",
+        "Export up to <n> projects in parallel (default: number of CPU cores)."), "n",
+        QString::number(QThread::idealThreadCount()));
+    QCommandLineOption verboseOption("verbose", Application::translate("CLI",
+        "Print all debug messages to stderr."));
+    QCommandLineOption workerOption("worker", Application::translate("CLI",
+        "Internal: Export a single project and print its report."));
+    parser.addOptions({gerberOption, pdfOption, pngOption, tiffOption, dpiOption,
+                       layersOption, ercOption, outputDirOption, cacheDirOption,
+                       reportOption, jobsOption, verboseOption, workerOption});
+    parser.addPositionalArgument("projects", Application::translate("CLI",
+        "The *.lpp files of the projects to export."), "projects...");
+    parser.process(app);
+
+    if (parser.isSet(verboseOption)) {
+        Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::All);
+    }
+
+    QList<FilePath> projectFiles;
+    foreach (const QString& arg, parser.positionalArguments()) {
+        projectFiles.append(FilePath(QFileInfo(arg).absoluteFilePath()));
+    }
+    if (projectFiles.isEmpty()) {
+        parser.showHelp(2); // exits the application
+    }
+
+    // export everything if nothing is specified
+    ProjectExportJob::Options_t options;
+    bool exportAll = (!parser.isSet(gerberOption)) && (!parser.isSet(pdfOption))
+                     && (!parser.isSet(pngOption)) && (!parser.isSet(tiffOption))
+                     && (!parser.isSet(ercOption));
+    options.exportGerber = exportAll || parser.isSet(gerberOption);
+    options.exportPdf = exportAll || parser.isSet(pdfOption);
+    options.runErc = exportAll || parser.isSet(ercOption);
+    if (parser.isSet(pngOption)) {
+        options.imageFormat = "png";
+    } else if (parser.isSet(tiffOption)) {
+        options.imageFormat = "tiff";
+    }
+    bool valid = true;
+    options.imageDpi = parser.value(dpiOption).toInt(&valid);
+    if ((!valid) || (options.imageDpi < 1)) {
+        qCritical() << "Invalid resolution:" << parser.value(dpiOption);
+        return 2;
+    }
+    if (parser.isSet(layersOption)) {
+        QStringList ids = parser.value(layersOption).split(',', QString::SkipEmptyParts);
+        foreach (const QString& id, ids) {
+            options.boardLayers.append(id.trimmed().toInt(&valid));
+            if (!valid) {
+                qCritical() << "Invalid layer ID:" << id;
+                return 2;
+            }
+        }
+    }
+    if (parser.isSet(outputDirOption)) {
+        options.outputDir = FilePath(QFileInfo(parser.value(outputDirOption)).absoluteFilePath());
+    }
+    if (parser.isSet(cacheDirOption)) {
+        options.cacheDir = FilePath(QFileInfo(parser.value(cacheDirOption)).absoluteFilePath());
+    }
+
+    if (parser.isSet(workerOption)) {
+        // export one project in this process and print the report for the main process
+        if (projectFiles.count() != 1) return 2;
+        QJsonObject report = ProjectExportJob(projectFiles.first(), options).run();
+        QFile out;
+        out.open(stdout, QIODevice::WriteOnly);
+        out.write(QJsonDocument(report).toJson(QJsonDocument::Compact));
+        return report.value("success").toBool() ? 0 : 1;
+    }
+
+    // export all projects in worker processes
+    QJsonArray projects = BatchExport(projectFiles, options,
+                                      parser.value(jobsOption).toInt()).run();
+    bool success = true;
+    foreach (const QJsonValue& project, projects) {
+        success = success && project.toObject().value("success").toBool();
+    }
+    QJsonObject report;
+    report.insert("version", Application::applicationVersion());
+    report.insert("success", success);
+    report.insert("projects", projects);
+    if (!writeReport(QJsonDocument(report), parser.value(reportOption))) {
+        return 2;
+    }
+    return success ? 0 : 1;
+}
+
+/*****************************************************************************************
+ *  setApplicationMetadata()
+ ****************************************************************************************/
+
+static void setApplicationMetadata() noexcept
+{
+    Application::setOrganizationName("LibrePCB");
+    Application::setOrganizationDomain("librepcb.org");
+#ifdef GIT_BRANCH
+    Application::setApplicationName(QString("LibrePCB_git-%1").arg(GIT_BRANCH));
+#else
+    Application::setApplicationName("LibrePCB");
+#endif
+}
+
+/*****************************************************************************************
+ *  writeReport()
+ ****************************************************************************************/
+
+static bool writeReport(const QJsonDocument& report, const QString& filepath) noexcept
+{
+    QFile file(filepath);
+    bool success = filepath.isEmpty() ? file.open(stdout, QIODevice::WriteOnly)
+                                      : file.open(QIODevice::WriteOnly);
+    if ((!success) || (file.write(report.toJson()) < 0)) {
+        qCritical() << "Could not write the report:" << file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,241 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/exceptions.h>
+#include <librepcbproject/project.h>
+#include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/boardgerberexport.h>
+#include <librepcbproject/boards/boardimageexport.h>
+#include <librepcbproject/schematics/schematic.h>
+#include <librepcbcommon/graphics/tiledimagerenderer.h>
+#include <librepcbproject/erc/ercmsglist.h>
+#include "projectexportjob.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace cli {
+
+using namespace project;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+ProjectExportJob::ProjectExportJob(const FilePath& projectFile, const Options_t& options) noexcept :
+    mProjectFile(projectFile), mOptions(options)
+{
+}
+
+ProjectExportJob::~ProjectExportJob() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+QJsonObject ProjectExportJob::run() const noexcept
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QJsonObject report;
+    QJsonArray errors;
+    report.insert("project", mProjectFile.toNative());
+    try
+    {
+        Project project(mProjectFile, true); // can throw
+        report.insert("name", project.getName());
+        FilePath outputDir = mOptions.outputDir.isValid() ? mOptions.outputDir
+                             : project.getPath().getPathTo("generated");
+        report.insert("output_dir", outputDir.toNative());
+        if (mOptions.runErc) {
+            report.insert("erc", getErcMessages(project));
+        }
+        if (mOptions.exportGerber) {
+            report.insert("boards", exportBoards(project, outputDir, errors));
+        }
+        if (mOptions.exportPdf) {
+            report.insert("schematics_pdf", exportSchematics(project, outputDir, errors));
+        }
+        if (!mOptions.imageFormat.isEmpty()) {
+            report.insert("images", exportImages(project, outputDir, errors));
+        }
+    }
+    catch (Exception& e)
+    {
+        errors.append(e.getUserMsg());
+    }
+
+    report.insert("errors", errors);
+    report.insert("success", errors.isEmpty());
+    report.insert("duration_ms", static_cast<double>(timer.elapsed()));
+    return report;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QJsonArray ProjectExportJob::exportBoards(const Project& project, const FilePath& outputDir,
+                                          QJsonArray& errors) const noexcept
+{
+    QJsonArray boards;
+    foreach (const Board* board, project.getBoards()) {
+        QString dirName = FilePath::cleanFileName(board->getName(), FilePath::ReplaceSpaces);
+        if (dirName.isEmpty()) dirName = board->getUuid().toStr();
+        FilePath dir = outputDir.getPathTo("gerber/" % dirName);
+        QJsonObject obj;
+        obj.insert("name", board->getName());
+        obj.insert("output_dir", dir.toNative());
+        try
+        {
+            BoardGerberExport grbExport(*board, dir, mOptions.cacheDir);
+            grbExport.exportAllLayers(); // can throw
+            obj.insert("success", true);
+        }
+        catch (Exception& e)
+        {
+            obj.insert("success", false);
+            errors.append(QString("%1: %2").arg(board->getName(), e.getUserMsg()));
+        }
+        boards.append(obj);
+    }
+    return boards;
+}
+
+QJsonValue ProjectExportJob::exportSchematics(Project& project, const FilePath& outputDir,
+                                              QJsonArray& errors) const noexcept
+{
+    if (project.getSchematics().isEmpty()) return QJsonValue(); // nothing to export
+
+    QString filename = FilePath::cleanFileName(project.getName() % "_schematics.pdf",
+                                               FilePath::ReplaceSpaces);
+    FilePath filepath = outputDir.getPathTo(filename);
+    try
+    {
+        if (!outputDir.mkPath()) {
+            throw RuntimeError(__FILE__, __LINE__, outputDir.toStr(), QString(
+                tr("Could not create the directory \"%1\".")).arg(outputDir.toNative()));
+        }
+        project.exportSchematicsAsPdf(filepath); // can throw
+        return filepath.toNative();
+    }
+    catch (Exception& e)
+    {
+        errors.append(e.getUserMsg());
+        return QJsonValue();
+    }
+}
+
+QJsonArray ProjectExportJob::exportImages(Project& project, const FilePath& outputDir,
+                                          QJsonArray& errors) const noexcept
+{
+    QJsonArray images;
+    FilePath dir = outputDir.getPathTo("images");
+    QString suffix = "." % mOptions.imageFormat;
+    foreach (Board* board, project.getBoards()) {
+        QString filename = FilePath::cleanFileName(board->getName() % suffix,
+                                                   FilePath::ReplaceSpaces);
+        FilePath filepath = dir.getPathTo(filename);
+        try
+        {
+            BoardImageExport imageExport(*board);
+            imageExport.setDpi(mOptions.imageDpi);
+            imageExport.setLayers(mOptions.boardLayers);
+            imageExport.exportToFile(filepath); // can throw
+            images.append(filepath.toNative());
+        }
+        catch (Exception& e)
+        {
+            errors.append(QString("%1: %2").arg(board->getName(), e.getUserMsg()));
+        }
+    }
+    for (int i = 0; i < project.getSchematics().count(); ++i) {
+        const Schematic* schematic = project.getSchematics().at(i);
+        QString filename = FilePath::cleanFileName(QString("%1_%2").arg(i + 1)
+            .arg(schematic->getName()) % suffix, FilePath::ReplaceSpaces);
+        FilePath filepath = dir.getPathTo(filename);
+        try
+        {
+            schematic->clearSelection();
+            QRectF rect = schematic->getPrintRect();
+            QPicture picture;
+            {
+                QPainter painter(&picture);
+                schematic->renderToQPainter(painter, rect);
+            }
+            TiledImageRenderer renderer(picture, rect);
+            renderer.setDpi(mOptions.imageDpi);
+            renderer.setBackgroundColor(Qt::white);
+            renderer.exportToFile(filepath); // can throw
+            images.append(filepath.toNative());
+        }
+        catch (Exception& e)
+        {
+            errors.append(QString("%1: %2").arg(schematic->getName(), e.getUserMsg()));
+        }
+    }
+    return images;
+}
+
+QJsonArray ProjectExportJob::getErcMessages(const Project& project) const noexcept
+{
+    QJsonArray messages;
+    foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
+        if ((!msg->isVisible()) || (msg->isIgnored())) continue;
+        QJsonObject obj;
+        obj.insert("type", getErcMsgTypeName(msg->getMsgType()));
+        obj.insert("message", msg->getMsg());
+        messages.append(obj);
+    }
+    return messages;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QString ProjectExportJob::getErcMsgTypeName(ErcMsg::ErcMsgType_t type) noexcept
+{
+    switch (type)
+    {
+        case ErcMsg::ErcMsgType_t::CircuitError:        return "circuit_error";
+        case ErcMsg::ErcMsgType_t::CircuitWarning:      return "circuit_warning";
+        case ErcMsg::ErcMsgType_t::SchematicError:      return "schematic_error";
+        case ErcMsg::ErcMsgType_t::SchematicWarning:    return "schematic_warning";
+        case ErcMsg::ErcMsgType_t::BoardError:          return "board_error";
+        case ErcMsg::ErcMsgType_t::BoardWarning:        return "board_warning";
+        default: Q_ASSERT(false); return "unknown";
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace cli
+} // namespace librepcb
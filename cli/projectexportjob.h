@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CLI_PROJECTEXPORTJOB_H
+#define LIBREPCB_CLI_PROJECTEXPORTJOB_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/fileio/filepath.h>
+#include <librepcbproject/erc/ercmsg.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace project {
+class Project;
+}
+
+namespace cli {
+
+/*****************************************************************************************
+ *  Class ProjectExportJob
+ ****************************************************************************************/
+
+/**
+ * @brief The ProjectExportJob class exports the output files of a single project
+ *
+ * The project is opened in read-only mode, so it is neither locked nor modified, and no
+ * message boxes are shown. Errors do not abort the job, they are collected in the report
+ * instead (e.g. a board without outline does not prevent the export of the PDF).
+ *
+ * The output files are written to these locations within the output directory:
+ *  - Gerber/Excellon files: "gerber/<board name>/"
+ *  - Schematics: "<project name>_schematics.pdf"
+ *  - Images: "images/<board name>.<suffix>" and "images/<page>_<schematic name>.<suffix>"
+ */
+class ProjectExportJob final
+{
+        Q_DECLARE_TR_FUNCTIONS(ProjectExportJob)
+
+    public:
+
+        // Types
+        struct Options_t {
+            bool exportGerber = true;   ///< export the Gerber/Excellon files of all boards
+            bool exportPdf = true;      ///< export all schematic pages as PDF
+            bool runErc = true;         ///< add the ERC messages to the report
+            QString imageFormat;        ///< "png" or "tiff" to export images of all
+                                        ///< boards and schematics, empty: no images
+            int imageDpi = 600;         ///< the resolution of the images
+            QList<int> boardLayers;     ///< the layers in board images (empty: visible)
+            FilePath outputDir;         ///< invalid: the "generated" dir of the project
+            FilePath cacheDir;          ///< the CAM output cache, invalid: no cache
+        };
+
+        // Constructors / Destructor
+        ProjectExportJob() = delete;
+        ProjectExportJob(const ProjectExportJob& other) = delete;
+        ProjectExportJob(const FilePath& projectFile, const Options_t& options) noexcept;
+        ~ProjectExportJob() noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Open the project and export all requested files
+         *
+         * @return The report of the project (the format is described in README.md)
+         */
+        QJsonObject run() const noexcept;
+
+        // Operator Overloadings
+        ProjectExportJob& operator=(const ProjectExportJob& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        QJsonArray exportBoards(const project::Project& project, const FilePath& outputDir,
+                                QJsonArray& errors) const noexcept;
+        QJsonValue exportSchematics(project::Project& project, const FilePath& outputDir,
+                                    QJsonArray& errors) const noexcept;
+        QJsonArray exportImages(project::Project& project, const FilePath& outputDir,
+                                QJsonArray& errors) const noexcept;
+        QJsonArray getErcMessages(const project::Project& project) const noexcept;
+
+        // Static Methods
+        static QString getErcMsgTypeName(project::ErcMsg::ErcMsgType_t type) noexcept;
+
+
+        // Private Member Variables
+        FilePath mProjectFile;
+        Options_t mOptions;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace cli
+} // namespace librepcb
+
+#endif // LIBREPCB_CLI_PROJECTEXPORTJOB_H
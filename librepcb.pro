@@ -4,9 +4,11 @@ SUBDIRS = \
     3rdparty \
     libs \
     librepcb \
+    cli \
     tools \
     tests
 
 librepcb.depends = libs
+cli.depends = libs
 tools.depends = libs
 tests.depends = 3rdparty libs
@@ -78,6 +78,12 @@ class BoardDesignRules final : public IF_XmlSerializableObject
         const Length& getRestringViaMin() const noexcept {return mRestringViaMin;}
         const Length& getRestringViaMax() const noexcept {return mRestringViaMax;}
 
+        // Getters: Copper
+        const Length& getCopperClearance() const noexcept {return mCopperClearance;}
+        const Length& getCopperMinWidth() const noexcept {return mCopperMinWidth;}
+        const Length& getDrillMinDiameter() const noexcept {return mDrillMinDiameter;}
+        const Length& getThermalSpokeWidth() const noexcept {return mThermalSpokeWidth;}
+
 
         // Setters: General Attributes
         void setName(const QString& name) noexcept {if (!name.isEmpty()) mName = name;}
@@ -102,6 +108,12 @@ class BoardDesignRules final : public IF_XmlSerializableObject
         void setRestringViaMin(const Length& min) noexcept {if (min >= 0) mRestringViaMin = min;}
         void setRestringViaMax(const Length& max) noexcept {if (max >= 0) mRestringViaMax = max;}
 
+        // Setters: Copper
+        void setCopperClearance(const Length& clearance) noexcept {if (clearance >= 0) mCopperClearance = clearance;}
+        void setCopperMinWidth(const Length& width) noexcept {if (width >= 0) mCopperMinWidth = width;}
+        void setDrillMinDiameter(const Length& dia) noexcept {if (dia >= 0) mDrillMinDiameter = dia;}
+        void setThermalSpokeWidth(const Length& width) noexcept {if (width > 0) mThermalSpokeWidth = width;}
+
         // General Methods
         void restoreDefaults() noexcept;
 
@@ -147,6 +159,12 @@ class BoardDesignRules final : public IF_XmlSerializableObject
         qreal mRestringViaRatio;
         Length mRestringViaMin;
         Length mRestringViaMax;
+
+        // Copper
+        Length mCopperClearance;    ///< minimum distance between copper of different nets
+        Length mCopperMinWidth;     ///< minimum width of traces
+        Length mDrillMinDiameter;   ///< minimum diameter of vias and pad holes
+        Length mThermalSpokeWidth;  ///< width of the spokes connecting pads with zones
 };
 
 /*****************************************************************************************
@@ -0,0 +1,103 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "camoutputcache.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CamOutputCache::CamOutputCache(const FilePath& directory) noexcept :
+    mDirectory(directory)
+{
+}
+
+CamOutputCache::~CamOutputCache() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+bool CamOutputCache::isUpToDate(const FilePath& outputFile, const QByteArray& key) const noexcept
+{
+    if (!isEnabled()) return false;
+    QFile entry(getEntryFilePath(outputFile).toStr());
+    if (!entry.open(QIODevice::ReadOnly)) return false; // not cached yet
+
+    // the entry contains the hex encoded key and content hash, one per line
+    QList<QByteArray> lines = entry.readAll().split('\n');
+    if ((lines.count() < 2) || (lines.at(0) != key.toHex())) return false;
+    QByteArray contentHash = calcContentHash(outputFile);
+    return (!contentHash.isEmpty()) && (lines.at(1) == contentHash.toHex());
+}
+
+void CamOutputCache::update(const FilePath& outputFile, const QByteArray& key) const noexcept
+{
+    if (!isEnabled()) return;
+    QByteArray contentHash = calcContentHash(outputFile);
+    if (contentHash.isEmpty() || (!mDirectory.mkPath())) {
+        qWarning() << "Could not update the CAM output cache of" << outputFile.toNative();
+        return;
+    }
+    QByteArray content = key.toHex() + '\n' + contentHash.toHex() + '\n';
+    QSaveFile entry(getEntryFilePath(outputFile).toStr());
+    if ((!entry.open(QIODevice::WriteOnly)) || (entry.write(content) < 0) ||
+        (!entry.commit()))
+    {
+        qWarning() << "Could not write the CAM output cache entry:" << entry.errorString();
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+FilePath CamOutputCache::getEntryFilePath(const FilePath& outputFile) const noexcept
+{
+    QByteArray name = QCryptographicHash::hash(outputFile.toStr().toUtf8(),
+                                               QCryptographicHash::Sha1).toHex();
+    return mDirectory.getPathTo(QString::fromLatin1(name));
+}
+
+QByteArray CamOutputCache::calcContentHash(const FilePath& file) noexcept
+{
+    QFile f(file.toStr());
+    if (!f.open(QIODevice::ReadOnly)) return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&f)) return QByteArray();
+    return hash.result();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
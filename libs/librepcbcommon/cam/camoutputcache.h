@@ -0,0 +1,108 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CAMOUTPUTCACHE_H
+#define LIBREPCB_CAMOUTPUTCACHE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../fileio/filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class CamOutputCache
+ ****************************************************************************************/
+
+/**
+ * @brief The CamOutputCache class remembers from which inputs output files were generated
+ *
+ * For every output file, the cache stores a key (a hash over all inputs of the file,
+ * calculated by the caller) and a hash over the content of the written file. An output
+ * file does not need to be generated again if its key did not change and the file was
+ * neither modified nor deleted in the meantime. This avoids the generation and keeps the
+ * timestamp of the file unchanged.
+ *
+ * Every output file has its own small entry file in the cache directory, so different
+ * output files can be checked and updated concurrently. The cache is optional: If it
+ * cannot be read or written, the files are just generated again. A cache with an invalid
+ * directory is disabled, i.e. it never reports a file as up to date and writes nothing.
+ */
+class CamOutputCache final
+{
+    public:
+
+        // Constructors / Destructor
+        CamOutputCache() = delete;
+        CamOutputCache(const CamOutputCache& other) = delete;
+        explicit CamOutputCache(const FilePath& directory) noexcept;
+        ~CamOutputCache() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept {return mDirectory.isValid();}
+
+        // General Methods
+
+        /**
+         * @brief Check whether an output file was already generated with the same key
+         *
+         * @param outputFile    The output file to check
+         * @param key           The hash over all inputs of the output file
+         *
+         * @return True if the file exists and its content is still what was generated
+         *         from the same key, false if it needs to be generated
+         */
+        bool isUpToDate(const FilePath& outputFile, const QByteArray& key) const noexcept;
+
+        /**
+         * @brief Remember the key of an output file (after it was written)
+         *
+         * @param outputFile    The output file which was generated
+         * @param key           The hash over all inputs of the output file
+         */
+        void update(const FilePath& outputFile, const QByteArray& key) const noexcept;
+
+        // Operator Overloadings
+        CamOutputCache& operator=(const CamOutputCache& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        FilePath getEntryFilePath(const FilePath& outputFile) const noexcept;
+        static QByteArray calcContentHash(const FilePath& file) noexcept;
+
+
+        // Private Member Variables
+        FilePath mDirectory;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CAMOUTPUTCACHE_H
@@ -0,0 +1,262 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "drillpathoptimizer.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+constexpr int DrillPathOptimizer::sNeighbourCount;
+constexpr int DrillPathOptimizer::sDefaultWorkPerDrill;
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QVector<int> DrillPathOptimizer::optimize(const QVector<Point>& positions,
+                                          int workPerDrill) noexcept
+{
+    int count = positions.count();
+    if (count < 3) {
+        QVector<int> path;
+        for (int i = 0; i < count; ++i) path.append(i);
+        if ((count == 2) && (positions.at(1).getLength() < positions.at(0).getLength())) {
+            std::swap(path[0], path[1]); // start at the drill nearest to the origin
+        }
+        return path;
+    }
+
+    // determine the extent of all drills
+    qint64 minX = positions.first().getX().toNm(), maxX = minX;
+    qint64 minY = positions.first().getY().toNm(), maxY = minY;
+    for (int i = 1; i < count; ++i) {
+        minX = qMin(minX, positions.at(i).getX().toNm());
+        maxX = qMax(maxX, positions.at(i).getX().toNm());
+        minY = qMin(minY, positions.at(i).getY().toNm());
+        maxY = qMax(maxY, positions.at(i).getY().toNm());
+    }
+
+    // build a grid with roughly one drill per cell (also for very narrow extents)
+    qreal width = qreal(maxX - minX), height = qreal(maxY - minY);
+    qreal cellSizeF = qMax(qSqrt(qMax(width, 1.0) * qMax(height, 1.0) / count),
+                           qMax(width, height) / count);
+    qint64 cellSize = qMax(qint64(qCeil(cellSizeF)), qint64(1));
+    int cols = int((maxX - minX) / cellSize) + 1;
+    int rows = int((maxY - minY) / cellSize) + 1;
+    QVector<QVector<int>> grid(cols * rows);
+    QVector<int> cells(count);
+    for (int i = 0; i < count; ++i) {
+        int cx = int((positions.at(i).getX().toNm() - minX) / cellSize);
+        int cy = int((positions.at(i).getY().toNm() - minY) / cellSize);
+        cells[i] = cy * cols + cx;
+        grid[cells.at(i)].append(i);
+    }
+
+    QVector<int> path = buildNearestNeighbourPath(positions, grid, cells, cols, rows,
+                                                  cellSize);
+    QVector<QVector<int>> neighbours = findNeighbours(positions, grid, cells, cols, rows,
+                                                      cellSize);
+    improveWith2Opt(positions, neighbours, path, qint64(workPerDrill) * count);
+    return path;
+}
+
+qreal DrillPathOptimizer::calcPathLength(const QVector<Point>& positions,
+                                         const QVector<int>& order) noexcept
+{
+    qreal length = 0;
+    for (int i = 1; i < order.count(); ++i) {
+        length += distance(positions.at(order.at(i - 1)), positions.at(order.at(i)));
+    }
+    return length;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QVector<int> DrillPathOptimizer::buildNearestNeighbourPath(const QVector<Point>& positions,
+        const QVector<QVector<int>>& grid, const QVector<int>& cells,
+        int cols, int rows, qint64 cellSize) noexcept
+{
+    // start at the drill nearest to the origin (ties are broken by the index)
+    int current = 0;
+    for (int i = 1; i < positions.count(); ++i) {
+        if (positions.at(i).getLength() < positions.at(current).getLength()) current = i;
+    }
+
+    QVector<QVector<int>> remaining = grid;
+    QVector<int> path;
+    path.reserve(positions.count());
+    int maxRing = qMax(cols, rows);
+    while (true) {
+        path.append(current);
+        QVector<int>& cell = remaining[cells.at(current)];
+        cell.remove(cell.indexOf(current));
+        if (path.count() == positions.count()) break;
+
+        // search the nearest unvisited drill in rings around the current cell
+        int cellX = cells.at(current) % cols, cellY = cells.at(current) / cols;
+        int next = -1;
+        qreal nextDistance = 0;
+        for (int r = 0; r <= maxRing; ++r) {
+            // all drills in this ring are at least (r-1) cells away
+            if ((next >= 0) && (r > 0) && (qreal(r - 1) * cellSize > nextDistance)) break;
+            for (int cy = cellY - r; cy <= cellY + r; ++cy) {
+                if ((cy < 0) || (cy >= rows)) continue;
+                // in the inner rows, only the left and right cell belong to the ring
+                bool outerRow = (qAbs(cy - cellY) == r);
+                int step = outerRow ? 1 : 2 * r;
+                for (int cx = cellX - r; cx <= cellX + r; cx += step) {
+                    if ((cx < 0) || (cx >= cols)) continue;
+                    foreach (int i, remaining.at(cy * cols + cx)) {
+                        qreal d = distance(positions.at(current), positions.at(i));
+                        if ((next < 0) || (d < nextDistance) ||
+                            ((d == nextDistance) && (i < next))) {
+                            next = i;
+                            nextDistance = d;
+                        }
+                    }
+                }
+            }
+        }
+        Q_ASSERT(next >= 0);
+        current = next;
+    }
+    return path;
+}
+
+QVector<QVector<int>> DrillPathOptimizer::findNeighbours(const QVector<Point>& positions,
+        const QVector<QVector<int>>& grid, const QVector<int>& cells,
+        int cols, int rows, qint64 cellSize) noexcept
+{
+    int k = qMin(sNeighbourCount, positions.count() - 1);
+    int maxRing = qMax(cols, rows);
+    QVector<QVector<int>> neighbours(positions.count());
+    QVector<QPair<qreal, int>> candidates; // sorted by distance, at most k entries
+    for (int i = 0; i < positions.count(); ++i) {
+        candidates.clear();
+        int cellX = cells.at(i) % cols, cellY = cells.at(i) / cols;
+        for (int r = 0; r <= maxRing; ++r) {
+            if ((candidates.count() == k) && (r > 0) &&
+                (qreal(r - 1) * cellSize > candidates.last().first)) break;
+            for (int cy = cellY - r; cy <= cellY + r; ++cy) {
+                if ((cy < 0) || (cy >= rows)) continue;
+                bool outerRow = (qAbs(cy - cellY) == r);
+                int step = outerRow ? 1 : 2 * r;
+                for (int cx = cellX - r; cx <= cellX + r; cx += step) {
+                    if ((cx < 0) || (cx >= cols)) continue;
+                    foreach (int j, grid.at(cy * cols + cx)) {
+                        if (j == i) continue;
+                        QPair<qreal, int> candidate(distance(positions.at(i), positions.at(j)), j);
+                        if ((candidates.count() == k) && !(candidate < candidates.last())) continue;
+                        auto it = std::upper_bound(candidates.begin(), candidates.end(), candidate);
+                        candidates.insert(it, candidate);
+                        if (candidates.count() > k) candidates.removeLast();
+                    }
+                }
+            }
+        }
+        neighbours[i].reserve(candidates.count());
+        foreach (const auto& candidate, candidates) {
+            neighbours[i].append(candidate.second);
+        }
+    }
+    return neighbours;
+}
+
+void DrillPathOptimizer::improveWith2Opt(const QVector<Point>& positions,
+        const QVector<QVector<int>>& neighbours, QVector<int>& path, qint64 workBudget) noexcept
+{
+    int n = path.count();
+    QVector<int> index(n); // the index of every drill in the path
+    for (int i = 0; i < n; ++i) index[path.at(i)] = i;
+
+    // The path is open, so the edges before the first and after the last drill do not
+    // exist (length 0). A 2-opt move (x, y) with -1 <= x < y-1 < n-1 replaces the edges
+    // (x, x+1) and (y, y+1) by (x, y) and (x+1, y+1) by reversing the path from x+1 to y.
+    auto edgeLength = [&](int a, int b) {
+        return ((a < 0) || (b >= n)) ? 0.0 : distance(positions.at(path.at(a)),
+                                                       positions.at(path.at(b)));
+    };
+
+    // only drills next to a changed edge are checked again ("don't look bits")
+    QVector<bool> queued(n, true);
+    QQueue<int> queue;
+    for (int i = 0; i < n; ++i) queue.enqueue(path.at(i));
+
+    // every evaluated neighbour and every moved drill costs one unit of the work budget
+    qint64 work = 0;
+    while ((!queue.isEmpty()) && (work < workBudget)) {
+        int drill = queue.dequeue();
+        queued[drill] = false;
+        int i = index.at(drill);
+        bool improved = false;
+        for (int direction = 0; (direction < 2) && (!improved); ++direction) {
+            // direction 0: replace the edge to the successor, 1: to the predecessor
+            qreal oldEdge = (direction == 0) ? edgeLength(i, i + 1) : edgeLength(i - 1, i);
+            foreach (int neighbour, neighbours.at(drill)) {
+                ++work;
+                qreal newEdge = distance(positions.at(drill), positions.at(neighbour));
+                if (newEdge >= oldEdge) break; // the neighbours are sorted by distance
+                int j = index.at(neighbour);
+                int x = qMin(i, j) - direction;
+                int y = qMax(i, j) - direction;
+                if (y - x < 2) continue; // adjacent edges
+                qreal gain = edgeLength(x, x + 1) + edgeLength(y, y + 1)
+                           - edgeLength(x, y) - edgeLength(x + 1, y + 1);
+                if (gain <= 0.5) continue; // ignore rounding errors (below 1nm)
+                std::reverse(path.begin() + x + 1, path.begin() + y + 1);
+                work += y - x;
+                for (int k = x + 1; k <= y; ++k) index[path.at(k)] = k;
+                for (int k : {x, x + 1, y, y + 1}) {
+                    if ((k >= 0) && (k < n) && (!queued.at(path.at(k)))) {
+                        queued[path.at(k)] = true;
+                        queue.enqueue(path.at(k));
+                    }
+                }
+                improved = true;
+                break;
+            }
+        }
+    }
+}
+
+qreal DrillPathOptimizer::distance(const Point& p1, const Point& p2) noexcept
+{
+    qreal dx = qreal(p1.getX().toNm() - p2.getX().toNm());
+    qreal dy = qreal(p1.getY().toNm() - p2.getY().toNm());
+    return qSqrt(dx * dx + dy * dy);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
@@ -0,0 +1,122 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_DRILLPATHOPTIMIZER_H
+#define LIBREPCB_DRILLPATHOPTIMIZER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class DrillPathOptimizer
+ ****************************************************************************************/
+
+/**
+ * @brief The DrillPathOptimizer class calculates a short path through all drills of a tool
+ *
+ * The path starts at the drill nearest to the origin and is built with the nearest
+ * neighbour heuristic, using a uniform grid to find the nearest unvisited drill. Then the
+ * path is improved with 2-opt moves (reversing a part of the path) until no improving
+ * move is found or the work budget is exhausted. Only the nearest drills of every drill
+ * are considered as new neighbours, so every pass costs roughly O(n) instead of O(n²).
+ *
+ * The work budget counts the evaluated neighbours and the drills moved by reversing parts
+ * of the path, so it bounds the run time without depending on the speed of the machine.
+ * The path is open (the drill head does not return to the start), and the result only
+ * depends on the positions and the budget, i.e. it is always deterministic.
+ */
+class DrillPathOptimizer final
+{
+    public:
+
+        // Constructors / Destructor
+        DrillPathOptimizer() = delete;
+        DrillPathOptimizer(const DrillPathOptimizer& other) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Calculate the order in which the drills should be drilled
+         *
+         * @param positions     The positions of all drills (of the same tool)
+         * @param workPerDrill  The max. work of the 2-opt improvement per drill (see
+         *                      class description), 0 means nearest neighbour path only
+         *
+         * @return The indices of all positions in drilling order
+         */
+        static QVector<int> optimize(const QVector<Point>& positions,
+                                     int workPerDrill = sDefaultWorkPerDrill) noexcept;
+
+        /**
+         * @brief Calculate the length of a path
+         *
+         * @param positions     The positions of all drills
+         * @param order         The indices of the positions in drilling order
+         *
+         * @return The length of the path [nm]
+         */
+        static qreal calcPathLength(const QVector<Point>& positions,
+                                    const QVector<int>& order) noexcept;
+
+        // Static Attributes
+        static constexpr int sDefaultWorkPerDrill = 1000; ///< enough for typical boards
+
+        // Operator Overloadings
+        DrillPathOptimizer& operator=(const DrillPathOptimizer& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        static QVector<int> buildNearestNeighbourPath(const QVector<Point>& positions,
+                                                      const QVector<QVector<int>>& grid,
+                                                      const QVector<int>& cells,
+                                                      int cols, int rows,
+                                                      qint64 cellSize) noexcept;
+        static QVector<QVector<int>> findNeighbours(const QVector<Point>& positions,
+                                                    const QVector<QVector<int>>& grid,
+                                                    const QVector<int>& cells,
+                                                    int cols, int rows,
+                                                    qint64 cellSize) noexcept;
+        static void improveWith2Opt(const QVector<Point>& positions,
+                                    const QVector<QVector<int>>& neighbours,
+                                    QVector<int>& path, qint64 workBudget) noexcept;
+        static qreal distance(const Point& p1, const Point& p2) noexcept;
+
+        /// The number of nearest drills which are considered by the 2-opt moves
+        static constexpr int sNeighbourCount = 8;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_DRILLPATHOPTIMIZER_H
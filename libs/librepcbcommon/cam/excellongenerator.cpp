@@ -22,6 +22,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include "excellongenerator.h"
+#include "drillpathoptimizer.h"
 #include "../fileio/smarttextfile.h"
 
 /*****************************************************************************************
@@ -34,7 +35,7 @@ namespace librepcb {
  ****************************************************************************************/
 
 ExcellonGenerator::ExcellonGenerator() noexcept :
-    mOutput()
+    mOutput(), mDrillList(), mRotation(), mOffset(), mRepetitions({Point(0, 0)})
 {
 }
 
@@ -48,7 +49,18 @@ ExcellonGenerator::~ExcellonGenerator() noexcept
 
 void ExcellonGenerator::drill(const Point& pos, const Length& dia) noexcept
 {
-    mDrillList.insert(dia, pos);
+    mDrillList.insert(dia, pos.rotated(mRotation) + mOffset);
+}
+
+void ExcellonGenerator::setTransformation(const Angle& rotation, const Point& offset) noexcept
+{
+    mRotation = rotation;
+    mOffset = offset;
+}
+
+void ExcellonGenerator::setRepetitions(const QVector<Point>& offsets) noexcept
+{
+    mRepetitions = offsets.isEmpty() ? QVector<Point>({Point(0, 0)}) : offsets;
 }
 
 void ExcellonGenerator::generate() throw (Exception)
@@ -70,6 +82,9 @@ void ExcellonGenerator::reset() noexcept
 {
     mOutput.clear();
     mDrillList.clear();
+    mRotation = Angle::deg0();
+    mOffset = Point(0, 0);
+    mRepetitions = {Point(0, 0)};
 }
 
 /*****************************************************************************************
@@ -105,10 +120,22 @@ void ExcellonGenerator::printToolList() noexcept
 
 void ExcellonGenerator::printDrills() noexcept
 {
-    for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
+    QList<Length> diameters = mDrillList.uniqueKeys();
+    for (int i = 0; i < diameters.count(); ++i) {
         mOutput.append(QString("T%1\n").arg(i+1)); // Select Tool
-        Length dia = mDrillList.uniqueKeys().value(i);
-        foreach (const Point& pos, mDrillList.values(dia)) {
+        QList<Point> drills = mDrillList.values(diameters.at(i));
+        QVector<Point> positions;
+        positions.reserve(drills.count() * mRepetitions.count());
+        foreach (const Point& offset, mRepetitions) {
+            foreach (const Point& drill, drills) {
+                positions.append(drill + offset);
+            }
+        }
+        // drill in an order which keeps the travel distance of the drill head short (the
+        // work budget of the optimization is proportional to the number of drills, so
+        // the output does not depend on the speed of the machine)
+        foreach (int index, DrillPathOptimizer::optimize(positions)) {
+            const Point& pos = positions.at(index);
             mOutput.append(QString("X%1Y%2\n").arg(pos.getX().toMmString(),
                                                    pos.getY().toMmString()));
         }
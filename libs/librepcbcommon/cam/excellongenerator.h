@@ -60,6 +60,22 @@ class ExcellonGenerator final
 
         // General Methods
         void drill(const Point& pos, const Length& dia) noexcept;
+
+        /**
+         * @brief Rotate and move the drills of all subsequent #drill() calls
+         *
+         * @see GerberGenerator#setTransformation()
+         */
+        void setTransformation(const Angle& rotation, const Point& offset) noexcept;
+
+        /**
+         * @brief Repeat all drills at several offsets (e.g. for a panel)
+         *
+         * The drills are stored only once and repeated when generating the output. The
+         * repetitions are written as plain coordinates since the Excellon pattern
+         * commands (M25/M02) are not supported by all CAM tools.
+         */
+        void setRepetitions(const QVector<Point>& offsets) noexcept;
         void generate() throw (Exception);
         void saveToFile(const FilePath& filepath) const throw (Exception);
         void reset() noexcept;
@@ -79,6 +95,9 @@ class ExcellonGenerator final
         // Excellon Data
         QString mOutput;
         QMultiMap<Length, Point> mDrillList;
+        Angle mRotation;                ///< see #setTransformation()
+        Point mOffset;                  ///< see #setTransformation()
+        QVector<Point> mRepetitions;    ///< see #setRepetitions()
 };
 
 /*****************************************************************************************
@@ -51,8 +51,8 @@ QString GerberApertureList::generateString() const noexcept
     foreach (const QString& macro, mApertureMacros) {
         str.append(QString("%AM%1*%\n").arg(macro));
     }
-    foreach (int number, mApertures.keys()) {
-        str.append(QString("%ADD%1%2*%\n").arg(number).arg(mApertures.value(number)));
+    for (int i = 0; i < mApertures.count(); ++i) {
+        str.append(QString("%ADD%1%2*%\n").arg(i + 10).arg(generateAperture(mApertures.at(i))));
     }
     str.append("G04 --- APERTURE LIST END --- *\n");
     return str;
@@ -64,15 +64,15 @@ QString GerberApertureList::generateString() const noexcept
 
 int GerberApertureList::setCircle(const Length& dia, const Length& hole)
 {
-    return setCurrentAperture(generateCircle(dia, hole));
+    return setCurrentAperture(Shape_t::Circle, dia, Length(0), Angle::deg0(), hole);
 }
 
 int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateRect(w, h, hole));
+        return setCurrentAperture(Shape_t::Rect, w, h, Angle::deg0(), hole);
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateRect(h, w, hole));
+        return setCurrentAperture(Shape_t::Rect, h, w, Angle::deg0(), hole);
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
         if (hole > 0) {
@@ -80,16 +80,16 @@ int GerberApertureList::setRect(const Length& w, const Length& h, const Angle& r
         } else {
             addMacro(generateRotatedRectMacro());
         }
-        return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+        return setCurrentAperture(Shape_t::RotatedRect, w, h, rot, hole);
     }
 }
 
 int GerberApertureList::setObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept
 {
     if (rot % Angle::deg180() == 0) {
-        return setCurrentAperture(generateObround(w, h, hole));
+        return setCurrentAperture(Shape_t::Obround, w, h, Angle::deg0(), hole);
     } else if (rot % Angle::deg90() == 0) {
-        return setCurrentAperture(generateObround(h, w, hole));
+        return setCurrentAperture(Shape_t::Obround, h, w, Angle::deg0(), hole);
     } else {
         // Rotation is not a multiple of 90 degrees --> we need to use an aperture macro
         if (hole > 0) {
@@ -97,7 +97,7 @@ int GerberApertureList::setObround(const Length& w, const Length& h, const Angle
         } else {
             addMacro(generateRotatedObroundMacro());
         }
-        return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+        return setCurrentAperture(Shape_t::RotatedObround, w, h, rot, hole);
     }
 }
 
@@ -108,27 +108,38 @@ int GerberApertureList::setRegularPolygon(const Length& dia, int n, const Angle&
     }
     // Adjust rotation as its interpretation differs between LibrePCB and Gerber specs
     Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-    return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+    return setCurrentAperture(Shape_t::RegularPolygon, dia, Length(0), grbRot, hole, n);
 }
 
 void GerberApertureList::reset() noexcept
 {
     //mApertureMacros.clear();
     mApertures.clear();
+    mApertureNumbers.clear();
 }
 
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept
+int GerberApertureList::setCurrentAperture(Shape_t shape, const Length& w, const Length& h,
+                                           const Angle& rot, const Length& hole, int n) noexcept
 {
-    int number = mApertures.key(aperture, -1);
-    if (number < 0) {
-        number = mApertures.count() + 10; // 10 is the number of the first aperture
-        Q_ASSERT(!mApertures.contains(number));
-        mApertures.insert(number, aperture);
+    Aperture_t aperture;
+    aperture.shape = shape;
+    aperture.width = w.toNm();
+    aperture.height = h.toNm();
+    // equal rotations must give the same key (e.g. -90° and 270°)
+    aperture.rotation = rot.mappedTo0_360deg().toMicroDeg();
+    aperture.hole = qMax(hole.toNm(), LengthBase_t(0)); // no hole is generated if <= 0
+    aperture.vertices = n;
+    auto it = mApertureNumbers.constFind(aperture);
+    if (it != mApertureNumbers.constEnd()) {
+        return it.value();
     }
+    int number = mApertures.count() + 10; // 10 is the number of the first aperture
+    mApertures.append(aperture);
+    mApertureNumbers.insert(aperture, number);
     return number;
 }
 
@@ -143,6 +154,24 @@ void GerberApertureList::addMacro(const QString& macro) noexcept
  *  Aperture Generator Methods
  ****************************************************************************************/
 
+QString GerberApertureList::generateAperture(const Aperture_t& aperture) noexcept
+{
+    Length w(aperture.width);
+    Length h(aperture.height);
+    Angle rot(aperture.rotation);
+    Length hole(aperture.hole);
+    switch (aperture.shape)
+    {
+        case Shape_t::Circle:           return generateCircle(w, hole);
+        case Shape_t::Rect:             return generateRect(w, h, hole);
+        case Shape_t::Obround:          return generateObround(w, h, hole);
+        case Shape_t::RegularPolygon:   return generateRegularPolygon(w, aperture.vertices, rot, hole);
+        case Shape_t::RotatedRect:      return generateRotatedRect(w, h, rot, hole);
+        case Shape_t::RotatedObround:   return generateRotatedObround(w, h, rot, hole);
+        default:                        Q_ASSERT(false); return QString();
+    }
+}
+
 QString GerberApertureList::generateCircle(const Length& dia, const Length& hole) noexcept
 {
     if (hole > 0) {
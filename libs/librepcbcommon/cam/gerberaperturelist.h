@@ -41,6 +41,11 @@ namespace librepcb {
 /**
  * @brief The GerberApertureList class
  *
+ * The apertures are identified by a structural key (shape, dimensions in nanometers,
+ * rotation in microdegrees mapped to [0..360[ degrees and hole), so looking up an
+ * already existing aperture is a hash lookup. The aperture definitions are formatted only
+ * in #generateString().
+ *
  * @author ubruhin
  * @date 2016-03-31
  */
@@ -72,11 +77,39 @@ class GerberApertureList final
 
     private:
 
+        // Private Types
+        enum class Shape_t {Circle, Rect, Obround, RegularPolygon, RotatedRect,
+                            RotatedObround};
+        struct Aperture_t {
+            Shape_t shape;
+            LengthBase_t width;     ///< the diameter for circles and polygons
+            LengthBase_t height;    ///< 0 for circles and polygons
+            qint32 rotation;        ///< [microdegrees]
+            LengthBase_t hole;      ///< 0 if there is no hole
+            int vertices;           ///< only for polygons, 0 otherwise
+
+            bool operator==(const Aperture_t& rhs) const noexcept {
+                return (shape == rhs.shape) && (width == rhs.width)
+                    && (height == rhs.height) && (rotation == rhs.rotation)
+                    && (hole == rhs.hole) && (vertices == rhs.vertices);
+            }
+        };
+        friend uint qHash(const Aperture_t& key, uint seed) noexcept {
+            seed = hashCombine(seed, qHash(static_cast<int>(key.shape)));
+            seed = hashCombine(seed, qHash(key.width));
+            seed = hashCombine(seed, qHash(key.height));
+            seed = hashCombine(seed, qHash(key.rotation));
+            seed = hashCombine(seed, qHash(key.hole));
+            return hashCombine(seed, qHash(key.vertices));
+        }
+
         // Private Methods
-        int setCurrentAperture(const QString& aperture) noexcept;
+        int setCurrentAperture(Shape_t shape, const Length& w, const Length& h,
+                               const Angle& rot, const Length& hole, int n = 0) noexcept;
         void addMacro(const QString& macro) noexcept;
 
         // Aperture Generator Methods
+        static QString generateAperture(const Aperture_t& aperture) noexcept;
         static QString generateCircle(const Length& dia, const Length& hole) noexcept;
         static QString generateRect(const Length& w, const Length& h, const Length& hole) noexcept;
         static QString generateObround(const Length& w, const Length& h, const Length& hole) noexcept;
@@ -87,10 +120,14 @@ class GerberApertureList final
         static QString generateRotatedObroundMacroWithHole();
         static QString generateRotatedRect(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
         static QString generateRotatedObround(const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
+        static uint hashCombine(uint seed, uint hash) noexcept {
+            return seed ^ (hash + 0x9e3779b9u + (seed << 6) + (seed >> 2));
+        }
 
 
         QList<QString> mApertureMacros;
-        QMap<int, QString> mApertures; ///< key: aperture number (>= 10); value: aperture definition
+        QVector<Aperture_t> mApertures;         ///< index: aperture number - 10
+        QHash<Aperture_t, int> mApertureNumbers; ///< value: aperture number (>= 10)
 };
 
 /*****************************************************************************************
@@ -25,13 +25,19 @@
 #include "gerberaperturelist.h"
 #include "../geometry/ellipse.h"
 #include "../geometry/polygon.h"
-#include "../fileio/smarttextfile.h"
+#include "../fileio/filepath.h"
 
 /*****************************************************************************************
  *  Namespace
  ****************************************************************************************/
 namespace librepcb {
 
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+constexpr int GerberGenerator::sContentBufferSize;
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
@@ -40,10 +46,11 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
                                  const QString& projRevision) noexcept :
     mProjectId(QString(projName).remove(QChar(','))),
     mProjectGuid(projUuid.toStr().remove(QChar('-'))),
-    mProjectRevision(projRevision), mOutput(), mContent(),
+    mProjectRevision(projRevision), mContent(), mContentSpool(), mContentSpoolError(),
     mApertureList(new GerberApertureList()), mCurrentApertureNumber(-1),
-    mMultiQuadrantArcModeOn(false)
+    mMultiQuadrantArcModeOn(false), mRotation(), mOffset()
 {
+    mContent.reserve(sContentBufferSize);
 }
 
 GerberGenerator::~GerberGenerator() noexcept
@@ -58,12 +65,30 @@ void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept
 {
     switch (p)
     {
-        case LayerPolarity::Positive: mContent.append("%LPD*%\n"); break;
-        case LayerPolarity::Negative: mContent.append("%LPC*%\n"); break;
+        case LayerPolarity::Positive: appendContent("%LPD*%\n"); break;
+        case LayerPolarity::Negative: appendContent("%LPC*%\n"); break;
         default: qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p); break;
     }
 }
 
+void GerberGenerator::setTransformation(const Angle& rotation, const Point& offset) noexcept
+{
+    mRotation = rotation;
+    mOffset = offset;
+}
+
+void GerberGenerator::beginStepAndRepeat(int countX, int countY, const Length& stepX,
+                                         const Length& stepY) noexcept
+{
+    appendContent(QString("%SRX%1Y%2I%3J%4*%\n").arg(countX).arg(countY)
+                  .arg(stepX.toMmString(), stepY.toMmString()).toLatin1());
+}
+
+void GerberGenerator::endStepAndRepeat() noexcept
+{
+    appendContent("%SR*%\n");
+}
+
 void GerberGenerator::drawLine(const Point& start, const Point& end, const Length& width) noexcept
 {
     setCurrentAperture(mApertureList->setCircle(width, Length(0)));
@@ -71,6 +96,16 @@ void GerberGenerator::drawLine(const Point& start, const Point& end, const Lengt
     linearInterpolateToPosition(end);
 }
 
+void GerberGenerator::drawPolyline(const QVector<Point>& points, const Length& width) noexcept
+{
+    if (points.count() < 2) return;
+    setCurrentAperture(mApertureList->setCircle(width, Length(0)));
+    moveToPosition(points.first());
+    for (int i = 1; i < points.count(); ++i) {
+        linearInterpolateToPosition(points.at(i));
+    }
+}
+
 void GerberGenerator::drawEllipseOutline(const Ellipse& ellipse) noexcept
 {
     if (ellipse.getRadiusX() == ellipse.getRadiusY()) {
@@ -79,8 +114,12 @@ void GerberGenerator::drawEllipseOutline(const Ellipse& ellipse) noexcept
         if (innerDia < 0) innerDia = 0;
         flashCircle(ellipse.getCenter(), outerDia, innerDia);
     } else {
-        // TODO!
-        qWarning() << "Ellipse was ignored in gerber output!";
+        const QVector<Point>& vertices = ellipse.getVertices();
+        setCurrentAperture(mApertureList->setCircle(ellipse.getLineWidth(), Length(0)));
+        moveToPosition(vertices.first());
+        for (int i = 1; i < vertices.count(); ++i) {
+            linearInterpolateToPosition(vertices.at(i));
+        }
     }
 }
 
@@ -89,8 +128,7 @@ void GerberGenerator::drawEllipseArea(const Ellipse& ellipse) noexcept
     if (ellipse.getRadiusX() == ellipse.getRadiusY()) {
         flashCircle(ellipse.getCenter(), ellipse.getRadiusX() * 2, Length(0));
     } else {
-        // TODO!
-        qWarning() << "Ellipse was ignored in gerber output!";
+        drawRegion(ellipse.getVertices());
     }
 }
 
@@ -158,6 +196,19 @@ void GerberGenerator::drawPolygonArea(const Polygon& polygon) noexcept
     setRegionModeOff();
 }
 
+void GerberGenerator::drawRegion(const QVector<Point>& points) noexcept
+{
+    if (points.count() < 3) return;
+    setCurrentAperture(mApertureList->setCircle(Length(0), Length(0)));
+    setRegionModeOn();
+    moveToPosition(points.first());
+    for (int i = 1; i < points.count(); ++i) {
+        linearInterpolateToPosition(points.at(i));
+    }
+    linearInterpolateToPosition(points.first()); // regions must be closed
+    setRegionModeOff();
+}
+
 void GerberGenerator::flashCircle(const Point& pos, const Length& dia, const Length& hole) noexcept
 {
     setCurrentAperture(mApertureList->setCircle(dia, hole));
@@ -167,21 +218,21 @@ void GerberGenerator::flashCircle(const Point& pos, const Length& dia, const Len
 void GerberGenerator::flashRect(const Point& pos, const Length& w, const Length& h,
                                 const Angle& rot, const Length& hole) noexcept
 {
-    setCurrentAperture(mApertureList->setRect(w, h, rot, hole));
+    setCurrentAperture(mApertureList->setRect(w, h, rot + mRotation, hole));
     flashAtPosition(pos);
 }
 
 void GerberGenerator::flashObround(const Point& pos, const Length& w, const Length& h,
                                    const Angle& rot, const Length& hole) noexcept
 {
-    setCurrentAperture(mApertureList->setObround(w, h, rot, hole));
+    setCurrentAperture(mApertureList->setObround(w, h, rot + mRotation, hole));
     flashAtPosition(pos);
 }
 
 void GerberGenerator::flashRegularPolygon(const Point& pos, const Length& dia, int n,
                                           const Angle& rot, const Length& hole) noexcept
 {
-    setCurrentAperture(mApertureList->setRegularPolygon(dia, n, rot, hole));
+    setCurrentAperture(mApertureList->setRegularPolygon(dia, n, rot + mRotation, hole));
     flashAtPosition(pos);
 }
 
@@ -191,26 +242,73 @@ void GerberGenerator::flashRegularPolygon(const Point& pos, const Length& dia, i
 
 void GerberGenerator::reset() noexcept
 {
-    mOutput.clear();
-    mContent.clear();
+    mContent.resize(0); // keeps the reserved memory
+    mContentSpool.reset();
+    mContentSpoolError.clear();
     mApertureList->reset();
     mCurrentApertureNumber = -1;
+    mRotation = Angle::deg0();
+    mOffset = Point(0, 0);
 }
 
-void GerberGenerator::generate() throw (Exception)
+void GerberGenerator::generate(QIODevice& device) throw (Exception)
 {
-    mOutput.clear();
-    printHeader();
-    printApertureList();
-    printContent();
-    printFooter();
+    if (mContentSpool) flushContent();
+    if (!mContentSpoolError.isEmpty()) {
+        throw RuntimeError(__FILE__, __LINE__, mContentSpoolError,
+            QString(tr("Could not write the temporary Gerber data: %1"))
+            .arg(mContentSpoolError));
+    }
+
+    // according to the RS-274C standard, the checksum covers everything before the
+    // checksum itself, but without linebreaks
+    QCryptographicHash checksum(QCryptographicHash::Md5);
+    writeOutput(device, checksum, generateHeader());
+    writeOutput(device, checksum, mApertureList->generateString().toLatin1());
+    writeOutput(device, checksum, "G04 --- BOARD BEGIN --- *\n");
+    if (mContentSpool) {
+        // second pass: copy the spooled content chunk by chunk
+        if (!mContentSpool->seek(0)) {
+            throw RuntimeError(__FILE__, __LINE__, mContentSpool->errorString(),
+                QString(tr("Could not read the temporary Gerber data: %1"))
+                .arg(mContentSpool->errorString()));
+        }
+        while (!mContentSpool->atEnd()) {
+            writeOutput(device, checksum, mContentSpool->read(sContentBufferSize));
+        }
+    } else {
+        writeOutput(device, checksum, mContent);
+    }
+    writeOutput(device, checksum, "G04 --- BOARD END --- *\n");
+
+    // footer
+    QByteArray footer = "%TF.MD5," + checksum.result().toHex() + "*%\n";
+    footer.append("M02*\n"); // end of file
+    if (device.write(footer) != footer.size()) {
+        throw RuntimeError(__FILE__, __LINE__, device.errorString(),
+            QString(tr("Could not write the Gerber data: %1")).arg(device.errorString()));
+    }
 }
 
-void GerberGenerator::saveToFile(const FilePath& filepath) const throw (Exception)
+void GerberGenerator::saveToFile(const FilePath& filepath) throw (Exception)
 {
-    QScopedPointer<SmartTextFile> file(SmartTextFile::create(filepath));
-    file->setContent(mOutput.toLatin1());
-    file->save(true);
+    FilePath parentDir = filepath.getParentDir();
+    if (!parentDir.mkPath()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(),
+            QString(tr("Could not create directory \"%1\".")).arg(parentDir.toNative()));
+    }
+    QSaveFile file(filepath.toStr());
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__, QString("%1: %2 [%3]")
+            .arg(filepath.toStr(), file.errorString()).arg(file.error()),
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), file.errorString()));
+    }
+    generate(file); // QSaveFile is buffered, so the content is streamed in chunks
+    if (!file.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(), QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(filepath.toNative(), file.errorString()));
+    }
 }
 
 /*****************************************************************************************
@@ -220,25 +318,31 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const throw (Exceptio
 void GerberGenerator::setCurrentAperture(int number) noexcept
 {
     if (number != mCurrentApertureNumber) {
-        mContent.append(QString("D%1*\n").arg(number));
+        char buffer[32];
+        int size = 0;
+        buffer[size++] = 'D';
+        size += formatInteger(number, &buffer[size]);
+        buffer[size++] = '*';
+        buffer[size++] = '\n';
+        appendContent(QByteArray::fromRawData(buffer, size));
         mCurrentApertureNumber = number;
     }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept
 {
-    mContent.append("G36*\n");
+    appendContent("G36*\n");
 }
 
 void GerberGenerator::setRegionModeOff() noexcept
 {
-    mContent.append("G37*\n");
+    appendContent("G37*\n");
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept
 {
     if (!mMultiQuadrantArcModeOn) {
-        mContent.append("G75*\n");
+        appendContent("G75*\n");
         mMultiQuadrantArcModeOn = true;
     }
 }
@@ -246,111 +350,187 @@ void GerberGenerator::setMultiQuadrantArcModeOn() noexcept
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept
 {
     if (mMultiQuadrantArcModeOn) {
-        mContent.append("G74*\n");
+        appendContent("G74*\n");
         mMultiQuadrantArcModeOn = false;
     }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept
 {
-    mContent.append("G01*\n");
+    appendContent("G01*\n");
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept
 {
-    mContent.append("G02*\n");
+    appendContent("G02*\n");
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept
 {
-    mContent.append("G03*\n");
+    appendContent("G03*\n");
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D02*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendCoordinates(transform(pos), "D02");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D01*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendCoordinates(transform(pos), "D01");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept
 {
-    Point diff = center - start;
+    Point diff = transform(center) - transform(start);
     if (!mMultiQuadrantArcModeOn) {
         diff.makeAbs(); // no sign allowed in single quadrant mode!
     }
-    mContent.append(QString("X%1Y%2I%3J%4D01*\n").arg(end.getX().toNmString(),
-                                                      end.getY().toNmString(),
-                                                      diff.getX().toNmString(),
-                                                      diff.getY().toNmString()));
+    Point p = transform(end);
+    char buffer[128];
+    int size = 0;
+    buffer[size++] = 'X';
+    size += formatInteger(p.getX().toNm(), &buffer[size]);
+    buffer[size++] = 'Y';
+    size += formatInteger(p.getY().toNm(), &buffer[size]);
+    buffer[size++] = 'I';
+    size += formatInteger(diff.getX().toNm(), &buffer[size]);
+    buffer[size++] = 'J';
+    size += formatInteger(diff.getY().toNm(), &buffer[size]);
+    memcpy(&buffer[size], "D01*\n", 5);
+    size += 5;
+    appendContent(QByteArray::fromRawData(buffer, size));
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept
 {
-    mContent.append(QString("X%1Y%2D03*\n").arg(pos.getX().toNmString(),
-                                                pos.getY().toNmString()));
+    appendCoordinates(transform(pos), "D03");
 }
 
-void GerberGenerator::printHeader() noexcept
+void GerberGenerator::appendCoordinates(const Point& pos, const char* dcode) noexcept
 {
-    mOutput.append("G04 --- HEADER BEGIN --- *\n");
+    // "X<x>Y<y><dcode>*\n", the coordinates are integer nanometers (format 6.6)
+    char buffer[64];
+    int size = 0;
+    buffer[size++] = 'X';
+    size += formatInteger(pos.getX().toNm(), &buffer[size]);
+    buffer[size++] = 'Y';
+    size += formatInteger(pos.getY().toNm(), &buffer[size]);
+    for (const char* c = dcode; *c; ++c) {
+        buffer[size++] = *c;
+    }
+    buffer[size++] = '*';
+    buffer[size++] = '\n';
+    appendContent(QByteArray::fromRawData(buffer, size));
+}
+
+Point GerberGenerator::transform(const Point& pos) const noexcept
+{
+    if (mRotation == Angle::deg0()) {
+        return pos + mOffset;
+    } else {
+        return pos.rotated(mRotation) + mOffset;
+    }
+}
+
+void GerberGenerator::appendContent(const QByteArray& data) noexcept
+{
+    mContent.append(data);
+    if (mContent.size() >= sContentBufferSize) {
+        flushContent();
+    }
+}
+
+void GerberGenerator::flushContent() noexcept
+{
+    if (!mContentSpoolError.isEmpty()) {
+        mContent.resize(0); // generate() will fail anyway
+        return;
+    }
+    if (mContent.isEmpty()) return;
+    if (!mContentSpool) {
+        mContentSpool.reset(new QTemporaryFile());
+        if (!mContentSpool->open()) {
+            mContentSpoolError = mContentSpool->errorString();
+            mContent.resize(0); // generate() will fail anyway
+            return;
+        }
+    }
+    if ((!mContentSpool->seek(mContentSpool->size())) ||
+        (mContentSpool->write(mContent) != mContent.size()))
+    {
+        mContentSpoolError = mContentSpool->errorString();
+    }
+    mContent.resize(0); // keeps the reserved memory
+}
+
+QByteArray GerberGenerator::generateHeader() const noexcept
+{
+    QString header = "G04 --- HEADER BEGIN --- *\n";
 
     // add some X2 attributes
-    mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(qApp->applicationVersion()));
-    mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate)));
-    mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(mProjectId, mProjectGuid, mProjectRevision));
-    mOutput.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
-    //mOutput.append("%TF.FilePolarity,Positive*%\n");
+    header.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n").arg(qApp->applicationVersion()));
+    header.append(QString("%TF.CreationDate,%1*%\n").arg(QDateTime::currentDateTime().toString(Qt::ISODate)));
+    header.append(QString("%TF.ProjectId,%1,%2,%3*%\n").arg(mProjectId, mProjectGuid, mProjectRevision));
+    header.append("%TF.Part,Single*%\n"); // "Single" means "this is a PCB"
+    //header.append("%TF.FilePolarity,Positive*%\n");
 
     // coordinate format specification:
     //  - leading zeros omitted
     //  - absolute coordinates
     //  - coordiante format "6.6" --> allows us to directly use LengthBase_t (nanometers)!
-    mOutput.append("%FSLAX66Y66*%\n");
+    header.append("%FSLAX66Y66*%\n");
 
     // set unit to millimeters
-    mOutput.append("%MOMM*%\n");
+    header.append("%MOMM*%\n");
 
     // start linear interpolation mode
-    mOutput.append("G01*\n");
+    header.append("G01*\n");
 
     // use single quadrant arc mode
-    mOutput.append("G74*\n");
+    header.append("G74*\n");
 
-    mOutput.append("G04 --- HEADER END --- *\n");
+    header.append("G04 --- HEADER END --- *\n");
+    return header.toLatin1();
 }
 
-void GerberGenerator::printApertureList() noexcept
+void GerberGenerator::writeOutput(QIODevice& device, QCryptographicHash& checksum,
+                                  const QByteArray& data) const throw (Exception)
 {
-    mOutput.append(mApertureList->generateString());
-}
+    if (device.write(data) != data.size()) {
+        throw RuntimeError(__FILE__, __LINE__, device.errorString(),
+            QString(tr("Could not write the Gerber data: %1")).arg(device.errorString()));
+    }
 
-void GerberGenerator::printContent() noexcept
-{
-    mOutput.append("G04 --- BOARD BEGIN --- *\n");
-    mOutput.append(mContent);
-    mOutput.append("G04 --- BOARD END --- *\n");
+    // linebreaks are not included in the checksum
+    const char* begin = data.constData();
+    const char* end = begin + data.size();
+    while (begin < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(begin, '\n', end - begin));
+        if (!lineEnd) lineEnd = end;
+        checksum.addData(begin, lineEnd - begin);
+        begin = lineEnd + 1;
+    }
 }
 
-void GerberGenerator::printFooter() noexcept
-{
-    // MD5 checksum over content
-    mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
-
-    // end of file
-    mOutput.append("M02*\n");
-}
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept
-{
-    // according to the RS-274C standard, linebreaks are not included in the checksum
-    QString data = QString(mOutput).remove(QChar('\n'));
-    return QString(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+int GerberGenerator::formatInteger(qint64 value, char* buffer) noexcept
+{
+    // format the digits in reverse order, then copy them to the buffer
+    char digits[20];
+    int count = 0;
+    quint64 magnitude = (value < 0) ? (quint64(0) - quint64(value)) : quint64(value);
+    do {
+        digits[count++] = char('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+    int size = 0;
+    if (value < 0) buffer[size++] = '-';
+    while (count > 0) buffer[size++] = digits[--count];
+    return size;
 }
 
 /*****************************************************************************************
@@ -45,6 +45,14 @@ class GerberApertureList;
 /**
  * @brief The GerberGenerator class
  *
+ * The plotted objects are formatted directly into a byte buffer (coordinates are
+ * integer nanometers, see the "6.6" coordinate format). Since the header and the
+ * aperture list have to be written before the content, but are known only after all
+ * objects are plotted, the content is spooled to a temporary file as soon as the buffer
+ * is full. #generate() then writes the header and the aperture list, followed by the
+ * spooled content, to the output device and calculates the checksum on the fly. So the
+ * memory usage only depends on the number of apertures, not on the size of the file.
+ *
  * @todo Remove/Escape illegal characters in #mProjectId and #mProjectRevision!
  * @todo Use file/aperture attributes
  *
@@ -69,16 +77,35 @@ class GerberGenerator final
                         const QString& projRevision) noexcept;
         ~GerberGenerator() noexcept;
 
-        // Getters
-        const QString& toStr() const noexcept {return mOutput;}
-
         // Plot Methods
         void setLayerPolarity(LayerPolarity p) noexcept;
+
+        /**
+         * @brief Rotate and move all subsequently plotted objects
+         *
+         * The objects are rotated around the origin first, then moved by the offset.
+         * This allows to plot the same geometry at another place (e.g. in a panel)
+         * without transforming every object before.
+         */
+        void setTransformation(const Angle& rotation, const Point& offset) noexcept;
+
+        /**
+         * @brief Start a step and repeat block (%SR)
+         *
+         * All objects plotted until #endStepAndRepeat() are repeated in a grid of
+         * countX * countY copies, the first copy at the plotted position.
+         */
+        void beginStepAndRepeat(int countX, int countY, const Length& stepX,
+                                const Length& stepY) noexcept;
+        void endStepAndRepeat() noexcept;
+
         void drawLine(const Point& start, const Point& end, const Length& width) noexcept;
+        void drawPolyline(const QVector<Point>& points, const Length& width) noexcept;
         void drawEllipseOutline(const Ellipse& ellipse) noexcept;
         void drawEllipseArea(const Ellipse& ellipse) noexcept;
         void drawPolygonOutline(const Polygon& polygon) noexcept;
         void drawPolygonArea(const Polygon& polygon) noexcept;
+        void drawRegion(const QVector<Point>& points) noexcept;
         void flashCircle(const Point& pos, const Length& dia, const Length& hole) noexcept;
         void flashRect(const Point& pos, const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
         void flashObround(const Point& pos, const Length& w, const Length& h, const Angle& rot, const Length& hole) noexcept;
@@ -86,8 +113,16 @@ class GerberGenerator final
 
         // General Methods
         void reset() noexcept;
-        void generate() throw (Exception);
-        void saveToFile(const FilePath& filepath) const throw (Exception);
+
+        /**
+         * @brief Write the whole Gerber file to a device
+         *
+         * @param device    An open (preferably buffered) device to write to
+         *
+         * @throw Exception if the content could not be spooled or written
+         */
+        void generate(QIODevice& device) throw (Exception);
+        void saveToFile(const FilePath& filepath) throw (Exception);
 
         // Operator Overloadings
         GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
@@ -108,11 +143,22 @@ class GerberGenerator final
         void linearInterpolateToPosition(const Point& pos) noexcept;
         void circularInterpolateToPosition(const Point& start, const Point& center, const Point& end) noexcept;
         void flashAtPosition(const Point& pos) noexcept;
-        void printHeader() noexcept;
-        void printApertureList() noexcept;
-        void printContent() noexcept;
-        void printFooter() noexcept;
-        QString calcOutputMd5Checksum() const noexcept;
+        void appendCoordinates(const Point& pos, const char* dcode) noexcept;
+        Point transform(const Point& pos) const noexcept;
+        void appendContent(const QByteArray& data) noexcept;
+        void flushContent() noexcept;
+        QByteArray generateHeader() const noexcept;
+        void writeOutput(QIODevice& device, QCryptographicHash& checksum,
+                         const QByteArray& data) const throw (Exception);
+
+        // Static Methods
+
+        /**
+         * @brief Format an integer into a buffer (without null termination)
+         *
+         * @return The number of written characters (at most 20)
+         */
+        static int formatInteger(qint64 value, char* buffer) noexcept;
 
 
         // Metadata
@@ -121,11 +167,17 @@ class GerberGenerator final
         QString mProjectRevision;
 
         // Gerber Data
-        QString mOutput;
-        QString mContent;
+        QByteArray mContent;                        ///< the not yet spooled content
+        QScopedPointer<QTemporaryFile> mContentSpool; ///< created when needed
+        QString mContentSpoolError;                 ///< set if spooling failed
         QScopedPointer<GerberApertureList> mApertureList;
         int mCurrentApertureNumber;
         bool mMultiQuadrantArcModeOn;
+        Angle mRotation;        ///< see #setTransformation()
+        Point mOffset;          ///< see #setTransformation()
+
+        /// The size of the content buffer before it is spooled to the temporary file
+        static constexpr int sContentBufferSize = 1024 * 1024;
 };
 
 /*****************************************************************************************
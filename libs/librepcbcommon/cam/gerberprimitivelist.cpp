@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <tuple>
+#include "gerberprimitivelist.h"
+#include "gerbergenerator.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GerberPrimitiveList::GerberPrimitiveList() noexcept
+{
+}
+
+GerberPrimitiveList::~GerberPrimitiveList() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void GerberPrimitiveList::append(const Primitive_t& primitive) noexcept
+{
+    mPrimitives.append(primitive);
+}
+
+void GerberPrimitiveList::sortByAperture() noexcept
+{
+    // primitives with the same key use the same aperture (at least for the most part,
+    // e.g. filled outlines need a second aperture for the area)
+    auto getKey = [](const Primitive_t& p) {
+        switch (p.type)
+        {
+            case Primitive_t::Type_t::Polyline:
+            case Primitive_t::Type_t::FlashCircle:
+                return std::make_tuple(0, p.width.toNm(), LengthBase_t(0), qint32(0));
+            case Primitive_t::Type_t::PolygonOutline:
+                return std::make_tuple(0, p.polygon->getLineWidth().toNm(), LengthBase_t(0),
+                                       qint32(0));
+            case Primitive_t::Type_t::EllipseOutline:
+                return std::make_tuple(0, p.ellipse->getLineWidth().toNm(), LengthBase_t(0),
+                                       qint32(0));
+            default:
+                return std::make_tuple(static_cast<int>(p.type), p.width.toNm(),
+                                       p.height.toNm() + p.vertices,
+                                       p.rotation.toMicroDeg());
+        }
+    };
+
+    // the regions are always at the beginning and must stay there
+    auto first = std::find_if(mPrimitives.begin(), mPrimitives.end(),
+        [](const Primitive_t& p) {return p.type != Primitive_t::Type_t::Region;});
+    std::stable_sort(first, mPrimitives.end(),
+        [&getKey](const Primitive_t& a, const Primitive_t& b) {return getKey(a) < getKey(b);});
+}
+
+void GerberPrimitiveList::draw(GerberGenerator& gen) const noexcept
+{
+    for (int i = 0; i < mPrimitives.count(); ++i) {
+        drawPrimitive(gen, mPrimitives.at(i));
+        bool isLastRegion = (mPrimitives.at(i).type == Primitive_t::Type_t::Region) &&
+            ((i + 1 == mPrimitives.count()) ||
+             (mPrimitives.at(i + 1).type != Primitive_t::Type_t::Region));
+        if (isLastRegion) {
+            // the holes of copper zones are cleared with negative polarity
+            gen.setLayerPolarity(GerberGenerator::LayerPolarity::Positive);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void GerberPrimitiveList::drawPrimitive(GerberGenerator& gen, const Primitive_t& primitive) noexcept
+{
+    switch (primitive.type)
+    {
+        case Primitive_t::Type_t::Region: {
+            gen.setLayerPolarity(primitive.negative ? GerberGenerator::LayerPolarity::Negative
+                                                    : GerberGenerator::LayerPolarity::Positive);
+            gen.drawRegion(primitive.points);
+            break;
+        }
+        case Primitive_t::Type_t::Polyline: {
+            gen.drawPolyline(primitive.points, primitive.width);
+            break;
+        }
+        case Primitive_t::Type_t::PolygonOutline: {
+            gen.drawPolygonOutline(*primitive.polygon);
+            if (primitive.filled) gen.drawPolygonArea(*primitive.polygon);
+            break;
+        }
+        case Primitive_t::Type_t::EllipseOutline: {
+            gen.drawEllipseOutline(*primitive.ellipse);
+            if (primitive.filled) gen.drawEllipseArea(*primitive.ellipse);
+            break;
+        }
+        case Primitive_t::Type_t::FlashCircle: {
+            gen.flashCircle(primitive.position, primitive.width, Length(0));
+            break;
+        }
+        case Primitive_t::Type_t::FlashRect: {
+            gen.flashRect(primitive.position, primitive.width, primitive.height,
+                          primitive.rotation, Length(0));
+            break;
+        }
+        case Primitive_t::Type_t::FlashObround: {
+            gen.flashObround(primitive.position, primitive.width, primitive.height,
+                             primitive.rotation, Length(0));
+            break;
+        }
+        case Primitive_t::Type_t::FlashRegularPolygon: {
+            gen.flashRegularPolygon(primitive.position, primitive.width, primitive.vertices,
+                                    primitive.rotation, Length(0));
+            break;
+        }
+        default: {
+            Q_ASSERT(false);
+            break;
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
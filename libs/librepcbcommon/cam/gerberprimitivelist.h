@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_GERBERPRIMITIVELIST_H
+#define LIBREPCB_GERBERPRIMITIVELIST_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+#include "../geometry/polygon.h"
+#include "../geometry/ellipse.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class GerberGenerator;
+
+/*****************************************************************************************
+ *  Class GerberPrimitiveList
+ ****************************************************************************************/
+
+/**
+ * @brief The GerberPrimitiveList class holds the objects to plot on one Gerber layer
+ *
+ * The regions (e.g. copper zones, whose holes are cleared with negative polarity) must
+ * be appended before all other primitives. All primitives after the regions are drawn
+ * with positive polarity, so their order does not affect the image and they can be
+ * sorted to minimize the aperture changes (see #sortByAperture()).
+ */
+class GerberPrimitiveList final
+{
+    public:
+
+        // Types
+
+        /// A scene-space object to plot
+        struct Primitive_t {
+            enum class Type_t {Region, Polyline, PolygonOutline, EllipseOutline, FlashCircle,
+                               FlashRect, FlashObround, FlashRegularPolygon};
+            Type_t type;
+            bool negative = false;  ///< Region only: clear instead of dark polarity
+            bool filled = false;    ///< PolygonOutline/EllipseOutline: draw the area too
+            Point position;         ///< flashes only: center
+            Length width;           ///< flashes: width/diameter, Polyline: line width
+            Length height;          ///< FlashRect and FlashObround only
+            Angle rotation;         ///< flashes only
+            int vertices = 0;       ///< FlashRegularPolygon only
+            QVector<Point> points;  ///< Region and Polyline only
+            QSharedPointer<const Polygon> polygon;  ///< PolygonOutline only
+            QSharedPointer<const Ellipse> ellipse;  ///< EllipseOutline only
+        };
+
+        // Constructors / Destructor
+        GerberPrimitiveList() noexcept;
+        ~GerberPrimitiveList() noexcept;
+
+        // Getters
+        const QVector<Primitive_t>& getPrimitives() const noexcept {return mPrimitives;}
+
+        // General Methods
+        void append(const Primitive_t& primitive) noexcept;
+
+        /**
+         * @brief Sort the primitives to minimize the aperture changes
+         *
+         * Only the (dark) primitives after the regions are sorted since their order does
+         * not affect the image. The sort is stable, so the output is still deterministic.
+         */
+        void sortByAperture() noexcept;
+
+        /**
+         * @brief Draw all primitives
+         *
+         * The polarity is set by the regions and reset to positive after the last region.
+         */
+        void draw(GerberGenerator& gen) const noexcept;
+
+
+    private:
+
+        // Private Methods
+        static void drawPrimitive(GerberGenerator& gen, const Primitive_t& primitive) noexcept;
+
+
+        // Attributes
+        QVector<Primitive_t> mPrimitives;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GERBERPRIMITIVELIST_H
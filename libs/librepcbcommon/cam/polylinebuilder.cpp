@@ -0,0 +1,90 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "polylinebuilder.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QVector<QVector<Point>> PolylineBuilder::build(const QVector<QPair<Point, Point>>& segments) noexcept
+{
+    // find all segments at every end point
+    auto key = [](const Point& p) {return qMakePair(p.getX().toNm(), p.getY().toNm());};
+    QHash<QPair<qint64, qint64>, QVector<int>> segmentsAt;
+    for (int i = 0; i < segments.count(); ++i) {
+        segmentsAt[key(segments.at(i).first)].append(i);
+        segmentsAt[key(segments.at(i).second)].append(i);
+    }
+    auto degree = [&](const Point& p) {return segmentsAt.value(key(p)).count();};
+
+    // follow the segments until an open end, a junction or an already used segment
+    QVector<bool> used(segments.count(), false);
+    auto trace = [&](int segment, const Point& start) {
+        QVector<Point> polyline = {start};
+        Point current = start;
+        while (segment >= 0) {
+            used[segment] = true;
+            const QPair<Point, Point>& s = segments.at(segment);
+            current = (s.first == current) ? s.second : s.first;
+            polyline.append(current);
+            segment = -1;
+            const QVector<int>& candidates = segmentsAt[key(current)];
+            if (candidates.count() == 2) {
+                foreach (int candidate, candidates) {
+                    if (!used.at(candidate)) segment = candidate;
+                }
+            }
+        }
+        return polyline;
+    };
+
+    // open polylines start at open ends and junctions...
+    QVector<QVector<Point>> polylines;
+    for (int i = 0; i < segments.count(); ++i) {
+        if (used.at(i)) continue;
+        if (degree(segments.at(i).first) != 2) {
+            polylines.append(trace(i, segments.at(i).first));
+        } else if (degree(segments.at(i).second) != 2) {
+            polylines.append(trace(i, segments.at(i).second));
+        }
+    }
+
+    // ...and all remaining segments belong to closed loops
+    for (int i = 0; i < segments.count(); ++i) {
+        if (!used.at(i)) polylines.append(trace(i, segments.at(i).first));
+    }
+    return polylines;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
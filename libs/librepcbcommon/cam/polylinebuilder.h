@@ -0,0 +1,83 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_POLYLINEBUILDER_H
+#define LIBREPCB_POLYLINEBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class PolylineBuilder
+ ****************************************************************************************/
+
+/**
+ * @brief The PolylineBuilder class merges connected line segments into polylines
+ *
+ * Segments are connected if they have an end point at exactly the same position. Every
+ * polyline runs through points where exactly two segments meet, and ends at open ends
+ * and junctions (points with more than two segments). Closed loops without any junction
+ * become a single polyline whose first and last point are equal.
+ *
+ * Every segment is contained in exactly one polyline, so drawing the polylines with a
+ * round aperture gives exactly the same image as drawing all segments separately, but
+ * needs only one move per polyline instead of one per segment.
+ *
+ * The result is deterministic (it only depends on the order of the segments).
+ */
+class PolylineBuilder final
+{
+    public:
+
+        // Constructors / Destructor
+        PolylineBuilder() = delete;
+        PolylineBuilder(const PolylineBuilder& other) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Merge line segments into polylines
+         *
+         * @param segments      The start and end points of all segments
+         *
+         * @return The points of all polylines (each with at least two points)
+         */
+        static QVector<QVector<Point>> build(const QVector<QPair<Point, Point>>& segments) noexcept;
+
+        // Operator Overloadings
+        PolylineBuilder& operator=(const PolylineBuilder& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_POLYLINEBUILDER_H
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CONCURRENTJOBS_H
+#define LIBREPCB_CONCURRENTJOBS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ConcurrentJobs
+ ****************************************************************************************/
+
+/**
+ * @brief The ConcurrentJobs class runs independent jobs in parallel and waits for them
+ *
+ * The jobs are executed by a thread pool with one thread per CPU core (QtConcurrent is
+ * not used to avoid the additional dependency). A single job is executed directly in the
+ * calling thread since starting a thread would only add overhead.
+ *
+ * @warning The jobs must not access any QObject or graphics item which lives in another
+ *          thread, and must not share any data which is modified during the execution.
+ */
+class ConcurrentJobs final
+{
+    public:
+
+        // Constructors / Destructor
+        ConcurrentJobs() noexcept {}
+        ConcurrentJobs(const ConcurrentJobs& other) = delete;
+        ~ConcurrentJobs() noexcept {}
+
+        // Getters
+        int count() const noexcept {return mJobs.count();}
+
+        // General Methods
+        void add(const std::function<void()>& job) noexcept {mJobs.append(job);}
+
+        /**
+         * @brief Run all jobs and block until all of them are finished
+         */
+        void run() noexcept
+        {
+            if (mJobs.count() == 1) {
+                mJobs.first()();
+            } else if (mJobs.count() > 1) {
+                QThreadPool pool;
+                foreach (const std::function<void()>& job, mJobs) {
+                    pool.start(new Runnable(job)); // the pool takes the ownership
+                }
+                pool.waitForDone();
+            }
+            mJobs.clear();
+        }
+
+        /**
+         * @brief Run all jobs and call a function periodically until they are finished
+         *
+         * The function is called in the calling thread (e.g. to update a progress dialog
+         * and to process events), so even a single job is executed by the thread pool.
+         *
+         * @param waitCallback  Called every @p intervalMs milliseconds while waiting
+         * @param intervalMs    The interval of the callback [ms]
+         */
+        void run(const std::function<void()>& waitCallback, int intervalMs = 50) noexcept
+        {
+            if (!mJobs.isEmpty()) {
+                QThreadPool pool;
+                foreach (const std::function<void()>& job, mJobs) {
+                    pool.start(new Runnable(job)); // the pool takes the ownership
+                }
+                while (!pool.waitForDone(intervalMs)) {
+                    waitCallback();
+                }
+            }
+            mJobs.clear();
+        }
+
+        // Operator Overloadings
+        ConcurrentJobs& operator=(const ConcurrentJobs& rhs) = delete;
+
+
+    private:
+
+        class Runnable final : public QRunnable
+        {
+            public:
+                explicit Runnable(const std::function<void()>& function) noexcept :
+                    QRunnable(), mFunction(function) {}
+                void run() override {mFunction();}
+            private:
+                std::function<void()> mFunction;
+        };
+
+        QList<std::function<void()>> mJobs;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CONCURRENTJOBS_H
@@ -96,6 +96,11 @@ void BoardDesignRulesDialog::updateWidgets() noexcept
     mUi->spbxRestringViasRatio->setValue(mDesignRules.getRestringViaRatio()*100);
     mUi->spbxRestringViasMin->setValue(mDesignRules.getRestringViaMin().toMm());
     mUi->spbxRestringViasMax->setValue(mDesignRules.getRestringViaMax().toMm());
+    // copper
+    mUi->spbxCopperClearance->setValue(mDesignRules.getCopperClearance().toMm());
+    mUi->spbxCopperMinWidth->setValue(mDesignRules.getCopperMinWidth().toMm());
+    mUi->spbxDrillMinDiameter->setValue(mDesignRules.getDrillMinDiameter().toMm());
+    mUi->spbxThermalSpokeWidth->setValue(mDesignRules.getThermalSpokeWidth().toMm());
 }
 
 void BoardDesignRulesDialog::applyRules() noexcept
@@ -119,6 +124,11 @@ void BoardDesignRulesDialog::applyRules() noexcept
     mDesignRules.setRestringViaRatio(mUi->spbxRestringViasRatio->value()/100);
     mDesignRules.setRestringViaMin(Length::fromMm(mUi->spbxRestringViasMin->value()));
     mDesignRules.setRestringViaMax(Length::fromMm(mUi->spbxRestringViasMax->value()));
+    // copper
+    mDesignRules.setCopperClearance(Length::fromMm(mUi->spbxCopperClearance->value()));
+    mDesignRules.setCopperMinWidth(Length::fromMm(mUi->spbxCopperMinWidth->value()));
+    mDesignRules.setDrillMinDiameter(Length::fromMm(mUi->spbxDrillMinDiameter->value()));
+    mDesignRules.setThermalSpokeWidth(Length::fromMm(mUi->spbxThermalSpokeWidth->value()));
 }
 
 /*****************************************************************************************
@@ -0,0 +1,190 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_DISJOINTSET_H
+#define LIBREPCB_DISJOINTSET_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class DisjointSet
+ ****************************************************************************************/
+
+/**
+ * @brief The DisjointSet class implements a union-find data structure
+ *
+ * Items are added as single-element sets which then can be merged with #unite(). Thanks
+ * to path compression and union by rank, all operations run in nearly constant time.
+ *
+ * The sets returned by #getSets() (and the items within them) are sorted by the order in
+ * which the items were added, so the result is deterministic.
+ *
+ * @note The item type @p T must be usable as a QHash key (e.g. a pointer).
+ */
+template <typename T>
+class DisjointSet final
+{
+    public:
+
+        // Constructors / Destructor
+        DisjointSet() noexcept : mSetCount(0) {}
+        DisjointSet(const DisjointSet& other) = default;
+        ~DisjointSet() noexcept {}
+
+        // Getters
+        int count() const noexcept {return mItems.count();}
+        int getSetCount() const noexcept {return mSetCount;}
+        bool contains(T item) const noexcept {return mIndices.contains(item);}
+
+        // General Methods
+
+        /**
+         * @brief Add an item as a new set (does nothing if the item already exists)
+         */
+        void add(T item) noexcept
+        {
+            if (mIndices.contains(item)) return;
+            mIndices.insert(item, mItems.count());
+            mItems.append(item);
+            mParents.append(mParents.count());
+            mRanks.append(0);
+            ++mSetCount;
+        }
+
+        /**
+         * @brief Merge the sets of two items
+         *
+         * Items which were not added yet are added automatically.
+         *
+         * @return True if the items were in different sets, false otherwise
+         */
+        bool unite(T a, T b) noexcept
+        {
+            add(a);
+            add(b);
+            int rootA = findRoot(mIndices.value(a));
+            int rootB = findRoot(mIndices.value(b));
+            if (rootA == rootB) return false;
+            if (mRanks.at(rootA) < mRanks.at(rootB)) {
+                qSwap(rootA, rootB);
+            }
+            mParents[rootB] = rootA;
+            if (mRanks.at(rootA) == mRanks.at(rootB)) {
+                ++mRanks[rootA];
+            }
+            --mSetCount;
+            return true;
+        }
+
+        /**
+         * @brief Check whether two items are in the same set
+         *
+         * @return False if at least one of the items was not added
+         */
+        bool isConnected(T a, T b) const noexcept
+        {
+            if ((!mIndices.contains(a)) || (!mIndices.contains(b))) return false;
+            return findRoot(mIndices.value(a)) == findRoot(mIndices.value(b));
+        }
+
+        /**
+         * @brief Get the representative item of the set which contains an item
+         *
+         * @warning The item must have been added before!
+         */
+        T find(T item) const noexcept
+        {
+            Q_ASSERT(mIndices.contains(item));
+            return mItems.at(findRoot(mIndices.value(item)));
+        }
+
+        /**
+         * @brief Get all sets, sorted by the insertion order of their first item
+         */
+        QList<QList<T>> getSets() const noexcept
+        {
+            QList<QList<T>> sets;
+            QHash<int, int> rootToSet;
+            for (int i = 0; i < mItems.count(); ++i) {
+                int root = findRoot(i);
+                auto it = rootToSet.find(root);
+                if (it == rootToSet.end()) {
+                    it = rootToSet.insert(root, sets.count());
+                    sets.append(QList<T>());
+                }
+                sets[it.value()].append(mItems.at(i));
+            }
+            return sets;
+        }
+
+        void clear() noexcept
+        {
+            mIndices.clear();
+            mItems.clear();
+            mParents.clear();
+            mRanks.clear();
+            mSetCount = 0;
+        }
+
+        // Operator Overloadings
+        DisjointSet& operator=(const DisjointSet& rhs) = default;
+
+
+    private:
+
+        // Private Methods
+        int findRoot(int index) const noexcept
+        {
+            int root = index;
+            while (mParents.at(root) != root) {
+                root = mParents.at(root);
+            }
+            // path compression (doesn't change the observable state, thus it's const)
+            while (mParents.at(index) != root) {
+                int next = mParents.at(index);
+                mParents[index] = root;
+                index = next;
+            }
+            return root;
+        }
+
+
+        // Attributes
+        QHash<T, int> mIndices;         ///< the index of every item in #mItems
+        QVector<T> mItems;              ///< all items in the order they were added
+        mutable QVector<int> mParents;  ///< the parent index of every item
+        QVector<int> mRanks;            ///< upper bound of the tree height of every root
+        int mSetCount;                  ///< the number of disjoint sets
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_DISJOINTSET_H
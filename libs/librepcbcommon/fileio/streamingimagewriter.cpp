@@ -0,0 +1,534 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "streamingimagewriter.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+StreamingImageWriter::StreamingImageWriter(const FilePath& filepath, Format_t format,
+                                           const QSize& size, bool alpha, int dpi,
+                                           int tileSize) throw (Exception) :
+    mFilePath(filepath), mFormat(format), mSize(size), mAlpha(alpha), mDpi(dpi),
+    mTileSize(tileSize), mTileColumns(0), mTileRows(0), mFile(filepath.toStr()),
+    mWrittenRows(0), mWrittenTiles(0), mBitBuffer(0), mBitCount(0), mPreviousByte(-1), mAdler32A(1), mAdler32B(0)
+{
+    if ((size.width() < 1) || (size.height() < 1) || (dpi < 1) ||
+        (size.width() > (INT_MAX - 1) / getBytesPerPixel()))
+    {
+        throw LogicError(__FILE__, __LINE__, QString("%1x%2 @ %3 DPI")
+            .arg(size.width()).arg(size.height()).arg(dpi),
+            tr("Invalid image size or resolution."));
+    }
+    if ((tileSize < 0) || (tileSize > 65536) || (tileSize % 16 != 0) ||
+        ((tileSize > 0) && (format != Format_t::Tiff)))
+    {
+        throw LogicError(__FILE__, __LINE__, QString::number(tileSize),
+            tr("Invalid tile size."));
+    }
+    if (tileSize > 0) {
+        // every tile needs at least 32 bytes, so more tiles would exceed 4 GiB anyway
+        qint64 columns = (qint64(size.width()) + tileSize - 1) / tileSize;
+        qint64 rows = (qint64(size.height()) + tileSize - 1) / tileSize;
+        if (columns * rows > qint64(0xFFFFFFFF) / 32) {
+            throw RuntimeError(__FILE__, __LINE__, QString("%1x%2").arg(columns).arg(rows),
+                tr("The image is too large for a TIFF file (max. 4 GiB)."));
+        }
+        mTileColumns = int(columns);
+        mTileRows = int(rows);
+    }
+    FilePath parentDir = filepath.getParentDir();
+    if (!parentDir.mkPath()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(),
+            QString(tr("Could not create directory \"%1\".")).arg(parentDir.toNative()));
+    }
+    if (!mFile.open(QIODevice::WriteOnly)) {
+        throw RuntimeError(__FILE__, __LINE__, QString("%1: %2 [%3]")
+            .arg(filepath.toStr(), mFile.errorString()).arg(mFile.error()),
+            QString(tr("Could not open or create file \"%1\": %2"))
+            .arg(filepath.toNative(), mFile.errorString()));
+    }
+
+    switch (mFormat)
+    {
+        case Format_t::Png:     writePngHeader(); break;
+        case Format_t::Tiff:    writeTiffHeader(); break;
+        default: Q_ASSERT(false); break;
+    }
+}
+
+StreamingImageWriter::~StreamingImageWriter() noexcept
+{
+    // if finish() was not called, QSaveFile discards the file
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void StreamingImageWriter::writeRow(const uchar* pixels) throw (Exception)
+{
+    if (mTileSize > 0) {
+        throw LogicError(__FILE__, __LINE__, QString(),
+            tr("The image must be written tile by tile."));
+    }
+    if (mWrittenRows >= mSize.height()) {
+        throw LogicError(__FILE__, __LINE__, QString::number(mWrittenRows),
+            tr("All rows of the image were already written."));
+    }
+    switch (mFormat)
+    {
+        case Format_t::Png:     writePngRow(pixels); break;
+        case Format_t::Tiff:    writeTiffRow(pixels); break;
+        default: Q_ASSERT(false); break;
+    }
+    ++mWrittenRows;
+}
+
+void StreamingImageWriter::writeTile(int column, int row, const uchar* pixels,
+                                     int bytesPerLine) throw (Exception)
+{
+    if ((column < 0) || (column >= mTileColumns) || (row < 0) || (row >= mTileRows) ||
+        (mStripByteCounts.at(row * mTileColumns + column) > 0))
+    {
+        throw LogicError(__FILE__, __LINE__, QString("%1/%2").arg(column).arg(row),
+            tr("Invalid tile or tile already written."));
+    }
+
+    // the tiles at the right and bottom edges are padded (every row of a tile is
+    // compressed separately, like the rows of strips)
+    int bpp = getBytesPerPixel();
+    int width = qMin(mTileSize, mSize.width() - column * mTileSize);
+    int height = qMin(mTileSize, mSize.height() - row * mTileSize);
+    QByteArray line(mTileSize * bpp, '\0');
+    QByteArray tile;
+    for (int y = 0; y < mTileSize; ++y) {
+        if (y < height) {
+            memcpy(line.data(), pixels + (y * bytesPerLine), width * bpp);
+        } else if (y == height) {
+            line.fill('\0');
+        }
+        tile.append(compressPackBits(reinterpret_cast<const uchar*>(line.constData()),
+                                     line.size()));
+    }
+    qint64 offset = mFile.pos();
+    if (offset + tile.size() > qint64(0xFFFFFFFF)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(),
+            tr("The image is too large for a TIFF file (max. 4 GiB)."));
+    }
+    mStripOffsets[row * mTileColumns + column] = quint32(offset);
+    mStripByteCounts[row * mTileColumns + column] = quint32(tile.size());
+    write(tile);
+    ++mWrittenTiles;
+}
+
+void StreamingImageWriter::finish() throw (Exception)
+{
+    if ((mTileSize > 0) && (mWrittenTiles != mStripByteCounts.count())) {
+        throw LogicError(__FILE__, __LINE__, QString("%1/%2")
+            .arg(mWrittenTiles).arg(mStripByteCounts.count()),
+            tr("Not all tiles of the image were written."));
+    } else if ((mTileSize == 0) && (mWrittenRows != mSize.height())) {
+        throw LogicError(__FILE__, __LINE__, QString("%1/%2")
+            .arg(mWrittenRows).arg(mSize.height()),
+            tr("Not all rows of the image were written."));
+    }
+    switch (mFormat)
+    {
+        case Format_t::Png:     finishPng(); break;
+        case Format_t::Tiff:    finishTiff(); break;
+        default: Q_ASSERT(false); break;
+    }
+    if (!mFile.commit()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(), QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(mFilePath.toNative(), mFile.errorString()));
+    }
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+StreamingImageWriter::Format_t StreamingImageWriter::getFormatFromFilePath(
+        const FilePath& filepath) throw (Exception)
+{
+    QString suffix = filepath.getSuffix().toLower();
+    if (suffix == "png") {
+        return Format_t::Png;
+    } else if ((suffix == "tif") || (suffix == "tiff")) {
+        return Format_t::Tiff;
+    } else {
+        throw RuntimeError(__FILE__, __LINE__, suffix,
+            QString(tr("Unsupported image format: \"%1\" (only PNG and TIFF are "
+                       "supported)")).arg(filepath.getFilename()));
+    }
+}
+
+QByteArray StreamingImageWriter::compressPackBits(const uchar* data, int size) noexcept
+{
+    QByteArray result;
+    result.reserve(size + (size / 128) + 1);
+    int i = 0;
+    while (i < size) {
+        // a run of at least 3 equal bytes is stored as (1 - count) and the byte
+        int run = 1;
+        while ((i + run < size) && (run < 128) && (data[i + run] == data[i])) ++run;
+        if (run >= 3) {
+            result.append(static_cast<char>(1 - run));
+            result.append(static_cast<char>(data[i]));
+            i += run;
+            continue;
+        }
+
+        // otherwise copy all bytes up to the next run, stored as (count - 1) and the bytes
+        int count = 0;
+        while ((i + count < size) && (count < 128)) {
+            if ((i + count + 2 < size) && (data[i + count] == data[i + count + 1]) &&
+                (data[i + count] == data[i + count + 2]))
+            {
+                break;
+            }
+            ++count;
+        }
+        result.append(static_cast<char>(count - 1));
+        result.append(reinterpret_cast<const char*>(&data[i]), count);
+        i += count;
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  Private Methods: PNG
+ ****************************************************************************************/
+
+void StreamingImageWriter::writePngHeader() throw (Exception)
+{
+    write(QByteArray("\x89PNG\r\n\x1a\n", 8));
+
+    QByteArray header;
+    QDataStream headerStream(&header, QIODevice::WriteOnly); // big endian
+    headerStream << quint32(mSize.width()) << quint32(mSize.height());
+    headerStream << quint8(8);                  // bit depth
+    headerStream << quint8(mAlpha ? 6 : 2);     // color type: RGBA or RGB
+    headerStream << quint8(0) << quint8(0) << quint8(0); // deflate, filter 0, no interlace
+    writePngChunk("IHDR", header);
+
+    QByteArray phys;
+    QDataStream physStream(&phys, QIODevice::WriteOnly);
+    quint32 pixelsPerMeter = qRound(mDpi / 0.0254);
+    physStream << pixelsPerMeter << pixelsPerMeter << quint8(1); // unit: meter
+    writePngChunk("pHYs", phys);
+
+    // zlib header (deflate, 32K window, no dictionary) and the first (non-final) block
+    // with fixed Huffman codes, which is used for all rows
+    mDeflated.append("\x78\x01", 2);
+    putBits(0, 1); // BFINAL
+    putBits(1, 2); // BTYPE: fixed Huffman codes
+    mRowBuffer.resize(1 + mSize.width() * getBytesPerPixel());
+}
+
+void StreamingImageWriter::writePngRow(const uchar* pixels) throw (Exception)
+{
+    // "Sub" filter: the difference to the pixel on the left, so areas with the same color
+    // consist of zeros which are compressed by the run-length matches
+    int bpp = getBytesPerPixel();
+    int size = mSize.width() * bpp;
+    uchar* row = reinterpret_cast<uchar*>(mRowBuffer.data());
+    row[0] = 1;
+    for (int i = 0; i < size; ++i) {
+        row[i + 1] = (i < bpp) ? pixels[i] : uchar(pixels[i] - pixels[i - bpp]);
+    }
+
+    // Adler-32 checksum of the uncompressed data (5552 bytes can be summed up without
+    // overflow before the modulo is needed)
+    const uchar* data = row;
+    int remaining = mRowBuffer.size();
+    while (remaining > 0) {
+        int count = qMin(remaining, 5552);
+        remaining -= count;
+        while (count-- > 0) {
+            mAdler32A += *data++;
+            mAdler32B += mAdler32A;
+        }
+        mAdler32A %= 65521;
+        mAdler32B %= 65521;
+    }
+
+    deflateRle(row, mRowBuffer.size());
+    if (mDeflated.size() >= 256 * 1024) {
+        writePngChunk("IDAT", mDeflated);
+        mDeflated.clear();
+    }
+}
+
+void StreamingImageWriter::finishPng() throw (Exception)
+{
+    putHuffmanCode(0, 7); // end of block
+    putBits(1, 1); // BFINAL: an empty final block
+    putBits(1, 2);
+    putHuffmanCode(0, 7);
+    if (mBitCount > 0) putBits(0, 8 - mBitCount);
+    QDataStream stream(&mDeflated, QIODevice::Append);
+    stream << quint32((mAdler32B << 16) | mAdler32A);
+    writePngChunk("IDAT", mDeflated);
+    mDeflated.clear();
+    writePngChunk("IEND", QByteArray());
+}
+
+void StreamingImageWriter::writePngChunk(const char* type, const QByteArray& data) throw (Exception)
+{
+    QByteArray chunk;
+    QDataStream stream(&chunk, QIODevice::WriteOnly);
+    stream << quint32(data.size());
+    stream.writeRawData(type, 4);
+    stream.writeRawData(data.constData(), data.size());
+    stream << calcCrc32(0, chunk.constData() + 4, chunk.size() - 4); // type and data
+    write(chunk);
+}
+
+void StreamingImageWriter::deflateRle(const uchar* data, int size) noexcept
+{
+    // only matches with distance 1 are used, i.e. runs of the previous byte
+    int i = 0;
+    while (i < size) {
+        if (data[i] == mPreviousByte) {
+            int run = 1;
+            while ((i + run < size) && (run < 258) && (data[i + run] == data[i])) ++run;
+            if (run >= 3) {
+                putRunLength(run);
+                i += run;
+                continue;
+            }
+        }
+        putLiteral(data[i]);
+        mPreviousByte = data[i];
+        ++i;
+    }
+}
+
+void StreamingImageWriter::putBits(quint32 value, int count) noexcept
+{
+    // deflate packs the bits starting at the least significant bit of every byte
+    mBitBuffer |= quint64(value) << mBitCount;
+    mBitCount += count;
+    while (mBitCount >= 8) {
+        mDeflated.append(static_cast<char>(mBitBuffer & 0xFF));
+        mBitBuffer >>= 8;
+        mBitCount -= 8;
+    }
+}
+
+void StreamingImageWriter::putHuffmanCode(quint32 code, int length) noexcept
+{
+    // Huffman codes are packed starting at the most significant bit
+    quint32 reversed = 0;
+    for (int i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    putBits(reversed, length);
+}
+
+void StreamingImageWriter::putLiteral(uchar value) noexcept
+{
+    if (value < 144) {
+        putHuffmanCode(0x30 + value, 8);
+    } else {
+        putHuffmanCode(0x190 + (value - 144), 9);
+    }
+}
+
+void StreamingImageWriter::putRunLength(int length) noexcept
+{
+    Q_ASSERT((length >= 3) && (length <= 258));
+    static const int bases[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const int extraBits[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    int index = 28;
+    while (bases[index] > length) --index;
+    int symbol = 257 + index;
+    if (symbol < 280) {
+        putHuffmanCode(symbol - 256, 7);
+    } else {
+        putHuffmanCode(0xC0 + (symbol - 280), 8);
+    }
+    putBits(length - bases[index], extraBits[index]);
+    putHuffmanCode(0, 5); // distance code 0: distance 1
+}
+
+/*****************************************************************************************
+ *  Private Methods: TIFF
+ ****************************************************************************************/
+
+void StreamingImageWriter::writeTiffHeader() throw (Exception)
+{
+    // the offset of the image file directory is written by finishTiff()
+    write(QByteArray("II\x2a\x00\x00\x00\x00\x00", 8));
+    if (mTileSize > 0) {
+        mStripOffsets.fill(0, mTileColumns * mTileRows);
+        mStripByteCounts.fill(0, mTileColumns * mTileRows);
+    } else {
+        mStripOffsets.reserve(mSize.height());
+        mStripByteCounts.reserve(mSize.height());
+    }
+}
+
+void StreamingImageWriter::writeTiffRow(const uchar* pixels) throw (Exception)
+{
+    QByteArray strip = compressPackBits(pixels, mSize.width() * getBytesPerPixel());
+    qint64 offset = mFile.pos();
+    if (offset + strip.size() > qint64(0xFFFFFFFF)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(),
+            tr("The image is too large for a TIFF file (max. 4 GiB)."));
+    }
+    mStripOffsets.append(quint32(offset));
+    mStripByteCounts.append(quint32(strip.size()));
+    write(strip);
+}
+
+void StreamingImageWriter::finishTiff() throw (Exception)
+{
+    if (mFile.pos() % 2) write(QByteArray(1, '\0')); // offsets must be word aligned
+
+    // values which do not fit into the 4 bytes of a directory entry are written before
+    // the directory
+    quint32 base = quint32(mFile.pos());
+    int samplesPerPixel = getBytesPerPixel();
+    QByteArray values;
+    QDataStream valuesStream(&values, QIODevice::WriteOnly);
+    valuesStream.setByteOrder(QDataStream::LittleEndian);
+    quint32 bitsPerSampleOffset = base + values.size();
+    for (int i = 0; i < samplesPerPixel; ++i) valuesStream << quint16(8);
+    quint32 resolutionOffset = base + values.size();
+    valuesStream << quint32(mDpi) << quint32(1);
+    quint32 stripOffsetsOffset = mStripOffsets.first();
+    quint32 stripByteCountsOffset = mStripByteCounts.first();
+    if (mStripOffsets.count() > 1) {
+        stripOffsetsOffset = base + values.size();
+        foreach (quint32 offset, mStripOffsets) valuesStream << offset;
+        stripByteCountsOffset = base + values.size();
+        foreach (quint32 count, mStripByteCounts) valuesStream << count;
+    }
+    quint32 directoryOffset = base + values.size();
+    if (qint64(directoryOffset) + 256 > qint64(0xFFFFFFFF)) {
+        throw RuntimeError(__FILE__, __LINE__, QString(),
+            tr("The image is too large for a TIFF file (max. 4 GiB)."));
+    }
+
+    // the image file directory (the entries must be sorted by tag)
+    enum Type_t {Short = 3, Long = 4, Rational = 5};
+    QByteArray directory;
+    QDataStream stream(&directory, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    auto addEntry = [&stream](quint16 tag, Type_t type, quint32 count, quint32 value) {
+        // a single SHORT value is stored left-justified, which is the same as a
+        // little endian LONG
+        stream << tag << quint16(type) << count << value;
+    };
+    quint32 count = mStripOffsets.count();
+    quint16 entryCount = ((mTileSize > 0) ? 14 : 13) + (mAlpha ? 1 : 0);
+    stream << entryCount;
+    addEntry(256, Long, 1, mSize.width());                      // ImageWidth
+    addEntry(257, Long, 1, mSize.height());                     // ImageLength
+    addEntry(258, Short, samplesPerPixel, bitsPerSampleOffset); // BitsPerSample
+    addEntry(259, Short, 1, 32773);                             // Compression: PackBits
+    addEntry(262, Short, 1, 2);                                 // PhotometricInterpretation: RGB
+    if (mTileSize == 0) {
+        addEntry(273, Long, count, stripOffsetsOffset);         // StripOffsets
+    }
+    addEntry(277, Short, 1, samplesPerPixel);                   // SamplesPerPixel
+    if (mTileSize == 0) {
+        addEntry(278, Long, 1, 1);                              // RowsPerStrip
+        addEntry(279, Long, count, stripByteCountsOffset);      // StripByteCounts
+    }
+    addEntry(282, Rational, 1, resolutionOffset);               // XResolution
+    addEntry(283, Rational, 1, resolutionOffset);               // YResolution
+    addEntry(284, Short, 1, 1);                                 // PlanarConfiguration: chunky
+    addEntry(296, Short, 1, 2);                                 // ResolutionUnit: inch
+    if (mTileSize > 0) {
+        addEntry(322, Long, 1, mTileSize);                      // TileWidth
+        addEntry(323, Long, 1, mTileSize);                      // TileLength
+        addEntry(324, Long, count, stripOffsetsOffset);         // TileOffsets
+        addEntry(325, Long, count, stripByteCountsOffset);      // TileByteCounts
+    }
+    if (mAlpha) {
+        addEntry(338, Short, 1, 2);                             // ExtraSamples: unassoc. alpha
+    }
+    stream << quint32(0); // no further directories
+
+    write(values);
+    write(directory);
+    QByteArray offset;
+    QDataStream offsetStream(&offset, QIODevice::WriteOnly);
+    offsetStream.setByteOrder(QDataStream::LittleEndian);
+    offsetStream << directoryOffset;
+    if ((!mFile.seek(4)) || (mFile.write(offset) != offset.size())) {
+        throw RuntimeError(__FILE__, __LINE__, QString(), QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(mFilePath.toNative(), mFile.errorString()));
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods: Common
+ ****************************************************************************************/
+
+void StreamingImageWriter::write(const QByteArray& data) throw (Exception)
+{
+    if (mFile.write(data) != data.size()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(), QString(tr("Could not write to "
+            "file \"%1\": %2")).arg(mFilePath.toNative(), mFile.errorString()));
+    }
+}
+
+quint32 StreamingImageWriter::calcCrc32(quint32 crc, const char* data, int size) noexcept
+{
+    static const QVector<quint32> table = [](){
+        QVector<quint32> t(256);
+        for (quint32 n = 0; n < 256; ++n) {
+            quint32 c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (int i = 0; i < size; ++i) {
+        crc = table.at((crc ^ static_cast<uchar>(data[i])) & 0xFF) ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
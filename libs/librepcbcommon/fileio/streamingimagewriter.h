@@ -0,0 +1,195 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_STREAMINGIMAGEWRITER_H
+#define LIBREPCB_STREAMINGIMAGEWRITER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "filepath.h"
+#include "../exceptions.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class StreamingImageWriter
+ ****************************************************************************************/
+
+/**
+ * @brief The StreamingImageWriter class writes PNG or TIFF images row by row or tile by
+ *        tile
+ *
+ * QImageWriter needs the whole image in memory, which is not possible for very large
+ * images (e.g. a board rendered at 2400 DPI). This class encodes every row (or tile) as
+ * soon as it is written, so only the current row (or tile) needs to be in memory.
+ *
+ * The pixels are written as 8 bit RGB or RGBA (not premultiplied). The encoders are kept
+ * simple to avoid any dependency on zlib or libtiff, but still compress the large areas
+ * with the same color of rendered boards and schematics quite well:
+ *  - PNG: "Sub" filter and a deflate stream with run-length matches only (like the
+ *    Z_RLE strategy of zlib) and the fixed Huffman codes.
+ *  - TIFF: One strip per row, or square tiles if a tile size is given (so that even
+ *    very wide images never need whole rows in memory), compressed with PackBits. The
+ *    file size is limited to 4 GiB (no BigTIFF).
+ *
+ * The file is written with QSaveFile, so it is replaced only by #finish().
+ */
+class StreamingImageWriter final
+{
+        Q_DECLARE_TR_FUNCTIONS(StreamingImageWriter)
+
+    public:
+
+        // Types
+        enum class Format_t {Png, Tiff};
+
+        // Constructors / Destructor
+        StreamingImageWriter() = delete;
+        StreamingImageWriter(const StreamingImageWriter& other) = delete;
+
+        /**
+         * @brief Create the output file and write the image header
+         *
+         * @param filepath  The file to write (the parent directory is created if needed)
+         * @param format    The file format
+         * @param size      The size of the image in pixels
+         * @param alpha     Whether the rows contain an alpha channel (RGBA) or not (RGB)
+         * @param dpi       The resolution which is stored in the file
+         * @param tileSize  TIFF only: the width and height of the tiles (a multiple of 16,
+         *                  max. 65536) which are written with #writeTile(), or 0 to write
+         *                  the image row by row with #writeRow()
+         *
+         * @throw Exception if the file could not be created
+         */
+        StreamingImageWriter(const FilePath& filepath, Format_t format, const QSize& size,
+                             bool alpha, int dpi, int tileSize = 0) throw (Exception);
+        ~StreamingImageWriter() noexcept;
+
+        // Getters
+        int getBytesPerPixel() const noexcept {return mAlpha ? 4 : 3;}
+        int getWrittenRows() const noexcept {return mWrittenRows;}
+        int getTileSize() const noexcept {return mTileSize;}
+
+        // General Methods
+
+        /**
+         * @brief Append the next row of the image
+         *
+         * @param pixels    The pixels of the row (width * #getBytesPerPixel() bytes)
+         *
+         * @throw Exception if all rows were already written or on write errors
+         */
+        void writeRow(const uchar* pixels) throw (Exception);
+
+        /**
+         * @brief Write a tile of the image (only if a tile size is set)
+         *
+         * The tiles can be written in any order. The tiles at the right and bottom edges
+         * contain only the pixels within the image, they are padded automatically.
+         *
+         * @param column        The column of the tile (0 = left)
+         * @param row           The row of the tile (0 = top)
+         * @param pixels        The pixels of the tile (within the image)
+         * @param bytesPerLine  The distance between the rows of @p pixels
+         *
+         * @throw Exception if the tile is invalid or was already written, or on write
+         *        errors
+         */
+        void writeTile(int column, int row, const uchar* pixels, int bytesPerLine) throw (Exception);
+
+        /**
+         * @brief Finish the file after all rows were written
+         *
+         * @throw Exception if not all rows (or tiles) were written or on write errors
+         */
+        void finish() throw (Exception);
+
+        // Operator Overloadings
+        StreamingImageWriter& operator=(const StreamingImageWriter& rhs) = delete;
+
+        // Static Methods
+
+        /// Get the format from the file suffix ("png", "tif" or "tiff")
+        static Format_t getFormatFromFilePath(const FilePath& filepath) throw (Exception);
+
+        /// Encode data with PackBits (the run-length encoding used for TIFF)
+        static QByteArray compressPackBits(const uchar* data, int size) noexcept;
+
+
+    private:
+
+        // Private Methods
+        void writePngHeader() throw (Exception);
+        void writePngRow(const uchar* pixels) throw (Exception);
+        void finishPng() throw (Exception);
+        void writePngChunk(const char* type, const QByteArray& data) throw (Exception);
+        void deflateRle(const uchar* data, int size) noexcept;
+        void putBits(quint32 value, int count) noexcept;
+        void putHuffmanCode(quint32 code, int length) noexcept;
+        void putLiteral(uchar value) noexcept;
+        void putRunLength(int length) noexcept;
+        void writeTiffHeader() throw (Exception);
+        void writeTiffRow(const uchar* pixels) throw (Exception);
+        void finishTiff() throw (Exception);
+        void write(const QByteArray& data) throw (Exception);
+
+        // Static Methods
+        static quint32 calcCrc32(quint32 crc, const char* data, int size) noexcept;
+
+
+        // General Attributes
+        FilePath mFilePath;
+        Format_t mFormat;
+        QSize mSize;
+        bool mAlpha;
+        int mDpi;
+        int mTileSize;                      ///< 0 if the image is written row by row
+        int mTileColumns;
+        int mTileRows;
+        QSaveFile mFile;
+        int mWrittenRows;
+        int mWrittenTiles;
+        QByteArray mRowBuffer;              ///< the filtered row (PNG only)
+
+        // PNG deflate stream
+        QByteArray mDeflated;               ///< compressed data not yet written to IDAT
+        quint64 mBitBuffer;
+        int mBitCount;
+        int mPreviousByte;                  ///< -1 at the beginning of the stream
+        quint32 mAdler32A;
+        quint32 mAdler32B;
+
+        // TIFF strips (or tiles, sorted by row and column)
+        QVector<quint32> mStripOffsets;
+        QVector<quint32> mStripByteCounts;  ///< 0 for tiles which are not written yet
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_STREAMINGIMAGEWRITER_H
@@ -0,0 +1,127 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_BOUNDINGBOX_H
+#define LIBREPCB_BOUNDINGBOX_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class BoundingBox
+ ****************************************************************************************/
+
+/**
+ * @brief The BoundingBox class represents an axis-aligned rectangle in nanometers
+ *
+ * In contrast to QRectF, all coordinates are integers (#Length), so comparisons are
+ * exact and no conversion from/to pixels is needed. The borders belong to the box, so
+ * a box with zero width and height still contains exactly one point.
+ *
+ * A default constructed bounding box is invalid (empty) and neither contains nor
+ * intersects anything. Uniting it with another box results in the other box.
+ */
+class BoundingBox final
+{
+    public:
+
+        // Constructors / Destructor
+        BoundingBox() noexcept : mMin(), mMax(), mIsValid(false) {}
+        BoundingBox(const BoundingBox& other) noexcept :
+            mMin(other.mMin), mMax(other.mMax), mIsValid(other.mIsValid) {}
+        BoundingBox(const Point& p1, const Point& p2) noexcept :
+            mMin(qMin(p1.getX(), p2.getX()), qMin(p1.getY(), p2.getY())),
+            mMax(qMax(p1.getX(), p2.getX()), qMax(p1.getY(), p2.getY())), mIsValid(true) {}
+        ~BoundingBox() noexcept {}
+
+        // Getters
+        bool isValid() const noexcept {return mIsValid;}
+        const Point& getMin() const noexcept {return mMin;}
+        const Point& getMax() const noexcept {return mMax;}
+        Length getWidth() const noexcept {return mMax.getX() - mMin.getX();}
+        Length getHeight() const noexcept {return mMax.getY() - mMin.getY();}
+        Point getCenter() const noexcept {return (mMin + mMax) / 2;}
+
+        // General Methods
+        bool contains(const Point& p) const noexcept {
+            return mIsValid && (p.getX() >= mMin.getX()) && (p.getX() <= mMax.getX())
+                            && (p.getY() >= mMin.getY()) && (p.getY() <= mMax.getY());
+        }
+        bool contains(const BoundingBox& other) const noexcept {
+            return mIsValid && other.mIsValid && contains(other.mMin) && contains(other.mMax);
+        }
+        bool intersects(const BoundingBox& other) const noexcept {
+            return mIsValid && other.mIsValid
+                && (other.mMin.getX() <= mMax.getX()) && (other.mMax.getX() >= mMin.getX())
+                && (other.mMin.getY() <= mMax.getY()) && (other.mMax.getY() >= mMin.getY());
+        }
+        BoundingBox united(const BoundingBox& other) const noexcept {
+            if (!mIsValid) return other;
+            if (!other.mIsValid) return *this;
+            return BoundingBox(Point(qMin(mMin.getX(), other.mMin.getX()), qMin(mMin.getY(), other.mMin.getY())),
+                               Point(qMax(mMax.getX(), other.mMax.getX()), qMax(mMax.getY(), other.mMax.getY())));
+        }
+        BoundingBox united(const Point& p) const noexcept {return united(BoundingBox(p, p));}
+        BoundingBox expanded(const Length& margin) const noexcept {
+            if (!mIsValid) return *this;
+            return BoundingBox(mMin - Point(margin, margin), mMax + Point(margin, margin));
+        }
+        QRectF toPxQRectF() const noexcept {
+            return QRectF(mMin.toPxQPointF(), mMax.toPxQPointF()).normalized();
+        }
+
+        // Static Methods
+        static BoundingBox fromPx(const QRectF& rect) throw (RangeError) {
+            if (rect.isNull()) return BoundingBox();
+            return BoundingBox(Point::fromPx(rect.topLeft()), Point::fromPx(rect.bottomRight()));
+        }
+
+        // Operator Overloadings
+        BoundingBox& operator=(const BoundingBox& rhs) noexcept {
+            mMin = rhs.mMin; mMax = rhs.mMax; mIsValid = rhs.mIsValid; return *this;
+        }
+        bool operator==(const BoundingBox& rhs) const noexcept {
+            if (mIsValid != rhs.mIsValid) return false;
+            return (!mIsValid) || ((mMin == rhs.mMin) && (mMax == rhs.mMax));
+        }
+        bool operator!=(const BoundingBox& rhs) const noexcept {return !(*this == rhs);}
+
+
+    private:
+
+        Point mMin;     ///< the corner with the smallest coordinates
+        Point mMax;     ///< the corner with the largest coordinates
+        bool mIsValid;  ///< false if the box is empty
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_BOUNDINGBOX_H
@@ -0,0 +1,210 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "convexshape.h"
+#include "hittest.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+BoundingBox ConvexShape::getBoundingBox() const noexcept
+{
+    BoundingBox box;
+    foreach (const Point& vertex, mVertices) {
+        box = box.united(vertex);
+    }
+    return box.expanded(mRadius);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+bool ConvexShape::contains(const Point& p) const noexcept
+{
+    return isValid() && (getCoreDistanceTo(ConvexShape({p}, Length(0))) <= mRadius);
+}
+
+Length ConvexShape::getDistanceTo(const ConvexShape& other) const noexcept
+{
+    Q_ASSERT(isValid() && other.isValid());
+    Length distance = getCoreDistanceTo(other) - mRadius - other.mRadius;
+    return (distance > 0) ? distance : Length(0);
+}
+
+QVector<Point> ConvexShape::getOutline(const Length& maxError) const noexcept
+{
+    int count = mVertices.count();
+    if ((mRadius <= 0) || (count == 0)) return mVertices;
+
+    // the chords touch the exact arc if the vertices lie on a slightly bigger radius
+    qreal r = mRadius.toNm();
+    qreal maxStep = 2 * qAcos(r / (r + qMax(maxError.toNm(), qint64(1))));
+    QVector<Point> outline;
+    auto appendArc = [&](const Point& center, qreal startAngle, qreal sweep) {
+        int segments = qMax(1, qCeil(sweep / maxStep));
+        qreal step = sweep / segments;
+        qreal radius = r / qCos(step / 2);
+        for (int i = 0; i <= segments; ++i) {
+            qreal angle = startAngle + i * step;
+            outline.append(center + Point(qRound64(radius * qCos(angle)),
+                                          qRound64(radius * qSin(angle))));
+        }
+    };
+
+    if (count == 1) {
+        appendArc(mVertices.first(), 0, 2 * M_PI);
+        outline.removeLast(); // same as the first vertex
+        return outline;
+    }
+    // a line segment is handled like a polygon with two (antiparallel) edges
+    for (int i = 0; i < count; ++i) {
+        const Point& prev = mVertices.at((i + count - 1) % count);
+        const Point& vertex = mVertices.at(i);
+        const Point& next = mVertices.at((i + 1) % count);
+        // the outward normals of the edges (for counterclockwise polygons)
+        qreal angleIn = qAtan2(-(vertex.getX() - prev.getX()).toNm(),
+                               (vertex.getY() - prev.getY()).toNm());
+        qreal angleOut = qAtan2(-(next.getX() - vertex.getX()).toNm(),
+                                (next.getY() - vertex.getY()).toNm());
+        qreal sweep = angleOut - angleIn;
+        while (sweep < 0) sweep += 2 * M_PI;
+        appendArc(vertex, angleIn, sweep);
+    }
+    return outline;
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+ConvexShape ConvexShape::circle(const Point& center, const Length& diameter) noexcept
+{
+    return ConvexShape({center}, diameter / 2);
+}
+
+ConvexShape ConvexShape::capsule(const Point& p1, const Point& p2, const Length& width) noexcept
+{
+    return ConvexShape({p1, p2}, width / 2);
+}
+
+ConvexShape ConvexShape::rect(const Point& center, const Length& width,
+                              const Length& height, const Angle& rotation) noexcept
+{
+    Length rx = width / 2, ry = height / 2;
+    return ConvexShape(transformed({Point(-rx, -ry), Point(rx, -ry), Point(rx, ry),
+                                    Point(-rx, ry)}, center, rotation), Length(0));
+}
+
+ConvexShape ConvexShape::obround(const Point& center, const Length& width,
+                                 const Length& height, const Angle& rotation) noexcept
+{
+    if (width >= height) {
+        Point end((width - height) / 2, Length(0));
+        return ConvexShape(transformed({-end, end}, center, rotation), height / 2);
+    } else {
+        Point end(Length(0), (height - width) / 2);
+        return ConvexShape(transformed({-end, end}, center, rotation), width / 2);
+    }
+}
+
+ConvexShape ConvexShape::octagon(const Point& center, const Length& width,
+                                 const Length& height, const Angle& rotation) noexcept
+{
+    // same chamfer as used by HitTest::isPointInOctagon()
+    Length rx = width / 2, ry = height / 2;
+    Length a = qMin(rx, ry).scaled(2 - qSqrt(2));
+    return ConvexShape(transformed({Point(rx, a - ry), Point(rx, ry - a),
+                                    Point(rx - a, ry), Point(a - rx, ry),
+                                    Point(-rx, ry - a), Point(-rx, a - ry),
+                                    Point(a - rx, -ry), Point(rx - a, -ry)},
+                                   center, rotation), Length(0));
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+Length ConvexShape::getCoreDistanceTo(const ConvexShape& other) const noexcept
+{
+    // a shape lying completely within the other one doesn't intersect any edge
+    if (isInCorePolygon(other.mVertices.first())) return Length(0);
+    if (other.isInCorePolygon(mVertices.first())) return Length(0);
+
+    // otherwise the shortest distance is between two edges (zero if they intersect)
+    Length distance(-1);
+    int count = mVertices.count(), otherCount = other.mVertices.count();
+    int edges = (count > 2) ? count : 1, otherEdges = (otherCount > 2) ? otherCount : 1;
+    for (int i = 0; i < edges; ++i) {
+        const Point& p1 = mVertices.at(i);
+        const Point& p2 = mVertices.at((i + 1) % count);
+        for (int k = 0; k < otherEdges; ++k) {
+            const Point& q1 = other.mVertices.at(k);
+            const Point& q2 = other.mVertices.at((k + 1) % otherCount);
+            Length d = HitTest::getDistanceBetweenSegments(p1, p2, q1, q2);
+            if ((distance < 0) || (d < distance)) distance = d;
+            if (distance == 0) return distance;
+        }
+    }
+    return distance;
+}
+
+bool ConvexShape::isInCorePolygon(const Point& p) const noexcept
+{
+    if (mVertices.count() < 3) return false;
+    bool positive = false, negative = false;
+    for (int i = 0; i < mVertices.count(); ++i) {
+        const Point& a = mVertices.at(i);
+        const Point& b = mVertices.at((i + 1) % mVertices.count());
+        // exact as long as all coordinates are within +/- 1 meter (no 64bit overflow)
+        qint64 cross = (b.getX().toNm() - a.getX().toNm()) * (p.getY().toNm() - a.getY().toNm())
+                     - (b.getY().toNm() - a.getY().toNm()) * (p.getX().toNm() - a.getX().toNm());
+        if (cross > 0) positive = true;
+        if (cross < 0) negative = true;
+        if (positive && negative) return false;
+    }
+    return true;
+}
+
+QVector<Point> ConvexShape::transformed(const QVector<Point>& vertices, const Point& center,
+                                        const Angle& rotation) noexcept
+{
+    QVector<Point> result;
+    result.reserve(vertices.count());
+    foreach (const Point& vertex, vertices) {
+        result.append(vertex.rotated(rotation) + center);
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
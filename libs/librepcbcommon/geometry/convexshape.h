@@ -0,0 +1,144 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CONVEXSHAPE_H
+#define LIBREPCB_CONVEXSHAPE_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+#include "boundingbox.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class ConvexShape
+ ****************************************************************************************/
+
+/**
+ * @brief The ConvexShape class represents a convex polygon inflated by a radius
+ *
+ * This is the Minkowski sum of a convex polygon (the "core", which may also be a single
+ * point or a line segment) and a circle. All copper primitives of a board can be
+ * represented this way without any approximation of round edges:
+ *  - circle: a point with radius
+ *  - trace/obround: a line segment with radius
+ *  - rectangle/octagon: a polygon without radius
+ *
+ * The distance between two such shapes is simply the distance between their cores minus
+ * both radii, which makes clearance checks cheap and exact (apart from rounding to
+ * nanometers).
+ */
+class ConvexShape final
+{
+    public:
+
+        // Constructors / Destructor
+        ConvexShape() noexcept : mVertices(), mRadius(0) {}
+        ConvexShape(const ConvexShape& other) noexcept :
+            mVertices(other.mVertices), mRadius(other.mRadius) {}
+        ConvexShape(const QVector<Point>& vertices, const Length& radius) noexcept :
+            mVertices(vertices), mRadius(radius) {}
+        ~ConvexShape() noexcept {}
+
+        // Getters
+        bool isValid() const noexcept {return !mVertices.isEmpty();}
+        const QVector<Point>& getVertices() const noexcept {return mVertices;}
+        const Length& getRadius() const noexcept {return mRadius;}
+        BoundingBox getBoundingBox() const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Check whether a point lies within the shape (borders included)
+         */
+        bool contains(const Point& p) const noexcept;
+
+        /**
+         * @brief Calculate the shortest distance to another shape
+         *
+         * @return The distance (rounded to nanometers), zero if the shapes overlap
+         */
+        Length getDistanceTo(const ConvexShape& other) const noexcept;
+
+        /**
+         * @brief Get a copy of the shape with a bigger radius (e.g. to add a clearance)
+         */
+        ConvexShape expanded(const Length& margin) const noexcept {
+            return ConvexShape(mVertices, mRadius + margin);
+        }
+
+        /**
+         * @brief Approximate the outline of the shape by a polygon
+         *
+         * The round edges are replaced by straight segments which touch the exact
+         * outline, so the polygon always covers the whole shape and is at most maxError
+         * bigger than the shape.
+         *
+         * @param maxError  The max. distance between the polygon and the exact outline
+         *
+         * @return The vertices of the polygon in counterclockwise order
+         */
+        QVector<Point> getOutline(const Length& maxError) const noexcept;
+
+        // Static Methods
+        static ConvexShape circle(const Point& center, const Length& diameter) noexcept;
+        static ConvexShape capsule(const Point& p1, const Point& p2, const Length& width) noexcept;
+        static ConvexShape rect(const Point& center, const Length& width,
+                                const Length& height, const Angle& rotation) noexcept;
+        static ConvexShape obround(const Point& center, const Length& width,
+                                   const Length& height, const Angle& rotation) noexcept;
+        static ConvexShape octagon(const Point& center, const Length& width,
+                                   const Length& height, const Angle& rotation) noexcept;
+
+        // Operator Overloadings
+        ConvexShape& operator=(const ConvexShape& rhs) noexcept {
+            mVertices = rhs.mVertices; mRadius = rhs.mRadius; return *this;
+        }
+
+
+    private:
+
+        /// Distance between the cores (without radii), zero if they overlap
+        Length getCoreDistanceTo(const ConvexShape& other) const noexcept;
+
+        /// Check whether a point lies within the core polygon (needs at least 3 vertices)
+        bool isInCorePolygon(const Point& p) const noexcept;
+
+        /// Rotate the vertices around the center and move them to the center
+        static QVector<Point> transformed(const QVector<Point>& vertices, const Point& center,
+                                          const Angle& rotation) noexcept;
+
+
+        QVector<Point> mVertices;   ///< the convex core polygon (1 or more vertices)
+        Length mRadius;             ///< the radius added around the core polygon
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_CONVEXSHAPE_H
@@ -71,6 +71,31 @@ Ellipse::~Ellipse() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+const QVector<Point>& Ellipse::getVertices(const Length& maxError) const noexcept
+{
+    if (mVertices.isEmpty() || (maxError != mVerticesMaxError)) {
+        // the parametric chords deviate at most like those of a circle with the larger
+        // radius, and a multiple of four chords keeps the outline symmetric
+        Length radius = qMax(mRadiusX, mRadiusY);
+        int count = 4 * PolygonSegment::calcChordCount(radius, Angle::deg90(), maxError);
+        mVertices.clear();
+        mVertices.reserve(count + 1);
+        for (int i = 0; i < count; ++i) {
+            qreal t = (2 * M_PI * i) / count;
+            Point p(Length(qRound64(mRadiusX.toNm() * qCos(t))),
+                    Length(qRound64(mRadiusY.toNm() * qSin(t))));
+            mVertices.append(p.rotated(mRotation) + mCenter);
+        }
+        mVertices.append(mVertices.first());
+        mVerticesMaxError = maxError;
+    }
+    return mVertices;
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -100,23 +125,27 @@ void Ellipse::setIsGrabArea(bool isGrabArea) noexcept
 void Ellipse::setCenter(const Point& center) noexcept
 {
     mCenter = center;
+    invalidateCaches();
 }
 
 void Ellipse::setRadiusX(const Length& radius) noexcept
 {
     Q_ASSERT(radius > 0);
     mRadiusX = radius;
+    invalidateCaches();
 }
 
 void Ellipse::setRadiusY(const Length& radius) noexcept
 {
     Q_ASSERT(radius > 0);
     mRadiusY = radius;
+    invalidateCaches();
 }
 
 void Ellipse::setRotation(const Angle& rotation) noexcept
 {
     mRotation = rotation;
+    invalidateCaches();
 }
 
 /*****************************************************************************************
@@ -126,6 +155,7 @@ void Ellipse::setRotation(const Angle& rotation) noexcept
 Ellipse& Ellipse::translate(const Point& offset) noexcept
 {
     mCenter += offset;
+    invalidateCaches();
     return *this;
 }
 
@@ -138,6 +168,7 @@ Ellipse& Ellipse::rotate(const Angle& angle, const Point& center) noexcept
 {
     mCenter.rotate(angle, center);
     mRotation += angle;
+    invalidateCaches();
     return *this;
 }
 
@@ -171,6 +202,11 @@ XmlDomElement* Ellipse::serializeToXmlDomElement() const throw (Exception)
  *  Private Methods
  ****************************************************************************************/
 
+void Ellipse::invalidateCaches() noexcept
+{
+    mVertices.clear();
+}
+
 bool Ellipse::checkAttributesValidity() const noexcept
 {
     if (mLayerId <= 0)          return false;
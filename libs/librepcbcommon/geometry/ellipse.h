@@ -26,6 +26,7 @@
 #include <QtCore>
 #include "../units/all_length_units.h"
 #include "../fileio/if_xmlserializableobject.h"
+#include "polygon.h"
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -63,6 +64,17 @@ class Ellipse final : public IF_XmlSerializableObject
         const Length& getRadiusY() const noexcept {return mRadiusY;}
         const Angle& getRotation() const noexcept {return mRotation;}
 
+        /**
+         * @brief Get the outline of the ellipse approximated by straight chords
+         *
+         * The outline is closed (the last vertex equals the first one) and is cached
+         * for the last used maxError, like Polygon#getVertices().
+         *
+         * @param maxError  The maximum distance between the ellipse and the chords
+         */
+        const QVector<Point>& getVertices(const Length& maxError =
+            Length(PolygonSegment::sDefaultMaxArcErrorNm)) const noexcept;
+
         // Setters
         void setLayerId(int id) noexcept;
         void setLineWidth(const Length& width) noexcept;
@@ -92,6 +104,7 @@ class Ellipse final : public IF_XmlSerializableObject
         Ellipse& operator=(const Ellipse& rhs) = delete;
 
         // Private Methods
+        void invalidateCaches() noexcept;
 
         /// @copydoc #IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
@@ -106,6 +119,10 @@ class Ellipse final : public IF_XmlSerializableObject
         Length mRadiusX;
         Length mRadiusY;
         Angle mRotation;
+
+        // Cached Attributes
+        mutable QVector<Point> mVertices;
+        mutable Length mVerticesMaxError;   ///< the tolerance of mVertices
 };
 
 /*****************************************************************************************
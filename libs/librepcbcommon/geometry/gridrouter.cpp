@@ -0,0 +1,529 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <queue>
+#include "gridrouter.h"
+#include "../concurrentjobs.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Local Helpers
+ ****************************************************************************************/
+
+namespace {
+
+/// The max. number of cells of all layers (limits the memory usage of huge boards)
+const qint64 sMaxCellCount = 2000000;
+
+/// The min. number of cells around a connection which may be used for detours
+const int sMinDetourCells = 10;
+
+struct OpenEntry_t {
+    float estimate;     ///< costs + heuristic
+    int state;          ///< (layer * rows + y) * cols + x, relative to the region
+
+    bool operator<(const OpenEntry_t& rhs) const noexcept {
+        // std::priority_queue pops the biggest entry first
+        if (estimate != rhs.estimate) return estimate > rhs.estimate;
+        return state > rhs.state;
+    }
+};
+
+} // namespace
+
+/*****************************************************************************************
+ *  Struct Region_t
+ ****************************************************************************************/
+
+/// A rectangular part of the grid with connections which are routed together
+struct GridRouter::Region_t {
+    int x0;
+    int y0;
+    int x1;             ///< inclusive
+    int y1;             ///< inclusive
+    QVector<int> connections;
+
+    bool overlaps(const Region_t& other) const noexcept {
+        return (x0 <= other.x1) && (other.x0 <= x1) && (y0 <= other.y1) && (other.y0 <= y1);
+    }
+};
+
+/*****************************************************************************************
+ *  Static Attributes
+ ****************************************************************************************/
+
+constexpr qint32 GridRouter::sFree;
+constexpr qint32 GridRouter::sBlocked;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+GridRouter::GridRouter(const BoundingBox& area, int layerCount, const Length& traceWidth,
+                       const Length& viaSize, const Length& clearance) noexcept :
+    mOrigin(area.isValid() ? area.getMin() : Point()), mCols(1), mRows(1),
+    mLayers(qBound(1, layerCount, 32)), mCellSize(qMax(traceWidth + clearance, Length(1))),
+    mTraceMargin(traceWidth / 2 + clearance), mViaMargin(viaSize / 2 + clearance),
+    mViaCost(10), mMaxIterations(20)
+{
+    if (area.isValid()) {
+        // bigger cells only increase the distance between traces, so this is safe
+        qint64 width = area.getWidth().toNm(), height = area.getHeight().toNm();
+        while (((width / mCellSize.toNm() + 1) * (height / mCellSize.toNm() + 1) * mLayers)
+               > sMaxCellCount) {
+            mCellSize = mCellSize * 2;
+        }
+        mCols = int(width / mCellSize.toNm()) + 1;
+        mRows = int(height / mCellSize.toNm()) + 1;
+    }
+    mTraceObstacles.fill(sFree, mCols * mRows * mLayers);
+    mViaObstacles.fill(sFree, mCols * mRows);
+
+    // a via conflicts with traces of other nets in all cells whose traces (up to the
+    // middle of the neighbour cells) are closer than this radius
+    qreal radius = (viaSize / 2 + clearance + traceWidth / 2).toNm() / qreal(mCellSize.toNm());
+    int range = qCeil(radius + 0.5);
+    for (int dy = -range; dy <= range; ++dy) {
+        for (int dx = -range; dx <= range; ++dx) {
+            qreal ax = qMax(qAbs(dx) - 0.5, 0.0), ay = qMax(qAbs(dy) - 0.5, 0.0);
+            qreal distance = qMin(qSqrt(ax * ax + dy * dy), qSqrt(dx * dx + ay * ay));
+            if (distance < radius) mViaFootprint.append(Cell_t{dx, dy});
+        }
+    }
+}
+
+GridRouter::~GridRouter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void GridRouter::addObstacle(int layer, const ConvexShape& shape, int net) noexcept
+{
+    if ((!shape.isValid()) || (layer >= mLayers)) return;
+
+    // traces are checked up to the middle of the neighbour cells because the distance
+    // between a convex shape and a straight trace is smallest between the cell centers
+    ConvexShape viaShape = shape.expanded(mViaMargin);
+    Length halfCell = mCellSize / 2;
+    BoundingBox box = shape.expanded(qMax(mTraceMargin + halfCell, mViaMargin)).getBoundingBox();
+    Cell_t min = getCell(box.getMin()), max = getCell(box.getMax());
+    for (int y = min.y; y <= max.y; ++y) {
+        for (int x = min.x; x <= max.x; ++x) {
+            Point center = getCellCenter(x, y);
+            if (viaShape.contains(center)) {
+                markObstacle(mViaObstacles, y * mCols + x, net);
+            }
+            ConvexShape horizontal = ConvexShape::capsule(center - Point(halfCell, Length(0)),
+                                                          center + Point(halfCell, Length(0)),
+                                                          Length(0));
+            ConvexShape vertical = ConvexShape::capsule(center - Point(Length(0), halfCell),
+                                                        center + Point(Length(0), halfCell),
+                                                        Length(0));
+            if ((shape.getDistanceTo(horizontal) >= mTraceMargin) &&
+                (shape.getDistanceTo(vertical) >= mTraceMargin)) {
+                continue;
+            }
+            for (int l = 0; l < mLayers; ++l) {
+                if ((layer < 0) || (layer == l)) {
+                    markObstacle(mTraceObstacles, (l * mRows + y) * mCols + x, net);
+                }
+            }
+        }
+    }
+}
+
+QVector<GridRouter::Result_t> GridRouter::route(const QVector<Connection_t>& connections,
+        const std::function<bool(int, int)>& progressCallback) const noexcept
+{
+    QVector<Result_t> results(connections.count());
+    Result_t* resultsData = results.data(); // detach before the threads write into it
+    QAtomicInt finished(0);
+    QAtomicInt canceled(0);
+    int total = connections.count() * (mMaxIterations + 1); // see routeRegion()
+
+    ConcurrentJobs jobs;
+    foreach (const Region_t& region, buildRegions(connections)) {
+        jobs.add([this, region, &connections, resultsData, &finished, &canceled]() {
+            routeRegion(region, connections, resultsData, finished, canceled);
+        });
+    }
+    if (progressCallback) {
+        jobs.run([&]() {
+            if (!progressCallback(finished.load(), total)) canceled.store(1);
+        });
+        if (canceled.load() || (!progressCallback(finished.load(), total))) {
+            return QVector<Result_t>(connections.count());
+        }
+    } else {
+        jobs.run();
+    }
+    return results;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+GridRouter::Cell_t GridRouter::getCell(const Point& pos) const noexcept
+{
+    qint64 cell = mCellSize.toNm();
+    qint64 x = ((pos.getX() - mOrigin.getX()).toNm() + cell / 2) / cell;
+    qint64 y = ((pos.getY() - mOrigin.getY()).toNm() + cell / 2) / cell;
+    return Cell_t{int(qBound(qint64(0), x, qint64(mCols - 1))),
+                  int(qBound(qint64(0), y, qint64(mRows - 1)))};
+}
+
+Point GridRouter::getCellCenter(int x, int y) const noexcept
+{
+    return mOrigin + Point(mCellSize * x, mCellSize * y);
+}
+
+void GridRouter::markObstacle(QVector<qint32>& grid, int index, int net) const noexcept
+{
+    qint32& value = grid[index];
+    if ((value == sFree) && (net >= 0)) {
+        value = net;
+    } else if (value != net) {
+        value = sBlocked; // copper without net, or copper of several nets
+    }
+}
+
+QList<GridRouter::Region_t> GridRouter::buildRegions(
+        const QVector<Connection_t>& connections) const noexcept
+{
+    // the search area of every connection
+    QList<Region_t> regions;
+    for (int i = 0; i < connections.count(); ++i) {
+        Cell_t start = getCell(connections.at(i).start);
+        Cell_t end = getCell(connections.at(i).end);
+        int detour = qMax(sMinDetourCells,
+                          qMax(qAbs(start.x - end.x), qAbs(start.y - end.y)) / 4);
+        Region_t region;
+        region.x0 = qMax(qMin(start.x, end.x) - detour, 0);
+        region.y0 = qMax(qMin(start.y, end.y) - detour, 0);
+        region.x1 = qMin(qMax(start.x, end.x) + detour, mCols - 1);
+        region.y1 = qMin(qMax(start.y, end.y) + detour, mRows - 1);
+        region.connections.append(i);
+        regions.append(region);
+    }
+
+    // merge overlapping regions until all regions are independent
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (int i = 0; i < regions.count(); ++i) {
+            for (int j = regions.count() - 1; j > i; --j) {
+                if (!regions.at(i).overlaps(regions.at(j))) continue;
+                Region_t& region = regions[i];
+                const Region_t& other = regions.at(j);
+                region.x0 = qMin(region.x0, other.x0);
+                region.y0 = qMin(region.y0, other.y0);
+                region.x1 = qMax(region.x1, other.x1);
+                region.y1 = qMax(region.y1, other.y1);
+                region.connections += other.connections;
+                regions.removeAt(j);
+                merged = true;
+            }
+        }
+    }
+
+    // route the biggest regions first to keep all threads busy until the end
+    std::sort(regions.begin(), regions.end(), [](const Region_t& a, const Region_t& b) {
+        return a.connections.count() > b.connections.count();
+    });
+    return regions;
+}
+
+void GridRouter::routeRegion(const Region_t& region, const QVector<Connection_t>& connections,
+                             Result_t* results, QAtomicInt& finished,
+                             const QAtomicInt& canceled) const noexcept
+{
+    int w = region.x1 - region.x0 + 1;
+    int h = region.y1 - region.y0 + 1;
+    int count = w * h * mLayers;
+    auto getGlobalIndex = [&](int state) {
+        int x = state % w, y = (state / w) % h, layer = state / (w * h);
+        return (layer * mRows + region.y0 + y) * mCols + region.x0 + x;
+    };
+
+    // the congestion state of the region
+    QVector<float> history(count, 0);       // costs of cells which were overused before
+    QVector<quint8> netCount(count, 0);     // number of nets using a cell
+    QHash<quint64, int> usage;              // key: (state << 32) | net
+    float presentFactor = 0.5f;             // costs of cells which are used by other nets
+    auto occupy = [&](int state, int net) {
+        if (++usage[(quint64(state) << 32) | quint32(net)] == 1) ++netCount[state];
+    };
+    auto release = [&](int state, int net) {
+        auto it = usage.find((quint64(state) << 32) | quint32(net));
+        if ((it != usage.end()) && (--it.value() == 0)) {
+            usage.erase(it);
+            --netCount[state];
+        }
+    };
+
+    // all cells which are occupied by a path (traces and via footprints)
+    auto getOccupiedStates = [&](const QVector<int>& path) {
+        QVector<int> states = path;
+        for (int i = 1; i < path.count(); ++i) {
+            if (path.at(i) % (w * h) != path.at(i - 1) % (w * h)) continue; // no via
+            int x = path.at(i) % w, y = (path.at(i) / w) % h;
+            foreach (const Cell_t& cell, mViaFootprint) {
+                for (int layer = 0; layer < mLayers; ++layer) {
+                    states.append((layer * h + y + cell.y) * w + x + cell.x);
+                }
+            }
+        }
+        std::sort(states.begin(), states.end());
+        states.erase(std::unique(states.begin(), states.end()), states.end());
+        return states;
+    };
+
+    // search the cheapest path of a connection with A*
+    QVector<float> costs(count, 0);
+    QVector<int> parents(count, -1);
+    QVector<int> visitedStamps(count, 0);   // costs/parents are valid for this stamp
+    QVector<int> closedStamps(count, 0);
+    QVector<int> ownNetStamps(count, 0);    // cell is used by the net of the connection
+    int stamp = 0;
+    QHash<int, QVector<int>> paths; // key: connection index
+    auto search = [&](int index) {
+        const Connection_t& connection = connections.at(index);
+        ++stamp;
+        foreach (int other, region.connections) {
+            if ((other == index) || (connections.at(other).net != connection.net)) continue;
+            foreach (int state, getOccupiedStates(paths.value(other))) {
+                ownNetStamps[state] = stamp;
+            }
+        }
+        auto getCellCosts = [&](int state) {
+            int others = netCount.at(state) - ((ownNetStamps.at(state) == stamp) ? 1 : 0);
+            return (1 + history.at(state)) * (1 + presentFactor * others);
+        };
+
+        Cell_t start = getCell(connection.start), end = getCell(connection.end);
+        int sx = start.x - region.x0, sy = start.y - region.y0;
+        int ex = end.x - region.x0, ey = end.y - region.y0;
+        std::priority_queue<OpenEntry_t> open;
+        auto push = [&](int state, float cost, int parent, int x, int y) {
+            if ((visitedStamps.at(state) == stamp) && (costs.at(state) <= cost)) return;
+            visitedStamps[state] = stamp;
+            costs[state] = cost;
+            parents[state] = parent;
+            open.push(OpenEntry_t{cost + qAbs(x - ex) + qAbs(y - ey), state});
+        };
+        for (int layer = 0; layer < mLayers; ++layer) {
+            int state = (layer * h + sy) * w + sx;
+            if ((connection.startLayers & (1u << layer)) &&
+                isPassable(mTraceObstacles.at(getGlobalIndex(state)), connection.net)) {
+                push(state, 0, -1, sx, sy);
+            }
+        }
+        while ((!open.empty()) && (!canceled.load())) {
+            int state = open.top().state;
+            open.pop();
+            if (closedStamps.at(state) == stamp) continue;
+            closedStamps[state] = stamp;
+            int x = state % w, y = (state / w) % h, layer = state / (w * h);
+            if ((x == ex) && (y == ey) && (connection.endLayers & (1u << layer))) {
+                QVector<int> path;
+                for (int s = state; s >= 0; s = parents.at(s)) path.prepend(s);
+                return path;
+            }
+            float cost = costs.at(state);
+
+            // horizontal and vertical steps
+            const int dx[4] = {1, -1, 0, 0};
+            const int dy[4] = {0, 0, 1, -1};
+            for (int i = 0; i < 4; ++i) {
+                int nx = x + dx[i], ny = y + dy[i];
+                if ((nx < 0) || (nx >= w) || (ny < 0) || (ny >= h)) continue;
+                int next = (layer * h + ny) * w + nx;
+                if (closedStamps.at(next) == stamp) continue;
+                if (!isPassable(mTraceObstacles.at(getGlobalIndex(next)), connection.net)) continue;
+                push(next, cost + getCellCosts(next), state, nx, ny);
+            }
+
+            // vias to all other layers (the footprint must be within the region)
+            if ((mLayers < 2) || (!isPassable(mViaObstacles.at((region.y0 + y) * mCols +
+                                                               region.x0 + x),
+                                              connection.net))) {
+                continue;
+            }
+            float viaCosts = mViaCost;
+            bool viaPossible = true;
+            foreach (const Cell_t& cell, mViaFootprint) {
+                int fx = x + cell.x, fy = y + cell.y;
+                if ((fx < 0) || (fx >= w) || (fy < 0) || (fy >= h)) {
+                    viaPossible = false;
+                    break;
+                }
+                for (int l = 0; l < mLayers; ++l) {
+                    viaCosts += getCellCosts((l * h + fy) * w + fx) - 1;
+                }
+            }
+            if (!viaPossible) continue;
+            for (int l = 0; l < mLayers; ++l) {
+                int next = (l * h + y) * w + x;
+                if ((l == layer) || (closedStamps.at(next) == stamp)) continue;
+                if (!isPassable(mTraceObstacles.at(getGlobalIndex(next)), connection.net)) continue;
+                push(next, cost + viaCosts, state, x, y);
+            }
+        }
+        return QVector<int>(); // no path found
+    };
+    auto hasConflict = [&](int index) {
+        foreach (int state, getOccupiedStates(paths.value(index))) {
+            if (netCount.at(state) > 1) return true;
+        }
+        return false;
+    };
+    auto ripUp = [&](int index) {
+        foreach (int state, getOccupiedStates(paths.value(index))) {
+            release(state, connections.at(index).net);
+        }
+        paths[index].clear();
+    };
+    auto reroute = [&](int index) {
+        paths[index] = search(index);
+        foreach (int state, getOccupiedStates(paths.value(index))) {
+            occupy(state, connections.at(index).net);
+        }
+    };
+
+    // route short connections first, they have the least alternatives
+    QVector<int> order = region.connections;
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        auto getLength = [&](int i) {
+            Point d = connections.at(i).end - connections.at(i).start;
+            return d.getX().abs() + d.getY().abs();
+        };
+        Length la = getLength(a), lb = getLength(b);
+        return (la != lb) ? (la < lb) : (a < b);
+    });
+    foreach (int index, order) {
+        if (canceled.load()) return;
+        reroute(index);
+        finished.ref();
+    }
+
+    // rip up and retry until there are no conflicts anymore (every iteration counts as
+    // one more pass over all connections of the region for the progress)
+    int iteration = 0;
+    for (; iteration < mMaxIterations; ++iteration) {
+        bool overused = false;
+        for (int state = 0; state < count; ++state) {
+            if (netCount.at(state) > 1) {
+                history[state] += 1;
+                overused = true;
+            }
+        }
+        if (!overused) break;
+        presentFactor = presentFactor * 1.5f + 0.5f;
+        QVector<int> conflicting;
+        foreach (int index, order) {
+            if (hasConflict(index)) conflicting.append(index);
+        }
+        foreach (int index, conflicting) ripUp(index);
+        finished.fetchAndAddRelaxed(order.count() - conflicting.count());
+        foreach (int index, conflicting) {
+            if (canceled.load()) return;
+            reroute(index);
+            finished.ref();
+        }
+    }
+    finished.fetchAndAddRelaxed(order.count() * (mMaxIterations - iteration)); // skipped
+
+    // remove the remaining conflicts and create the results
+    foreach (int index, order) {
+        if (hasConflict(index)) ripUp(index);
+    }
+    foreach (int index, order) {
+        if (!paths.value(index).isEmpty()) {
+            results[index] = createResult(connections.at(index), paths.value(index), region);
+        }
+    }
+}
+
+GridRouter::Result_t GridRouter::createResult(const Connection_t& connection,
+        const QVector<int>& path, const Region_t& region) const noexcept
+{
+    int w = region.x1 - region.x0 + 1;
+    int h = region.y1 - region.y0 + 1;
+    Result_t result;
+    result.routed = true;
+
+    // collect the vertices of every layer and convert them to segments
+    QVector<Point> vertices;
+    auto flush = [&](int layer) {
+        QVector<Point> points;
+        foreach (const Point& vertex, vertices) {
+            if ((!points.isEmpty()) && (vertex == points.last())) continue;
+            if (points.count() >= 2) {
+                // skip collinear vertices
+                Point d1 = points.last() - points.at(points.count() - 2);
+                Point d2 = vertex - points.last();
+                if ((d1.getX().toNm() * d2.getY().toNm() == d1.getY().toNm() * d2.getX().toNm()) &&
+                    (d1.getX().toNm() * d2.getX().toNm() + d1.getY().toNm() * d2.getY().toNm() > 0))
+                {
+                    points.last() = vertex;
+                    continue;
+                }
+            }
+            points.append(vertex);
+        }
+        for (int i = 1; i < points.count(); ++i) {
+            result.segments.append(Segment_t{layer, points.at(i - 1), points.at(i)});
+        }
+        vertices.clear();
+    };
+    int layer = path.first() / (w * h);
+    vertices.append(connection.start);
+    for (int i = 0; i < path.count(); ++i) {
+        int state = path.at(i);
+        Point center = getCellCenter(region.x0 + state % w, region.y0 + (state / w) % h);
+        if (state / (w * h) != layer) {
+            flush(layer);
+            result.vias.append(center);
+            layer = state / (w * h);
+        }
+        vertices.append(center);
+    }
+    vertices.append(connection.end);
+    flush(layer);
+    return result;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
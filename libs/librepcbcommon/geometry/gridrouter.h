@@ -0,0 +1,206 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_GRIDROUTER_H
+#define LIBREPCB_GRIDROUTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+#include "../units/all_length_units.h"
+#include "boundingbox.h"
+#include "convexshape.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class GridRouter
+ ****************************************************************************************/
+
+/**
+ * @brief The GridRouter class is a multi-layer maze router for point-to-point connections
+ *
+ * The routing area is divided into square cells whose size is the trace width plus the
+ * clearance, so traces of different nets in neighbouring cells never violate the
+ * clearance. Every cell of every layer may carry one trace of one net. Vias go through
+ * all layers and block all cells around them (on all layers) which are too close.
+ *
+ * Existing copper is added as obstacles before routing. An obstacle blocks all cells
+ * where a trace (from the cell center to the middle of the neighbour cells) would be too
+ * close to it, but only for other nets (cells of the same net may be used, e.g. to reach
+ * a pad).
+ *
+ * Connections are routed with A* (horizontal and vertical steps plus vias) and the
+ * conflicts between them are resolved with negotiated congestion ("rip-up and retry"):
+ * Cells used by more than one net get more expensive in every iteration, and all
+ * connections which are involved in a conflict are ripped up and routed again. The
+ * connections which still have conflicts after the last iteration are not routed.
+ *
+ * Connections whose search areas (bounding box plus some space for detours) do not
+ * overlap are independent of each other. They are grouped into regions which are routed
+ * in parallel, each region with its own congestion state.
+ */
+class GridRouter final
+{
+    public:
+
+        // Types
+
+        /**
+         * @brief A connection to route
+         *
+         * The layers are bit masks of the grid layer indices where the start or end
+         * point can be connected (e.g. all layers for a THT pad).
+         */
+        struct Connection_t {
+            int net;                ///< ID of the net (>= 0)
+            Point start;
+            quint32 startLayers;
+            Point end;
+            quint32 endLayers;
+        };
+
+        /// A trace segment of a routed connection
+        struct Segment_t {
+            int layer;
+            Point p1;
+            Point p2;
+        };
+
+        /// The result of a connection
+        struct Result_t {
+            bool routed;
+            QVector<Segment_t> segments;
+            QVector<Point> vias;
+            Result_t() noexcept : routed(false), segments(), vias() {}
+        };
+
+        // Constructors / Destructor
+        GridRouter() = delete;
+        GridRouter(const GridRouter& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param area          The area where traces and vias may be placed
+         * @param layerCount    The number of copper layers (1..32)
+         * @param traceWidth    The width of the routed traces
+         * @param viaSize       The outer diameter of the routed vias
+         * @param clearance     The min. distance between copper of different nets
+         */
+        GridRouter(const BoundingBox& area, int layerCount, const Length& traceWidth,
+                   const Length& viaSize, const Length& clearance) noexcept;
+        ~GridRouter() noexcept;
+
+        // Getters
+        const Length& getCellSize() const noexcept {return mCellSize;}
+        int getColumnCount() const noexcept {return mCols;}
+        int getRowCount() const noexcept {return mRows;}
+
+        // Setters
+
+        /// The costs of a via, relative to the costs of a trace through one cell
+        void setViaCost(int cost) noexcept {mViaCost = qMax(cost, 1);}
+
+        /// The max. number of rip-up and retry iterations
+        void setMaxIterations(int count) noexcept {mMaxIterations = qMax(count, 0);}
+
+        // General Methods
+
+        /**
+         * @brief Add existing copper which must not be touched by other nets
+         *
+         * @param layer     The grid layer index, or -1 for all layers (e.g. vias)
+         * @param shape     The copper shape
+         * @param net       The ID of the net of the copper, or -1 for copper without net
+         */
+        void addObstacle(int layer, const ConvexShape& shape, int net) noexcept;
+
+        /**
+         * @brief Route connections
+         *
+         * @param connections       The connections to route
+         * @param progressCallback  Optional; called periodically in the calling thread
+         *                          with the number of finished and total routing passes
+         *                          (every connection is counted once for the first
+         *                          routing and once per rip-up and retry iteration).
+         *                          If it returns false, routing is aborted and all results
+         *                          are marked as not routed.
+         *
+         * @return One result per connection (same order)
+         */
+        QVector<Result_t> route(const QVector<Connection_t>& connections,
+                                const std::function<bool(int, int)>& progressCallback =
+                                    std::function<bool(int, int)>()) const noexcept;
+
+        // Operator Overloadings
+        GridRouter& operator=(const GridRouter& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct Region_t;
+        struct Cell_t {int x; int y;};
+
+        // Private Methods
+        Cell_t getCell(const Point& pos) const noexcept;
+        Point getCellCenter(int x, int y) const noexcept;
+        void markObstacle(QVector<qint32>& grid, int index, int net) const noexcept;
+        bool isPassable(qint32 obstacle, int net) const noexcept {
+            return (obstacle == sFree) || (obstacle == net);
+        }
+        QList<Region_t> buildRegions(const QVector<Connection_t>& connections) const noexcept;
+        void routeRegion(const Region_t& region, const QVector<Connection_t>& connections,
+                         Result_t* results, QAtomicInt& finished,
+                         const QAtomicInt& canceled) const noexcept;
+        Result_t createResult(const Connection_t& connection,
+                              const QVector<int>& path, const Region_t& region) const noexcept;
+
+
+        // Attributes
+        static constexpr qint32 sFree = -2;     ///< obstacle value of a free cell
+        static constexpr qint32 sBlocked = -1;  ///< obstacle value of a cell without net
+        Point mOrigin;                  ///< center of the cell (0, 0)
+        int mCols;
+        int mRows;
+        int mLayers;
+        Length mCellSize;
+        Length mTraceMargin;            ///< min. distance between trace center and copper
+        Length mViaMargin;              ///< min. distance between via center and copper
+        int mViaCost;
+        int mMaxIterations;
+        QVector<qint32> mTraceObstacles;    ///< index: (layer * rows + y) * cols + x
+        QVector<qint32> mViaObstacles;      ///< index: y * cols + x
+        QVector<Cell_t> mViaFootprint;      ///< cells around a via which it blocks
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_GRIDROUTER_H
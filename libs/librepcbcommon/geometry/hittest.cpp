@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "hittest.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+Length HitTest::getDistanceToSegment(const Point& p, const Point& p1, const Point& p2) noexcept
+{
+    return Length(qRound64(qSqrt(getSquaredDistanceToSegment(p, p1, p2))));
+}
+
+Length HitTest::getDistanceBetweenSegments(const Point& p1, const Point& p2,
+                                           const Point& q1, const Point& q2) noexcept
+{
+    if (doSegmentsIntersect(p1, p2, q1, q2)) return Length(0);
+    // otherwise the shortest distance is always at one of the end points
+    return qMin(qMin(getDistanceToSegment(p1, q1, q2), getDistanceToSegment(p2, q1, q2)),
+                qMin(getDistanceToSegment(q1, p1, p2), getDistanceToSegment(q2, p1, p2)));
+}
+
+bool HitTest::doSegmentsIntersect(const Point& p1, const Point& p2,
+                                  const Point& q1, const Point& q2) noexcept
+{
+    int o1 = getOrientation(p1, p2, q1);
+    int o2 = getOrientation(p1, p2, q2);
+    int o3 = getOrientation(q1, q2, p1);
+    int o4 = getOrientation(q1, q2, p2);
+    if ((o1 != o2) && (o3 != o4)) return true;
+    // collinear cases: check whether an end point lies on the other segment
+    auto isOnSegment = [](const Point& p, const Point& a, const Point& b) {
+        return (p.getX() >= qMin(a.getX(), b.getX())) && (p.getX() <= qMax(a.getX(), b.getX()))
+            && (p.getY() >= qMin(a.getY(), b.getY())) && (p.getY() <= qMax(a.getY(), b.getY()));
+    };
+    if ((o1 == 0) && isOnSegment(q1, p1, p2)) return true;
+    if ((o2 == 0) && isOnSegment(q2, p1, p2)) return true;
+    if ((o3 == 0) && isOnSegment(p1, q1, q2)) return true;
+    if ((o4 == 0) && isOnSegment(p2, q1, q2)) return true;
+    return false;
+}
+
+bool HitTest::isPointInCircle(const Point& p, const Point& center, const Length& diameter) noexcept
+{
+    qint64 dx = qAbs(p.getX().toNm() - center.getX().toNm());
+    qint64 dy = qAbs(p.getY().toNm() - center.getY().toNm());
+    qint64 d = diameter.toNm();
+    if ((dx > d) || (dy > d)) return false; // also avoids overflows below
+    return (4 * (dx*dx + dy*dy)) <= (d*d);
+}
+
+bool HitTest::isPointInCapsule(const Point& p, const Point& p1, const Point& p2,
+                               const Length& width) noexcept
+{
+    qreal w = width.toNm();
+    return (4 * getSquaredDistanceToSegment(p, p1, p2)) <= (w*w);
+}
+
+bool HitTest::isPointInRect(const Point& p, const Point& center, const Length& width,
+                            const Length& height, const Angle& rotation) noexcept
+{
+    Point local = mapToLocal(p, center, rotation);
+    return (local.getX().abs() * 2 <= width) && (local.getY().abs() * 2 <= height);
+}
+
+bool HitTest::isPointInObround(const Point& p, const Point& center, const Length& width,
+                               const Length& height, const Angle& rotation) noexcept
+{
+    // work with doubled coordinates to avoid rounding errors when halving sizes
+    Point local = mapToLocal(p, center, rotation) * 2;
+    if (width >= height) {
+        Point end(width - height, Length(0));
+        return isPointInCapsule(local, -end, end, height * 2);
+    } else {
+        Point end(Length(0), height - width);
+        return isPointInCapsule(local, -end, end, width * 2);
+    }
+}
+
+bool HitTest::isPointInOctagon(const Point& p, const Point& center, const Length& width,
+                               const Length& height, const Angle& rotation) noexcept
+{
+    Point local = mapToLocal(p, center, rotation);
+    qint64 x = local.getX().abs().toNm();
+    qint64 y = local.getY().abs().toNm();
+    if ((2 * x > width.toNm()) || (2 * y > height.toNm())) return false;
+    qreal rx = width.toNm() / qreal(2);
+    qreal ry = height.toNm() / qreal(2);
+    qreal a = qMin(rx, ry) * (2 - qSqrt(2));
+    return (x + y) <= (rx + ry - a);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+Point HitTest::mapToLocal(const Point& p, const Point& center, const Angle& rotation) noexcept
+{
+    return (p - center).rotated(-rotation);
+}
+
+int HitTest::getOrientation(const Point& a, const Point& b, const Point& c) noexcept
+{
+    // exact as long as all coordinates are within +/- 1 meter (no 64bit overflow)
+    qint64 cross = (b.getX().toNm() - a.getX().toNm()) * (c.getY().toNm() - a.getY().toNm())
+                 - (b.getY().toNm() - a.getY().toNm()) * (c.getX().toNm() - a.getX().toNm());
+    return (cross > 0) ? 1 : ((cross < 0) ? -1 : 0);
+}
+
+qreal HitTest::getSquaredDistanceToSegment(const Point& p, const Point& p1,
+                                           const Point& p2) noexcept
+{
+    qint64 dx = p2.getX().toNm() - p1.getX().toNm();
+    qint64 dy = p2.getY().toNm() - p1.getY().toNm();
+    qint64 vx = p.getX().toNm() - p1.getX().toNm();
+    qint64 vy = p.getY().toNm() - p1.getY().toNm();
+    qint64 dot = vx*dx + vy*dy;
+    qint64 len2 = dx*dx + dy*dy;
+    if ((dot <= 0) || (len2 == 0)) {
+        // nearest point is p1
+        return qreal(vx*vx + vy*vy);
+    } else if (dot >= len2) {
+        // nearest point is p2
+        qint64 wx = p.getX().toNm() - p2.getX().toNm();
+        qint64 wy = p.getY().toNm() - p2.getY().toNm();
+        return qreal(wx*wx + wy*wy);
+    } else {
+        // nearest point is between p1 and p2
+        qreal cross = qreal(vx*dy - vy*dx);
+        return (cross * cross) / qreal(len2);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
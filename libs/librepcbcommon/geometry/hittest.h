@@ -0,0 +1,147 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_HITTEST_H
+#define LIBREPCB_HITTEST_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class HitTest
+ ****************************************************************************************/
+
+/**
+ * @brief The HitTest class provides exact point-in-shape tests for primitive shapes
+ *
+ * All calculations are done in nanometers. Squared distances are calculated with 64bit
+ * integers as long as they can't overflow, so the results are exact (also on the border
+ * of the shapes, which always belongs to the shape).
+ *
+ * Rotated shapes are rotated counterclockwise around their center. To test against a
+ * horizontally mirrored shape, just negate the rotation (all shapes are symmetric).
+ */
+class HitTest final
+{
+    public:
+
+        // Constructors / Destructor
+        HitTest() = delete;
+        HitTest(const HitTest& other) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Calculate the shortest distance between a point and a line segment
+         *
+         * @param p     The point
+         * @param p1    Start point of the segment
+         * @param p2    End point of the segment (may be equal to p1)
+         *
+         * @return The distance (rounded to nanometers)
+         */
+        static Length getDistanceToSegment(const Point& p, const Point& p1,
+                                           const Point& p2) noexcept;
+
+        /**
+         * @brief Calculate the shortest distance between two line segments
+         *
+         * @return The distance (rounded to nanometers), zero if the segments intersect
+         */
+        static Length getDistanceBetweenSegments(const Point& p1, const Point& p2,
+                                                 const Point& q1, const Point& q2) noexcept;
+
+        /**
+         * @brief Check whether two line segments intersect or touch each other
+         *
+         * The check is exact, there are no rounding errors at all.
+         */
+        static bool doSegmentsIntersect(const Point& p1, const Point& p2,
+                                        const Point& q1, const Point& q2) noexcept;
+
+        /**
+         * @brief Check whether a point is inside a circle
+         */
+        static bool isPointInCircle(const Point& p, const Point& center,
+                                    const Length& diameter) noexcept;
+
+        /**
+         * @brief Check whether a point is inside a line with round caps ("capsule")
+         *
+         * @param p     The point
+         * @param p1    Start point of the line
+         * @param p2    End point of the line
+         * @param width The width of the line (= diameter of the caps)
+         */
+        static bool isPointInCapsule(const Point& p, const Point& p1, const Point& p2,
+                                     const Length& width) noexcept;
+
+        /**
+         * @brief Check whether a point is inside a (rotated) rectangle
+         */
+        static bool isPointInRect(const Point& p, const Point& center, const Length& width,
+                                  const Length& height, const Angle& rotation) noexcept;
+
+        /**
+         * @brief Check whether a point is inside a (rotated) obround (rectangle with
+         *        fully rounded short sides)
+         */
+        static bool isPointInObround(const Point& p, const Point& center, const Length& width,
+                                     const Length& height, const Angle& rotation) noexcept;
+
+        /**
+         * @brief Check whether a point is inside a (rotated) octagon
+         *
+         * The chamfer of the corners is the same as used for the octagonal pads and
+         * vias: `min(width, height) / 2 * (2 - sqrt(2))`
+         */
+        static bool isPointInOctagon(const Point& p, const Point& center, const Length& width,
+                                     const Length& height, const Angle& rotation) noexcept;
+
+
+    private:
+
+        /// Transform a point into the local coordinate system of a rotated shape
+        static Point mapToLocal(const Point& p, const Point& center,
+                                const Angle& rotation) noexcept;
+
+        /// Sign of the cross product (b - a) x (c - a): 1 = ccw, -1 = cw, 0 = collinear
+        static int getOrientation(const Point& a, const Point& b, const Point& c) noexcept;
+
+        /// Squared distance between a point and a line segment [nm²]
+        static qreal getSquaredDistanceToSegment(const Point& p, const Point& p1,
+                                                 const Point& p2) noexcept;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_HITTEST_H
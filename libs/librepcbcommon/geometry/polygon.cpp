@@ -71,6 +71,22 @@ Point PolygonSegment::calcArcCenter(const Point& startPos) const noexcept
     }
 }
 
+void PolygonSegment::appendVertices(const Point& startPos, const Length& maxError,
+                                    QVector<Point>& vertices) const noexcept
+{
+    Angle angle = mAngle.mappedTo180deg(); // as in calcArcCenter()
+    if ((angle != 0) && (startPos != mEndPos)) {
+        Point center = calcArcCenter(startPos);
+        int count = calcChordCount((startPos - center).getLength(), angle, maxError);
+        for (int i = 1; i < count; ++i) {
+            // rotate the start point to avoid accumulating rounding errors
+            Angle a(qint32(qint64(angle.toMicroDeg()) * i / count));
+            vertices.append(startPos.rotated(a, center));
+        }
+    }
+    vertices.append(mEndPos);
+}
+
 XmlDomElement* PolygonSegment::serializeToXmlDomElement() const throw (Exception)
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -82,6 +98,16 @@ XmlDomElement* PolygonSegment::serializeToXmlDomElement() const throw (Exception
     return root.take();
 }
 
+int PolygonSegment::calcChordCount(const Length& radius, const Angle& angle,
+                                   const Length& maxError) noexcept
+{
+    // the chords of an arc with radius r have a sagitta of r * (1 - cos(step / 2))
+    qreal r = qAbs(radius.toNm());
+    qreal error = qMax(maxError.toNm(), LengthBase_t(1));
+    qreal maxStep = (error < r) ? 2 * qAcos(1 - error / r) : M_PI;
+    return qMax(1, qCeil(qAbs(angle.toRad()) / maxStep));
+}
+
 bool PolygonSegment::checkAttributesValidity() const noexcept
 {
     return true;
@@ -173,43 +199,29 @@ Point Polygon::calcCenterOfArcSegment(int index) const noexcept
     }
 }
 
+const QVector<Point>& Polygon::getVertices(const Length& maxError) const noexcept
+{
+    if (mVertices.isEmpty() || (maxError != mVerticesMaxError)) {
+        mVertices.clear();
+        mVertices.append(mStartPos);
+        foreach (const PolygonSegment* segment, mSegments) {
+            Point startPos = mVertices.last(); // copy, the vector may be reallocated
+            segment->appendVertices(startPos, maxError, mVertices);
+        }
+        mVerticesMaxError = maxError;
+    }
+    return mVertices;
+}
+
 const QPainterPath& Polygon::toQPainterPathPx() const noexcept
 {
     if (mPainterPathPx.isEmpty())
     {
         mPainterPathPx.setFillRule(Qt::WindingFill);
-        Point lastPos = mStartPos;
-        mPainterPathPx.moveTo(lastPos.toPxQPointF());
-        foreach (const PolygonSegment* segment, mSegments)
-        {
-            if (segment->getAngle() == 0)
-            {
-                mPainterPathPx.lineTo(segment->getEndPos().toPxQPointF());
-            }
-            else
-            {
-                // TODO: this is very provisional and may contain bugs...
-                // all lengths in pixels
-                qreal x1 = lastPos.toPxQPointF().x();
-                qreal y1 = lastPos.toPxQPointF().y();
-                qreal x2 = segment->getEndPos().toPxQPointF().x();
-                qreal y2 = segment->getEndPos().toPxQPointF().y();
-                qreal x3 = (x1+x2)/qreal(2);
-                qreal y3 = (y1+y2)/qreal(2);
-                qreal dx = x2-x1;
-                qreal dy = y2-y1;
-                qreal q = qSqrt(dx*dx + dy*dy);
-                qreal r = qAbs(q / (qreal(2) * qSin(segment->getAngle().toRad()/qreal(2))));
-                qreal rh = r * qCos(segment->getAngle().mappedTo180deg().toRad()/qreal(2));
-                qreal hx = -dy * rh / q;
-                qreal hy = dx * rh / q;
-                qreal cx = x3 + hx * (segment->getAngle().mappedTo180deg() > 0 ? -1 : 1);
-                qreal cy = y3 + hy * (segment->getAngle().mappedTo180deg() > 0 ? -1 : 1);
-                QRectF rect(cx-r, cy-r, 2*r, 2*r);
-                qreal startAngleDeg = -qRadiansToDegrees(qAtan2(y1-cy, x1-cx));
-                mPainterPathPx.arcTo(rect, startAngleDeg, segment->getAngle().toDeg());
-            }
-            lastPos = segment->getEndPos();
+        const QVector<Point>& vertices = getVertices();
+        mPainterPathPx.moveTo(vertices.first().toPxQPointF());
+        for (int i = 1; i < vertices.count(); ++i) {
+            mPainterPathPx.lineTo(vertices.at(i).toPxQPointF());
         }
     }
     return mPainterPathPx;
@@ -244,7 +256,7 @@ void Polygon::setIsGrabArea(bool isGrabArea) noexcept
 void Polygon::setStartPos(const Point& pos) noexcept
 {
     mStartPos = pos;
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCaches();
 }
 
 /*****************************************************************************************
@@ -257,6 +269,7 @@ Polygon& Polygon::translate(const Point& offset) noexcept
     foreach (PolygonSegment* segment, mSegments) {
         segment->setEndPos(segment->getEndPos() + offset);
     }
+    invalidateCaches();
     return *this;
 }
 
@@ -271,6 +284,7 @@ Polygon& Polygon::rotate(const Angle& angle, const Point& center) noexcept
     foreach (PolygonSegment* segment, mSegments) {
         segment->setEndPos(segment->getEndPos().rotated(angle, center));
     }
+    invalidateCaches();
     return *this;
 }
 
@@ -302,7 +316,7 @@ void Polygon::appendSegment(PolygonSegment& segment) noexcept
 {
     Q_ASSERT(!mSegments.contains(&segment));
     mSegments.append(&segment);
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCaches();
 }
 
 void Polygon::removeSegment(PolygonSegment& segment) throw (Exception)
@@ -313,7 +327,7 @@ void Polygon::removeSegment(PolygonSegment& segment) throw (Exception)
             tr("The last segment of a polygon cannot be removed."));
     }
     mSegments.removeAll(&segment);
-    mPainterPathPx = QPainterPath(); // invalidate painter path
+    invalidateCaches();
 }
 
 XmlDomElement* Polygon::serializeToXmlDomElement() const throw (Exception)
@@ -388,6 +402,12 @@ Polygon* Polygon::createCenteredRect(int layerId, const Length& lineWidth, bool
  *  Private Methods
  ****************************************************************************************/
 
+void Polygon::invalidateCaches() noexcept
+{
+    mVertices.clear();
+    mPainterPathPx = QPainterPath();
+}
+
 bool Polygon::checkAttributesValidity() const noexcept
 {
     if (mLayerId <= 0)          return false;
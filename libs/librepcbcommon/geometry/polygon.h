@@ -58,6 +58,17 @@ class PolygonSegment final : public IF_XmlSerializableObject
         const Angle& getAngle() const noexcept {return mAngle;}
         Point calcArcCenter(const Point& startPos) const noexcept;
 
+        /**
+         * @brief Append the vertices of this segment, with arcs approximated by chords
+         *
+         * @param startPos  The end position of the previous segment (is not appended)
+         * @param maxError  The maximum distance between the arc and its chords
+         * @param vertices  The list to append to (the end position is always the last
+         *                  appended vertex)
+         */
+        void appendVertices(const Point& startPos, const Length& maxError,
+                            QVector<Point>& vertices) const noexcept;
+
         // Setters
         void setEndPos(const Point& pos) noexcept {mEndPos = pos;}
         void setAngle(const Angle& angle) noexcept {mAngle = angle;}
@@ -67,6 +78,23 @@ class PolygonSegment final : public IF_XmlSerializableObject
         /// @copydoc IF_XmlSerializableObject#serializeToXmlDomElement()
         XmlDomElement* serializeToXmlDomElement() const throw (Exception) override;
 
+        // Static Methods
+
+        /**
+         * @brief Calculate the number of equal chords needed to approximate an arc
+         *
+         * @param radius    The radius of the arc
+         * @param angle     The angle of the arc (the sign is ignored)
+         * @param maxError  The maximum distance between the arc and its chords
+         *
+         * @return The number of chords (at least one)
+         */
+        static int calcChordCount(const Length& radius, const Angle& angle,
+                                  const Length& maxError) noexcept;
+
+        // Static Attributes
+        static constexpr LengthBase_t sDefaultMaxArcErrorNm = 1000; ///< used for rendering
+
 
     private:
 
@@ -118,6 +146,23 @@ class Polygon final : public IF_XmlSerializableObject
         const PolygonSegment* getSegment(int index) const noexcept {return mSegments.value(index);}
         Point getStartPointOfSegment(int index) const noexcept;
         Point calcCenterOfArcSegment(int index) const noexcept;
+
+        /**
+         * @brief Get the vertices of the polygon with all arcs approximated by chords
+         *
+         * The result starts with the start position and contains the end positions of
+         * all segments, so the last vertex equals the first one if the polygon is
+         * closed. It is cached for the last used maxError, so all consumers which use
+         * the same tolerance (e.g. rendering, hit testing and copper zones) share it.
+         *
+         * @param maxError  The maximum distance between the arcs and their chords
+         *
+         * @warning The cache is not thread-safe, so call this method before accessing
+         *          the polygon from other threads.
+         */
+        const QVector<Point>& getVertices(const Length& maxError =
+            Length(PolygonSegment::sDefaultMaxArcErrorNm)) const noexcept;
+
         const QPainterPath& toQPainterPathPx() const noexcept;
 
         // Setters
@@ -155,6 +200,7 @@ class Polygon final : public IF_XmlSerializableObject
         Polygon& operator=(const Polygon& rhs) = delete;
 
         // Private Methods
+        void invalidateCaches() noexcept;
 
         /// @copydoc #IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
@@ -169,6 +215,8 @@ class Polygon final : public IF_XmlSerializableObject
         QList<PolygonSegment*> mSegments;
 
         // Cached Attributes
+        mutable QVector<Point> mVertices;
+        mutable Length mVerticesMaxError;   ///< the tolerance of mVertices
         mutable QPainterPath mPainterPathPx;
 };
 
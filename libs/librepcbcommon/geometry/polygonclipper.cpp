@@ -0,0 +1,550 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "polygonclipper.h"
+#include "polygon.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+PolygonClipper::Paths PolygonClipper::execute(Operation op, const Paths& subject,
+                                              const Paths& clip, FillRule fillRule) noexcept
+{
+    QVector<Edge_t> edges;
+    addEdges(edges, subject, false);
+    addEdges(edges, clip, true);
+    splitEdges(edges);
+    mergeEdges(edges);
+    return buildContours(classifyEdges(edges, op, fillRule));
+}
+
+PolygonClipper::Paths PolygonClipper::unite(const Paths& paths, FillRule fillRule) noexcept
+{
+    return execute(Operation::Union, paths, Paths(), fillRule);
+}
+
+PolygonClipper::Paths PolygonClipper::offset(const Paths& paths, const Length& delta,
+                                             const Length& maxError) noexcept
+{
+    // after the union, the area is always on the left side of the edges
+    Paths normalized = unite(paths);
+    if (delta == 0) return normalized;
+
+    // the band along the edges which is added or removed: a rectangle on the outer (or
+    // inner) side of every edge, and a circle sector at every vertex where there is a gap
+    // between the rectangles of the adjacent edges
+    qreal distance = delta.abs().toNm();
+    qreal error = qMax(maxError.toNm(), LengthBase_t(1));
+    qreal maxStep = (error < distance) ? 2 * qAcos(1 - error / distance) : M_PI / 2;
+    qreal side = (delta > 0) ? -M_PI / 2 : M_PI / 2; // rotation from edge to normal
+    auto offsetPoint = [distance](const Point& p, qreal angle) {
+        return p + Point(qRound64(distance * qCos(angle)), qRound64(distance * qSin(angle)));
+    };
+    Paths band;
+    auto appendToBand = [&band](Path path) {
+        // all shapes need the same orientation, otherwise their windings cancel out
+        if (calcArea(path) < 0) std::reverse(path.begin(), path.end());
+        band.append(path);
+    };
+    foreach (const Path& path, normalized) {
+        int count = path.count();
+        QVector<qreal> normals(count);
+        for (int i = 0; i < count; ++i) {
+            Point diff = path.at((i + 1) % count) - path.at(i);
+            normals[i] = qAtan2(diff.getY().toNm(), diff.getX().toNm()) + side;
+        }
+        for (int i = 0; i < count; ++i) {
+            const Point& p1 = path.at(i);
+            const Point& p2 = path.at((i + 1) % count);
+            appendToBand({p1, p2, offsetPoint(p2, normals.at(i)), offsetPoint(p1, normals.at(i))});
+
+            // convex vertices need a round corner when growing, concave when shrinking
+            const Point& p0 = path.at((i + count - 1) % count);
+            qreal cross = qreal((p1 - p0).getX().toNm()) * qreal((p2 - p1).getY().toNm())
+                        - qreal((p1 - p0).getY().toNm()) * qreal((p2 - p1).getX().toNm());
+            if ((cross == 0) || ((cross > 0) != (delta > 0))) continue;
+            qreal startAngle = normals.at((i + count - 1) % count);
+            qreal sweep = normals.at(i) - startAngle;
+            while (sweep > M_PI) sweep -= 2 * M_PI;
+            while (sweep <= -M_PI) sweep += 2 * M_PI;
+            int steps = qMax(1, qCeil(qAbs(sweep) / maxStep));
+            Path sector = {p1};
+            for (int k = 0; k <= steps; ++k) {
+                sector.append(offsetPoint(p1, startAngle + (sweep * k) / steps));
+            }
+            appendToBand(sector);
+        }
+    }
+    if (delta > 0) {
+        return execute(Operation::Union, normalized, band);
+    } else {
+        return execute(Operation::Difference, normalized, band);
+    }
+}
+
+qreal PolygonClipper::calcArea(const Path& path) noexcept
+{
+    if (path.count() < 3) return 0;
+    // relative to the first vertex to keep the rounding errors small
+    qreal x0 = path.first().getX().toNm(), y0 = path.first().getY().toNm();
+    qreal area = 0;
+    for (int i = 1; i < path.count() - 1; ++i) {
+        qreal x1 = path.at(i).getX().toNm() - x0, y1 = path.at(i).getY().toNm() - y0;
+        qreal x2 = path.at(i + 1).getX().toNm() - x0, y2 = path.at(i + 1).getY().toNm() - y0;
+        area += x1 * y2 - x2 * y1;
+    }
+    return area / 2;
+}
+
+PolygonClipper::Path PolygonClipper::flatten(const Polygon& polygon,
+                                             const Length& maxError) noexcept
+{
+    Path path;
+    foreach (const Point& vertex, polygon.getVertices(maxError)) {
+        if (path.isEmpty() || (vertex != path.last())) path.append(vertex);
+    }
+    if ((path.count() > 1) && (path.first() == path.last())) {
+        path.removeLast(); // paths are implicitly closed
+    }
+    return path;
+}
+
+Polygon* PolygonClipper::toPolygon(const Path& path, int layerId, const Length& lineWidth,
+                                   bool fill, bool isGrabArea) noexcept
+{
+    Point start = path.isEmpty() ? Point(0, 0) : path.first();
+    Polygon* polygon = new Polygon(layerId, lineWidth, fill, isGrabArea, start);
+    for (int i = 1; i < path.count(); ++i) {
+        polygon->appendSegment(*new PolygonSegment(path.at(i), Angle::deg0()));
+    }
+    if (path.count() > 1) {
+        polygon->appendSegment(*new PolygonSegment(start, Angle::deg0()));
+    }
+    return polygon;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void PolygonClipper::addEdges(QVector<Edge_t>& edges, const Paths& paths, bool isClip) noexcept
+{
+    foreach (const Path& path, paths) {
+        for (int i = 0; i < path.count(); ++i) {
+            const Point& p1 = path.at(i);
+            const Point& p2 = path.at((i + 1) % path.count());
+            Vertex_t v1 = {p1.getX().toNm(), p1.getY().toNm()};
+            Vertex_t v2 = {p2.getX().toNm(), p2.getY().toNm()};
+            if (isEqual(v1, v2)) continue;
+            int wind = isLess(v1, v2) ? 1 : -1;
+            Edge_t edge;
+            edge.a = (wind > 0) ? v1 : v2;
+            edge.b = (wind > 0) ? v2 : v1;
+            edge.windS = isClip ? 0 : wind;
+            edge.windC = isClip ? wind : 0;
+            edges.append(edge);
+        }
+    }
+}
+
+void PolygonClipper::splitEdges(QVector<Edge_t>& edges) noexcept
+{
+    // rounding the intersection points may create new intersections, but this converges
+    // quickly since the edges move by less than one nanometer; after the first iteration
+    // only pairs with at least one new (split) edge need to be checked again
+    QVector<bool> isNew(edges.count(), true);
+    for (int iteration = 0; iteration < 32; ++iteration) {
+        int count = edges.count();
+        if (count < 2) return;
+        QVector<QVector<Vertex_t>> splits(count);
+        auto addSplit = [&](int index, const Vertex_t& p) {
+            if (isLess(edges.at(index).a, p) && isLess(p, edges.at(index).b)) {
+                splits[index].append(p);
+                return true;
+            }
+            return false;
+        };
+
+        // put all edges into a uniform grid to find the pairs with overlapping bounding
+        // boxes (roughly one edge per cell, long edges are added to several cells)
+        qint64 minX = edges.first().a.x, maxX = minX;
+        qint64 minY = edges.first().a.y, maxY = edges.first().b.y;
+        foreach (const Edge_t& e, edges) {
+            minX = qMin(minX, qMin(e.a.x, e.b.x));
+            maxX = qMax(maxX, qMax(e.a.x, e.b.x));
+            minY = qMin(minY, e.a.y); // a.y <= b.y
+            maxY = qMax(maxY, e.b.y);
+        }
+        qreal width = qreal(maxX - minX) + 1, height = qreal(maxY - minY) + 1;
+        qreal cellSizeF = qMax(qSqrt(width * height / count), qMax(width, height) / 1024);
+        qint64 cellSize = qMax(qint64(qCeil(cellSizeF)), qint64(1));
+        int cols = int((maxX - minX) / cellSize) + 1;
+        int rows = int((maxY - minY) / cellSize) + 1;
+        QVector<QVector<int>> grid(cols * rows);
+        QVector<int> firstCol(count), firstRow(count);
+        for (int i = 0; i < count; ++i) {
+            const Edge_t& e = edges.at(i);
+            int x1 = int((qMin(e.a.x, e.b.x) - minX) / cellSize);
+            int x2 = int((qMax(e.a.x, e.b.x) - minX) / cellSize);
+            int y1 = int((e.a.y - minY) / cellSize);
+            int y2 = int((e.b.y - minY) / cellSize);
+            firstCol[i] = x1;
+            firstRow[i] = y1;
+            for (int y = y1; y <= y2; ++y) {
+                for (int x = x1; x <= x2; ++x) grid[y * cols + x].append(i);
+            }
+        }
+
+        bool modified = false;
+        for (int cell = 0; cell < grid.count(); ++cell) {
+            const QVector<int>& indices = grid.at(cell);
+            int col = cell % cols, row = cell / cols;
+            for (int k = 0; k < indices.count(); ++k) {
+                int i = indices.at(k);
+                const Edge_t& e = edges.at(i);
+                for (int l = k + 1; l < indices.count(); ++l) {
+                    int j = indices.at(l);
+                    if ((!isNew.at(i)) && (!isNew.at(j))) continue;
+                    // check every pair only in the first cell which contains both edges
+                    if ((qMax(firstCol.at(i), firstCol.at(j)) != col) ||
+                        (qMax(firstRow.at(i), firstRow.at(j)) != row)) continue;
+                    const Edge_t& f = edges.at(j);
+                    if ((e.b.y < f.a.y) || (f.b.y < e.a.y)) continue;
+                    if ((qMax(e.a.x, e.b.x) < qMin(f.a.x, f.b.x)) ||
+                        (qMax(f.a.x, f.b.x) < qMin(e.a.x, e.b.x))) continue;
+                    int o1 = orientation(e.a, e.b, f.a);
+                    int o2 = orientation(e.a, e.b, f.b);
+                    int o3 = orientation(f.a, f.b, e.a);
+                    int o4 = orientation(f.a, f.b, e.b);
+                    if ((o1 * o2 < 0) && (o3 * o4 < 0)) {
+                        // proper crossing, split both edges at the rounded intersection
+                        qreal ex = e.b.x - e.a.x, ey = e.b.y - e.a.y;
+                        qreal fx = f.b.x - f.a.x, fy = f.b.y - f.a.y;
+                        qreal t = ((f.a.x - e.a.x) * fy - (f.a.y - e.a.y) * fx) /
+                                  (ex * fy - ey * fx);
+                        Vertex_t p = {e.a.x + qRound64(t * ex), e.a.y + qRound64(t * ey)};
+                        modified |= addSplit(i, p);
+                        modified |= addSplit(j, p);
+                    } else {
+                        // vertices touching the other edge (includes collinear overlaps)
+                        if (o1 == 0) modified |= addSplit(i, f.a);
+                        if (o2 == 0) modified |= addSplit(i, f.b);
+                        if (o3 == 0) modified |= addSplit(j, e.a);
+                        if (o4 == 0) modified |= addSplit(j, e.b);
+                    }
+                }
+            }
+        }
+        if (!modified) return;
+
+        QVector<Edge_t> result;
+        QVector<bool> resultIsNew;
+        result.reserve(count * 2);
+        resultIsNew.reserve(count * 2);
+        for (int i = 0; i < count; ++i) {
+            QVector<Vertex_t>& points = splits[i];
+            if (points.isEmpty()) {
+                result.append(edges.at(i));
+                resultIsNew.append(false);
+                continue;
+            }
+            // all split points are between a and b, so sorting them gives the new edges
+            std::sort(points.begin(), points.end(), &PolygonClipper::isLess);
+            Edge_t edge = edges.at(i);
+            Vertex_t start = edge.a;
+            foreach (const Vertex_t& p, points) {
+                if (isEqual(p, start)) continue;
+                edge.a = start;
+                edge.b = p;
+                result.append(edge);
+                resultIsNew.append(true);
+                start = p;
+            }
+            edge.a = start;
+            edge.b = edges.at(i).b;
+            result.append(edge);
+            resultIsNew.append(true);
+        }
+        edges = result;
+        isNew = resultIsNew;
+    }
+    qWarning() << "PolygonClipper: Failed to split all edges, the result may be invalid.";
+}
+
+void PolygonClipper::mergeEdges(QVector<Edge_t>& edges) noexcept
+{
+    std::sort(edges.begin(), edges.end(), [](const Edge_t& e, const Edge_t& f){
+        if (!isEqual(e.a, f.a)) return isLess(e.a, f.a);
+        return isLess(e.b, f.b);
+    });
+    int count = 0;
+    for (int i = 0; i < edges.count(); ++i) {
+        const Edge_t& e = edges.at(i);
+        if ((count > 0) && isEqual(edges.at(count - 1).a, e.a) &&
+            isEqual(edges.at(count - 1).b, e.b))
+        {
+            edges[count - 1].windS += e.windS;
+            edges[count - 1].windC += e.windC;
+        } else {
+            edges[count++] = e;
+        }
+    }
+    edges.resize(count);
+    // edges which cancel out (e.g. of two identical paths with opposite orientation)
+    // don't separate different areas
+    edges.erase(std::remove_if(edges.begin(), edges.end(), [](const Edge_t& e){
+        return (e.windS == 0) && (e.windC == 0);
+    }), edges.end());
+}
+
+QVector<PolygonClipper::Edge_t> PolygonClipper::classifyEdges(const QVector<Edge_t>& edges,
+        Operation op, FillRule fillRule) noexcept
+{
+    QVector<Edge_t> result;
+    if (edges.isEmpty()) return result;
+
+    auto isInside = [fillRule](int winding) {
+        return (fillRule == FillRule::EvenOdd) ? ((winding & 1) != 0) : (winding != 0);
+    };
+    auto isInResult = [op, &isInside](int windS, int windC) {
+        bool s = isInside(windS), c = isInside(windC);
+        switch (op)
+        {
+            case Operation::Union:          return s || c;
+            case Operation::Intersection:   return s && c;
+            case Operation::Difference:     return s && (!c);
+            case Operation::Xor:            return s != c;
+            default:                        return false;
+        }
+    };
+
+    // buckets of edges along the y axis (for horizontal rays) and along the x axis (for
+    // vertical rays), so every ray only needs to be tested against the nearby edges
+    qint64 minX = edges.first().a.x, maxX = minX;
+    qint64 minY = edges.first().a.y, maxY = minY;
+    foreach (const Edge_t& e, edges) {
+        minX = qMin(minX, qMin(e.a.x, e.b.x));
+        maxX = qMax(maxX, qMax(e.a.x, e.b.x));
+        minY = qMin(minY, e.a.y);
+        maxY = qMax(maxY, e.b.y);
+    }
+    int bucketCount = qBound(1, edges.count() / 4, 4096);
+    qint64 bucketHeight = (maxY - minY) / bucketCount + 1;
+    qint64 bucketWidth = (maxX - minX) / bucketCount + 1;
+    QVector<QVector<int>> rows(bucketCount), columns(bucketCount);
+    for (int i = 0; i < edges.count(); ++i) {
+        const Edge_t& e = edges.at(i);
+        if (e.a.y != e.b.y) {
+            for (qint64 k = (e.a.y - minY) / bucketHeight; k <= (e.b.y - minY) / bucketHeight; ++k) {
+                rows[k].append(i);
+            }
+        }
+        if (e.a.x != e.b.x) {
+            qint64 x1 = qMin(e.a.x, e.b.x) - minX, x2 = qMax(e.a.x, e.b.x) - minX;
+            for (qint64 k = x1 / bucketWidth; k <= x2 / bucketWidth; ++k) {
+                columns[k].append(i);
+            }
+        }
+    }
+
+    for (int i = 0; i < edges.count(); ++i) {
+        const Edge_t& e = edges.at(i);
+        // the midpoint of the edge with doubled coordinates to keep them integer
+        qint64 mx2 = e.a.x + e.b.x, my2 = e.a.y + e.b.y;
+        int windS = 0, windC = 0; // on the left side of the edge
+        if (e.a.y != e.b.y) {
+            // horizontal ray to +x, which starts on the right side of the (upward) edge
+            foreach (int j, rows.at((my2 - 2 * minY) / (2 * bucketHeight))) {
+                const Edge_t& f = edges.at(j);
+                if ((j == i) || (2 * f.a.y > my2) || (2 * f.b.y <= my2)) continue;
+                if (crossSign(f.b.x - f.a.x, f.b.y - f.a.y,
+                              mx2 - 2 * f.a.x, my2 - 2 * f.a.y) > 0) {
+                    windS += f.windS; // f is right of the midpoint
+                    windC += f.windC;
+                }
+            }
+            windS += e.windS;
+            windC += e.windC;
+        } else {
+            // vertical ray to +y, which starts on the left side of the (rightward) edge
+            foreach (int j, columns.at((mx2 - 2 * minX) / (2 * bucketWidth))) {
+                const Edge_t& f = edges.at(j);
+                qint64 dx = f.b.x - f.a.x;
+                if ((j == i) || (2 * qMin(f.a.x, f.b.x) > mx2) ||
+                    (2 * qMax(f.a.x, f.b.x) <= mx2)) continue;
+                int side = crossSign(dx, f.b.y - f.a.y, mx2 - 2 * f.a.x, my2 - 2 * f.a.y);
+                if (side * ((dx > 0) ? 1 : -1) < 0) {
+                    // f is above the midpoint, and counts positive if it runs to -x
+                    int sign = (dx < 0) ? 1 : -1;
+                    windS += sign * f.windS;
+                    windC += sign * f.windC;
+                }
+            }
+        }
+        bool left = isInResult(windS, windC);
+        bool right = isInResult(windS - e.windS, windC - e.windC);
+        if (left != right) {
+            // the result area must be on the left side of the directed edge
+            Edge_t directed = e;
+            if (right) qSwap(directed.a, directed.b);
+            result.append(directed);
+        }
+    }
+    return result;
+}
+
+PolygonClipper::Paths PolygonClipper::buildContours(const QVector<Edge_t>& edges) noexcept
+{
+    QHash<QPair<qint64, qint64>, QVector<int>> outgoing;
+    for (int i = 0; i < edges.count(); ++i) {
+        outgoing[qMakePair(edges.at(i).a.x, edges.at(i).a.y)].append(i);
+    }
+
+    // order of directions clockwise from r: (0, pi), pi, (pi, 2*pi), 2*pi
+    auto getQuarter = [](const Vertex_t& r, const Vertex_t& d) {
+        int cross = crossSign(r.x, r.y, d.x, d.y);
+        if (cross < 0) return 0;
+        if (cross > 0) return 2;
+        bool opposite = (r.x != 0) ? ((r.x > 0) != (d.x > 0)) : ((r.y > 0) != (d.y > 0));
+        return opposite ? 1 : 3;
+    };
+
+    Paths contours;
+    QVector<bool> used(edges.count(), false);
+    for (int first = 0; first < edges.count(); ++first) {
+        if (used.at(first)) continue;
+        QVector<Vertex_t> vertices;
+        int current = first;
+        while (true) {
+            used[current] = true;
+            const Edge_t& e = edges.at(current);
+            vertices.append(e.a);
+            // choose the next edge which turns most to the left, so touching contours
+            // are separated at their common vertices
+            Vertex_t r = {e.a.x - e.b.x, e.a.y - e.b.y};
+            int next = -1, nextQuarter = 0;
+            Vertex_t nextDir = {0, 0};
+            foreach (int k, outgoing.value(qMakePair(e.b.x, e.b.y))) {
+                if (used.at(k) && (k != first)) continue;
+                Vertex_t d = {edges.at(k).b.x - e.b.x, edges.at(k).b.y - e.b.y};
+                int quarter = getQuarter(r, d);
+                if ((next < 0) || (quarter < nextQuarter) || ((quarter == nextQuarter) &&
+                    (crossSign(nextDir.x, nextDir.y, d.x, d.y) > 0)))
+                {
+                    next = k;
+                    nextQuarter = quarter;
+                    nextDir = d;
+                }
+            }
+            if ((next < 0) || (next == first)) break;
+            current = next;
+        }
+
+        // remove vertices between collinear edges (e.g. created by splitting)
+        bool removed = true;
+        while (removed && (vertices.count() >= 3)) {
+            removed = false;
+            for (int i = 0; i < vertices.count(); ++i) {
+                const Vertex_t& prev = vertices.at((i + vertices.count() - 1) % vertices.count());
+                const Vertex_t& next = vertices.at((i + 1) % vertices.count());
+                if (orientation(prev, vertices.at(i), next) == 0) {
+                    vertices.remove(i--);
+                    removed = true;
+                    if (vertices.count() < 3) break;
+                }
+            }
+        }
+        if (vertices.count() < 3) continue;
+        Path path;
+        path.reserve(vertices.count());
+        foreach (const Vertex_t& v, vertices) {
+            path.append(Point(v.x, v.y));
+        }
+        contours.append(path);
+    }
+    return contours;
+}
+
+bool PolygonClipper::isLess(const Vertex_t& p, const Vertex_t& q) noexcept
+{
+    return (p.y < q.y) || ((p.y == q.y) && (p.x < q.x));
+}
+
+bool PolygonClipper::isEqual(const Vertex_t& p, const Vertex_t& q) noexcept
+{
+    return (p.x == q.x) && (p.y == q.y);
+}
+
+int PolygonClipper::crossSign(qint64 ax, qint64 ay, qint64 bx, qint64 by) noexcept
+{
+    // fast path if the products can't overflow
+    const qint64 limit = Q_INT64_C(1) << 31;
+    if ((qAbs(ax) < limit) && (qAbs(ay) < limit) && (qAbs(bx) < limit) && (qAbs(by) < limit)) {
+        qint64 cross = ax * by - ay * bx;
+        return (cross > 0) ? 1 : ((cross < 0) ? -1 : 0);
+    }
+
+    // exact comparison of ax*by and ay*bx with 128 bit products
+    struct Product_t {
+        bool negative;
+        quint64 hi;
+        quint64 lo;
+    };
+    auto multiply = [](qint64 a, qint64 b) {
+        Product_t p;
+        p.negative = (a != 0) && (b != 0) && ((a < 0) != (b < 0));
+        quint64 ua = (a < 0) ? quint64(-a) : quint64(a);
+        quint64 ub = (b < 0) ? quint64(-b) : quint64(b);
+        quint64 a0 = ua & 0xFFFFFFFFu, a1 = ua >> 32, b0 = ub & 0xFFFFFFFFu, b1 = ub >> 32;
+        quint64 p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        quint64 mid = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+        p.lo = (p00 & 0xFFFFFFFFu) | (mid << 32);
+        p.hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+        return p;
+    };
+    Product_t p1 = multiply(ax, by), p2 = multiply(ay, bx);
+    if (p1.negative != p2.negative) {
+        return p1.negative ? -1 : 1; // a negative product is never zero
+    }
+    int cmp = (p1.hi != p2.hi) ? ((p1.hi > p2.hi) ? 1 : -1)
+                               : ((p1.lo != p2.lo) ? ((p1.lo > p2.lo) ? 1 : -1) : 0);
+    return p1.negative ? -cmp : cmp;
+}
+
+int PolygonClipper::orientation(const Vertex_t& a, const Vertex_t& b, const Vertex_t& c) noexcept
+{
+    return crossSign(b.x - a.x, b.y - a.y, c.x - a.x, c.y - a.y);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
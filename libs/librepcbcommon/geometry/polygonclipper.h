@@ -0,0 +1,178 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_POLYGONCLIPPER_H
+#define LIBREPCB_POLYGONCLIPPER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class Polygon;
+
+/*****************************************************************************************
+ *  Class PolygonClipper
+ ****************************************************************************************/
+
+/**
+ * @brief The PolygonClipper class provides boolean operations and offsetting of polygons
+ *        with integer (nanometer) coordinates
+ *
+ * All operations work on paths, i.e. lists of vertices which are implicitly closed. Arcs
+ * of #Polygon objects are flattened to straight segments with a configurable tolerance
+ * (see #flatten()), and the results can be converted back with #toPolygon().
+ *
+ * The boolean operations build the planar arrangement of all edges:
+ *  1. All edges are split at their intersections and at vertices which touch them. The
+ *     intersection points are rounded to nanometers, so the splitting is repeated until
+ *     no edges cross anymore.
+ *  2. Identical edges (e.g. the common edge of two adjacent rectangles) are merged.
+ *  3. For every edge, the winding numbers of the subject and the clip paths on both of
+ *     its sides are determined with a ray from the edge's midpoint. All predicates are
+ *     evaluated exactly with integer arithmetic.
+ *  4. The edges which separate the inside of the result from the outside are kept and
+ *     linked to closed contours.
+ *
+ * The resulting contours never cross each other, but may touch at vertices. Outer
+ * contours are counterclockwise, holes are clockwise (i.e. the area is always on the left
+ * side), so the result can be used as input with any fill rule.
+ *
+ * @note The coordinates must be within ±2^31 nanometers (about ±2.1 meters).
+ */
+class PolygonClipper final
+{
+    public:
+
+        // Types
+        typedef QVector<Point> Path;
+        typedef QList<Path> Paths;
+        enum class Operation {Union, Intersection, Difference, Xor};
+        enum class FillRule {EvenOdd, NonZero};
+
+        // Constructors / Destructor
+        PolygonClipper() = delete;
+        PolygonClipper(const PolygonClipper& other) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Execute a boolean operation
+         *
+         * @param op        The operation (Difference: subject minus clip)
+         * @param subject   The subject paths
+         * @param clip      The clip paths
+         * @param fillRule  How the inside of the subject and clip paths is determined
+         *
+         * @return The contours of the result (see class description)
+         */
+        static Paths execute(Operation op, const Paths& subject, const Paths& clip,
+                             FillRule fillRule = FillRule::NonZero) noexcept;
+
+        /**
+         * @brief Merge paths to non-overlapping contours (same as a union with no clip)
+         */
+        static Paths unite(const Paths& paths,
+                           FillRule fillRule = FillRule::NonZero) noexcept;
+
+        /**
+         * @brief Grow (positive delta) or shrink (negative delta) paths with round corners
+         *
+         * The round corners are approximated by chords, i.e. the result is up to maxError
+         * smaller than the exact offset (when growing) in the corners.
+         *
+         * @param paths     The paths to offset (evaluated with the non-zero fill rule)
+         * @param delta     The offset distance
+         * @param maxError  The max. deviation of the approximated round corners
+         *
+         * @return The contours of the result (see class description)
+         */
+        static Paths offset(const Paths& paths, const Length& delta,
+                            const Length& maxError) noexcept;
+
+        /**
+         * @brief Calculate the signed area of a path (positive if counterclockwise)
+         *
+         * @return The area in square nanometers
+         */
+        static qreal calcArea(const Path& path) noexcept;
+
+        /**
+         * @brief Convert a polygon to a path by flattening its arc segments
+         *
+         * This uses the cached vertices of the polygon (see Polygon#getVertices()).
+         *
+         * @param polygon   The polygon (treated as closed)
+         * @param maxError  The max. distance between the arcs and their chords
+         */
+        static Path flatten(const Polygon& polygon, const Length& maxError) noexcept;
+
+        /**
+         * @brief Convert a path to a closed polygon with straight segments
+         *
+         * @return A new polygon (the caller takes the ownership)
+         */
+        static Polygon* toPolygon(const Path& path, int layerId, const Length& lineWidth,
+                                  bool fill, bool isGrabArea) noexcept;
+
+        // Operator Overloadings
+        PolygonClipper& operator=(const PolygonClipper& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct Vertex_t {
+            qint64 x;
+            qint64 y;
+        };
+        struct Edge_t {
+            Vertex_t a;     ///< the lower vertex (by y, then by x), or the start vertex
+            Vertex_t b;     ///< the upper vertex, or the end vertex (of result edges)
+            int windS;      ///< +1 if the subject path runs from a to b, -1 if reverse
+            int windC;      ///< same for the clip path
+        };
+
+        // Private Methods
+        static void addEdges(QVector<Edge_t>& edges, const Paths& paths, bool isClip) noexcept;
+        static void splitEdges(QVector<Edge_t>& edges) noexcept;
+        static void mergeEdges(QVector<Edge_t>& edges) noexcept;
+        static QVector<Edge_t> classifyEdges(const QVector<Edge_t>& edges, Operation op,
+                                             FillRule fillRule) noexcept;
+        static Paths buildContours(const QVector<Edge_t>& edges) noexcept;
+        static bool isLess(const Vertex_t& p, const Vertex_t& q) noexcept;
+        static bool isEqual(const Vertex_t& p, const Vertex_t& q) noexcept;
+        static int crossSign(qint64 ax, qint64 ay, qint64 bx, qint64 by) noexcept;
+        static int orientation(const Vertex_t& a, const Vertex_t& b, const Vertex_t& c) noexcept;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_POLYGONCLIPPER_H
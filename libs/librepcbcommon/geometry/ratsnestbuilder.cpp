@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "ratsnestbuilder.h"
+#include "../disjointset.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QList<QPair<int, int>> RatsnestBuilder::build(const QVector<Point>& positions,
+                                              const QVector<int>& islands) noexcept
+{
+    Q_ASSERT(positions.count() == islands.count());
+    QList<QPair<int, int>> airwires;
+    int count = qMin(positions.count(), islands.count());
+    if (count < 2) return airwires;
+
+    // determine the extent of all anchors
+    qint64 minX = positions.first().getX().toNm(), maxX = minX;
+    qint64 minY = positions.first().getY().toNm(), maxY = minY;
+    for (int i = 1; i < count; ++i) {
+        minX = qMin(minX, positions.at(i).getX().toNm());
+        maxX = qMax(maxX, positions.at(i).getX().toNm());
+        minY = qMin(minY, positions.at(i).getY().toNm());
+        maxY = qMax(maxY, positions.at(i).getY().toNm());
+    }
+
+    // build a grid with roughly one anchor per cell (also for very narrow extents)
+    qreal width = qreal(maxX - minX), height = qreal(maxY - minY);
+    qreal cellSizeF = qMax(qSqrt(qMax(width, 1.0) * qMax(height, 1.0) / count),
+                           qMax(width, height) / count);
+    qint64 cellSize = qMax(qint64(qCeil(cellSizeF)), qint64(1));
+    int cols = int((maxX - minX) / cellSize) + 1;
+    int rows = int((maxY - minY) / cellSize) + 1;
+    QVector<QVector<int>> grid(cols * rows);
+    QVector<int> cellX(count), cellY(count);
+    for (int i = 0; i < count; ++i) {
+        cellX[i] = int((positions.at(i).getX().toNm() - minX) / cellSize);
+        cellY[i] = int((positions.at(i).getY().toNm() - minY) / cellSize);
+        grid[cellY.at(i) * cols + cellX.at(i)].append(i);
+    }
+
+    struct Edge_t {
+        int anchor1 = -1;       ///< -1 if no edge was found yet
+        int anchor2 = -1;
+        qreal distance = 0;     ///< squared length of the edge
+    };
+    auto isShorter = [](qreal distance, int a, int b, const Edge_t& edge) {
+        if (edge.anchor1 < 0) return true;
+        if (distance != edge.distance) return distance < edge.distance;
+        // make ties deterministic
+        return qMakePair(qMin(a, b), qMax(a, b)) <
+               qMakePair(qMin(edge.anchor1, edge.anchor2), qMax(edge.anchor1, edge.anchor2));
+    };
+
+    DisjointSet<int> components;
+    for (int i = 0; i < count; ++i) components.add(islands.at(i));
+    QVector<int> component(count);
+    int maxRing = qMax(cols, rows);
+    while (components.getSetCount() > 1) {
+        // the largest component is skipped because searching from there would be the
+        // most expensive, and it is connected anyway by the edges of the other components
+        QMap<int, int> sizes;
+        for (int i = 0; i < count; ++i) {
+            component[i] = components.find(islands.at(i));
+            ++sizes[component.at(i)];
+        }
+        int largest = sizes.firstKey();
+        for (auto it = sizes.constBegin(); it != sizes.constEnd(); ++it) {
+            if (it.value() > sizes.value(largest)) largest = it.key();
+        }
+
+        // search the shortest edge from every component to any other component
+        QMap<int, Edge_t> shortest;
+        for (int i = 0; i < count; ++i) {
+            int c = component.at(i);
+            if (c == largest) continue;
+            Edge_t& best = shortest[c];
+            qint64 x = positions.at(i).getX().toNm(), y = positions.at(i).getY().toNm();
+            for (int r = 0; r <= maxRing; ++r) {
+                if ((best.anchor1 >= 0) && (r > 0)) {
+                    // all anchors in this ring are at least (r-1) cells away
+                    qreal bound = qreal(r - 1) * cellSize;
+                    if (bound * bound > best.distance) break;
+                }
+                for (int cy = cellY.at(i) - r; cy <= cellY.at(i) + r; ++cy) {
+                    if ((cy < 0) || (cy >= rows)) continue;
+                    // in the inner rows, only the left and right cell belong to the ring
+                    bool outerRow = (qAbs(cy - cellY.at(i)) == r);
+                    int step = outerRow ? 1 : 2 * r;
+                    for (int cx = cellX.at(i) - r; cx <= cellX.at(i) + r; cx += step) {
+                        if ((cx < 0) || (cx >= cols)) continue;
+                        foreach (int j, grid.at(cy * cols + cx)) {
+                            if (component.at(j) == c) continue;
+                            qreal dx = qreal(positions.at(j).getX().toNm() - x);
+                            qreal dy = qreal(positions.at(j).getY().toNm() - y);
+                            qreal distance = dx * dx + dy * dy;
+                            if (isShorter(distance, i, j, best)) {
+                                best.anchor1 = i;
+                                best.anchor2 = j;
+                                best.distance = distance;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // connect every component with its nearest neighbour
+        bool merged = false;
+        foreach (const Edge_t& edge, shortest) {
+            if (edge.anchor1 < 0) continue;
+            if (components.unite(islands.at(edge.anchor1), islands.at(edge.anchor2))) {
+                airwires.append(qMakePair(edge.anchor1, edge.anchor2));
+                merged = true;
+            }
+        }
+        if (!merged) {
+            qCritical() << "Failed to connect all islands of the ratsnest!";
+            break;
+        }
+    }
+    return airwires;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
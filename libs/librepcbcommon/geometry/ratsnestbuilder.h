@@ -0,0 +1,86 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_RATSNESTBUILDER_H
+#define LIBREPCB_RATSNESTBUILDER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class RatsnestBuilder
+ ****************************************************************************************/
+
+/**
+ * @brief The RatsnestBuilder class calculates the air wires between unconnected islands
+ *
+ * The input is a list of anchor points, each of them belonging to an island (a group of
+ * anchors which are already connected together). The result is a minimum spanning tree
+ * over the islands, i.e. the shortest set of air wires which connects all islands.
+ *
+ * The tree is built with Borůvka's algorithm: In every round, the nearest anchor of
+ * another island is searched for every anchor, and each island is connected with its
+ * nearest neighbour island. The nearest neighbour searches use a uniform grid and are
+ * aborted as soon as no closer anchor can be found, so the costs are roughly
+ * O(n * log(n)) for evenly distributed anchors instead of O(n²) for a complete graph.
+ *
+ * The result is deterministic (ties are broken by the anchor indices).
+ */
+class RatsnestBuilder final
+{
+    public:
+
+        // Constructors / Destructor
+        RatsnestBuilder() = delete;
+        RatsnestBuilder(const RatsnestBuilder& other) = delete;
+
+
+        // Static Methods
+
+        /**
+         * @brief Calculate the air wires between islands of anchors
+         *
+         * @param positions     The positions of all anchors
+         * @param islands       The island ID of every anchor (same size as positions)
+         *
+         * @return The air wires as pairs of anchor indices. For N islands, exactly N-1
+         *         air wires are returned.
+         */
+        static QList<QPair<int, int>> build(const QVector<Point>& positions,
+                                            const QVector<int>& islands) noexcept;
+
+        // Operator Overloadings
+        RatsnestBuilder& operator=(const RatsnestBuilder& rhs) = delete;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_RATSNESTBUILDER_H
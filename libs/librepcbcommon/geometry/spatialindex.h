@@ -0,0 +1,297 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_SPATIALINDEX_H
+#define LIBREPCB_SPATIALINDEX_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include "../units/all_length_units.h"
+#include "boundingbox.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class SpatialIndex
+ ****************************************************************************************/
+
+/**
+ * @brief The SpatialIndex class is a uniform grid over axis-aligned bounding boxes
+ *
+ * Every item is registered with its bounding box (in nanometers) and is stored in all
+ * grid cells which are touched by this box. Range queries then only have to look at the
+ * cells which overlap the query rectangle, so the costs depend on the number of items in
+ * the neighbourhood and not on the total number of items.
+ *
+ * Items which would span too many cells (e.g. very long lines) are kept in a separate
+ * list which is checked on every query, so they can't blow up the memory usage.
+ *
+ * The results of all queries are sorted by the order in which the items were inserted
+ * (updating the bounding box of an item does not change its order). This way the
+ * results are deterministic and equal to a linear scan over a list.
+ *
+ * @note The item type @p T must be usable as a QHash key (e.g. a pointer).
+ */
+template <typename T>
+class SpatialIndex final
+{
+    public:
+
+        // Constructors / Destructor
+        SpatialIndex() = delete;
+        SpatialIndex(const SpatialIndex& other) = delete;
+        explicit SpatialIndex(const Length& cellSize) noexcept :
+            mCellSize(qMax(cellSize.toNm(), LengthBase_t(1))), mNextSerial(0) {}
+        ~SpatialIndex() noexcept {}
+
+        // Getters
+        int count() const noexcept {return mEntries.count();}
+        bool contains(T item) const noexcept {return mEntries.contains(item);}
+
+        // General Methods
+
+        /**
+         * @brief Add an item or update the bounding box of an already added item
+         *
+         * @param item  The item to add/update
+         * @param p1    One corner of the bounding box
+         * @param p2    The opposite corner of the bounding box
+         */
+        void insert(T item, const Point& p1, const Point& p2) noexcept
+        {
+            Entry entry;
+            entry.minX = qMin(p1.getX().toNm(), p2.getX().toNm());
+            entry.minY = qMin(p1.getY().toNm(), p2.getY().toNm());
+            entry.maxX = qMax(p1.getX().toNm(), p2.getX().toNm());
+            entry.maxY = qMax(p1.getY().toNm(), p2.getY().toNm());
+            auto it = mEntries.find(item);
+            if (it != mEntries.end()) {
+                if ((it->minX == entry.minX) && (it->minY == entry.minY) &&
+                    (it->maxX == entry.maxX) && (it->maxY == entry.maxY))
+                {
+                    return; // nothing changed
+                }
+                entry.serial = it->serial;
+                removeFromCells(item, *it);
+                *it = entry;
+            } else {
+                entry.serial = mNextSerial++;
+                mEntries.insert(item, entry);
+            }
+            addToCells(item, entry);
+        }
+
+        /**
+         * @brief Add or update an item with the specified bounding box
+         *
+         * @note An invalid bounding box removes the item from the index (it couldn't be
+         *       found anyway).
+         */
+        void insert(T item, const BoundingBox& box) noexcept
+        {
+            if (box.isValid()) {
+                insert(item, box.getMin(), box.getMax());
+            } else {
+                remove(item);
+            }
+        }
+
+        /**
+         * @brief Update the bounding box of an item, but only if it is already added
+         */
+        void update(T item, const Point& p1, const Point& p2) noexcept
+        {
+            if (mEntries.contains(item)) insert(item, p1, p2);
+        }
+
+        /**
+         * @brief Remove an item from the index
+         *
+         * @return True if the item was in the index, false otherwise
+         */
+        bool remove(T item) noexcept
+        {
+            auto it = mEntries.find(item);
+            if (it == mEntries.end()) return false;
+            removeFromCells(item, *it);
+            mEntries.erase(it);
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            mEntries.clear();
+            mCells.clear();
+            mOversized.clear();
+        }
+
+        /**
+         * @brief Get all items whose bounding box intersects the specified rectangle
+         *
+         * @param p1    One corner of the rectangle
+         * @param p2    The opposite corner of the rectangle
+         *
+         * @return All found items, sorted by insertion order
+         */
+        QList<T> query(const Point& p1, const Point& p2) const noexcept
+        {
+            qint64 minX = qMin(p1.getX().toNm(), p2.getX().toNm());
+            qint64 minY = qMin(p1.getY().toNm(), p2.getY().toNm());
+            qint64 maxX = qMax(p1.getX().toNm(), p2.getX().toNm());
+            qint64 maxY = qMax(p1.getY().toNm(), p2.getY().toNm());
+            QVector<QPair<quint64, T>> found;
+            auto check = [&](T item) {
+                const Entry& e = mEntries[item];
+                if ((e.maxX < minX) || (e.minX > maxX) || (e.maxY < minY) || (e.minY > maxY)) return;
+                found.append(qMakePair(e.serial, item));
+            };
+            qint64 cx1 = cellCoord(minX), cx2 = cellCoord(maxX);
+            qint64 cy1 = cellCoord(minY), cy2 = cellCoord(maxY);
+            if ((cx2 - cx1 + 1) * (cy2 - cy1 + 1) > mEntries.count()) {
+                // the query rectangle is huge, a linear scan is cheaper
+                for (auto it = mEntries.constBegin(); it != mEntries.constEnd(); ++it) {
+                    check(it.key());
+                }
+            } else {
+                foreach (T item, mOversized) check(item);
+                QSet<T> visited;
+                for (qint64 cx = cx1; cx <= cx2; ++cx) {
+                    for (qint64 cy = cy1; cy <= cy2; ++cy) {
+                        auto cell = mCells.constFind(cellKey(cx, cy));
+                        if (cell == mCells.constEnd()) continue;
+                        foreach (T item, *cell) {
+                            // items spanning multiple cells must be reported only once
+                            if ((cx1 != cx2) || (cy1 != cy2)) {
+                                if (visited.contains(item)) continue;
+                                visited.insert(item);
+                            }
+                            check(item);
+                        }
+                    }
+                }
+            }
+            std::sort(found.begin(), found.end(),
+                [](const QPair<quint64, T>& a, const QPair<quint64, T>& b){return a.first < b.first;});
+            QList<T> list;
+            list.reserve(found.count());
+            for (const QPair<quint64, T>& pair : found) list.append(pair.second);
+            return list;
+        }
+
+        /**
+         * @brief Get all items whose bounding box intersects the specified box
+         */
+        QList<T> query(const BoundingBox& box) const noexcept
+        {
+            return box.isValid() ? query(box.getMin(), box.getMax()) : QList<T>();
+        }
+
+        /**
+         * @brief Get all items whose bounding box contains the specified point
+         */
+        QList<T> query(const Point& pos) const noexcept {return query(pos, pos);}
+
+        // Operator Overloadings
+        SpatialIndex& operator=(const SpatialIndex& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct Entry {
+            qint64 minX;
+            qint64 minY;
+            qint64 maxX;
+            qint64 maxY;
+            quint64 serial;     ///< insertion order, used to sort query results
+        };
+
+        /// Items which span more cells than this are stored in #mOversized
+        static constexpr qint64 sMaxCellsPerItem = 256;
+
+        // Private Methods
+        qint64 cellCoord(qint64 nm) const noexcept
+        {
+            // round towards negative infinity
+            return (nm >= 0) ? (nm / mCellSize) : (-((-nm - 1) / mCellSize) - 1);
+        }
+
+        static quint64 cellKey(qint64 cx, qint64 cy) noexcept
+        {
+            return (quint64(quint32(qint32(cx))) << 32) | quint64(quint32(qint32(cy)));
+        }
+
+        bool isOversized(const Entry& e) const noexcept
+        {
+            qint64 cols = cellCoord(e.maxX) - cellCoord(e.minX) + 1;
+            qint64 rows = cellCoord(e.maxY) - cellCoord(e.minY) + 1;
+            return (cols * rows > sMaxCellsPerItem);
+        }
+
+        void addToCells(T item, const Entry& e) noexcept
+        {
+            if (isOversized(e)) {
+                mOversized.insert(item);
+                return;
+            }
+            for (qint64 cx = cellCoord(e.minX); cx <= cellCoord(e.maxX); ++cx) {
+                for (qint64 cy = cellCoord(e.minY); cy <= cellCoord(e.maxY); ++cy) {
+                    mCells[cellKey(cx, cy)].append(item);
+                }
+            }
+        }
+
+        void removeFromCells(T item, const Entry& e) noexcept
+        {
+            if (isOversized(e)) {
+                mOversized.remove(item);
+                return;
+            }
+            for (qint64 cx = cellCoord(e.minX); cx <= cellCoord(e.maxX); ++cx) {
+                for (qint64 cy = cellCoord(e.minY); cy <= cellCoord(e.maxY); ++cy) {
+                    auto cell = mCells.find(cellKey(cx, cy));
+                    if (cell == mCells.end()) continue;
+                    cell->removeOne(item);
+                    if (cell->isEmpty()) mCells.erase(cell);
+                }
+            }
+        }
+
+
+        // Attributes
+        qint64 mCellSize;                       ///< the edge length of a cell [nm]
+        quint64 mNextSerial;                    ///< serial number for the next new item
+        QHash<T, Entry> mEntries;               ///< all items with their bounding box
+        QHash<quint64, QVector<T>> mCells;      ///< the grid cells
+        QSet<T> mOversized;                     ///< items which span too many cells
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_SPATIALINDEX_H
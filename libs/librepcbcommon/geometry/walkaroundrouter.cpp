@@ -0,0 +1,360 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <queue>
+#include <limits>
+#include "walkaroundrouter.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Local Helpers
+ ****************************************************************************************/
+
+namespace {
+
+/// The 8 octilinear directions, counterclockwise starting with +X
+const int sDirX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+const int sDirY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+/// Pseudo direction of the start node (no bend costs for the first segment)
+const int sNoDirection = 8;
+
+/// The additional costs of a 45° bend, relative to the grid interval
+const qreal sBendCostFactor = 0.3;
+
+int getDirection(qint64 dx, qint64 dy) noexcept
+{
+    int sx = (dx > 0) ? 1 : ((dx < 0) ? -1 : 0);
+    int sy = (dy > 0) ? 1 : ((dy < 0) ? -1 : 0);
+    for (int i = 0; i < 8; ++i) {
+        if ((sDirX[i] == sx) && (sDirY[i] == sy)) return i;
+    }
+    return sNoDirection;
+}
+
+/// The number of 45° steps between two directions, or -1 for an acute angle
+int getBendSteps(int dir1, int dir2) noexcept
+{
+    if ((dir1 == sNoDirection) || (dir2 == sNoDirection)) return 0;
+    int diff = qAbs(dir1 - dir2);
+    diff = qMin(diff, 8 - diff);
+    return (diff > 2) ? -1 : diff;
+}
+
+/// The length of the shortest octilinear path (admissible A* heuristic)
+qreal getOctileDistance(qint64 dx, qint64 dy) noexcept
+{
+    qreal ax = qAbs(dx), ay = qAbs(dy);
+    return qMax(ax, ay) + (M_SQRT2 - 1) * qMin(ax, ay);
+}
+
+struct Node_t {
+    int cx;         ///< grid column relative to the start point
+    int cy;         ///< grid row relative to the start point
+    int dir;        ///< the direction of the segment from the parent node
+    qreal cost;     ///< the costs from the start point to this node
+    int parent;     ///< index of the previous node, -1 for the start node
+    bool closed;
+};
+
+struct OpenEntry_t {
+    qreal estimate;     ///< costs + heuristic
+    quint64 serial;     ///< insertion order to make ties deterministic
+    int node;           ///< the node index (the last grid node for goal entries)
+    bool goal;          ///< whether this entry represents the complete path
+    bool hasMiddle;     ///< whether the goal connection consists of two segments
+    Point middle;       ///< the bend of the goal connection
+
+    bool operator<(const OpenEntry_t& rhs) const noexcept {
+        // std::priority_queue pops the biggest entry first
+        if (estimate != rhs.estimate) return estimate > rhs.estimate;
+        return serial > rhs.serial;
+    }
+};
+
+/**
+ * @brief Check whether a segment moves away from the core of an obstacle
+ *
+ * The distance to a convex core is convex along the segment, so it never decreases if
+ * it doesn't decrease at the beginning. Points within the core polygon have no
+ * direction to escape, so every segment is considered as moving away there.
+ */
+bool isMovingAway(const ConvexShape& obstacle, const Point& from, const Point& to) noexcept
+{
+    const QVector<Point>& vertices = obstacle.getVertices();
+    if ((vertices.count() >= 3) && ConvexShape(vertices, Length(0)).contains(from)) {
+        return true;
+    }
+    // the nearest point of the core outline
+    qreal fx = from.getX().toNm(), fy = from.getY().toNm();
+    qreal nearestX = vertices.first().getX().toNm(), nearestY = vertices.first().getY().toNm();
+    qreal nearestDistance = std::numeric_limits<qreal>::max();
+    for (int i = 0; i < vertices.count(); ++i) {
+        const Point& a = vertices.at(i);
+        const Point& b = vertices.at((i + 1) % vertices.count());
+        qreal ax = a.getX().toNm(), ay = a.getY().toNm();
+        qreal abx = b.getX().toNm() - ax, aby = b.getY().toNm() - ay;
+        qreal length2 = abx * abx + aby * aby;
+        qreal t = (length2 > 0) ? ((fx - ax) * abx + (fy - ay) * aby) / length2 : 0;
+        t = qBound(qreal(0), t, qreal(1));
+        qreal x = ax + t * abx, y = ay + t * aby;
+        qreal distance = (fx - x) * (fx - x) + (fy - y) * (fy - y);
+        if (distance < nearestDistance) {
+            nearestDistance = distance;
+            nearestX = x;
+            nearestY = y;
+        }
+    }
+    qreal dx = to.getX().toNm() - fx, dy = to.getY().toNm() - fy;
+    return (dx * (fx - nearestX) + dy * (fy - nearestY)) >= 0;
+}
+
+/// A unique key for a grid node plus a slot number (0..15)
+quint64 getNodeKey(int cx, int cy, int slot) noexcept
+{
+    return (quint64(quint32(cx)) << 32) | (quint64(quint32(cy) & 0x0FFFFFFF) << 4) |
+           quint64(slot);
+}
+
+} // namespace
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+WalkaroundRouter::WalkaroundRouter(const Length& gridInterval, const Length& margin) noexcept :
+    mGridInterval(qMax(gridInterval, Length(1))), mMargin(qMax(margin, Length(0))),
+    mMaxExpandedNodes(5000), mObstacles(), mIndex(mGridInterval * 4)
+{
+}
+
+WalkaroundRouter::~WalkaroundRouter() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void WalkaroundRouter::addObstacle(const ConvexShape& shape) noexcept
+{
+    if (!shape.isValid()) return;
+    ConvexShape expanded = shape.expanded(mMargin);
+    mIndex.insert(mObstacles.count(), expanded.getBoundingBox());
+    mObstacles.append(expanded);
+}
+
+QVector<Point> WalkaroundRouter::route(const Point& start, const Point& end,
+                                       const BoundingBox& area) const noexcept
+{
+    // obstacles at the start or end point are only passed while leaving them (see isFree())
+    QSet<int> startObstacles, endObstacles;
+    foreach (int index, mIndex.query(start)) {
+        if (mObstacles.at(index).contains(start)) startObstacles.insert(index);
+    }
+    foreach (int index, mIndex.query(end)) {
+        if (mObstacles.at(index).contains(end)) endObstacles.insert(index);
+    }
+    auto isInStartObstacle = [&](const Point& pos) {
+        foreach (int index, startObstacles) {
+            if (mObstacles.at(index).contains(pos)) return true;
+        }
+        return false;
+    };
+
+    qint64 step = mGridInterval.toNm();
+    qreal bendCost = sBendCostFactor * step;
+    auto getPos = [&](const Node_t& node) {
+        return start + Point(node.cx * step, node.cy * step);
+    };
+    auto getHeuristic = [&](const Point& pos) {
+        return getOctileDistance(end.getX().toNm() - pos.getX().toNm(),
+                                 end.getY().toNm() - pos.getY().toNm());
+    };
+
+    // the same segments are checked from several nodes (one per incoming direction),
+    // so the results are cached (key: grid node + outgoing direction or goal variant)
+    QHash<quint64, bool> freeSegments;
+    auto isFreeCached = [&](const Node_t& node, int slot, const Point& p1, const Point& p2,
+                            const Point& p3) {
+        quint64 key = getNodeKey(node.cx, node.cy, slot);
+        auto it = freeSegments.constFind(key);
+        if (it != freeSegments.constEnd()) return it.value();
+        bool free = isFree(p1, p2, start, startObstacles, end, endObstacles) &&
+                    ((p3 == p2) || isFree(p2, p3, start, startObstacles, end, endObstacles));
+        freeSegments.insert(key, free);
+        return free;
+    };
+
+    QVector<Node_t> nodes;
+    QHash<quint64, int> nodeIndices;
+    std::priority_queue<OpenEntry_t> open;
+    quint64 serial = 0;
+    nodes.append(Node_t{0, 0, sNoDirection, 0, -1, false});
+    nodeIndices.insert(getNodeKey(0, 0, 0), 0);
+    open.push(OpenEntry_t{getHeuristic(start), serial++, 0, false, false, Point()});
+
+    int expandedNodes = 0;
+    while ((!open.empty()) && (expandedNodes < mMaxExpandedNodes)) {
+        OpenEntry_t entry = open.top();
+        open.pop();
+        if (entry.goal) {
+            // the cheapest path is complete, collect its vertices backwards
+            QVector<Point> reversed;
+            reversed.append(end);
+            if (entry.hasMiddle) reversed.append(entry.middle);
+            for (int i = entry.node; i >= 0; i = nodes.at(i).parent) {
+                Point pos = getPos(nodes.at(i));
+                if (pos != reversed.last()) reversed.append(pos);
+            }
+            QVector<Point> path;
+            for (int i = reversed.count() - 1; i >= 0; --i) {
+                const Point& pos = reversed.at(i);
+                if (path.count() >= 2) {
+                    // skip collinear vertices
+                    Point d1 = path.at(path.count() - 1) - path.at(path.count() - 2);
+                    Point d2 = pos - path.at(path.count() - 1);
+                    if ((getDirection(d1.getX().toNm(), d1.getY().toNm()) ==
+                         getDirection(d2.getX().toNm(), d2.getY().toNm())) &&
+                        (d1.getX().toNm() * d2.getY().toNm() ==
+                         d1.getY().toNm() * d2.getX().toNm()))
+                    {
+                        path.last() = pos;
+                        continue;
+                    }
+                }
+                path.append(pos);
+            }
+            return path;
+        }
+        if (nodes.at(entry.node).closed) continue; // outdated entry
+        nodes[entry.node].closed = true;
+        ++expandedNodes;
+        Node_t node = nodes.at(entry.node);
+        Point pos = getPos(node);
+
+        // try to connect the end point directly (with one bend, like "45° - 90°")
+        qint64 dx = end.getX().toNm() - pos.getX().toNm();
+        qint64 dy = end.getY().toNm() - pos.getY().toNm();
+        qint64 diagonal = qMin(qAbs(dx), qAbs(dy));
+        QVector<Point> middles;
+        if ((dx == 0) || (dy == 0) || (qAbs(dx) == qAbs(dy))) {
+            middles.append(pos); // only one segment
+        } else {
+            qint64 sx = (dx > 0) ? 1 : -1, sy = (dy > 0) ? 1 : -1;
+            middles.append(pos + Point(sx * diagonal, sy * diagonal));  // diagonal first
+            middles.append(end - Point(sx * diagonal, sy * diagonal));  // straight first
+        }
+        for (int variant = 0; variant < middles.count(); ++variant) {
+            const Point& middle = middles.at(variant);
+            qreal cost = node.cost + getOctileDistance(dx, dy);
+            int previousDir = node.dir;
+            bool valid = true;
+            Point segments[2] = {middle - pos, end - middle};
+            for (const Point& segment : segments) {
+                if (segment.isOrigin()) continue;
+                int dir = getDirection(segment.getX().toNm(), segment.getY().toNm());
+                int bends = getBendSteps(previousDir, dir);
+                if (bends < 0) {valid = false; break;}
+                cost += bends * bendCost;
+                previousDir = dir;
+            }
+            if (!valid) continue;
+            if (!isFreeCached(node, sNoDirection + 1 + variant, pos, middle, end)) continue;
+            open.push(OpenEntry_t{cost, serial++, entry.node, true, middle != pos, middle});
+        }
+
+        // expand to the neighbour grid nodes (from the start node, the first segment is
+        // extended until it leaves the obstacles at the start point)
+        for (int dir = 0; dir < 8; ++dir) {
+            int bends = getBendSteps(node.dir, dir);
+            if (bends < 0) continue;
+            int steps = 1;
+            int cx = node.cx + sDirX[dir], cy = node.cy + sDirY[dir];
+            Point nextPos = start + Point(cx * step, cy * step);
+            while ((entry.node == 0) && (steps < mMaxExpandedNodes) &&
+                   ((!area.isValid()) || area.contains(nextPos)) &&
+                   isInStartObstacle(nextPos))
+            {
+                ++steps;
+                cx += sDirX[dir];
+                cy += sDirY[dir];
+                nextPos = start + Point(cx * step, cy * step);
+            }
+            if (area.isValid() && (!area.contains(nextPos))) continue;
+            qreal cost = node.cost + bends * bendCost +
+                         steps * (((dir % 2) == 0) ? step : (M_SQRT2 * step));
+            quint64 key = getNodeKey(cx, cy, 0);
+            int index = nodeIndices.value(key, -1);
+            if ((index >= 0) && (nodes.at(index).closed || (nodes.at(index).cost <= cost))) {
+                continue;
+            }
+            if (!isFreeCached(node, dir, pos, nextPos, nextPos)) continue;
+            if (index < 0) {
+                index = nodes.count();
+                nodes.append(Node_t{cx, cy, dir, cost, entry.node, false});
+                nodeIndices.insert(key, index);
+            } else {
+                nodes[index].cost = cost;
+                nodes[index].parent = entry.node;
+            }
+            open.push(OpenEntry_t{cost + getHeuristic(nextPos), serial++, index, false,
+                                  false, Point()});
+        }
+    }
+    return QVector<Point>(); // no path found (within the limits)
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool WalkaroundRouter::isFree(const Point& p1, const Point& p2, const Point& start,
+                              const QSet<int>& startObstacles, const Point& end,
+                              const QSet<int>& endObstacles) const noexcept
+{
+    ConvexShape segment((p1 == p2) ? QVector<Point>{p1} : QVector<Point>{p1, p2}, Length(0));
+    foreach (int index, mIndex.query(p1, p2)) {
+        const ConvexShape& obstacle = mObstacles.at(index);
+        if ((p1 == start) && startObstacles.contains(index) &&
+            isMovingAway(obstacle, p1, p2)) {
+            continue; // leaving the obstacle at the start point
+        }
+        if ((p2 == end) && endObstacles.contains(index) && isMovingAway(obstacle, p2, p1)) {
+            continue; // entering the obstacle at the end point straight
+        }
+        if (obstacle.getDistanceTo(segment) == 0) return false;
+    }
+    return true;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
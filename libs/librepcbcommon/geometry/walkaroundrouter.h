@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_WALKAROUNDROUTER_H
+#define LIBREPCB_WALKAROUNDROUTER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "../units/all_length_units.h"
+#include "boundingbox.h"
+#include "convexshape.h"
+#include "spatialindex.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Class WalkaroundRouter
+ ****************************************************************************************/
+
+/**
+ * @brief The WalkaroundRouter class searches a trace path around obstacles
+ *
+ * The obstacles are the copper shapes of other nets, each expanded by the required
+ * distance between them and the center line of the trace (half the trace width plus the
+ * clearance). The path is searched with A* on an octilinear grid which is aligned to the
+ * start point, so all segments are horizontal, vertical or diagonal. The last segment(s)
+ * from a grid node to the end point may be off-grid (like the "45° - 90°" wire mode).
+ *
+ * Bends are a bit more expensive than straight steps, so the result doesn't zig-zag, and
+ * acute angles (more than 90° direction change) are not allowed at all. The bend costs
+ * are based on the direction of the cheapest known path to a grid node, i.e. the
+ * direction is not part of the search state. This may miss a slightly better path in
+ * rare cases, but it keeps the search space eight times smaller.
+ *
+ * The search is bounded by an area and by the max. number of expanded grid nodes, so a
+ * single call returns within a few milliseconds even if there is no path at all. This is
+ * required for interactive routing where a route is searched on every mouse move.
+ *
+ * Obstacles which already contain the start or end point are kept, but the first segment
+ * may pass them as long as it moves away from them (and the last segment as long as it
+ * moves towards the end point), otherwise it would not be possible to start or end a
+ * trace close to another net. The first segment from the start point is extended over
+ * several grid steps until it has left these obstacles.
+ */
+class WalkaroundRouter final
+{
+    public:
+
+        // Constructors / Destructor
+        WalkaroundRouter() = delete;
+        WalkaroundRouter(const WalkaroundRouter& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param gridInterval  The grid interval of the path vertices (must be > 0)
+         * @param margin        The min. distance between the trace center line and any
+         *                      obstacle (i.e. half trace width + clearance)
+         */
+        WalkaroundRouter(const Length& gridInterval, const Length& margin) noexcept;
+        ~WalkaroundRouter() noexcept;
+
+        // Getters
+        int getObstacleCount() const noexcept {return mObstacles.count();}
+        int getMaxExpandedNodes() const noexcept {return mMaxExpandedNodes;}
+
+        // Setters
+        void setMaxExpandedNodes(int count) noexcept {mMaxExpandedNodes = qMax(count, 1);}
+
+        // General Methods
+
+        /**
+         * @brief Add an obstacle (the copper shape of another net)
+         */
+        void addObstacle(const ConvexShape& shape) noexcept;
+
+        /**
+         * @brief Search a path from the start point to the end point
+         *
+         * @param start     The start point of the trace
+         * @param end       The end point of the trace
+         * @param area      The area which may be used by the path (should contain all
+         *                  added obstacles in this area)
+         *
+         * @return All vertices of the path, including the start and end point and without
+         *         collinear vertices. An empty list if no path was found.
+         */
+        QVector<Point> route(const Point& start, const Point& end,
+                             const BoundingBox& area) const noexcept;
+
+        // Operator Overloadings
+        WalkaroundRouter& operator=(const WalkaroundRouter& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+        bool isFree(const Point& p1, const Point& p2, const Point& start,
+                    const QSet<int>& startObstacles, const Point& end,
+                    const QSet<int>& endObstacles) const noexcept;
+
+
+        // Attributes
+        Length mGridInterval;
+        Length mMargin;
+        int mMaxExpandedNodes;
+        QVector<ConvexShape> mObstacles;    ///< already expanded by #mMargin
+        SpatialIndex<int> mIndex;           ///< index of #mObstacles
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_WALKAROUNDROUTER_H
@@ -42,6 +42,17 @@ GraphicsItem::~GraphicsItem() noexcept
 {
 }
 
+/*****************************************************************************************
+ *  Protected Methods
+ ****************************************************************************************/
+
+bool GraphicsItem::isPrinting(const QPainter* painter) noexcept
+{
+    const QPaintDevice* device = painter ? painter->device() : nullptr;
+    if (!device) return false;
+    return (device->devType() == QInternal::Printer) || (device->devType() == QInternal::Picture);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
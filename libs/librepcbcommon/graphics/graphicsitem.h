@@ -45,6 +45,23 @@ class GraphicsItem : public QGraphicsItem
         // Constructors / Destructor
         explicit GraphicsItem() noexcept;
         virtual ~GraphicsItem() noexcept;
+
+
+    protected:
+
+        /**
+         * @brief Check whether an item is painted for a printout instead of the screen
+         *
+         * On printouts, items do not draw screen-only decorations and ignore the level
+         * of detail. Besides printers (incl. PDF files), this is also the case for
+         * pictures, since they are only recorded to be played back at a high resolution
+         * (see TiledImageRenderer).
+         *
+         * @param painter   The painter passed to QGraphicsItem::paint()
+         *
+         * @return True if the painter paints to a printer or picture
+         */
+        static bool isPrinting(const QPainter* painter) noexcept;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,252 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "tiledimagerenderer.h"
+#include "../fileio/streamingimagewriter.h"
+#include "../units/all_length_units.h"
+#include "../concurrentjobs.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+
+/*****************************************************************************************
+ *  Static Attributes
+ ****************************************************************************************/
+
+constexpr int TiledImageRenderer::sMaxImageSize;
+constexpr qint64 TiledImageRenderer::sMaxBandBytes;
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+TiledImageRenderer::TiledImageRenderer(const QPicture& picture, const QRectF& sourceRect) noexcept :
+    mPicture(picture), mSourceRect(sourceRect), mDpi(600), mBackgroundColor(Qt::white),
+    mTileSize(512), mJobCount(0)
+{
+}
+
+TiledImageRenderer::~TiledImageRenderer() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QSize TiledImageRenderer::getImageSize() const throw (Exception)
+{
+    qreal scale = qreal(mDpi) / Length::sPixelsPerInch;
+    qreal width = qMax(std::ceil(mSourceRect.width() * scale), qreal(1));
+    qreal height = qMax(std::ceil(mSourceRect.height() * scale), qreal(1));
+    if ((!(width <= sMaxImageSize)) || (!(height <= sMaxImageSize))) { // NaN too
+        throw RuntimeError(__FILE__, __LINE__, QString("%1x%2").arg(width).arg(height),
+            tr("The image is too large (max. %1 pixels wide and high), please reduce "
+               "the resolution.").arg(sMaxImageSize));
+    }
+    return QSize(int(width), int(height));
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void TiledImageRenderer::exportToFile(const FilePath& filepath) const throw (Exception)
+{
+    QSize size = getImageSize(); // can throw
+    bool alpha = (mBackgroundColor.alpha() < 255);
+    StreamingImageWriter::Format_t format = StreamingImageWriter::getFormatFromFilePath(
+                                            filepath); // can throw
+    if (format == StreamingImageWriter::Format_t::Tiff) {
+        // the tile size of TIFF files must be a multiple of 16
+        int tileSize = ((mTileSize + 15) / 16) * 16;
+        StreamingImageWriter writer(filepath, format, size, alpha, mDpi, tileSize); // can throw
+        exportTiles(writer, size, alpha); // can throw
+        writer.finish(); // can throw
+    } else {
+        StreamingImageWriter writer(filepath, format, size, alpha, mDpi); // can throw
+        exportBands(writer, size, alpha); // can throw
+        writer.finish(); // can throw
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void TiledImageRenderer::exportTiles(StreamingImageWriter& writer, const QSize& size,
+                                     bool alpha) const throw (Exception)
+{
+    int tileSize = writer.getTileSize();
+    int columns = (size.width() + tileSize - 1) / tileSize;
+    int rows = (size.height() + tileSize - 1) / tileSize;
+    int tileCount = columns * rows;
+    int jobCount = qBound(1, getJobCount(), tileCount);
+    QVector<QPicture> pictures = copyPicture(jobCount);
+
+    // every job renders one tile of a batch, while the previous batch is written
+    QVector<QImage> batches[2] = {QVector<QImage>(jobCount), QVector<QImage>(jobCount)};
+    int batchCount = (tileCount + jobCount - 1) / jobCount;
+    QScopedPointer<Exception> writeError;
+    for (int batch = 0; batch <= batchCount; ++batch) {
+        ConcurrentJobs jobs;
+        if (batch < batchCount) {
+            QImage* tiles = batches[batch % 2].data(); // detach in this thread
+            for (int job = 0; job < jobCount; ++job) {
+                int index = batch * jobCount + job;
+                if (index >= tileCount) break;
+                QRect rect((index % columns) * tileSize, (index / columns) * tileSize,
+                           tileSize, tileSize);
+                rect &= QRect(QPoint(0, 0), size);
+                QPicture* picture = &pictures[job];
+                QImage* tile = &tiles[job];
+                jobs.add([this, picture, tile, rect, alpha](){
+                    *tile = renderTile(*picture, rect, alpha);
+                });
+            }
+        }
+        if (batch > 0) {
+            const QVector<QImage>& previous = batches[(batch - 1) % 2];
+            int first = (batch - 1) * jobCount;
+            int count = qMin(jobCount, tileCount - first);
+            jobs.add([&writer, &writeError, &previous, first, count, columns](){
+                try {
+                    for (int i = 0; i < count; ++i) {
+                        const QImage& tile = previous.at(i);
+                        writer.writeTile((first + i) % columns, (first + i) / columns,
+                                         tile.constBits(), tile.bytesPerLine()); // can throw
+                    }
+                } catch (const Exception& e) {
+                    writeError.reset(e.clone());
+                }
+            });
+        }
+        jobs.run();
+        if (writeError) writeError->raise();
+    }
+}
+
+void TiledImageRenderer::exportBands(StreamingImageWriter& writer, const QSize& size,
+                                     bool alpha) const throw (Exception)
+{
+    // PNG images can only be written row by row, so the height of the bands is limited
+    // to keep the memory usage independent of the image size
+    int bytesPerPixel = writer.getBytesPerPixel();
+    qint64 bytesPerBand = sMaxBandBytes / 2;
+    int bandHeight = int(qBound(qint64(1), bytesPerBand / (qint64(size.width()) * bytesPerPixel),
+                                qint64(mTileSize)));
+    QImage::Format format = alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
+    int columns = (size.width() + mTileSize - 1) / mTileSize;
+    int jobCount = qBound(1, getJobCount(), columns);
+    QVector<QPicture> pictures = copyPicture(jobCount);
+
+    // while the tiles of one band are rendered, the previous band is written
+    QImage bands[2] = {QImage(size.width(), bandHeight, format),
+                       QImage(size.width(), bandHeight, format)};
+    if (bands[0].isNull() || bands[1].isNull()) {
+        throw RuntimeError(__FILE__, __LINE__, QString("%1x%2").arg(size.width()).arg(bandHeight),
+            tr("Not enough memory to render the image."));
+    }
+    int bandCount = (size.height() + bandHeight - 1) / bandHeight;
+    QScopedPointer<Exception> writeError;
+    for (int band = 0; band <= bandCount; ++band) {
+        ConcurrentJobs jobs;
+        if (band < bandCount) {
+            int top = band * bandHeight;
+            int height = qMin(bandHeight, size.height() - top);
+            uchar* bits = bands[band % 2].bits(); // detach in this thread
+            int bytesPerLine = bands[band % 2].bytesPerLine();
+            for (int job = 0; job < jobCount; ++job) {
+                QPicture* picture = &pictures[job];
+                jobs.add([&, job, picture, top, height, bits, bytesPerLine](){
+                    for (int column = job; column < columns; column += jobCount) {
+                        int left = column * mTileSize;
+                        QRect rect(left, top, qMin(mTileSize, size.width() - left), height);
+                        QImage tile = renderTile(*picture, rect, alpha);
+                        for (int y = 0; y < height; ++y) {
+                            memcpy(bits + (y * bytesPerLine) + (left * bytesPerPixel),
+                                   tile.constScanLine(y), rect.width() * bytesPerPixel);
+                        }
+                    }
+                });
+            }
+        }
+        if (band > 0) {
+            const QImage& previous = bands[(band - 1) % 2];
+            int height = qMin(bandHeight, size.height() - (band - 1) * bandHeight);
+            jobs.add([&writer, &writeError, &previous, height](){
+                try {
+                    for (int y = 0; y < height; ++y) {
+                        writer.writeRow(previous.constScanLine(y)); // can throw
+                    }
+                } catch (const Exception& e) {
+                    writeError.reset(e.clone());
+                }
+            });
+        }
+        jobs.run();
+        if (writeError) writeError->raise();
+    }
+}
+
+QVector<QPicture> TiledImageRenderer::copyPicture(int count) const noexcept
+{
+    // QPicture::play() is not reentrant, so every job gets its own deep copy
+    QVector<QPicture> pictures(count);
+    for (QPicture& picture : pictures) {
+        picture.setData(mPicture.data(), mPicture.size());
+    }
+    return pictures;
+}
+
+int TiledImageRenderer::getJobCount() const noexcept
+{
+    return (mJobCount > 0) ? mJobCount : QThread::idealThreadCount();
+}
+
+QImage TiledImageRenderer::renderTile(QPicture& picture, const QRect& rect, bool alpha) const noexcept
+{
+    QImage tile(rect.size(), QImage::Format_ARGB32_Premultiplied);
+    tile.fill(mBackgroundColor);
+    {
+        QPainter painter(&tile);
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                               QPainter::SmoothPixmapTransform);
+        qreal scale = qreal(mDpi) / Length::sPixelsPerInch;
+        painter.translate(-rect.topLeft());
+        painter.scale(scale, scale);
+        painter.translate(-mSourceRect.topLeft());
+        painter.drawPicture(0, 0, picture);
+    }
+    return tile.convertToFormat(alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
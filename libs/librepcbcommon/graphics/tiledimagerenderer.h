@@ -0,0 +1,147 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_TILEDIMAGERENDERER_H
+#define LIBREPCB_TILEDIMAGERENDERER_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include "../exceptions.h"
+#include "../fileio/filepath.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class StreamingImageWriter;
+
+/*****************************************************************************************
+ *  Class TiledImageRenderer
+ ****************************************************************************************/
+
+/**
+ * @brief The TiledImageRenderer class renders a QPicture into a large PNG or TIFF file
+ *
+ * Rendering a whole scene at a high resolution (e.g. a board at 2400 DPI) into a single
+ * QImage needs gigabytes of memory. Instead, the image is rendered in fixed-size tiles in
+ * parallel (see ConcurrentJobs) and streamed into a StreamingImageWriter, while the next
+ * tiles are already rendered:
+ *  - TIFF: The file is tiled, so only two batches of tiles (one tile per job) need to be
+ *    in memory, independent of the image size.
+ *  - PNG: The rows are written one after another, so the tiles are copied into bands
+ *    whose height is limited by #sMaxBandBytes. Only two bands need to be in memory,
+ *    independent of the height of the image.
+ *
+ * The picture must be recorded in scene coordinates (72 DPI, see Length::toPx()), e.g.
+ * by rendering a QGraphicsScene into it. The graphics scene itself cannot be rendered by
+ * several threads at the same time, but every job can play back its own copy of the
+ * picture.
+ */
+class TiledImageRenderer final
+{
+        Q_DECLARE_TR_FUNCTIONS(TiledImageRenderer)
+
+    public:
+
+        // Constructors / Destructor
+        TiledImageRenderer() = delete;
+        TiledImageRenderer(const TiledImageRenderer& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param picture       The recorded scene
+         * @param sourceRect    The area of the picture to render (scene coordinates)
+         */
+        TiledImageRenderer(const QPicture& picture, const QRectF& sourceRect) noexcept;
+        ~TiledImageRenderer() noexcept;
+
+        // Getters
+        int getDpi() const noexcept {return mDpi;}
+        const QColor& getBackgroundColor() const noexcept {return mBackgroundColor;}
+
+        /**
+         * @brief Get the size of the image in pixels
+         *
+         * @throw Exception if the image is too large (see #sMaxImageSize)
+         */
+        QSize getImageSize() const throw (Exception);
+
+        // Setters
+        void setDpi(int dpi) noexcept {mDpi = dpi;}
+
+        /// A transparent color adds an alpha channel to the image
+        void setBackgroundColor(const QColor& color) noexcept {mBackgroundColor = color;}
+
+        /// The width and height of the tiles in pixels (TIFF: rounded up to a multiple of 16)
+        void setTileSize(int size) noexcept {mTileSize = qBound(1, size, 4096);}
+
+        /// The number of parallel jobs (0 = QThread::idealThreadCount())
+        void setJobCount(int count) noexcept {mJobCount = qMax(count, 0);}
+
+        // General Methods
+
+        /**
+         * @brief Render the picture and write the image file
+         *
+         * @param filepath  The PNG or TIFF file to write (the format depends on the suffix)
+         *
+         * @throw Exception on error (e.g. unsupported format or write errors)
+         */
+        void exportToFile(const FilePath& filepath) const throw (Exception);
+
+        // Operator Overloadings
+        TiledImageRenderer& operator=(const TiledImageRenderer& rhs) = delete;
+
+        // Static Attributes
+        static constexpr int sMaxImageSize = 1 << 20;               ///< max. width and height
+        static constexpr qint64 sMaxBandBytes = 64 * 1024 * 1024;   ///< PNG: both bands
+
+
+    private:
+
+        // Private Methods
+        void exportTiles(StreamingImageWriter& writer, const QSize& size, bool alpha) const throw (Exception);
+        void exportBands(StreamingImageWriter& writer, const QSize& size, bool alpha) const throw (Exception);
+        QImage renderTile(QPicture& picture, const QRect& rect, bool alpha) const noexcept;
+        QVector<QPicture> copyPicture(int count) const noexcept;
+        int getJobCount() const noexcept;
+
+
+        // Attributes
+        QPicture mPicture;
+        QRectF mSourceRect;
+        int mDpi;
+        QColor mBackgroundColor;
+        int mTileSize;
+        int mJobCount;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace librepcb
+
+#endif // LIBREPCB_TILEDIMAGERENDERER_H
@@ -42,11 +42,13 @@ HEADERS += \
     fileio/smartfile.h \
     fileio/smarttextfile.h \
     fileio/smartxmlfile.h \
+    fileio/streamingimagewriter.h \
     fileio/xmldomdocument.h \
     fileio/xmldomelement.h \
     graphics/graphicsitem.h \
     graphics/graphicsscene.h \
     graphics/graphicsview.h \
+    graphics/tiledimagerenderer.h \
     graphics/if_graphicsvieweventhandler.h \
     units/all_length_units.h \
     units/angle.h \
@@ -80,8 +82,22 @@ HEADERS += \
     cam/gerbergenerator.h \
     cam/gerberaperturelist.h \
     cam/excellongenerator.h \
+    cam/drillpathoptimizer.h \
+    cam/polylinebuilder.h \
+    cam/gerberprimitivelist.h \
+    cam/camoutputcache.h \
     fileio/smartversionfile.h \
-    fileio/fileutils.h
+    fileio/fileutils.h \
+    geometry/spatialindex.h \
+    geometry/boundingbox.h \
+    geometry/hittest.h \
+    geometry/ratsnestbuilder.h \
+    geometry/convexshape.h \
+    geometry/polygonclipper.h \
+    geometry/walkaroundrouter.h \
+    geometry/gridrouter.h \
+    concurrentjobs.h \
+    disjointset.h
 
 SOURCES += \
     attributes/attributetype.cpp \
@@ -98,11 +114,13 @@ SOURCES += \
     fileio/smartfile.cpp \
     fileio/smarttextfile.cpp \
     fileio/smartxmlfile.cpp \
+    fileio/streamingimagewriter.cpp \
     fileio/xmldomdocument.cpp \
     fileio/xmldomelement.cpp \
     graphics/graphicsitem.cpp \
     graphics/graphicsscene.cpp \
     graphics/graphicsview.cpp \
+    graphics/tiledimagerenderer.cpp \
     units/angle.cpp \
     units/length.cpp \
     units/lengthunit.cpp \
@@ -130,8 +148,18 @@ SOURCES += \
     cam/gerbergenerator.cpp \
     cam/gerberaperturelist.cpp \
     cam/excellongenerator.cpp \
+    cam/drillpathoptimizer.cpp \
+    cam/polylinebuilder.cpp \
+    cam/gerberprimitivelist.cpp \
+    cam/camoutputcache.cpp \
     fileio/smartversionfile.cpp \
-    fileio/fileutils.cpp
+    fileio/fileutils.cpp \
+    geometry/hittest.cpp \
+    geometry/ratsnestbuilder.cpp \
+    geometry/convexshape.cpp \
+    geometry/polygonclipper.cpp \
+    geometry/walkaroundrouter.cpp \
+    geometry/gridrouter.cpp
 
 FORMS += \
     dialogs/gridsettingsdialog.ui \
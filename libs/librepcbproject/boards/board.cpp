@@ -27,6 +27,7 @@
 #include <librepcbcommon/fileio/xmldomdocument.h>
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include <librepcbcommon/scopeguardlist.h>
+#include <librepcbcommon/geometry/spatialindex.h>
 #include <librepcbcommon/boarddesignrules.h>
 #include <librepcbcommon/boardlayer.h>
 #include "../project.h"
@@ -45,6 +46,12 @@
 #include <librepcblibrary/cmp/component.h>
 #include "items/bi_polygon.h"
 #include "boardlayerstack.h"
+#include "boardconnectivity.h"
+#include "boardratsnest.h"
+#include "boardonlinedrc.h"
+#include "boardcopperzones.h"
+#include "boardnetstatistics.h"
+#include "boardpanel.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -58,11 +65,19 @@ namespace project {
 
 Board::Board(const Board& other, const FilePath& filepath, const QString& name) throw (Exception) :
     QObject(&other.getProject()), mProject(other.getProject()), mFilePath(filepath),
-    mIsAddedToProject(false)
+    mIsAddedToProject(false),
+    mSpatialIndex(new SpatialIndex<BI_Base*>(Length(5080000))), // 2 x 2.54mm cells
+    mAreaSelectionValid(false), mNextItemSerial(1), mNetPointListValid(false),
+    mNetLineListValid(false)
 {
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mConnectivity.reset(new BoardConnectivity(*this));
+        mRatsnest.reset(new BoardRatsnest(*this));
+        mOnlineDrc.reset(new BoardOnlineDrc(*this));
+        mCopperZones.reset(new BoardCopperZones(*this));
+        mNetStatistics.reset(new BoardNetStatistics(*this));
 
         // copy the other board
         mXmlFile.reset(SmartXmlFile::create(mFilePath));
@@ -80,6 +95,9 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
         // copy design rules
         mDesignRules.reset(new BoardDesignRules(*other.mDesignRules));
 
+        // copy panel
+        mPanel.reset(new BoardPanel(*other.mPanel));
+
         // copy device instances
         QHash<const BI_Device*, BI_Device*> copiedDeviceInstances;
         foreach (const BI_Device* device, other.mDeviceInstances) {
@@ -112,7 +130,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             BI_Via* via = copiedVias.value(netpoint->getVia(), nullptr);
             BI_NetPoint* copy = new BI_NetPoint(*this, *netpoint, pad, via);
             Q_ASSERT(!getNetPointByUuid(copy->getUuid()));
-            mNetPoints.append(copy);
+            mNetPoints.insert(getItemSerial(copy->getUuid()), copy);
             copiedNetPoints.insert(netpoint, copy);
         }
 
@@ -123,7 +141,7 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
             Q_ASSERT(start && end);
             BI_NetLine* copy = new BI_NetLine(*this, *netline, *start, *end);
             Q_ASSERT(!getNetLineByUuid(copy->getUuid()));
-            mNetLines.append(copy);
+            mNetLines.insert(getItemSerial(copy->getUuid()), copy);
         }
 
         // copy polygons
@@ -150,11 +168,18 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
         qDeleteAll(mNetPoints);         mNetPoints.clear();
+        mItemSerials.clear();
         qDeleteAll(mVias);              mVias.clear();
         qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
+        mPanel.reset();
         mDesignRules.reset();
         mGridProperties.reset();
         mLayerStack.reset();
+        mNetStatistics.reset();
+        mCopperZones.reset();
+        mOnlineDrc.reset();
+        mRatsnest.reset();
+        mConnectivity.reset();
         mXmlFile.reset();
         mGraphicsScene.reset();
         throw; // ...and rethrow the exception
@@ -163,11 +188,19 @@ Board::Board(const Board& other, const FilePath& filepath, const QString& name)
 
 Board::Board(Project& project, const FilePath& filepath, bool restore,
              bool readOnly, bool create, const QString& newName) throw (Exception) :
-    QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false)
+    QObject(&project), mProject(project), mFilePath(filepath), mIsAddedToProject(false),
+    mSpatialIndex(new SpatialIndex<BI_Base*>(Length(5080000))), // 2 x 2.54mm cells
+    mAreaSelectionValid(false), mNextItemSerial(1), mNetPointListValid(false),
+    mNetLineListValid(false)
 {
     try
     {
         mGraphicsScene.reset(new GraphicsScene());
+        mConnectivity.reset(new BoardConnectivity(*this));
+        mRatsnest.reset(new BoardRatsnest(*this));
+        mOnlineDrc.reset(new BoardOnlineDrc(*this));
+        mCopperZones.reset(new BoardCopperZones(*this));
+        mNetStatistics.reset(new BoardNetStatistics(*this));
 
         // try to open/create the XML board file
         if (create)
@@ -186,6 +219,9 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
 
             // load default design rules
             mDesignRules.reset(new BoardDesignRules());
+
+            // load default panel (disabled)
+            mPanel.reset(new BoardPanel());
         }
         else
         {
@@ -207,6 +243,10 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
             // load design rules
             mDesignRules.reset(new BoardDesignRules(*root.getFirstChild("board_design_rules", true)));
 
+            // load panel (optional, older boards do not have a panel)
+            XmlDomElement* panel = root.getFirstChild("properties/panel", true, false);
+            mPanel.reset(panel ? new BoardPanel(*panel) : new BoardPanel());
+
             // Load all device instances
             for (XmlDomElement* node = root.getFirstChild("devices/device", true, false);
                  node; node = node->getNextSibling("device"))
@@ -243,7 +283,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                         QString(tr("There is already a netpoint with the UUID \"%1\"!"))
                         .arg(netpoint->getUuid().toStr()));
                 }
-                mNetPoints.append(netpoint);
+                mNetPoints.insert(getItemSerial(netpoint->getUuid()), netpoint);
             }
 
             // Load all netlines
@@ -256,7 +296,7 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
                         QString(tr("There is already a netline with the UUID \"%1\"!"))
                         .arg(netline->getUuid().toStr()));
                 }
-                mNetLines.append(netline);
+                mNetLines.insert(getItemSerial(netline->getUuid()), netline);
             }
 
             // Load all polygons
@@ -286,11 +326,18 @@ Board::Board(Project& project, const FilePath& filepath, bool restore,
         qDeleteAll(mPolygons);          mPolygons.clear();
         qDeleteAll(mNetLines);          mNetLines.clear();
         qDeleteAll(mNetPoints);         mNetPoints.clear();
+        mItemSerials.clear();
         qDeleteAll(mVias);              mVias.clear();
         qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
+        mPanel.reset();
         mDesignRules.reset();
         mGridProperties.reset();
         mLayerStack.reset();
+        mNetStatistics.reset();
+        mCopperZones.reset();
+        mOnlineDrc.reset();
+        mRatsnest.reset();
+        mConnectivity.reset();
         mXmlFile.reset();
         mGraphicsScene.reset();
         throw; // ...and rethrow the exception
@@ -310,9 +357,15 @@ Board::~Board() noexcept
     qDeleteAll(mVias);              mVias.clear();
     qDeleteAll(mDeviceInstances);   mDeviceInstances.clear();
 
+    mPanel.reset();
     mDesignRules.reset();
     mGridProperties.reset();
     mLayerStack.reset();
+    mNetStatistics.reset();
+    mCopperZones.reset();
+    mOnlineDrc.reset();
+    mRatsnest.reset();
+    mConnectivity.reset();
     mXmlFile.reset();
     mGraphicsScene.reset();
 }
@@ -434,49 +487,63 @@ QList<BI_Base*> Board::getSelectedItems(bool vias,
 
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 {
-    QPointF scenePosPx = pos.toPxQPointF();
-    QList<BI_Base*> list;   // Note: The order of adding the items is very important (the
-                            // top most item must appear as the first item in the list)!
-    // vias
-    foreach (BI_Via* via, mVias)
-    {
-        if (via->isSelectable() && via->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(via);
-        }
-    }
-    // netpoints
-    foreach (BI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(netpoint);
-        }
-    }
-    // netlines
-    foreach (BI_NetLine* netline, mNetLines)
-    {
-        if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(scenePosPx)) {
-            list.append(netline);
+    QList<BI_Base*> vias, netpoints, netlines;
+    QList<BI_Footprint*> footprints; // in the order of their first appearance
+    QHash<BI_Footprint*, QList<BI_FootprintPad*>> footprintPads;
+    QSet<BI_Footprint*> hitFootprints;
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        if (!item->isSelectable()) continue;
+        switch (item->getType())
+        {
+            case BI_Base::Type_t::Via:
+                vias.append(item);
+                break;
+            case BI_Base::Type_t::NetPoint:
+                netpoints.append(item);
+                break;
+            case BI_Base::Type_t::NetLine:
+                netlines.append(item);
+                break;
+            case BI_Base::Type_t::Footprint:
+            {
+                BI_Footprint* footprint = static_cast<BI_Footprint*>(item);
+                if (!footprints.contains(footprint)) footprints.append(footprint);
+                hitFootprints.insert(footprint);
+                break;
+            }
+            case BI_Base::Type_t::FootprintPad:
+            {
+                BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+                BI_Footprint* footprint = &pad->getFootprint();
+                if (!footprints.contains(footprint)) footprints.append(footprint);
+                footprintPads[footprint].append(pad);
+                break;
+            }
+            default:
+                break; // polygons can't be selected by clicking on them
         }
     }
-    // footprints & pads
-    foreach (BI_Device* device, mDeviceInstances)
+
+    QList<BI_Base*> list;   // Note: The order of adding the items is very important (the
+                            // top most item must appear as the first item in the list)!
+    list.append(vias);
+    list.append(netpoints);
+    list.append(netlines);
+    foreach (BI_Footprint* footprint, footprints)
     {
-        BI_Footprint& footprint = device->getFootprint();
-        if (footprint.isSelectable() && footprint.getGrabAreaScenePx().contains(scenePosPx)) {
-            if (footprint.getIsMirrored()) {
-                list.append(&footprint);
+        if (hitFootprints.contains(footprint)) {
+            if (footprint->getIsMirrored()) {
+                list.append(footprint);
             } else {
-                list.prepend(&footprint);
+                list.prepend(footprint);
             }
         }
-        foreach (BI_FootprintPad* pad, footprint.getPads())
+        foreach (BI_FootprintPad* pad, footprintPads.value(footprint))
         {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(scenePosPx)) {
-                if (pad->getIsMirrored()) {
-                    list.append(pad);
-                } else {
-                    list.insert(1, pad);
-                }
+            if (pad->getIsMirrored()) {
+                list.append(pad);
+            } else {
+                list.insert(1, pad);
             }
         }
     }
@@ -486,11 +553,11 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept
 QList<BI_Via*> Board::getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept
 {
     QList<BI_Via*> list;
-    foreach (BI_Via* via, mVias)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos))
     {
-        if (via->isSelectable() && via->getGrabAreaScenePx().contains(pos.toPxQPointF())
-            && ((!netsignal) || (via->getNetSignal() == netsignal)))
-        {
+        if (item->getType() != BI_Base::Type_t::Via) continue;
+        BI_Via* via = static_cast<BI_Via*>(item);
+        if (via->isSelectable() && ((!netsignal) || (via->getNetSignal() == netsignal))) {
             list.append(via);
         }
     }
@@ -501,9 +568,11 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(const Point& pos, const BoardL
                                                   const NetSignal* netsignal) const noexcept
 {
     QList<BI_NetPoint*> list;
-    foreach (BI_NetPoint* netpoint, mNetPoints)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos))
     {
-        if (netpoint->isSelectable() && netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF())
+        if (item->getType() != BI_Base::Type_t::NetPoint) continue;
+        BI_NetPoint* netpoint = static_cast<BI_NetPoint*>(item);
+        if (netpoint->isSelectable()
             && ((!layer) || (&netpoint->getLayer() == layer))
             && ((!netsignal) || (&netpoint->getNetSignal() == netsignal)))
         {
@@ -517,9 +586,11 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(const Point& pos, const BoardLay
                                                 const NetSignal* netsignal) const noexcept
 {
     QList<BI_NetLine*> list;
-    foreach (BI_NetLine* netline, mNetLines)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos))
     {
-        if (netline->isSelectable() && netline->getGrabAreaScenePx().contains(pos.toPxQPointF())
+        if (item->getType() != BI_Base::Type_t::NetLine) continue;
+        BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+        if (netline->isSelectable()
             && ((!layer) || (&netline->getLayer() == layer))
             && ((!netsignal) || (&netline->getNetSignal() == netsignal)))
         {
@@ -533,21 +604,25 @@ QList<BI_FootprintPad*> Board::getPadsAtScenePos(const Point& pos, const BoardLa
                                                  const NetSignal* netsignal) const noexcept
 {
     QList<BI_FootprintPad*> list;
-    foreach (BI_Device* device, mDeviceInstances)
+    foreach (BI_Base* item, getItemCandidatesAtScenePos(pos))
     {
-        foreach (BI_FootprintPad* pad, device->getFootprint().getPads())
+        if (item->getType() != BI_Base::Type_t::FootprintPad) continue;
+        BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+        if (pad->isSelectable()
+            && ((!layer) || (pad->isOnLayer(layer->getId())))
+            && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
         {
-            if (pad->isSelectable() && pad->getGrabAreaScenePx().contains(pos.toPxQPointF())
-                && ((!layer) || (pad->isOnLayer(layer->getId())))
-                && ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal)))
-            {
-                list.append(pad);
-            }
+            list.append(pad);
         }
     }
     return list;
 }
 
+QList<BI_Base*> Board::getItemsInArea(const BoundingBox& area) const noexcept
+{
+    return mSpatialIndex->query(area);
+}
+
 QList<BI_Base*> Board::getAllItems() const noexcept
 {
     QList<BI_Base*> items;
@@ -573,6 +648,11 @@ void Board::setGridProperties(const GridProperties& grid) noexcept
     *mGridProperties = grid;
 }
 
+void Board::setPanel(const BoardPanel& panel) noexcept
+{
+    *mPanel = panel;
+}
+
 /*****************************************************************************************
  *  DeviceInstance Methods
  ****************************************************************************************/
@@ -596,6 +676,7 @@ void Board::addDeviceInstance(BI_Device& instance) throw (Exception)
     // add to board
     instance.addToBoard(*mGraphicsScene); // can throw
     mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
+    addToSpatialIndex(instance);
     updateErcMessages();
     emit deviceAdded(instance);
 }
@@ -608,6 +689,7 @@ void Board::removeDeviceInstance(BI_Device& instance) throw (Exception)
     // remove from board
     instance.removeFromBoard(*mGraphicsScene); // can throw
     mDeviceInstances.remove(instance.getComponentInstanceUuid());
+    removeFromSpatialIndex(instance);
     updateErcMessages();
     emit deviceRemoved(instance);
 }
@@ -639,6 +721,7 @@ void Board::addVia(BI_Via& via) throw (Exception)
     // add to board
     via.addToBoard(*mGraphicsScene); // can throw
     mVias.append(&via);
+    addToSpatialIndex(via);
 }
 
 void Board::removeVia(BI_Via& via) throw (Exception)
@@ -649,24 +732,30 @@ void Board::removeVia(BI_Via& via) throw (Exception)
     // remove from board
     via.removeFromBoard(*mGraphicsScene); // can throw
     mVias.removeOne(&via);
+    removeFromSpatialIndex(via);
 }
 
 /*****************************************************************************************
  *  NetPoint Methods
  ****************************************************************************************/
 
-BI_NetPoint* Board::getNetPointByUuid(const Uuid& uuid) const noexcept
+const QList<BI_NetPoint*>& Board::getNetPoints() const noexcept
 {
-    foreach (BI_NetPoint* netpoint, mNetPoints) {
-        if (netpoint->getUuid() == uuid)
-            return netpoint;
+    if (!mNetPointListValid) {
+        mNetPointList = mNetPoints.values(); // sorted by insertion serial
+        mNetPointListValid = true;
     }
-    return nullptr;
+    return mNetPointList;
+}
+
+BI_NetPoint* Board::getNetPointByUuid(const Uuid& uuid) const noexcept
+{
+    return mNetPoints.value(mItemSerials.value(uuid, 0), nullptr);
 }
 
 void Board::addNetPoint(BI_NetPoint& netpoint) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetPoints.contains(&netpoint))
+    if ((!mIsAddedToProject) || (getNetPointByUuid(netpoint.getUuid()) == &netpoint)
         || (&netpoint.getBoard() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -679,35 +768,45 @@ void Board::addNetPoint(BI_NetPoint& netpoint) throw (Exception)
     }
     // add to board
     netpoint.addToBoard(*mGraphicsScene); // can throw
-    mNetPoints.append(&netpoint);
+    mNetPoints.insert(getItemSerial(netpoint.getUuid()), &netpoint);
+    mNetPointListValid = false;
+    addToSpatialIndex(netpoint);
 }
 
 void Board::removeNetPoint(BI_NetPoint& netpoint) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetPoints.contains(&netpoint))) {
+    if ((!mIsAddedToProject) || (getNetPointByUuid(netpoint.getUuid()) != &netpoint)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
     netpoint.removeFromBoard(*mGraphicsScene); // can throw
-    mNetPoints.removeOne(&netpoint);
+    // the serial is kept to restore the original position if the netpoint is added again
+    mNetPoints.remove(mItemSerials.value(netpoint.getUuid()));
+    mNetPointListValid = false;
+    removeFromSpatialIndex(netpoint);
 }
 
 /*****************************************************************************************
  *  NetLine Methods
  ****************************************************************************************/
 
-BI_NetLine* Board::getNetLineByUuid(const Uuid& uuid) const noexcept
+const QList<BI_NetLine*>& Board::getNetLines() const noexcept
 {
-    foreach (BI_NetLine* netline, mNetLines) {
-        if (netline->getUuid() == uuid)
-            return netline;
+    if (!mNetLineListValid) {
+        mNetLineList = mNetLines.values(); // sorted by insertion serial
+        mNetLineListValid = true;
     }
-    return nullptr;
+    return mNetLineList;
+}
+
+BI_NetLine* Board::getNetLineByUuid(const Uuid& uuid) const noexcept
+{
+    return mNetLines.value(mItemSerials.value(uuid, 0), nullptr);
 }
 
 void Board::addNetLine(BI_NetLine& netline) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (mNetLines.contains(&netline))
+    if ((!mIsAddedToProject) || (getNetLineByUuid(netline.getUuid()) == &netline)
         || (&netline.getBoard() != this))
     {
         throw LogicError(__FILE__, __LINE__);
@@ -720,17 +819,22 @@ void Board::addNetLine(BI_NetLine& netline) throw (Exception)
     }
     // add to board
     netline.addToBoard(*mGraphicsScene); // can throw
-    mNetLines.append(&netline);
+    mNetLines.insert(getItemSerial(netline.getUuid()), &netline);
+    mNetLineListValid = false;
+    addToSpatialIndex(netline);
 }
 
 void Board::removeNetLine(BI_NetLine& netline) throw (Exception)
 {
-    if ((!mIsAddedToProject) || (!mNetLines.contains(&netline))) {
+    if ((!mIsAddedToProject) || (getNetLineByUuid(netline.getUuid()) != &netline)) {
         throw LogicError(__FILE__, __LINE__);
     }
     // remove from board
     netline.removeFromBoard(*mGraphicsScene); // can throw
-    mNetLines.removeOne(&netline);
+    // the serial is kept to restore the original position if the netline is added again
+    mNetLines.remove(mItemSerials.value(netline.getUuid()));
+    mNetLineListValid = false;
+    removeFromSpatialIndex(netline);
 }
 
 /*****************************************************************************************
@@ -746,6 +850,7 @@ void Board::addPolygon(BI_Polygon& polygon) throw (Exception)
     }
     polygon.addToBoard(*mGraphicsScene); // can throw
     mPolygons.append(&polygon);
+    addToSpatialIndex(polygon);
 }
 
 void Board::removePolygon(BI_Polygon& polygon) throw (Exception)
@@ -755,6 +860,7 @@ void Board::removePolygon(BI_Polygon& polygon) throw (Exception)
     }
     polygon.removeFromBoard(*mGraphicsScene); // can throw
     mPolygons.removeOne(&polygon);
+    removeFromSpatialIndex(polygon);
 }
 
 /*****************************************************************************************
@@ -773,6 +879,12 @@ void Board::addToProject() throw (Exception)
         item->addToBoard(*mGraphicsScene); // can throw
         sgl.add([this, item](){item->removeFromBoard(*mGraphicsScene);});
     }
+    foreach (BI_Base* item, items) {
+        addToSpatialIndex(*item);
+    }
+    mRatsnest->addToBoard(*mGraphicsScene);
+    mOnlineDrc->addToBoard();
+    mCopperZones->addToBoard();
     mIsAddedToProject = true;
     updateErcMessages();
     sgl.dismiss();
@@ -790,6 +902,14 @@ void Board::removeFromProject() throw (Exception)
         item->removeFromBoard(*mGraphicsScene); // can throw
         sgl.add([this, item](){item->addToBoard(*mGraphicsScene);});
     }
+    mSpatialIndex->clear();
+    mAreaSelection.clear();
+    mAreaSelectionValid = false;
+    mCopperZones->removeFromBoard();
+    mOnlineDrc->removeFromBoard();
+    mRatsnest->removeFromBoard(*mGraphicsScene);
+    mConnectivity->invalidateAll();
+    mNetStatistics->clear();
     mIsAddedToProject = false;
     updateErcMessages();
     sgl.dismiss();
@@ -829,27 +949,69 @@ void Board::showInView(GraphicsView& view) noexcept
 void Board::setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept
 {
     mGraphicsScene->setSelectionRect(p1, p2);
-    if (updateItems)
+    if (!updateItems) {
+        // the selection rectangle is finished, other selection changes may follow
+        mAreaSelection.clear();
+        mAreaSelectionValid = false;
+        return;
+    }
+
+    // determine the new selection (the spatial index only compares bounding boxes)
+    BoundingBox rect(p1, p2);
+    QRectF rectPx = rect.toPxQRectF();
+    QSet<BI_Base*> selection;
+    foreach (BI_Base* item, mSpatialIndex->query(rect))
     {
-        QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-        foreach (BI_Device* component, mDeviceInstances)
+        if ((!item->isSelectable()) || (item->getType() == BI_Base::Type_t::Polygon)) {
+            continue;
+        }
+        if (rect.contains(item->getBoundingBox()) ||
+            item->getGrabAreaScenePx().intersects(rectPx))
         {
-            BI_Footprint& footprint = component->getFootprint();
-            bool selectFootprint = footprint.isSelectable() && footprint.getGrabAreaScenePx().intersects(rectPx);
-            footprint.setSelected(selectFootprint);
-            foreach (BI_FootprintPad* pad, footprint.getPads())
-            {
-                bool selectPad = pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-                pad->setSelected(selectFootprint || selectPad);
+            selection.insert(item);
+            if (item->getType() == BI_Base::Type_t::Footprint) {
+                foreach (BI_FootprintPad* pad, static_cast<BI_Footprint*>(item)->getPads())
+                    selection.insert(pad);
+            }
+        }
+    }
+
+    // the first time, all selected items need to be determined (e.g. to deselect items
+    // which were selected before the selection rectangle was started)
+    if (!mAreaSelectionValid) {
+        mAreaSelection.clear();
+        foreach (BI_Device* device, mDeviceInstances) {
+            BI_Footprint& footprint = device->getFootprint();
+            if (footprint.isSelected()) mAreaSelection.insert(&footprint);
+            foreach (BI_FootprintPad* pad, footprint.getPads()) {
+                if (pad->isSelected()) mAreaSelection.insert(pad);
             }
         }
         foreach (BI_Via* via, mVias)
-            via->setSelected(via->isSelectable() && via->getGrabAreaScenePx().intersects(rectPx));
+            if (via->isSelected()) mAreaSelection.insert(via);
         foreach (BI_NetPoint* netpoint, mNetPoints)
-            netpoint->setSelected(netpoint->isSelectable() && netpoint->getGrabAreaScenePx().intersects(rectPx));
+            if (netpoint->isSelected()) mAreaSelection.insert(netpoint);
         foreach (BI_NetLine* netline, mNetLines)
-            netline->setSelected(netline->isSelectable() && netline->getGrabAreaScenePx().intersects(rectPx));
+            if (netline->isSelected()) mAreaSelection.insert(netline);
+        mAreaSelectionValid = true;
     }
+
+    // apply only the differences and repaint the scene once for all of them
+    bool changed = false;
+    foreach (BI_Base* item, mAreaSelection) {
+        if (!selection.contains(item)) {
+            item->setSelectedWithoutRepaint(false);
+            changed = true;
+        }
+    }
+    foreach (BI_Base* item, selection) {
+        if (!item->isSelected()) {
+            item->setSelectedWithoutRepaint(true);
+            changed = true;
+        }
+    }
+    mAreaSelection = selection;
+    if (changed) mGraphicsScene->update();
 }
 
 void Board::clearSelection() const noexcept
@@ -864,6 +1026,39 @@ void Board::clearSelection() const noexcept
         netline->setSelected(false);
 }
 
+QRectF Board::getPrintRect() const noexcept
+{
+    return mGraphicsScene->itemsBoundingRect();
+}
+
+void Board::renderToQPainter(QPainter& painter, const QRectF& rect) const noexcept
+{
+    mGraphicsScene->render(&painter, rect, rect, Qt::IgnoreAspectRatio);
+}
+
+int Board::runDesignRuleCheck() noexcept
+{
+    return mOnlineDrc->checkAll();
+}
+
+void Board::updateSpatialIndex(BI_Base& item) noexcept
+{
+    if (mSpatialIndex->contains(&item)) {
+        mSpatialIndex->insert(&item, item.getBoundingBox());
+        mConnectivity->invalidate(item);
+        mOnlineDrc->itemModified(item);
+        mCopperZones->itemModified(item);
+        mNetStatistics->itemModified(item);
+    }
+}
+
+void Board::itemNetSignalChanged(BI_Base& item) noexcept
+{
+    mOnlineDrc->itemModified(item);
+    mCopperZones->itemModified(item);
+    mNetStatistics->itemModified(item);
+}
+
 /*****************************************************************************************
  *  Helper Methods
  ****************************************************************************************/
@@ -895,6 +1090,65 @@ void Board::updateIcon() noexcept
     mIcon = QIcon(pixmap);
 }
 
+void Board::addToSpatialIndex(BI_Base& item) noexcept
+{
+    if (item.getType() == BI_Base::Type_t::Device) {
+        // devices are represented by their footprint and pads in the board
+        BI_Footprint& footprint = static_cast<BI_Device&>(item).getFootprint();
+        mSpatialIndex->insert(&footprint, footprint.getBoundingBox());
+        foreach (BI_FootprintPad* pad, footprint.getPads()) {
+            mSpatialIndex->insert(pad, pad->getBoundingBox());
+        }
+    } else {
+        mSpatialIndex->insert(&item, item.getBoundingBox());
+    }
+    mConnectivity->invalidate(item);
+    mOnlineDrc->itemModified(item);
+    mCopperZones->itemModified(item);
+    mNetStatistics->itemModified(item);
+}
+
+void Board::removeFromSpatialIndex(BI_Base& item) noexcept
+{
+    if (item.getType() == BI_Base::Type_t::Device) {
+        BI_Footprint& footprint = static_cast<BI_Device&>(item).getFootprint();
+        mSpatialIndex->remove(&footprint);
+        mAreaSelection.remove(&footprint);
+        foreach (BI_FootprintPad* pad, footprint.getPads()) {
+            mSpatialIndex->remove(pad);
+            mAreaSelection.remove(pad);
+        }
+    } else {
+        mSpatialIndex->remove(&item);
+        mAreaSelection.remove(&item);
+    }
+    mConnectivity->invalidate(item);
+    mOnlineDrc->itemRemoved(item);
+    mCopperZones->itemRemoved(item);
+    mNetStatistics->itemRemoved(item);
+}
+
+QList<BI_Base*> Board::getItemCandidatesAtScenePos(const Point& pos) const noexcept
+{
+    // the spatial index only compares bounding boxes, so check the exact shapes too
+    QList<BI_Base*> list;
+    foreach (BI_Base* item, mSpatialIndex->query(pos)) {
+        if (item->isAtScenePos(pos))
+            list.append(item);
+    }
+    return list;
+}
+
+quint64 Board::getItemSerial(const Uuid& uuid) noexcept
+{
+    quint64 serial = mItemSerials.value(uuid, 0);
+    if (serial == 0) {
+        serial = mNextItemSerial++;
+        mItemSerials.insert(uuid, serial);
+    }
+    return serial;
+}
+
 bool Board::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())     return false;
@@ -914,6 +1168,7 @@ XmlDomElement* Board::serializeToXmlDomElement() const throw (Exception)
     // properties: grid
     XmlDomElement* properties = root->appendChild("properties");
     properties->appendChild(mGridProperties->serializeToXmlDomElement());
+    if (mPanel->isEnabled()) properties->appendChild(mPanel->serializeToXmlDomElement());
     // layer stack
     root->appendChild(mLayerStack->serializeToXmlDomElement());
     // design rules
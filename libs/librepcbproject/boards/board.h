@@ -44,6 +44,8 @@ class GraphicsScene;
 class SmartXmlFile;
 class BoardLayer;
 class BoardDesignRules;
+class BoundingBox;
+template <typename T> class SpatialIndex;
 
 namespace project {
 
@@ -57,6 +59,12 @@ class BI_NetPoint;
 class BI_NetLine;
 class BI_Polygon;
 class BoardLayerStack;
+class BoardConnectivity;
+class BoardRatsnest;
+class BoardOnlineDrc;
+class BoardCopperZones;
+class BoardNetStatistics;
+class BoardPanel;
 
 /*****************************************************************************************
  *  Class Board
@@ -93,6 +101,7 @@ class Board final : public QObject, public IF_AttributeProvider,
             ZValue_FootprintPadsTop,    ///< Z value for #project#BI_FootprintPad items
             ZValue_FootprintsTop,       ///< Z value for #project#BI_Footprint items
             ZValue_Vias,                ///< Z value for #project#BI_Via items
+            ZValue_AirWires,            ///< Z value for #project#BGI_AirWires items
         };
 
         // Constructors / Destructor
@@ -107,9 +116,15 @@ class Board final : public QObject, public IF_AttributeProvider,
         Project& getProject() const noexcept {return mProject;}
         const FilePath& getFilePath() const noexcept {return mFilePath;}
         const GridProperties& getGridProperties() const noexcept {return *mGridProperties;}
+        const BoardPanel& getPanel() const noexcept {return *mPanel;}
         BoardLayerStack& getLayerStack() noexcept {return *mLayerStack;}
         BoardDesignRules& getDesignRules() noexcept {return *mDesignRules;}
         const BoardDesignRules& getDesignRules() const noexcept {return *mDesignRules;}
+        BoardConnectivity& getConnectivity() const noexcept {return *mConnectivity;}
+        BoardRatsnest& getRatsnest() const noexcept {return *mRatsnest;}
+        BoardOnlineDrc& getOnlineDrc() const noexcept {return *mOnlineDrc;}
+        BoardCopperZones& getCopperZones() const noexcept {return *mCopperZones;}
+        BoardNetStatistics& getNetStatistics() const noexcept {return *mNetStatistics;}
         bool isEmpty() const noexcept;
         QList<BI_Base*> getSelectedItems(bool vias,
                                          bool footprintPads,
@@ -124,6 +139,14 @@ class Board final : public QObject, public IF_AttributeProvider,
                                          bool attachedLines,
                                          bool attachedLinesFromFootprints) const noexcept;
         QList<BI_Base*> getItemsAtScenePos(const Point& pos) const noexcept;
+
+        /**
+         * @brief Get all items whose bounding box intersects an area
+         *
+         * Devices are represented by their footprint and pads. The result is empty as
+         * long as the board is not added to the project.
+         */
+        QList<BI_Base*> getItemsInArea(const BoundingBox& area) const noexcept;
         QList<BI_Via*> getViasAtScenePos(const Point& pos, const NetSignal* netsignal) const noexcept;
         QList<BI_NetPoint*> getNetPointsAtScenePos(const Point& pos, const BoardLayer* layer,
                                                    const NetSignal* netsignal) const noexcept;
@@ -135,6 +158,7 @@ class Board final : public QObject, public IF_AttributeProvider,
 
         // Setters: General
         void setGridProperties(const GridProperties& grid) noexcept;
+        void setPanel(const BoardPanel& panel) noexcept;
 
         // Getters: Attributes
         const Uuid& getUuid() const noexcept {return mUuid;}
@@ -154,12 +178,13 @@ class Board final : public QObject, public IF_AttributeProvider,
         void removeVia(BI_Via& via) throw (Exception);
 
         // NetPoint Methods
+        const QList<BI_NetPoint*>& getNetPoints() const noexcept;
         BI_NetPoint* getNetPointByUuid(const Uuid& uuid) const noexcept;
         void addNetPoint(BI_NetPoint& netpoint) throw (Exception);
         void removeNetPoint(BI_NetPoint& netpoint) throw (Exception);
 
         // NetLine Methods
-        const QList<BI_NetLine*>& getNetLines() const noexcept {return mNetLines;}
+        const QList<BI_NetLine*>& getNetLines() const noexcept;
         BI_NetLine* getNetLineByUuid(const Uuid& uuid) const noexcept;
         void addNetLine(BI_NetLine& netline) throw (Exception);
         void removeNetLine(BI_NetLine& netline) throw (Exception);
@@ -179,6 +204,52 @@ class Board final : public QObject, public IF_AttributeProvider,
         void setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept;
         void clearSelection() const noexcept;
 
+        /**
+         * @brief Get the area of the scene which is exported (the bounding rect of all items)
+         */
+        QRectF getPrintRect() const noexcept;
+
+        /**
+         * @brief Render an area of the scene without scaling (in scene coordinates)
+         *
+         * @note Only the items on visible layers are rendered, with the layer colors.
+         *
+         * @param painter   The painter to render to
+         * @param rect      The area to render (see #getPrintRect())
+         */
+        void renderToQPainter(QPainter& painter, const QRectF& rect) const noexcept;
+
+        /**
+         * @brief Update the spatial index after the grab area of an item has changed
+         *
+         * This method is called by BI_Base::grabAreaChanged() whenever the position,
+         * rotation or shape of an item has changed. Items which are not added to the
+         * board are ignored. The connectivity of the affected nets is invalidated too.
+         *
+         * @param item  The item which has changed
+         */
+        void updateSpatialIndex(BI_Base& item) noexcept;
+
+        /**
+         * @brief Notify the board that the net signal of an item has changed
+         *
+         * The position of the item is unchanged, but its clearances and the copper zones
+         * around it depend on the net signal.
+         *
+         * @param item  The item which has changed
+         */
+        void itemNetSignalChanged(BI_Base& item) noexcept;
+
+        /**
+         * @brief Run the design rule check (DRC) for the whole board immediately
+         *
+         * The violations are shown as ERC messages, and are kept up to date by the online
+         * DRC afterwards. See #BoardDesignRuleCheck for details about the checked rules.
+         *
+         * @return The number of violations
+         */
+        int runDesignRuleCheck() noexcept;
+
         // Helper Methods
         bool getAttributeValue(const QString& attrNS, const QString& attrKey,
                                bool passToParents, QString& value) const noexcept;
@@ -207,6 +278,10 @@ class Board final : public QObject, public IF_AttributeProvider,
         Board(Project& project, const FilePath& filepath, bool restore,
               bool readOnly, bool create, const QString& newName) throw (Exception);
         void updateIcon() noexcept;
+        void addToSpatialIndex(BI_Base& item) noexcept;
+        void removeFromSpatialIndex(BI_Base& item) noexcept;
+        QList<BI_Base*> getItemCandidatesAtScenePos(const Point& pos) const noexcept;
+        quint64 getItemSerial(const Uuid& uuid) noexcept;
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
@@ -227,8 +302,24 @@ class Board final : public QObject, public IF_AttributeProvider,
         QScopedPointer<BoardLayerStack> mLayerStack;
         QScopedPointer<GridProperties> mGridProperties;
         QScopedPointer<BoardDesignRules> mDesignRules;
+        QScopedPointer<BoardPanel> mPanel;
+        QScopedPointer<BoardConnectivity> mConnectivity;
+        QScopedPointer<BoardRatsnest> mRatsnest;
+        QScopedPointer<BoardOnlineDrc> mOnlineDrc;
+        QScopedPointer<BoardCopperZones> mCopperZones;
+        QScopedPointer<BoardNetStatistics> mNetStatistics;
         QRectF mViewRect;
 
+        /// Index over the grab areas of all items (footprints and pads instead of
+        /// devices) which are added to the board, used to speed up all "AtScenePos"
+        /// methods and the area selection
+        QScopedPointer<SpatialIndex<BI_Base*>> mSpatialIndex;
+
+        /// The items selected by the current selection rectangle, used to apply only the
+        /// differences on every change of the rectangle (see #setSelectionRect())
+        QSet<BI_Base*> mAreaSelection;
+        bool mAreaSelectionValid;
+
         // Attributes
         Uuid mUuid;
         QString mName;
@@ -237,10 +328,21 @@ class Board final : public QObject, public IF_AttributeProvider,
         // items
         QMap<Uuid, BI_Device*> mDeviceInstances;
         QList<BI_Via*> mVias;
-        QList<BI_NetPoint*> mNetPoints;
-        QList<BI_NetLine*> mNetLines;
+        QMap<quint64, BI_NetPoint*> mNetPoints; ///< key: serial from #mItemSerials
+        QMap<quint64, BI_NetLine*> mNetLines;   ///< key: serial from #mItemSerials
         QList<BI_Polygon*> mPolygons;
 
+        /// Insertion serials of netpoints and netlines, which define their order in the
+        /// lists (and thus in the board file and the CAM output) while keeping lookups and
+        /// removals cheap on big boards. Serials are kept after removing an item, so an
+        /// undone removal puts the item back to its original position.
+        QHash<Uuid, quint64> mItemSerials;
+        quint64 mNextItemSerial;
+        mutable QList<BI_NetPoint*> mNetPointList;  ///< cache for #getNetPoints()
+        mutable QList<BI_NetLine*> mNetLineList;    ///< cache for #getNetLines()
+        mutable bool mNetPointListValid;
+        mutable bool mNetLineListValid;
+
         // ERC messages
         QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
 };
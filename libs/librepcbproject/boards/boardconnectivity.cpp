@@ -0,0 +1,274 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/disjointset.h>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/geometry/boundingbox.h>
+#include "boardconnectivity.h"
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentsignalinstance.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardConnectivity::BoardConnectivity(Board& board) noexcept :
+    QObject(&board), mBoard(board)
+{
+    // the cache must not contain dangling pointers to removed net signals
+    connect(&mBoard.getProject().getCircuit(), &Circuit::netSignalRemoved,
+            this, [this](NetSignal& netsignal){invalidate(&netsignal);});
+}
+
+BoardConnectivity::~BoardConnectivity() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+const QList<BoardConnectivity::Island_t>& BoardConnectivity::getIslands(
+        const NetSignal& netsignal) const noexcept
+{
+    return getNetIslands(netsignal).islands;
+}
+
+bool BoardConnectivity::isFullyRouted(const NetSignal& netsignal) const noexcept
+{
+    const NetIslands_t& net = getNetIslands(netsignal);
+    // islands with pads come first, so only the second island needs to be checked
+    return (net.islands.count() < 2) || (net.islands.at(1).pads.isEmpty());
+}
+
+bool BoardConnectivity::areConnected(const BI_FootprintPad& pad1,
+                                     const BI_FootprintPad& pad2) const noexcept
+{
+    if (&pad1 == &pad2) return true;
+    const NetSignal* netsignal = pad1.getCompSigInstNetSignal();
+    if ((!netsignal) || (pad2.getCompSigInstNetSignal() != netsignal)) return false;
+    const NetIslands_t& net = getNetIslands(*netsignal);
+    int island1 = net.islandOfItem.value(&pad1, -1);
+    int island2 = net.islandOfItem.value(&pad2, -1);
+    return (island1 >= 0) && (island1 == island2);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardConnectivity::invalidate(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::NetPoint:
+            invalidate(&static_cast<const BI_NetPoint&>(item).getNetSignal());
+            break;
+        case BI_Base::Type_t::NetLine:
+            invalidate(&static_cast<const BI_NetLine&>(item).getNetSignal());
+            break;
+        case BI_Base::Type_t::Via:
+            invalidate(static_cast<const BI_Via&>(item).getNetSignal());
+            break;
+        case BI_Base::Type_t::FootprintPad:
+            invalidate(static_cast<const BI_FootprintPad&>(item).getCompSigInstNetSignal());
+            break;
+        case BI_Base::Type_t::Footprint:
+            foreach (const BI_FootprintPad* pad, static_cast<const BI_Footprint&>(item).getPads())
+                invalidate(*pad);
+            break;
+        case BI_Base::Type_t::Device:
+            invalidate(static_cast<const BI_Device&>(item).getFootprint());
+            break;
+        default:
+            break; // other items are not relevant for the connectivity
+    }
+}
+
+void BoardConnectivity::invalidate(const NetSignal* netsignal) noexcept
+{
+    if (netsignal) {
+        // always notify, even if the islands were not cached (e.g. not queried yet)
+        mCache.remove(netsignal);
+        emit netSignalInvalidated(netsignal);
+    }
+}
+
+void BoardConnectivity::invalidateAll() noexcept
+{
+    QList<const NetSignal*> netsignals = mCache.keys();
+    mCache.clear();
+    foreach (const NetSignal* netsignal, netsignals) {
+        emit netSignalInvalidated(netsignal);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+const BoardConnectivity::NetIslands_t& BoardConnectivity::getNetIslands(
+        const NetSignal& netsignal) const noexcept
+{
+    QList<BI_FootprintPad*> pads = getPadsOfNetSignal(netsignal);
+    auto it = mCache.find(&netsignal);
+    if ((it == mCache.end()) || (it->pads != pads)) {
+        it = mCache.insert(&netsignal, calcNetIslands(netsignal, pads));
+    }
+    return it.value();
+}
+
+QList<BI_FootprintPad*> BoardConnectivity::getPadsOfNetSignal(
+        const NetSignal& netsignal) const noexcept
+{
+    QList<BI_FootprintPad*> pads;
+    foreach (const ComponentSignalInstance* signal, netsignal.getComponentSignals()) {
+        foreach (BI_FootprintPad* pad, signal->getRegisteredFootprintPads()) {
+            if (&pad->getBoard() == &mBoard) pads.append(pad);
+        }
+    }
+    return pads;
+}
+
+BoardConnectivity::NetIslands_t BoardConnectivity::calcNetIslands(
+        const NetSignal& netsignal, const QList<BI_FootprintPad*>& pads) const noexcept
+{
+    // collect all items of the net signal on this board
+    QList<BI_Via*> vias;
+    foreach (BI_Via* via, netsignal.getBoardVias()) {
+        if (&via->getBoard() == &mBoard) vias.append(via);
+    }
+    QList<BI_NetPoint*> netpoints;
+    QList<BI_NetLine*> netlines;
+    foreach (BI_NetPoint* netpoint, netsignal.getBoardNetPoints()) {
+        if (&netpoint->getBoard() != &mBoard) continue;
+        netpoints.append(netpoint);
+        foreach (BI_NetLine* netline, netpoint->getLines()) {
+            // every netline is registered at two netpoints, add it only once
+            if (&netline->getStartPoint() == netpoint) netlines.append(netline);
+        }
+    }
+
+    // build the disjoint sets (pads first to get them sorted at the beginning)
+    DisjointSet<BI_Base*> set;
+    foreach (BI_FootprintPad* pad, pads) set.add(pad);
+    foreach (BI_Via* via, vias) set.add(via);
+    foreach (BI_NetPoint* netpoint, netpoints) set.add(netpoint);
+    foreach (BI_NetLine* netline, netlines) set.add(netline);
+    foreach (BI_NetLine* netline, netlines) {
+        set.unite(netline, &netline->getStartPoint());
+        set.unite(netline, &netline->getEndPoint());
+    }
+
+    // the pads and vias of the net signal, to filter the spatial index lookups
+    QSet<const BI_Base*> netItems;
+    foreach (BI_FootprintPad* pad, pads) netItems.insert(pad);
+    foreach (BI_Via* via, vias) netItems.insert(via);
+    foreach (BI_NetPoint* netpoint, netpoints) {
+        if (netpoint->isAttachedToPad()) {
+            set.unite(netpoint, netpoint->getFootprintPad());
+        } else if (netpoint->isAttachedToVia()) {
+            set.unite(netpoint, netpoint->getVia());
+        } else {
+            // traces may also end within a pad or via without being attached to it
+            const Point& pos = netpoint->getPosition();
+            foreach (BI_Base* item, getPadsAndViasAt(pos, netItems)) {
+                if ((item->getType() == BI_Base::Type_t::FootprintPad) &&
+                    (!static_cast<BI_FootprintPad*>(item)->isOnLayer(
+                         netpoint->getLayer().getId())))
+                {
+                    continue;
+                }
+                set.unite(netpoint, item);
+            }
+        }
+    }
+    foreach (BI_Via* via, vias) {
+        foreach (BI_Base* item, getPadsAndViasAt(via->getPosition(), netItems)) {
+            if (item->getType() == BI_Base::Type_t::FootprintPad) set.unite(via, item);
+        }
+    }
+
+    // convert the sets to islands
+    NetIslands_t net;
+    net.pads = pads;
+    foreach (const QList<BI_Base*>& items, set.getSets()) {
+        Island_t island;
+        foreach (BI_Base* item, items) {
+            net.islandOfItem.insert(item, net.islands.count());
+            switch (item->getType())
+            {
+                case BI_Base::Type_t::FootprintPad:
+                    island.pads.append(static_cast<BI_FootprintPad*>(item));
+                    break;
+                case BI_Base::Type_t::Via:
+                    island.vias.append(static_cast<BI_Via*>(item));
+                    break;
+                case BI_Base::Type_t::NetPoint:
+                    island.netpoints.append(static_cast<BI_NetPoint*>(item));
+                    break;
+                case BI_Base::Type_t::NetLine:
+                    island.netlines.append(static_cast<BI_NetLine*>(item));
+                    break;
+                default:
+                    Q_ASSERT(false);
+                    break;
+            }
+        }
+        net.islands.append(island);
+    }
+    return net;
+}
+
+QList<BI_Base*> BoardConnectivity::getPadsAndViasAt(const Point& pos,
+        const QSet<const BI_Base*>& netItems) const noexcept
+{
+    // the spatial index of the board finds the candidates without iterating all items
+    QList<BI_Base*> items;
+    foreach (BI_Base* item, mBoard.getItemsInArea(BoundingBox(pos, pos))) {
+        if (netItems.contains(item) && item->isAtScenePos(pos)) items.append(item);
+    }
+    return items;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
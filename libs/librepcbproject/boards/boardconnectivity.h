@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDCONNECTIVITY_H
+#define LIBREPCB_PROJECT_BOARDCONNECTIVITY_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+class BI_Base;
+class BI_FootprintPad;
+class BI_Via;
+class BI_NetPoint;
+class BI_NetLine;
+
+/*****************************************************************************************
+ *  Class BoardConnectivity
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardConnectivity class determines which copper items of a board are
+ *        connected together
+ *
+ * For every net signal, all pads, vias, netpoints and netlines of the board are grouped
+ * into "islands" of items which are connected by copper. Items are connected if:
+ *  - a netline ends at a netpoint
+ *  - a netpoint is attached to a pad or via
+ *  - a (not attached) netpoint lies within the copper of a pad or via on its layer
+ *  - the center of a via lies within the copper of a pad
+ *
+ * The islands are determined with a disjoint-set (union-find) structure and are cached
+ * per net signal. The board invalidates the cache of the affected net signals on every
+ * modification, so only those nets need to be recalculated on the next query. Changes of
+ * the net signal of component signals are detected automatically by comparing the pads.
+ */
+class BoardConnectivity final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        struct Island_t {
+            QList<BI_FootprintPad*> pads;
+            QList<BI_Via*> vias;
+            QList<BI_NetPoint*> netpoints;
+            QList<BI_NetLine*> netlines;
+        };
+
+        // Constructors / Destructor
+        BoardConnectivity() = delete;
+        BoardConnectivity(const BoardConnectivity& other) = delete;
+        explicit BoardConnectivity(Board& board) noexcept;
+        ~BoardConnectivity() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get all islands of a net signal
+         *
+         * Islands containing pads come first, in the order of their pads.
+         */
+        const QList<Island_t>& getIslands(const NetSignal& netsignal) const noexcept;
+
+        /**
+         * @brief Check whether all pads of a net signal are connected together
+         *
+         * Nets with less than two pads on the board are always fully routed.
+         */
+        bool isFullyRouted(const NetSignal& netsignal) const noexcept;
+
+        /**
+         * @brief Check whether two pads are connected by copper
+         */
+        bool areConnected(const BI_FootprintPad& pad1,
+                          const BI_FootprintPad& pad2) const noexcept;
+
+        // General Methods
+
+        /**
+         * @brief Invalidate the cached islands of all net signals an item belongs to
+         *
+         * Must be called whenever an item was added, removed or modified.
+         */
+        void invalidate(const BI_Base& item) noexcept;
+        void invalidate(const NetSignal* netsignal) noexcept;
+        void invalidateAll() noexcept;
+
+        // Operator Overloadings
+        BoardConnectivity& operator=(const BoardConnectivity& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief The islands of a net signal need to be recalculated
+         */
+        void netSignalInvalidated(const NetSignal* netsignal);
+
+
+    private:
+
+        struct NetIslands_t {
+            QList<BI_FootprintPad*> pads;   ///< all pads of the net on this board
+            QList<Island_t> islands;
+            QHash<const BI_Base*, int> islandOfItem;
+        };
+
+        const NetIslands_t& getNetIslands(const NetSignal& netsignal) const noexcept;
+        QList<BI_FootprintPad*> getPadsOfNetSignal(const NetSignal& netsignal) const noexcept;
+        NetIslands_t calcNetIslands(const NetSignal& netsignal,
+                                    const QList<BI_FootprintPad*>& pads) const noexcept;
+        QList<BI_Base*> getPadsAndViasAt(const Point& pos,
+                                         const QSet<const BI_Base*>& netItems) const noexcept;
+
+
+        // General
+        Board& mBoard; ///< A reference to the Board object (from the ctor)
+        mutable QHash<const NetSignal*, NetIslands_t> mCache;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDCONNECTIVITY_H
@@ -0,0 +1,344 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <librepcbcommon/boarddesignrules.h>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/concurrentjobs.h>
+#include <librepcbcommon/geometry/polygon.h>
+#include "boardcopperzones.h"
+#include "boarddesignrulecheck.h"
+#include "board.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netline.h"
+#include "../circuit/netsignal.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardCopperZones::BoardCopperZones(Board& board) noexcept :
+    QObject(&board), mBoard(board), mIsAddedToBoard(false)
+{
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(sUpdateDelayMs);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &BoardCopperZones::update);
+    // the design rules are modified by CmdBoardDesignRulesModify
+    connect(&mBoard, &Board::attributesChanged, this, &BoardCopperZones::boardAttributesChanged);
+}
+
+BoardCopperZones::~BoardCopperZones() noexcept
+{
+    Q_ASSERT(!mIsAddedToBoard);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardCopperZones::addToBoard() noexcept
+{
+    Q_ASSERT(!mIsAddedToBoard);
+    mIsAddedToBoard = true;
+    memorizeDesignRules();
+    foreach (BI_Polygon* polygon, mBoard.getPolygons()) {
+        if (polygon->isCopperZone()) invalidateZone(*polygon);
+    }
+}
+
+void BoardCopperZones::removeFromBoard() noexcept
+{
+    Q_ASSERT(mIsAddedToBoard);
+    mUpdateTimer.stop();
+    mIsAddedToBoard = false;
+    mInvalidZones.clear();
+    mItemsOfZones.clear();
+}
+
+void BoardCopperZones::itemModified(const BI_Base& item) noexcept
+{
+    if ((!mIsAddedToBoard) || (!item.isAddedToBoard())) return;
+    invalidateZones(item, false);
+}
+
+void BoardCopperZones::itemRemoved(const BI_Base& item) noexcept
+{
+    if (!mIsAddedToBoard) return;
+    invalidateZones(item, true);
+}
+
+void BoardCopperZones::update() noexcept
+{
+    mUpdateTimer.stop();
+    if ((!mIsAddedToBoard) || mInvalidZones.isEmpty()) return;
+
+    // read all board items in this thread...
+    QVector<ZoneJob_t> jobs;
+    jobs.reserve(mInvalidZones.count());
+    foreach (BI_Polygon* zone, mInvalidZones) {
+        ZoneJob_t job;
+        if (prepareJob(*zone, job)) {
+            jobs.append(job);
+        } else {
+            zone->setCopperFill(QList<BI_Polygon::FillContour_t>());
+            mItemsOfZones.remove(zone);
+        }
+    }
+    mInvalidZones.clear();
+
+    // ...then calculate the fills in parallel (every job writes only its own result)
+    ConcurrentJobs concurrentJobs;
+    for (int i = 0; i < jobs.count(); ++i) {
+        ZoneJob_t* job = &jobs[i];
+        concurrentJobs.add([this, job](){fillZone(*job);});
+    }
+    concurrentJobs.run();
+
+    foreach (const ZoneJob_t& job, jobs) {
+        job.zone->setCopperFill(job.fill);
+        mItemsOfZones.insert(job.zone, job.items);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void BoardCopperZones::boardAttributesChanged() noexcept
+{
+    if (!mIsAddedToBoard) return;
+    const BoardDesignRules& rules = mBoard.getDesignRules();
+    if ((rules.getCopperClearance() != mCopperClearance) ||
+        (rules.getThermalSpokeWidth() != mThermalSpokeWidth))
+    {
+        // all fills have changed
+        memorizeDesignRules();
+        foreach (BI_Polygon* polygon, mBoard.getPolygons()) {
+            if (polygon->isCopperZone()) invalidateZone(*polygon);
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardCopperZones::invalidateZones(const BI_Base& item, bool removed) noexcept
+{
+    if (item.getType() == BI_Base::Type_t::Polygon) {
+        // const_cast is fine since the polygon is one of our zones
+        BI_Polygon& polygon = const_cast<BI_Polygon&>(static_cast<const BI_Polygon&>(item));
+        if ((!removed) && polygon.isCopperZone()) {
+            invalidateZone(polygon);
+        } else {
+            mInvalidZones.remove(&polygon);
+            mItemsOfZones.remove(&polygon);
+            if (!polygon.getCopperFill().isEmpty()) {
+                polygon.setCopperFill(QList<BI_Polygon::FillContour_t>());
+            }
+        }
+        return;
+    }
+
+    QList<const BI_Base*> copperItems = BoardDesignRuleCheck::getCopperItems(item);
+    if (copperItems.isEmpty()) return;
+    foreach (BI_Polygon* zone, mBoard.getPolygons()) {
+        if ((!zone->isCopperZone()) || mInvalidZones.contains(zone)) continue;
+        // the old position of the item is only known by the last fill
+        BoundingBox area = zone->getBoundingBox().expanded(mCopperClearance);
+        const QSet<const BI_Base*> usedItems = mItemsOfZones.value(zone);
+        foreach (const BI_Base* copperItem, copperItems) {
+            if (usedItems.contains(copperItem) ||
+                ((!removed) && area.intersects(copperItem->getBoundingBox())))
+            {
+                invalidateZone(*zone);
+                break;
+            }
+        }
+    }
+}
+
+void BoardCopperZones::invalidateZone(BI_Polygon& zone) noexcept
+{
+    mInvalidZones.insert(&zone);
+    mUpdateTimer.start(); // restart the delay
+}
+
+void BoardCopperZones::memorizeDesignRules() noexcept
+{
+    const BoardDesignRules& rules = mBoard.getDesignRules();
+    mCopperClearance = rules.getCopperClearance();
+    mThermalSpokeWidth = rules.getThermalSpokeWidth();
+}
+
+bool BoardCopperZones::prepareJob(BI_Polygon& zone, ZoneJob_t& job) const noexcept
+{
+    if ((!zone.isCopperZone()) || (!zone.isAddedToBoard())) return false;
+    const NetSignal* netsignal = zone.getNetSignal();
+    int layerId = zone.getPolygon().getLayerId();
+    job.zone = &zone;
+
+    // the cached vertices must not be accessed from other threads, so copy them here
+    QPolygonF outline;
+    foreach (const Point& p, zone.getPolygon().getVertices()) {
+        outline.append(QPointF(p.getX().toNm(), p.getY().toNm()));
+    }
+    job.outline.addPolygon(outline);
+    job.outline.closeSubpath();
+
+    BoundingBox area = zone.getBoundingBox().expanded(mCopperClearance);
+    foreach (const BI_Base* item, mBoard.getItemsInArea(area)) {
+        switch (item->getType())
+        {
+            case BI_Base::Type_t::FootprintPad: {
+                const BI_FootprintPad* pad = static_cast<const BI_FootprintPad*>(item);
+                if (!pad->isOnLayer(layerId)) continue;
+                if (pad->getCompSigInstNetSignal() == netsignal) {
+                    job.pads.append(pad->getCopperShape());
+                    job.padRotations.append(pad->getSceneRotation());
+                } else {
+                    job.obstacles.append(pad->getCopperShape());
+                }
+                break;
+            }
+            case BI_Base::Type_t::Via: {
+                const BI_Via* via = static_cast<const BI_Via*>(item);
+                if (!via->isOnLayer(layerId)) continue;
+                if (via->getNetSignal() == netsignal) continue; // connected solid
+                job.obstacles.append(via->getCopperShape());
+                break;
+            }
+            case BI_Base::Type_t::NetLine: {
+                const BI_NetLine* netline = static_cast<const BI_NetLine*>(item);
+                if (netline->getLayer().getId() != layerId) continue;
+                if (&netline->getNetSignal() == netsignal) continue; // connected solid
+                job.obstacles.append(netline->getCopperShape());
+                break;
+            }
+            default:
+                continue; // no copper
+        }
+        job.items.insert(item);
+    }
+    return true;
+}
+
+void BoardCopperZones::fillZone(ZoneJob_t& job) const noexcept
+{
+    // isolate the zone from all foreign copper and from the pads (thermal reliefs)
+    QPainterPath obstacles = toPath(job.obstacles, mCopperClearance);
+    QPainterPath reliefs = toPath(job.pads, mCopperClearance);
+    QPainterPath clearances = obstacles;
+    clearances.addPath(reliefs);
+    QPainterPath fill = job.outline.subtracted(clearances);
+
+    // connect the pads with spokes along their axes through the relief areas
+    if (!job.pads.isEmpty()) {
+        QList<ConvexShape> spokes;
+        for (int i = 0; i < job.pads.count(); ++i) {
+            BoundingBox box = job.pads.at(i).getBoundingBox();
+            Point center = box.getCenter();
+            Length length = box.getWidth() + box.getHeight() + mCopperClearance * 2
+                          + mThermalSpokeWidth * 2;
+            const Angle& rotation = job.padRotations.at(i);
+            spokes.append(ConvexShape::rect(center, length, mThermalSpokeWidth, rotation));
+            spokes.append(ConvexShape::rect(center, mThermalSpokeWidth, length, rotation));
+        }
+        QPainterPath connections = toPath(spokes, Length(0)).intersected(reliefs)
+                                   .intersected(job.outline).subtracted(obstacles);
+        fill = fill.united(connections);
+    }
+    job.fill = toContours(fill);
+}
+
+QPainterPath BoardCopperZones::toPath(const QList<ConvexShape>& shapes,
+                                      const Length& margin) const noexcept
+{
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill); // all outlines are counterclockwise
+    foreach (const ConvexShape& shape, shapes) {
+        QPolygonF polygon;
+        foreach (const Point& p, shape.expanded(margin).getOutline(Length(sMaxErrorNm))) {
+            polygon.append(QPointF(p.getX().toNm(), p.getY().toNm()));
+        }
+        path.addPolygon(polygon);
+        path.closeSubpath();
+    }
+    return path;
+}
+
+QList<BI_Polygon::FillContour_t> BoardCopperZones::toContours(const QPainterPath& path) noexcept
+{
+    QList<QPolygonF> polygons = path.toSubpathPolygons();
+    QList<QPair<int, BI_Polygon::FillContour_t>> contours; // first: nesting depth
+    for (int i = 0; i < polygons.count(); ++i) {
+        const QPolygonF& polygon = polygons.at(i);
+        if (polygon.count() < 3) continue;
+        // the contours of a boolean operation result don't intersect each other, so the
+        // nesting depth is the number of contours which contain any vertex of this one
+        int depth = 0;
+        for (int k = 0; k < polygons.count(); ++k) {
+            if ((k != i) && polygons.at(k).boundingRect().contains(polygon.first()) &&
+                polygons.at(k).containsPoint(polygon.first(), Qt::OddEvenFill))
+            {
+                ++depth;
+            }
+        }
+        BI_Polygon::FillContour_t contour;
+        contour.isHole = (depth % 2 == 1);
+        foreach (const QPointF& p, polygon) {
+            Point point(Length(qRound64(p.x())), Length(qRound64(p.y())));
+            if (contour.points.isEmpty() || (point != contour.points.last())) {
+                contour.points.append(point);
+            }
+        }
+        if ((contour.points.count() > 1) && (contour.points.first() == contour.points.last())) {
+            contour.points.removeLast(); // the contours are implicitly closed
+        }
+        if (contour.points.count() >= 3) {
+            contours.append(qMakePair(depth, contour));
+        }
+    }
+    std::stable_sort(contours.begin(), contours.end(),
+        [](const QPair<int, BI_Polygon::FillContour_t>& a,
+           const QPair<int, BI_Polygon::FillContour_t>& b){return a.first < b.first;});
+    QList<BI_Polygon::FillContour_t> result;
+    for (const auto& contour : contours) {
+        result.append(contour.second);
+    }
+    return result;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDCOPPERZONES_H
+#define LIBREPCB_PROJECT_BOARDCOPPERZONES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/geometry/convexshape.h>
+#include "items/bi_polygon.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Base;
+
+/*****************************************************************************************
+ *  Class BoardCopperZones
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardCopperZones class calculates the copper fill of all copper zones of a
+ *        board (see BI_Polygon::isCopperZone())
+ *
+ * The fill of a zone is its outline minus the copper clearance around all pads, vias
+ * and traces of other net signals on the same layer. Pads of the zone's own net signal
+ * get a thermal relief: they are isolated by the clearance as well, but connected with
+ * four spokes (#BoardDesignRules::getThermalSpokeWidth()) along the pad axes. Vias and
+ * traces of the zone's net signal are connected solid.
+ *
+ * The fills are cached in the zones. The board reports every modified item, and only
+ * zones whose area (plus clearance) overlaps the item, or which used the item for their
+ * last fill, are invalidated. Invalid zones are refilled a short time after the last
+ * modification, so moving items around does not refill the zones on every mouse move.
+ * All board items are read in the main thread, then the polygon operations of all
+ * invalid zones are calculated in parallel.
+ *
+ * @note Copper zones do not interact with each other, and unconnected copper islands
+ *       within a zone are not removed.
+ */
+class BoardCopperZones final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        BoardCopperZones() = delete;
+        BoardCopperZones(const BoardCopperZones& other) = delete;
+        explicit BoardCopperZones(Board& board) noexcept;
+        ~BoardCopperZones() noexcept;
+
+        // Getters
+        bool isUpToDate() const noexcept {return mInvalidZones.isEmpty();}
+
+        // General Methods
+        void addToBoard() noexcept;
+        void removeFromBoard() noexcept;
+
+        /**
+         * @brief Invalidate all zones affected by an added or modified item
+         */
+        void itemModified(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Invalidate all zones affected by an item which was removed from the board
+         */
+        void itemRemoved(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Refill all invalid zones immediately (e.g. before exporting the board)
+         */
+        void update() noexcept;
+
+        // Operator Overloadings
+        BoardCopperZones& operator=(const BoardCopperZones& rhs) = delete;
+
+
+    private slots:
+
+        void boardAttributesChanged() noexcept;
+
+
+    private:
+
+        // Types
+        struct ZoneJob_t {
+            BI_Polygon* zone;
+            QPainterPath outline;           ///< in nanometers (not inverted Y)
+            QList<ConvexShape> obstacles;   ///< copper of other net signals
+            QList<ConvexShape> pads;        ///< pads of the same net signal (thermals)
+            QList<Angle> padRotations;
+            QSet<const BI_Base*> items;     ///< all items which influence the fill
+            QList<BI_Polygon::FillContour_t> fill;  ///< the result
+        };
+
+        // Private Methods
+        void invalidateZones(const BI_Base& item, bool removed) noexcept;
+        void invalidateZone(BI_Polygon& zone) noexcept;
+        void memorizeDesignRules() noexcept;
+        bool prepareJob(BI_Polygon& zone, ZoneJob_t& job) const noexcept;
+        void fillZone(ZoneJob_t& job) const noexcept;
+        QPainterPath toPath(const QList<ConvexShape>& shapes, const Length& margin) const noexcept;
+        static QList<BI_Polygon::FillContour_t> toContours(const QPainterPath& path) noexcept;
+
+
+        // General
+        Board& mBoard; ///< A reference to the Board object (from the ctor)
+        bool mIsAddedToBoard;
+        QSet<BI_Polygon*> mInvalidZones;
+        QHash<const BI_Polygon*, QSet<const BI_Base*>> mItemsOfZones;
+        QTimer mUpdateTimer;
+
+        // the design rules of the last fill, to detect modifications
+        Length mCopperClearance;
+        Length mThermalSpokeWidth;
+
+        // Static Variables
+        static constexpr int sUpdateDelayMs = 200;  ///< delay after the last modification
+        static constexpr qint64 sMaxErrorNm = 5000; ///< max. error of arc approximations
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDCOPPERZONES_H
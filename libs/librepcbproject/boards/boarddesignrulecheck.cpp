@@ -0,0 +1,387 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <algorithm>
+#include <librepcbcommon/geometry/spatialindex.h>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/concurrentjobs.h>
+#include <librepcblibrary/pkg/footprintpad.h>
+#include <librepcblibrary/pkg/footprintpadtht.h>
+#include "boarddesignrulecheck.h"
+#include "board.h"
+#include "boardlayerstack.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "../circuit/netsignal.h"
+#include "../circuit/componentinstance.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board, const BoardDesignRules& rules) noexcept :
+    mBoard(board), mRules(rules)
+{
+}
+
+BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardDesignRuleCheck::execute() noexcept
+{
+    mViolations.clear();
+    mCopperShapes.clear();
+    QList<const BI_Base*> items = getAllCopperItems();
+    foreach (const BI_Base* item, items) {
+        checkItemRules(*item);
+    }
+    initCopperLayers();
+    foreach (const BI_Base* item, items) {
+        addCopperShapes(*item);
+    }
+    checkCopperClearances(QMap<int, int>());
+    mCopperShapes.clear(); // not needed anymore
+}
+
+void BoardDesignRuleCheck::execute(const QList<const BI_Base*>& items) noexcept
+{
+    mViolations.clear();
+    mCopperShapes.clear();
+    foreach (const BI_Base* item, items) {
+        checkItemRules(*item);
+    }
+
+    // the shapes of the checked items come first on every layer...
+    initCopperLayers();
+    QSet<const BI_Base*> added;
+    foreach (const BI_Base* item, items) {
+        if (added.contains(item)) continue;
+        added.insert(item);
+        addCopperShapes(*item);
+    }
+    QMap<int, int> checkedShapesCount;
+    for (auto it = mCopperShapes.constBegin(); it != mCopperShapes.constEnd(); ++it) {
+        checkedShapesCount.insert(it.key(), it->count());
+    }
+
+    // ...followed by all other copper items within the clearance of any checked item (the
+    // areas are queried separately, the united area of distant items would be far too big)
+    foreach (const BI_Base* item, items) {
+        BoundingBox area = item->getBoundingBox().expanded(mRules.getCopperClearance());
+        foreach (const BI_Base* neighbour, mBoard.getItemsInArea(area)) {
+            if (added.contains(neighbour)) continue;
+            added.insert(neighbour);
+            addCopperShapes(*neighbour);
+        }
+    }
+    checkCopperClearances(checkedShapesCount);
+    mCopperShapes.clear(); // not needed anymore
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+QList<const BI_Base*> BoardDesignRuleCheck::getCopperItems(const BI_Base& item) noexcept
+{
+    QList<const BI_Base*> items;
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::Device:
+            return getCopperItems(static_cast<const BI_Device&>(item).getFootprint());
+        case BI_Base::Type_t::Footprint:
+            foreach (const BI_FootprintPad* pad, static_cast<const BI_Footprint&>(item).getPads())
+                items.append(pad);
+            break;
+        case BI_Base::Type_t::NetPoint:
+            // moving a netpoint modifies all its netlines
+            foreach (const BI_NetLine* netline, static_cast<const BI_NetPoint&>(item).getLines())
+                items.append(netline);
+            break;
+        case BI_Base::Type_t::FootprintPad:
+        case BI_Base::Type_t::Via:
+        case BI_Base::Type_t::NetLine:
+            items.append(&item);
+            break;
+        default:
+            break; // no copper
+    }
+    return items;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QList<const BI_Base*> BoardDesignRuleCheck::getAllCopperItems() const noexcept
+{
+    QList<const BI_Base*> items;
+    // pads (sorted to get the same order on every run)
+    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+        QList<BI_FootprintPad*> pads = device->getFootprint().getPads().values();
+        std::sort(pads.begin(), pads.end(), [](const BI_FootprintPad* a, const BI_FootprintPad* b)
+            {return a->getLibPadUuid() < b->getLibPadUuid();});
+        foreach (const BI_FootprintPad* pad, pads) items.append(pad);
+    }
+    foreach (const BI_Via* via, mBoard.getVias()) items.append(via);
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) items.append(netline);
+    return items;
+}
+
+void BoardDesignRuleCheck::initCopperLayers() noexcept
+{
+    foreach (int layerId, mBoard.getLayerStack().getAllBoardLayerIds()) {
+        if (BoardLayer::isCopperLayer(layerId)) {
+            mCopperShapes.insert(layerId, QVector<CopperShape_t>());
+        }
+    }
+}
+
+void BoardDesignRuleCheck::addCopperShapes(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::FootprintPad: {
+            const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+            const NetSignal* netsignal = pad.getCompSigInstNetSignal();
+            ConvexShape shape = pad.getCopperShape();
+            foreach (int layerId, mCopperShapes.keys()) {
+                if (pad.isOnLayer(layerId)) {
+                    addCopperShape(layerId, pad, netsignal ? (const void*)netsignal : &pad, shape);
+                }
+            }
+            break;
+        }
+        case BI_Base::Type_t::Via: {
+            const BI_Via& via = static_cast<const BI_Via&>(item);
+            const NetSignal* netsignal = via.getNetSignal();
+            ConvexShape shape = via.getCopperShape();
+            foreach (int layerId, mCopperShapes.keys()) {
+                if (via.isOnLayer(layerId)) {
+                    addCopperShape(layerId, via, netsignal ? (const void*)netsignal : &via, shape);
+                }
+            }
+            break;
+        }
+        case BI_Base::Type_t::NetLine: {
+            const BI_NetLine& netline = static_cast<const BI_NetLine&>(item);
+            addCopperShape(netline.getLayer().getId(), netline, &netline.getNetSignal(),
+                           netline.getCopperShape());
+            break;
+        }
+        default:
+            break; // no copper
+    }
+}
+
+void BoardDesignRuleCheck::addCopperShape(int layerId, const BI_Base& item, const void* net,
+                                          const ConvexShape& shape) noexcept
+{
+    auto it = mCopperShapes.find(layerId);
+    if (it == mCopperShapes.end()) return; // layer doesn't exist
+    CopperShape_t copper;
+    copper.item = &item;
+    copper.net = net;
+    copper.shape = shape;
+    copper.boundingBox = shape.getBoundingBox();
+    it->append(copper);
+}
+
+void BoardDesignRuleCheck::checkItemRules(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::FootprintPad: {
+            const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+            const library::FootprintPadTht* tht =
+                dynamic_cast<const library::FootprintPadTht*>(&pad.getLibPad());
+            if (tht) checkMinDrillDiameter(pad, tht->getDrillDiameter());
+            break;
+        }
+        case BI_Base::Type_t::Via:
+            checkMinDrillDiameter(item, static_cast<const BI_Via&>(item).getDrillDiameter());
+            break;
+        case BI_Base::Type_t::NetLine:
+            checkMinCopperWidth(static_cast<const BI_NetLine&>(item));
+            break;
+        default:
+            break; // no rules to check
+    }
+}
+
+void BoardDesignRuleCheck::checkMinCopperWidth(const BI_NetLine& netline) noexcept
+{
+    const Length& minWidth = mRules.getCopperMinWidth();
+    if (netline.getWidth() >= minWidth) return;
+    Violation_t violation;
+    violation.type = ViolationType_t::CopperMinWidth;
+    violation.message = QString(tr("Trace of net \"%1\" is too thin (%2mm < %3mm)"))
+        .arg(netline.getNetSignal().getName())
+        .arg(netline.getWidth().toMm()).arg(minWidth.toMm());
+    violation.position = (netline.getStartPoint().getPosition() +
+                          netline.getEndPoint().getPosition()) / 2;
+    violation.items.append(&netline);
+    mViolations.append(violation);
+}
+
+void BoardDesignRuleCheck::checkMinDrillDiameter(const BI_Base& item,
+                                                 const Length& diameter) noexcept
+{
+    const Length& minDiameter = mRules.getDrillMinDiameter();
+    if (diameter >= minDiameter) return;
+    Violation_t violation;
+    violation.type = ViolationType_t::DrillMinDiameter;
+    violation.message = QString(tr("Drill of %1 is too small (%2mm < %3mm)"))
+        .arg(getItemDescription(item)).arg(diameter.toMm()).arg(minDiameter.toMm());
+    violation.position = item.getPosition();
+    violation.items.append(&item);
+    mViolations.append(violation);
+}
+
+void BoardDesignRuleCheck::checkCopperClearances(const QMap<int, int>& checkedShapesCount) noexcept
+{
+    // each job checks a chunk of the (first checkedShapesCount) shapes of one layer
+    static constexpr int sChunkSize = 1000;
+    struct Job_t {
+        const QVector<CopperShape_t>* shapes;
+        const SpatialIndex<int>* index;
+        QString layerName;
+        int begin;
+        int end;
+        QList<Violation_t> violations;
+    };
+    QVector<Job_t> jobs;
+    QList<SpatialIndex<int>*> indices;
+    for (auto it = mCopperShapes.constBegin(); it != mCopperShapes.constEnd(); ++it) {
+        int count = checkedShapesCount.value(it.key(), it->count());
+        if ((count < 1) || (it->count() < 2)) continue;
+        SpatialIndex<int>* index = new SpatialIndex<int>(Length(1000000)); // 1mm cells
+        for (int i = 0; i < it->count(); ++i) {
+            index->insert(i, it->at(i).boundingBox);
+        }
+        indices.append(index);
+        for (int begin = 0; begin < count; begin += sChunkSize) {
+            Job_t job;
+            job.shapes = &it.value();
+            job.index = index;
+            job.layerName = mBoard.getLayerStack().getBoardLayer(it.key())->getName();
+            job.begin = begin;
+            job.end = qMin(begin + sChunkSize, count);
+            jobs.append(job);
+        }
+    }
+
+    // the threads only read the shapes and indices, and every job writes its own results
+    ConcurrentJobs concurrentJobs;
+    for (int i = 0; i < jobs.count(); ++i) {
+        Job_t* job = &jobs[i];
+        concurrentJobs.add([this, job](){
+            job->violations = checkCopperClearances(*job->shapes, *job->index, job->begin,
+                                                    job->end, job->layerName);
+        });
+    }
+    concurrentJobs.run();
+    qDeleteAll(indices);
+
+    foreach (const Job_t& job, jobs) {
+        mViolations.append(job.violations);
+    }
+}
+
+QList<BoardDesignRuleCheck::Violation_t> BoardDesignRuleCheck::checkCopperClearances(
+        const QVector<CopperShape_t>& shapes, const SpatialIndex<int>& index,
+        int begin, int end, const QString& layerName) const noexcept
+{
+    QList<Violation_t> violations;
+    const Length& clearance = mRules.getCopperClearance();
+    for (int i = begin; i < end; ++i) {
+        const CopperShape_t& a = shapes.at(i);
+        BoundingBox area = a.boundingBox.expanded(clearance);
+        foreach (int k, index.query(area)) {
+            if (k <= i) continue; // check every pair only once
+            const CopperShape_t& b = shapes.at(k);
+            if (a.net == b.net) continue;
+            Length distance = a.shape.getDistanceTo(b.shape);
+            if ((distance >= clearance) && (distance > 0)) continue;
+            Violation_t violation;
+            violation.type = ViolationType_t::CopperClearance;
+            violation.message = QString(tr("Clearance violation on layer \"%1\" between %2 "
+                "and %3 (%4mm < %5mm)")).arg(layerName, getItemDescription(*a.item),
+                getItemDescription(*b.item)).arg(distance.toMm()).arg(clearance.toMm());
+            Point min(qMax(area.getMin().getX(), b.boundingBox.getMin().getX()),
+                      qMax(area.getMin().getY(), b.boundingBox.getMin().getY()));
+            Point max(qMin(area.getMax().getX(), b.boundingBox.getMax().getX()),
+                      qMin(area.getMax().getY(), b.boundingBox.getMax().getY()));
+            violation.position = (min + max) / 2;
+            violation.items.append(a.item);
+            violation.items.append(b.item);
+            violations.append(violation);
+        }
+    }
+    return violations;
+}
+
+QString BoardDesignRuleCheck::getItemDescription(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::FootprintPad: {
+            const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+            return QString(tr("pad of \"%1\""))
+                .arg(pad.getFootprint().getDeviceInstance().getComponentInstance().getName());
+        }
+        case BI_Base::Type_t::Via: {
+            const BI_Via& via = static_cast<const BI_Via&>(item);
+            return via.getNetSignal() ? QString(tr("via of net \"%1\""))
+                                        .arg(via.getNetSignal()->getName()) : tr("via");
+        }
+        case BI_Base::Type_t::NetLine: {
+            const BI_NetLine& netline = static_cast<const BI_NetLine&>(item);
+            return QString(tr("trace of net \"%1\"")).arg(netline.getNetSignal().getName());
+        }
+        default:
+            return tr("unknown item");
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+#define LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/boarddesignrules.h>
+#include <librepcbcommon/geometry/convexshape.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+template <typename T>
+class SpatialIndex;
+
+namespace project {
+
+class Board;
+class BI_Base;
+class BI_NetLine;
+
+/*****************************************************************************************
+ *  Class BoardDesignRuleCheck
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardDesignRuleCheck class checks a board against its design rules (DRC)
+ *
+ * The following rules of #BoardDesignRules are checked:
+ *  - the clearance between copper items of different net signals on the same layer
+ *  - the minimum width of traces
+ *  - the minimum drill diameter of vias and THT pads
+ *
+ * All copper items are converted to #ConvexShape objects first, which is done in the
+ * calling thread because the board items must not be accessed from other threads. The
+ * clearance check then runs in parallel in a thread pool: the shapes of every layer are
+ * split into chunks, and every chunk checks its shapes against all nearby shapes found
+ * in a spatial index of the layer. The violations are sorted by layer and chunk, so the
+ * result does not depend on the scheduling of the threads.
+ */
+class BoardDesignRuleCheck final
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardDesignRuleCheck)
+
+    public:
+
+        // Types
+        enum class ViolationType_t {
+            CopperClearance,    ///< two copper items are too close together
+            CopperMinWidth,     ///< a trace is too thin
+            DrillMinDiameter,   ///< a drill of a via or pad is too small
+        };
+        struct Violation_t {
+            ViolationType_t type;
+            QString message;
+            Point position;                 ///< the (approximate) location of the violation
+            QList<const BI_Base*> items;    ///< all involved items
+        };
+
+        // Constructors / Destructor
+        BoardDesignRuleCheck() = delete;
+        BoardDesignRuleCheck(const BoardDesignRuleCheck& other) = delete;
+        BoardDesignRuleCheck(Board& board, const BoardDesignRules& rules) noexcept;
+        ~BoardDesignRuleCheck() noexcept;
+
+        // Getters
+        const QList<Violation_t>& getViolations() const noexcept {return mViolations;}
+
+        // General Methods
+
+        /**
+         * @brief Run the check (must be called from the thread which owns the board)
+         */
+        void execute() noexcept;
+
+        /**
+         * @brief Check only some items (e.g. the items modified by an undo command)
+         *
+         * Only violations which involve at least one of the specified items are reported,
+         * i.e. the rules of the items themselves and their clearances to all neighbour
+         * items. The neighbours are looked up in the spatial index of the board, so the
+         * board must be added to the project. Items without copper are ignored.
+         *
+         * @param items     The pads, vias and netlines to check
+         */
+        void execute(const QList<const BI_Base*>& items) noexcept;
+
+        // Static Methods
+
+        /**
+         * @brief Get the copper items (pads, vias and netlines) affected by an item
+         *
+         * For example the pads of a device, or the netlines of a netpoint.
+         */
+        static QList<const BI_Base*> getCopperItems(const BI_Base& item) noexcept;
+
+        // Operator Overloadings
+        BoardDesignRuleCheck& operator=(const BoardDesignRuleCheck& rhs) = delete;
+
+
+    private:
+
+        // Types
+        struct CopperShape_t {
+            const BI_Base* item;
+            const void* net;    ///< the net signal, or the item itself if it has no net
+            ConvexShape shape;
+            BoundingBox boundingBox;
+        };
+
+        // Private Methods
+        QList<const BI_Base*> getAllCopperItems() const noexcept;
+        void initCopperLayers() noexcept;
+        void addCopperShapes(const BI_Base& item) noexcept;
+        void addCopperShape(int layerId, const BI_Base& item, const void* net,
+                            const ConvexShape& shape) noexcept;
+        void checkItemRules(const BI_Base& item) noexcept;
+        void checkMinCopperWidth(const BI_NetLine& netline) noexcept;
+        void checkMinDrillDiameter(const BI_Base& item, const Length& diameter) noexcept;
+        void checkCopperClearances(const QMap<int, int>& checkedShapesCount) noexcept;
+        QList<Violation_t> checkCopperClearances(const QVector<CopperShape_t>& shapes,
+                                                 const SpatialIndex<int>& index,
+                                                 int begin, int end,
+                                                 const QString& layerName) const noexcept;
+        static QString getItemDescription(const BI_Base& item) noexcept;
+
+
+        // Attributes
+        Board& mBoard;
+        BoardDesignRules mRules;
+        QMap<int, QVector<CopperShape_t>> mCopperShapes; ///< key: layer ID
+        QList<Violation_t> mViolations;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDDESIGNRULECHECK_H
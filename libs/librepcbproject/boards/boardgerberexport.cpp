@@ -21,17 +21,25 @@
  *  Includes
  ****************************************************************************************/
 #include <QtCore>
+#include <algorithm>
+#include <tuple>
 #include "boardgerberexport.h"
 #include <librepcbcommon/cam/gerbergenerator.h>
 #include <librepcbcommon/cam/excellongenerator.h>
+#include <librepcbcommon/cam/polylinebuilder.h>
 #include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/concurrentjobs.h>
 #include <librepcbcommon/boarddesignrules.h>
 #include <librepcbcommon/geometry/hole.h>
+#include <librepcbcommon/geometry/boundingbox.h>
+#include <librepcbcommon/fileio/fileutils.h>
 #include <librepcblibrary/pkg/footprint.h>
 #include <librepcblibrary/pkg/footprintpadsmt.h>
 #include <librepcblibrary/pkg/footprintpadtht.h>
 #include "../project.h"
 #include "board.h"
+#include "boardcopperzones.h"
+#include "boardpanel.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
 #include "items/bi_footprintpad.h"
@@ -46,12 +54,31 @@
 namespace librepcb {
 namespace project {
 
+/*****************************************************************************************
+ *  Static Variables
+ ****************************************************************************************/
+
+const QVector<int> BoardGerberExport::sExportedLayers = {
+    BoardLayer::LayerID::BoardOutlines,
+    BoardLayer::LayerID::TopCopper,
+    BoardLayer::LayerID::TopStopMask,
+    BoardLayer::LayerID::TopOverlay,
+    BoardLayer::LayerID::BottomCopper,
+    BoardLayer::LayerID::BottomStopMask,
+    BoardLayer::LayerID::BottomOverlay,
+};
+
+const int BoardGerberExport::sOutputFormatVersion = 1;
+
 /*****************************************************************************************
  *  Constructors / Destructor
  ****************************************************************************************/
 
-BoardGerberExport::BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept :
-    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir)
+BoardGerberExport::BoardGerberExport(const Board& board, const FilePath& outputDir,
+                                     const FilePath& cacheDir) noexcept :
+    mProject(board.getProject()), mBoard(board), mOutputDirectory(outputDir),
+    mCache(cacheDir.isValid() ? cacheDir : (board.getProject().isReadOnly() ? FilePath()
+                                            : outputDir.getPathTo(".cache")))
 {
 }
 
@@ -65,14 +92,47 @@ BoardGerberExport::~BoardGerberExport() noexcept
 
 void BoardGerberExport::exportAllLayers() const throw (Exception)
 {
-    exportDrillsPTH();
-    exportLayerBoardOutlines();
-    exportLayerTopCopper();
-    exportLayerTopSolderMask();
-    exportLayerTopOverlay();
-    exportLayerBottomCopper();
-    exportLayerBottomSolderMask();
-    exportLayerBottomOverlay();
+    // update all lazily calculated data in this thread, the jobs must only read the board
+    mBoard.getCopperZones().update(); // the zones may not be filled yet
+    if (mBoard.getPanel().isEnabled()) {
+        getBoardOutline(); // calculates the vertices of the outline polygons
+    }
+    buildPrimitives(); // the geometry shared by all layers
+
+    // every file is generated by its own job with its own generator, so the content of
+    // the files does not depend on the execution order
+    QList<std::function<void()>> exports = {
+        [this](){exportDrillsPTH();},
+        [this](){exportDrillsMouseBites();},
+        [this](){exportLayerBoardOutlines();},
+        [this](){exportLayerTopCopper();},
+        [this](){exportLayerTopSolderMask();},
+        [this](){exportLayerTopOverlay();},
+        [this](){exportLayerBottomCopper();},
+        [this](){exportLayerBottomSolderMask();},
+        [this](){exportLayerBottomOverlay();},
+    };
+    QVector<QString> errors(exports.count());
+    ConcurrentJobs jobs;
+    for (int i = 0; i < exports.count(); ++i) {
+        std::function<void()> function = exports.at(i);
+        QString* error = &errors[i];
+        jobs.add([function, error](){
+            try {
+                function();
+            } catch (const Exception& e) {
+                *error = e.getUserMsg();
+            }
+        });
+    }
+    jobs.run();
+
+    // report the errors of all failed files at once (in a deterministic order)
+    errors.removeAll(QString());
+    if (!errors.isEmpty()) {
+        QStringList messages = errors.toList();
+        throw RuntimeError(__FILE__, __LINE__, QString(), messages.join("\n\n"));
+    }
 }
 
 /*****************************************************************************************
@@ -81,240 +141,352 @@ void BoardGerberExport::exportAllLayers() const throw (Exception)
 
 void BoardGerberExport::exportDrillsPTH() const throw (Exception)
 {
-    ExcellonGenerator gen;
+    QVector<QPair<Point, Length>> drills;
 
     // footprint holes and pads
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
         const BI_Footprint& footprint = device->getFootprint();
         for (int i = 0; i < footprint.getLibFootprint().getHoleCount(); ++i) {
             const Hole* hole = footprint.getLibFootprint().getHole(i); Q_ASSERT(hole);
-            gen.drill(footprint.mapToScene(hole->getPosition()), hole->getDiameter());
+            drills.append(qMakePair(footprint.mapToScene(hole->getPosition()),
+                                    hole->getDiameter()));
         }
         foreach (const BI_FootprintPad* pad, footprint.getPads()) {
             const library::FootprintPad& libPad = pad->getLibPad();
             if (libPad.getTechnology() == library::FootprintPad::Technology_t::THT) {
                 const library::FootprintPadTht* tht = dynamic_cast<const library::FootprintPadTht*>(&libPad); Q_ASSERT(tht);
-                gen.drill(pad->getPosition(), tht->getDrillDiameter());
+                drills.append(qMakePair(pad->getPosition(), tht->getDrillDiameter()));
             }
         }
     }
 
     // vias
     foreach (const BI_Via* via, mBoard.getVias()) {
-        gen.drill(via->getPosition(), via->getDrillDiameter());
+        drills.append(qMakePair(via->getPosition(), via->getDrillDiameter()));
     }
 
-    gen.generate();
     QString filename = QString("%1_DRILLS-PTH.drl").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcDrillsCacheKey(drills);
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
+    ExcellonGenerator gen;
+
+    // the drills are stored once and repeated for every instance of the panel
+    const BoardPanel& panel = mBoard.getPanel();
+    if (panel.isEnabled()) {
+        BoundingBox outline = getBoardOutline();
+        gen.setTransformation(panel.getRotation(), panel.getFirstInstanceOffset(outline));
+        gen.setRepetitions(panel.getInstanceOffsets(outline));
+    }
+
+    foreach (const auto& drill, drills) {
+        gen.drill(drill.first, drill.second);
+    }
+    gen.generate();
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
+}
+
+void BoardGerberExport::exportDrillsMouseBites() const throw (Exception)
+{
+    QString filename = QString("%1_DRILLS-NPTH.drl").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QVector<QPair<Point, Length>> drills;
+    const BoardPanel& panel = mBoard.getPanel();
+    if (panel.isEnabled()) {
+        foreach (const Point& pos, panel.getMouseBites(getBoardOutline())) {
+            drills.append(qMakePair(pos, panel.getMouseBiteDiameter()));
+        }
+    }
+    if (drills.isEmpty()) {
+        // a file of a previous export with mouse bites would still be manufactured
+        if (filepath.isExistingFile()) {
+            FileUtils::removeFile(filepath); // can throw
+        }
+        return;
+    }
+
+    QByteArray key = calcDrillsCacheKey(drills);
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
+    ExcellonGenerator gen;
+    foreach (const auto& drill, drills) {
+        gen.drill(drill.first, drill.second);
+    }
+    gen.generate();
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerBoardOutlines() const throw (Exception)
 {
+    QString filename = QString("%1_OUTLINES.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::BoardOutlines});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::BoardOutlines);
-    gen.generate();
-    QString filename = QString("%1_OUTLINES.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    drawPanelFrame(gen);
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerTopCopper() const throw (Exception)
 {
+    QString filename = QString("%1_COPPER-TOP.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::TopCopper});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::TopCopper);
-    gen.generate();
-    QString filename = QString("%1_COPPER-TOP.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerTopSolderMask() const throw (Exception)
 {
+    QString filename = QString("%1_SOLDERMASK-TOP.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::TopStopMask});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::TopStopMask);
-    gen.generate();
-    QString filename = QString("%1_SOLDERMASK-TOP.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerTopOverlay() const throw (Exception)
 {
+    QString filename = QString("%1_SILKSCREEN-TOP.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::TopOverlay, BoardLayer::TopStopMask});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::TopOverlay);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, BoardLayer::TopStopMask);
-    gen.generate();
-    QString filename = QString("%1_SILKSCREEN-TOP.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerBottomCopper() const throw (Exception)
 {
+    QString filename = QString("%1_COPPER-BOTTOM.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::BottomCopper});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::BottomCopper);
-    gen.generate();
-    QString filename = QString("%1_COPPER-BOTTOM.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerBottomSolderMask() const throw (Exception)
 {
+    QString filename = QString("%1_SOLDERMASK-BOTTOM.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::BottomStopMask});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::BottomStopMask);
-    gen.generate();
-    QString filename = QString("%1_SOLDERMASK-BOTTOM.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::exportLayerBottomOverlay() const throw (Exception)
 {
+    QString filename = QString("%1_SILKSCREEN-BOTTOM.gbr").arg(mProject.getName());
+    FilePath filepath = mOutputDirectory.getPathTo(filename);
+    QByteArray key = calcCacheKey({BoardLayer::BottomOverlay, BoardLayer::BottomStopMask});
+    if (mCache.isUpToDate(filepath, key)) return; // nothing changed since last export
+
     GerberGenerator gen(mProject.getName(), mBoard.getUuid(), mBoard.getName());
     drawLayer(gen, BoardLayer::BottomOverlay);
     gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
     drawLayer(gen, BoardLayer::BottomStopMask);
-    gen.generate();
-    QString filename = QString("%1_SILKSCREEN-BOTTOM.gbr").arg(mProject.getName());
-    gen.saveToFile(mOutputDirectory.getPathTo(filename));
+    gen.saveToFile(filepath);
+    mCache.update(filepath, key);
 }
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen, int layerId) const throw (Exception)
 {
-    // draw footprints incl. pads
+    beginPanel(gen);
+
+    auto it = mPrimitives.constFind(layerId);
+    if (it != mPrimitives.constEnd()) {
+        it.value().draw(gen);
+    }
+
+    endPanel(gen);
+}
+
+void BoardGerberExport::buildPrimitives() const throw (Exception)
+{
+    mPrimitives.clear();
+
+    // copper zones first since their holes are cleared with negative polarity
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        Q_ASSERT(polygon);
+        if (!polygon->isCopperZone()) continue;
+        foreach (const BI_Polygon::FillContour_t& contour, polygon->getCopperFill()) {
+            Primitive_t primitive;
+            primitive.type = Primitive_t::Type_t::Region;
+            primitive.negative = contour.isHole;
+            primitive.points = contour.points;
+            addPrimitive(polygon->getPolygon().getLayerId(), primitive);
+        }
+    }
+
+    // footprints incl. pads
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
         Q_ASSERT(device);
-        drawFootprint(gen, device->getFootprint(), layerId);
+        addFootprintPrimitives(device->getFootprint());
     }
 
-    // draw vias
+    // vias
     foreach (const BI_Via* via, mBoard.getVias()) {
         Q_ASSERT(via);
-        drawVia(gen, *via, layerId);
+        addViaPrimitives(*via);
     }
 
-    // draw traces
-    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
-        Q_ASSERT(netline);
-        if (netline->getLayer().getId() == layerId) {
-            gen.drawLine(netline->getStartPoint().getPosition(),
-                         netline->getEndPoint().getPosition(),
-                         netline->getWidth());
-        }
-    }
+    // traces
+    addTracePrimitives();
 
-    // draw polygons
+    // polygons
     foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
         Q_ASSERT(polygon);
-        if (layerId == polygon->getPolygon().getLayerId()) {
-            Polygon p(polygon->getPolygon());
-            p.setLineWidth(calcWidthOfLayer(polygon->getPolygon().getLineWidth(), layerId));
-            gen.drawPolygonOutline(p);
-        }
+        if (polygon->isCopperZone()) continue; // already added
+        int layerId = polygon->getPolygon().getLayerId();
+        QSharedPointer<Polygon> p(new Polygon(polygon->getPolygon()));
+        p->setLineWidth(calcWidthOfLayer(p->getLineWidth(), layerId));
+        Primitive_t primitive;
+        primitive.type = Primitive_t::Type_t::PolygonOutline;
+        primitive.polygon = p;
+        addPrimitive(layerId, primitive);
+    }
+
+    // minimize the aperture changes
+    for (auto it = mPrimitives.begin(); it != mPrimitives.end(); ++it) {
+        it.value().sortByAperture();
     }
 }
 
-void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via, int layerId) const throw (Exception)
+void BoardGerberExport::addTracePrimitives() const noexcept
 {
-    bool drawCopper = via.isOnLayer(layerId);
-    bool drawStopMask = (layerId == BoardLayer::TopStopMask || layerId == BoardLayer::BottomStopMask)
-                        && mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
-    if (drawCopper || drawStopMask) {
-        Length outerDiameter = via.getSize();
-        if (drawStopMask) {
-            outerDiameter += mBoard.getDesignRules().calcStopMaskClearance(via.getSize()) * 2;
+    // connected netlines of the same layer and width are drawn as one polyline
+    QMap<QPair<int, LengthBase_t>, QVector<QPair<Point, Point>>> segments;
+    foreach (const BI_NetLine* netline, mBoard.getNetLines()) {
+        Q_ASSERT(netline);
+        auto key = qMakePair(netline->getLayer().getId(), netline->getWidth().toNm());
+        segments[key].append(qMakePair(netline->getStartPoint().getPosition(),
+                                       netline->getEndPoint().getPosition()));
+    }
+    for (auto it = segments.constBegin(); it != segments.constEnd(); ++it) {
+        foreach (const QVector<Point>& polyline, PolylineBuilder::build(it.value())) {
+            Primitive_t primitive;
+            primitive.type = Primitive_t::Type_t::Polyline;
+            primitive.width = Length(it.key().second);
+            primitive.points = polyline;
+            addPrimitive(it.key().first, primitive);
         }
-        switch (via.getShape())
-        {
-            case BI_Via::Shape::Round: {
-                gen.flashCircle(via.getPosition(), outerDiameter, Length(0));
-                break;
-            }
-            case BI_Via::Shape::Square: {
-                gen.flashRect(via.getPosition(), outerDiameter, outerDiameter,
-                              Angle::deg0(), Length(0));
-                break;
-            }
-            case BI_Via::Shape::Octagon: {
-                gen.flashRegularPolygon(via.getPosition(), outerDiameter, 8,
-                                        Angle::deg0(), Length(0));
-                break;
-            }
-            default: {
-                throw LogicError(__FILE__, __LINE__);
-            }
+    }
+}
+
+void BoardGerberExport::addViaPrimitives(const BI_Via& via) const throw (Exception)
+{
+    Primitive_t::Type_t type;
+    switch (via.getShape())
+    {
+        case BI_Via::Shape::Round:      type = Primitive_t::Type_t::FlashCircle; break;
+        case BI_Via::Shape::Square:     type = Primitive_t::Type_t::FlashRect; break;
+        case BI_Via::Shape::Octagon:    type = Primitive_t::Type_t::FlashRegularPolygon; break;
+        default:                        throw LogicError(__FILE__, __LINE__);
+    }
+    bool requiresStopMask = mBoard.getDesignRules().doesViaRequireStopMask(via.getDrillDiameter());
+    Length stopMaskDiameter = via.getSize()
+        + mBoard.getDesignRules().calcStopMaskClearance(via.getSize()) * 2;
+
+    foreach (int layerId, sExportedLayers) {
+        bool drawCopper = via.isOnLayer(layerId);
+        bool drawStopMask = requiresStopMask && ((layerId == BoardLayer::TopStopMask) ||
+                                                 (layerId == BoardLayer::BottomStopMask));
+        if (drawCopper || drawStopMask) {
+            Length size = drawStopMask ? stopMaskDiameter : via.getSize();
+            addPrimitive(layerId, createFlash(type, via.getPosition(), size, size, Angle::deg0()));
         }
     }
 }
 
-void BoardGerberExport::drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, int layerId) const throw (Exception)
+void BoardGerberExport::addFootprintPrimitives(const BI_Footprint& footprint) const throw (Exception)
 {
-    // draw pads
+    const library::Footprint& libFootprint = footprint.getLibFootprint();
+    Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
+    auto getLayerOnBoard = [&footprint](int layer){
+        return footprint.getIsMirrored() ? BoardLayer::getMirroredLayerId(layer) : layer;
+    };
+
+    // pads
     foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-        drawFootprintPad(gen, *pad, layerId);
-    }
-
-    // draw polygons
-    for (int i = 0; i < footprint.getLibFootprint().getPolygonCount(); ++i) {
-        const Polygon* polygon = footprint.getLibFootprint().getPolygon(i); Q_ASSERT(polygon);
-        int layer = footprint.getIsMirrored() ? BoardLayer::getMirroredLayerId(layerId) : layerId;
-        if (layer == polygon->getLayerId()) {
-            Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
-            Polygon p = polygon->rotated(rot).translate(footprint.getPosition());
-            p.setLineWidth(calcWidthOfLayer(p.getLineWidth(), layer));
-            gen.drawPolygonOutline(p);
-            if (p.isFilled()) {
-                gen.drawPolygonArea(p);
-            }
-        }
+        addFootprintPadPrimitives(*pad);
     }
 
-    // draw ellipses
-    for (int i = 0; i < footprint.getLibFootprint().getEllipseCount(); ++i) {
-        const Ellipse* ellipse = footprint.getLibFootprint().getEllipse(i); Q_ASSERT(ellipse);
-        int layer = footprint.getIsMirrored() ? BoardLayer::getMirroredLayerId(layerId) : layerId;
-        if (layer == ellipse->getLayerId()) {
-            Angle rot = footprint.getIsMirrored() ? -footprint.getRotation() : footprint.getRotation();
-            Ellipse e = ellipse->rotated(rot).translate(footprint.getPosition());
-            e.setLineWidth(calcWidthOfLayer(e.getLineWidth(), layer));
-            gen.drawEllipseOutline(e);
-            if (e.isFilled()) {
-                gen.drawEllipseArea(e);
-            }
-        }
+    // polygons
+    for (int i = 0; i < libFootprint.getPolygonCount(); ++i) {
+        const Polygon* polygon = libFootprint.getPolygon(i); Q_ASSERT(polygon);
+        QSharedPointer<Polygon> p(new Polygon(polygon->rotated(rot).translate(footprint.getPosition())));
+        p->setLineWidth(calcWidthOfLayer(p->getLineWidth(), polygon->getLayerId()));
+        Primitive_t primitive;
+        primitive.type = Primitive_t::Type_t::PolygonOutline;
+        primitive.filled = p->isFilled();
+        primitive.polygon = p;
+        addPrimitive(getLayerOnBoard(polygon->getLayerId()), primitive);
     }
 
-    // TODO: draw texts
+    // ellipses
+    for (int i = 0; i < libFootprint.getEllipseCount(); ++i) {
+        const Ellipse* ellipse = libFootprint.getEllipse(i); Q_ASSERT(ellipse);
+        QSharedPointer<Ellipse> e(new Ellipse(ellipse->rotated(rot).translate(footprint.getPosition())));
+        e->setLineWidth(calcWidthOfLayer(e->getLineWidth(), ellipse->getLayerId()));
+        e->getVertices(); // calculate the cached vertices before they are read concurrently
+        Primitive_t primitive;
+        primitive.type = Primitive_t::Type_t::EllipseOutline;
+        primitive.filled = e->isFilled();
+        primitive.ellipse = e;
+        addPrimitive(getLayerOnBoard(ellipse->getLayerId()), primitive);
+    }
 
-    // draw holes
-    for (int i = 0; i < footprint.getLibFootprint().getHoleCount(); ++i) {
-        const Hole* hole = footprint.getLibFootprint().getHole(i); Q_ASSERT(hole);
-        gen.flashCircle(footprint.mapToScene(hole->getPosition()), hole->getDiameter(), Length(0));
+    // TODO: texts
+
+    // holes (on every layer)
+    for (int i = 0; i < libFootprint.getHoleCount(); ++i) {
+        const Hole* hole = libFootprint.getHole(i); Q_ASSERT(hole);
+        Primitive_t primitive = createFlash(Primitive_t::Type_t::FlashCircle,
+            footprint.mapToScene(hole->getPosition()), hole->getDiameter(),
+            hole->getDiameter(), Angle::deg0());
+        foreach (int layerId, sExportedLayers) {
+            addPrimitive(layerId, primitive);
+        }
     }
 }
 
-void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, int layerId) const throw (Exception)
+void BoardGerberExport::addFootprintPadPrimitives(const BI_FootprintPad& pad) const throw (Exception)
 {
-    bool isOnCopperLayer = pad.isOnLayer(layerId);
-    bool isOnSolderMaskTop = pad.isOnLayer(BoardLayer::LayerID::TopCopper) && (layerId == BoardLayer::LayerID::TopStopMask);
-    bool isOnSolderMaskBottom = pad.isOnLayer(BoardLayer::LayerID::BottomCopper) && (layerId == BoardLayer::LayerID::BottomStopMask);
-    if (!isOnCopperLayer && !isOnSolderMaskTop && !isOnSolderMaskBottom) {
-        return;
-    }
-
     Angle rot = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
     const library::FootprintPad& libPad = pad.getLibPad();
-    Length width = libPad.getWidth();
-    Length height = libPad.getHeight();
-    if (isOnSolderMaskTop || isOnSolderMaskBottom) {
-        Length size = qMin(width, height);
-        Length clearance = mBoard.getDesignRules().calcStopMaskClearance(size);
-        width += clearance*2;
-        height += clearance*2;
-    }
 
+    // determine the shape of the pad
+    Primitive_t::Type_t type;
     switch (libPad.getTechnology())
     {
         case library::FootprintPad::Technology_t::SMT: {
-            //const library::FootprintPadSmt* smt = dynamic_cast<const library::FootprintPadSmt*>(&libPad); Q_ASSERT(smt);
-            gen.flashRect(pad.getPosition(), width, height, rot, Length(0));
+            type = Primitive_t::Type_t::FlashRect;
             break;
         }
         case library::FootprintPad::Technology_t::THT: {
@@ -322,23 +494,20 @@ void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_Footprin
             switch (tht->getShape())
             {
                 case library::FootprintPadTht::Shape_t::ROUND: {
-                    if (width == height) {
-                        gen.flashCircle(pad.getPosition(), width, Length(0));
-                    } else {
-                        gen.flashObround(pad.getPosition(), width, height, rot, Length(0));
-                    }
+                    type = (libPad.getWidth() == libPad.getHeight())
+                        ? Primitive_t::Type_t::FlashCircle : Primitive_t::Type_t::FlashObround;
                     break;
                 }
                 case library::FootprintPadTht::Shape_t::RECT: {
-                    gen.flashRect(pad.getPosition(), width, height, rot, Length(0));
+                    type = Primitive_t::Type_t::FlashRect;
                     break;
                 }
                 case library::FootprintPadTht::Shape_t::OCTAGON: {
-                    if (width != height) {
+                    if (libPad.getWidth() != libPad.getHeight()) {
                         throw LogicError(__FILE__, __LINE__, QString(),
                             tr("Sorry, non-square octagons are not yet supported."));
                     }
-                    gen.flashRegularPolygon(pad.getPosition(), width, 8, rot, Length(0));
+                    type = Primitive_t::Type_t::FlashRegularPolygon;
                     break;
                 }
                 default: {
@@ -351,6 +520,150 @@ void BoardGerberExport::drawFootprintPad(GerberGenerator& gen, const BI_Footprin
             throw LogicError(__FILE__, __LINE__);
         }
     }
+
+    // the stop mask openings are enlarged by the clearance on all sides
+    Length width = libPad.getWidth();
+    Length height = libPad.getHeight();
+    Length clearance = mBoard.getDesignRules().calcStopMaskClearance(qMin(width, height));
+    Length stopMaskWidth = width + clearance * 2;
+    Length stopMaskHeight = height + clearance * 2;
+
+    foreach (int layerId, sExportedLayers) {
+        bool isOnCopperLayer = pad.isOnLayer(layerId);
+        bool isOnSolderMaskTop = pad.isOnLayer(BoardLayer::LayerID::TopCopper) && (layerId == BoardLayer::LayerID::TopStopMask);
+        bool isOnSolderMaskBottom = pad.isOnLayer(BoardLayer::LayerID::BottomCopper) && (layerId == BoardLayer::LayerID::BottomStopMask);
+        if (isOnSolderMaskTop || isOnSolderMaskBottom) {
+            addPrimitive(layerId, createFlash(type, pad.getPosition(), stopMaskWidth,
+                                              stopMaskHeight, rot));
+        } else if (isOnCopperLayer) {
+            addPrimitive(layerId, createFlash(type, pad.getPosition(), width, height, rot));
+        }
+    }
+}
+
+void BoardGerberExport::addPrimitive(int layerId, const Primitive_t& primitive) const noexcept
+{
+    if (sExportedLayers.contains(layerId)) {
+        mPrimitives[layerId].append(primitive);
+    }
+}
+
+QByteArray BoardGerberExport::calcCacheKey(const QVector<int>& layers) const throw (Exception)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    addCommonCacheKeyData(hash);
+    foreach (int layerId, layers) {
+        const QVector<Primitive_t> primitives = mPrimitives.value(layerId).getPrimitives();
+        addToHash(hash, layerId);
+        addToHash(hash, primitives.count());
+        foreach (const Primitive_t& primitive, primitives) {
+            addToHash(hash, primitive);
+        }
+    }
+    return hash.result();
+}
+
+QByteArray BoardGerberExport::calcDrillsCacheKey(const QVector<QPair<Point, Length>>& drills) const throw (Exception)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    addCommonCacheKeyData(hash);
+    addToHash(hash, drills.count());
+    foreach (const auto& drill, drills) {
+        addToHash(hash, drill.first);
+        addToHash(hash, drill.second.toNm());
+    }
+    return hash.result();
+}
+
+void BoardGerberExport::addCommonCacheKeyData(QCryptographicHash& hash) const throw (Exception)
+{
+    // the generator version, since the generated content may change with it
+    addToHash(hash, sOutputFormatVersion);
+    addToHash(hash, QCoreApplication::applicationVersion());
+
+    // the metadata written to the file header
+    addToHash(hash, mProject.getName());
+    addToHash(hash, mBoard.getUuid().toStr());
+    addToHash(hash, mBoard.getName());
+
+    // the panel (the offsets of the instances depend on the board outline)
+    const BoardPanel& panel = mBoard.getPanel();
+    addToHash(hash, panel.isEnabled());
+    if (panel.isEnabled()) {
+        BoundingBox outline = getBoardOutline();
+        addToHash(hash, outline.getMin());
+        addToHash(hash, outline.getMax());
+        addToHash(hash, panel.getColumns());
+        addToHash(hash, panel.getRows());
+        addToHash(hash, panel.getSpacingX().toNm());
+        addToHash(hash, panel.getSpacingY().toNm());
+        addToHash(hash, panel.getRotation().toMicroDeg());
+        addToHash(hash, panel.getRailWidth().toNm());
+        addToHash(hash, panel.getMouseBiteDiameter().toNm());
+        addToHash(hash, panel.getMouseBitePitch().toNm());
+        addToHash(hash, panel.getMouseBiteCount());
+    }
+}
+
+void BoardGerberExport::drawPanelFrame(GerberGenerator& gen) const throw (Exception)
+{
+    const BoardPanel& panel = mBoard.getPanel();
+    if (!panel.isEnabled()) return;
+
+    // the frame around the whole panel
+    BoundingBox frame = panel.getFrame(getBoardOutline());
+    Length width = calcWidthOfLayer(Length(0), BoardLayer::LayerID::BoardOutlines);
+    Point p1 = frame.getMin();
+    Point p2(frame.getMax().getX(), frame.getMin().getY());
+    Point p3 = frame.getMax();
+    Point p4(frame.getMin().getX(), frame.getMax().getY());
+    gen.drawLine(p1, p2, width);
+    gen.drawLine(p2, p3, width);
+    gen.drawLine(p3, p4, width);
+    gen.drawLine(p4, p1, width);
+
+    // the inner edges of the rails
+    if (panel.getRailWidth() > 0) {
+        Point rail(Length(0), panel.getRailWidth());
+        gen.drawLine(p1 + rail, p2 + rail, width);
+        gen.drawLine(p4 - rail, p3 - rail, width);
+    }
+}
+
+BoundingBox BoardGerberExport::getBoardOutline() const throw (Exception)
+{
+    BoundingBox outline;
+    foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+        Q_ASSERT(polygon);
+        if (polygon->getPolygon().getLayerId() != BoardLayer::LayerID::BoardOutlines) continue;
+        foreach (const Point& vertex, polygon->getPolygon().getVertices()) {
+            outline = outline.united(vertex);
+        }
+    }
+    if (!outline.isValid()) {
+        throw RuntimeError(__FILE__, __LINE__, QString(),
+            tr("The board has no outline, which is required to create a panel."));
+    }
+    return outline;
+}
+
+void BoardGerberExport::beginPanel(GerberGenerator& gen) const throw (Exception)
+{
+    const BoardPanel& panel = mBoard.getPanel();
+    if (!panel.isEnabled()) return;
+
+    BoundingBox outline = getBoardOutline();
+    Point pitch = panel.getPitch(outline);
+    gen.setTransformation(panel.getRotation(), panel.getFirstInstanceOffset(outline));
+    gen.beginStepAndRepeat(panel.getColumns(), panel.getRows(), pitch.getX(), pitch.getY());
+}
+
+void BoardGerberExport::endPanel(GerberGenerator& gen) const noexcept
+{
+    if (!mBoard.getPanel().isEnabled()) return;
+
+    gen.endStepAndRepeat();
+    gen.setTransformation(Angle::deg0(), Point(0, 0));
 }
 
 /*****************************************************************************************
@@ -366,6 +679,73 @@ Length BoardGerberExport::calcWidthOfLayer(const Length& width, int layerId) noe
     }
 }
 
+BoardGerberExport::Primitive_t BoardGerberExport::createFlash(Primitive_t::Type_t type,
+        const Point& pos, const Length& w, const Length& h, const Angle& rot) noexcept
+{
+    Primitive_t primitive;
+    primitive.type = type;
+    primitive.position = pos;
+    primitive.width = w;
+    primitive.height = h;
+    primitive.rotation = rot;
+    primitive.vertices = (type == Primitive_t::Type_t::FlashRegularPolygon) ? 8 : 0;
+    return primitive;
+}
+
+void BoardGerberExport::addToHash(QCryptographicHash& hash, qint64 value) noexcept
+{
+    hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void BoardGerberExport::addToHash(QCryptographicHash& hash, const QString& value) noexcept
+{
+    QByteArray utf8 = value.toUtf8();
+    addToHash(hash, utf8.size()); // to separate consecutive strings
+    hash.addData(utf8);
+}
+
+void BoardGerberExport::addToHash(QCryptographicHash& hash, const Point& value) noexcept
+{
+    addToHash(hash, value.getX().toNm());
+    addToHash(hash, value.getY().toNm());
+}
+
+void BoardGerberExport::addToHash(QCryptographicHash& hash, const Primitive_t& primitive) noexcept
+{
+    addToHash(hash, static_cast<int>(primitive.type));
+    addToHash(hash, primitive.negative);
+    addToHash(hash, primitive.filled);
+    addToHash(hash, primitive.position);
+    addToHash(hash, primitive.width.toNm());
+    addToHash(hash, primitive.height.toNm());
+    addToHash(hash, primitive.rotation.toMicroDeg());
+    addToHash(hash, primitive.vertices);
+    addToHash(hash, primitive.points.count());
+    foreach (const Point& point, primitive.points) {
+        addToHash(hash, point);
+    }
+    if (primitive.polygon) {
+        const Polygon& polygon = *primitive.polygon;
+        addToHash(hash, polygon.getLineWidth().toNm());
+        addToHash(hash, polygon.isFilled());
+        addToHash(hash, polygon.getStartPos());
+        addToHash(hash, polygon.getSegmentCount());
+        for (int i = 0; i < polygon.getSegmentCount(); ++i) {
+            addToHash(hash, polygon.getSegment(i)->getEndPos());
+            addToHash(hash, polygon.getSegment(i)->getAngle().toMicroDeg());
+        }
+    }
+    if (primitive.ellipse) {
+        const Ellipse& ellipse = *primitive.ellipse;
+        addToHash(hash, ellipse.getLineWidth().toNm());
+        addToHash(hash, ellipse.isFilled());
+        addToHash(hash, ellipse.getCenter());
+        addToHash(hash, ellipse.getRadiusX().toNm());
+        addToHash(hash, ellipse.getRadiusY().toNm());
+        addToHash(hash, ellipse.getRotation().toMicroDeg());
+    }
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,16 +26,20 @@
 #include <QtCore>
 #include <librepcbcommon/exceptions.h>
 #include <librepcbcommon/fileio/filepath.h>
+#include <librepcbcommon/cam/camoutputcache.h>
+#include <librepcbcommon/cam/gerberprimitivelist.h>
 #include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/geometry/polygon.h>
+#include <librepcbcommon/geometry/ellipse.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
  ****************************************************************************************/
 namespace librepcb {
 
-class Polygon;
-class Ellipse;
 class GerberGenerator;
+class ExcellonGenerator;
+class BoundingBox;
 
 namespace project {
 
@@ -52,6 +56,18 @@ class BI_FootprintPad;
 /**
  * @brief The BoardGerberExport class
  *
+ * Before the files are generated, all board items are converted once into flat lists
+ * of scene-space primitives (flashes, lines, regions, outlines), one list per exported
+ * layer. The layer writers then only stream the primitives of their layer, so the
+ * transformations of the footprint geometry and the pad sizes are calculated only once
+ * per export instead of once per file.
+ *
+ * Files whose inputs did not change since the last export are not generated again (see
+ * CamOutputCache). The cache key of a file is a hash over its primitives (or drills),
+ * the panel and the metadata written to the file, so it covers all relevant board
+ * items, design rules and library footprints. By default, the cache is stored in the
+ * ".cache" subdirectory of the output directory, except for read-only projects.
+ *
  * @author ubruhin
  * @date 2016-01-10
  */
@@ -64,10 +80,29 @@ class BoardGerberExport final : public QObject
         // Constructors / Destructor
         BoardGerberExport() = delete;
         BoardGerberExport(const BoardGerberExport& other) = delete;
-        BoardGerberExport(const Board& board, const FilePath& outputDir) noexcept;
+
+        /**
+         * @brief Constructor
+         *
+         * @param board     The board to export
+         * @param outputDir The directory of the generated files
+         * @param cacheDir  The directory of the CamOutputCache. If invalid, the ".cache"
+         *                  subdirectory of the output directory is used, or no cache at
+         *                  all if the project was opened in read-only mode.
+         */
+        BoardGerberExport(const Board& board, const FilePath& outputDir,
+                          const FilePath& cacheDir = FilePath()) noexcept;
         ~BoardGerberExport() noexcept;
 
         // General Methods
+
+        /**
+         * @brief Generate all Gerber and Excellon files
+         *
+         * The files are generated concurrently, one job per file. If some of them
+         * fail, the other files are still generated and the error messages of all
+         * failed files are reported together.
+         */
         void exportAllLayers() const throw (Exception);
 
         // Operator Overloadings
@@ -76,8 +111,13 @@ class BoardGerberExport final : public QObject
 
     private:
 
+        // Private Types
+
+        typedef GerberPrimitiveList::Primitive_t Primitive_t;
+
         // Private Methods
         void exportDrillsPTH() const throw (Exception);
+        void exportDrillsMouseBites() const throw (Exception);
         void exportLayerBoardOutlines() const throw (Exception);
         void exportLayerTopCopper() const throw (Exception);
         void exportLayerTopSolderMask() const throw (Exception);
@@ -87,18 +127,85 @@ class BoardGerberExport final : public QObject
         void exportLayerBottomOverlay() const throw (Exception);
 
         void drawLayer(GerberGenerator& gen, int layerId) const throw (Exception);
-        void drawVia(GerberGenerator& gen, const BI_Via& via, int layerId) const throw (Exception);
-        void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint, int layerId) const throw (Exception);
-        void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad, int layerId) const throw (Exception);
+
+        /**
+         * @brief Convert all board items into the primitives of all exported layers
+         *
+         * Must be called before the files are generated. The primitives are only read
+         * afterwards, so the layers can be generated concurrently.
+         */
+        void buildPrimitives() const throw (Exception);
+        void addTracePrimitives() const noexcept;
+        void addViaPrimitives(const BI_Via& via) const throw (Exception);
+        void addFootprintPrimitives(const BI_Footprint& footprint) const throw (Exception);
+        void addFootprintPadPrimitives(const BI_FootprintPad& pad) const throw (Exception);
+        void addPrimitive(int layerId, const Primitive_t& primitive) const noexcept;
+
+        void drawPanelFrame(GerberGenerator& gen) const throw (Exception);
+
+        /**
+         * @brief Get the bounding box of all polygons on the board outlines layer
+         *
+         * @throw RuntimeError if the board has no outline
+         */
+        BoundingBox getBoardOutline() const throw (Exception);
+
+        /**
+         * @brief Place the following objects at the first instance of the panel and
+         *        repeat them for all other instances (only if the panel is enabled)
+         *
+         * The geometry of the board is plotted only once, the other instances are
+         * created by the step and repeat block of the Gerber file.
+         */
+        void beginPanel(GerberGenerator& gen) const throw (Exception);
+        void endPanel(GerberGenerator& gen) const noexcept;
+
+        /**
+         * @brief Calculate the cache key of a Gerber file
+         *
+         * @param layers    The layers drawn to the file
+         *
+         * @return A hash over the primitives of the layers and all other inputs
+         */
+        QByteArray calcCacheKey(const QVector<int>& layers) const throw (Exception);
+
+        /**
+         * @brief Calculate the cache key of a drill file
+         *
+         * @param drills    The positions and diameters of all drills in the file
+         *
+         * @return A hash over the drills and all other inputs
+         */
+        QByteArray calcDrillsCacheKey(const QVector<QPair<Point, Length>>& drills) const throw (Exception);
+        void addCommonCacheKeyData(QCryptographicHash& hash) const throw (Exception);
 
         // Static Methods
         static Length calcWidthOfLayer(const Length& width, int layerId) noexcept;
+        static Primitive_t createFlash(Primitive_t::Type_t type, const Point& pos,
+                                       const Length& w, const Length& h,
+                                       const Angle& rot) noexcept;
+        static void addToHash(QCryptographicHash& hash, qint64 value) noexcept;
+        static void addToHash(QCryptographicHash& hash, const QString& value) noexcept;
+        static void addToHash(QCryptographicHash& hash, const Point& value) noexcept;
+        static void addToHash(QCryptographicHash& hash, const Primitive_t& primitive) noexcept;
 
 
         // Private Member Variables
         const Project& mProject;
         const Board& mBoard;
         FilePath mOutputDirectory;
+        CamOutputCache mCache;
+
+        /// The primitives of all exported layers (key: layer ID), built by
+        /// #buildPrimitives() in #exportAllLayers() before the files are generated
+        mutable QHash<int, GerberPrimitiveList> mPrimitives;
+
+        /// The layers which are exported (others are not converted into primitives)
+        static const QVector<int> sExportedLayers;
+
+        /// The version of the generated file content, part of all cache keys (increment
+        /// it whenever the same primitives are written differently)
+        static const int sOutputFormatVersion;
 };
 
 /*****************************************************************************************
@@ -0,0 +1,92 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/scopeguard.h>
+#include <librepcbcommon/graphics/tiledimagerenderer.h>
+#include "boardimageexport.h"
+#include "board.h"
+#include "boardlayerstack.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardImageExport::BoardImageExport(Board& board) noexcept :
+    mBoard(board), mDpi(600), mBackgroundColor(Qt::black), mLayers()
+{
+}
+
+BoardImageExport::~BoardImageExport() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardImageExport::exportToFile(const FilePath& filepath) const throw (Exception)
+{
+    QPicture picture;
+    QRectF rect;
+    {
+        // show only the selected layers while the board is recorded
+        BoardLayerStack& layerStack = mBoard.getLayerStack();
+        QHash<BoardLayer*, bool> visibility;
+        foreach (int id, layerStack.getAllBoardLayerIds()) {
+            BoardLayer* layer = layerStack.getBoardLayer(id);
+            visibility.insert(layer, layer->isVisible());
+            if (!mLayers.isEmpty()) layer->setVisible(mLayers.contains(id));
+        }
+        auto sg = scopeGuard([&visibility](){
+            for (auto it = visibility.constBegin(); it != visibility.constEnd(); ++it) {
+                it.key()->setVisible(it.value());
+            }
+        });
+
+        mBoard.clearSelection();
+        rect = mBoard.getPrintRect();
+        QPainter painter(&picture);
+        mBoard.renderToQPainter(painter, rect);
+    }
+
+    TiledImageRenderer renderer(picture, rect);
+    renderer.setDpi(mDpi);
+    renderer.setBackgroundColor(mBackgroundColor);
+    renderer.exportToFile(filepath); // can throw
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
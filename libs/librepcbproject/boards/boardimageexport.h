@@ -0,0 +1,103 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDIMAGEEXPORT_H
+#define LIBREPCB_PROJECT_BOARDIMAGEEXPORT_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <librepcbcommon/exceptions.h>
+#include <librepcbcommon/fileio/filepath.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+/*****************************************************************************************
+ *  Class BoardImageExport
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardImageExport class exports a board as a high-resolution PNG or TIFF image
+ *
+ * The board is recorded once into a QPicture (with the colors of its BoardLayer objects)
+ * and then rendered tile by tile with TiledImageRenderer, so the memory usage does not
+ * depend on the height of the image.
+ *
+ * If a list of layers is given, only these layers are exported. Their visibility is
+ * changed temporarily while the board is recorded and then restored. Items which are not
+ * a part of the physical board (air wires, origin crosses) are never exported.
+ */
+class BoardImageExport final
+{
+    public:
+
+        // Constructors / Destructor
+        BoardImageExport() = delete;
+        BoardImageExport(const BoardImageExport& other) = delete;
+        explicit BoardImageExport(Board& board) noexcept;
+        ~BoardImageExport() noexcept;
+
+        // Setters
+        void setDpi(int dpi) noexcept {mDpi = dpi;}
+        void setBackgroundColor(const QColor& color) noexcept {mBackgroundColor = color;}
+
+        /// The IDs of the layers to export (empty: all currently visible layers)
+        void setLayers(const QList<int>& layers) noexcept {mLayers = layers;}
+
+        // General Methods
+
+        /**
+         * @brief Export the board
+         *
+         * @param filepath  The PNG or TIFF file to write (the format depends on the suffix)
+         *
+         * @throw Exception on error
+         */
+        void exportToFile(const FilePath& filepath) const throw (Exception);
+
+        // Operator Overloadings
+        BoardImageExport& operator=(const BoardImageExport& rhs) = delete;
+
+
+    private:
+
+        // Attributes
+        Board& mBoard;
+        int mDpi;
+        QColor mBackgroundColor;
+        QList<int> mLayers;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDIMAGEEXPORT_H
@@ -0,0 +1,191 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/boardlayer.h>
+#include "boardnetstatistics.h"
+#include "board.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netline.h"
+#include "items/bi_via.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class NetStatistics_t
+ ****************************************************************************************/
+
+Length BoardNetStatistics::NetStatistics_t::getTotalLength() const noexcept
+{
+    Length length(0);
+    foreach (const Length& layerLength, lengthPerLayer) {
+        length += layerLength;
+    }
+    return length;
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardNetStatistics::BoardNetStatistics(Board& board) noexcept :
+    QObject(&board), mBoard(board)
+{
+}
+
+BoardNetStatistics::~BoardNetStatistics() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+BoardNetStatistics::NetStatistics_t BoardNetStatistics::getStatistics(
+        const NetSignal& netsignal) const noexcept
+{
+    return mStatistics.value(&netsignal);
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardNetStatistics::itemModified(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::NetLine:
+            updateNetLine(static_cast<const BI_NetLine&>(item), false);
+            break;
+        case BI_Base::Type_t::Via:
+            updateVia(static_cast<const BI_Via&>(item), false);
+            break;
+        default:
+            break; // netpoints report the modification of their netlines
+    }
+}
+
+void BoardNetStatistics::itemRemoved(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::NetLine:
+            updateNetLine(static_cast<const BI_NetLine&>(item), true);
+            break;
+        case BI_Base::Type_t::Via:
+            updateVia(static_cast<const BI_Via&>(item), true);
+            break;
+        default:
+            break;
+    }
+}
+
+void BoardNetStatistics::clear() noexcept
+{
+    QList<const NetSignal*> netsignals = mStatistics.keys();
+    mStatistics.clear();
+    mNetLines.clear();
+    mVias.clear();
+    foreach (const NetSignal* netsignal, netsignals) {
+        emit statisticsChanged(netsignal);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardNetStatistics::updateNetLine(const BI_NetLine& netline, bool removed) noexcept
+{
+    auto it = mNetLines.find(&netline);
+    NetLineContribution_t c;
+    if (!removed) {
+        c.netsignal = &netline.getNetSignal();
+        c.layerId = netline.getLayer().getId();
+        c.length = (netline.getEndPoint().getPosition() -
+                    netline.getStartPoint().getPosition()).getLength();
+        if ((it != mNetLines.end()) && (it->netsignal == c.netsignal) &&
+            (it->layerId == c.layerId) && (it->length == c.length)) {
+            return; // nothing relevant has changed (e.g. only the width)
+        }
+    }
+
+    // subtract the old contribution and add the new one
+    const NetSignal* oldNetSignal = nullptr;
+    if (it != mNetLines.end()) {
+        oldNetSignal = it->netsignal;
+        addNetLineContribution(it.value(), -1);
+        mNetLines.erase(it);
+    }
+    if (!removed) {
+        addNetLineContribution(c, 1);
+        mNetLines.insert(&netline, c);
+        emit statisticsChanged(c.netsignal);
+    }
+    if (oldNetSignal && ((removed) || (oldNetSignal != c.netsignal))) {
+        emit statisticsChanged(oldNetSignal);
+    }
+}
+
+void BoardNetStatistics::updateVia(const BI_Via& via, bool removed) noexcept
+{
+    const NetSignal* oldNetSignal = mVias.value(&via, nullptr);
+    const NetSignal* newNetSignal = removed ? nullptr : via.getNetSignal();
+    if (newNetSignal == oldNetSignal) return;
+
+    if (oldNetSignal) {
+        NetStatistics_t& statistics = mStatistics[oldNetSignal];
+        statistics.viaCount--;
+        if (statistics.isEmpty()) mStatistics.remove(oldNetSignal);
+        mVias.remove(&via);
+        emit statisticsChanged(oldNetSignal);
+    }
+    if (newNetSignal) {
+        mStatistics[newNetSignal].viaCount++;
+        mVias.insert(&via, newNetSignal);
+        emit statisticsChanged(newNetSignal);
+    }
+}
+
+void BoardNetStatistics::addNetLineContribution(const NetLineContribution_t& c,
+                                                int sign) noexcept
+{
+    NetStatistics_t& statistics = mStatistics[c.netsignal];
+    statistics.netLineCount += sign;
+    Length& layerLength = statistics.lengthPerLayer[c.layerId];
+    layerLength += c.length * sign;
+    if (layerLength == 0) statistics.lengthPerLayer.remove(c.layerId);
+    if (statistics.isEmpty()) mStatistics.remove(c.netsignal);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,151 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDNETSTATISTICS_H
+#define LIBREPCB_PROJECT_BOARDNETSTATISTICS_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+class BI_Base;
+class BI_NetLine;
+class BI_Via;
+
+/*****************************************************************************************
+ *  Class BoardNetStatistics
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardNetStatistics class provides the routed length, the via count and the
+ *        segment count of every net signal of a board
+ *
+ * The statistics are maintained incrementally: The board reports every added, modified
+ * and removed item (like for #BoardOnlineDrc), and only the contribution of that item is
+ * subtracted and added again. So the statistics are always up to date (e.g. while
+ * dragging a netpoint) without scanning the whole board.
+ *
+ * The length of a netline is the distance between its netpoints, summed up per copper
+ * layer. Vias are counted per net signal, their length (board thickness) is not added.
+ */
+class BoardNetStatistics final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Types
+        struct NetStatistics_t {
+            QMap<int, Length> lengthPerLayer;   ///< key: board layer ID
+            int netLineCount;
+            int viaCount;
+
+            NetStatistics_t() noexcept : netLineCount(0), viaCount(0) {}
+            Length getTotalLength() const noexcept;
+            bool isEmpty() const noexcept {return (netLineCount == 0) && (viaCount == 0);}
+        };
+
+        // Constructors / Destructor
+        BoardNetStatistics() = delete;
+        BoardNetStatistics(const BoardNetStatistics& other) = delete;
+        explicit BoardNetStatistics(Board& board) noexcept;
+        ~BoardNetStatistics() noexcept;
+
+        // Getters
+
+        /**
+         * @brief Get the statistics of a net signal (empty if it has no items on the board)
+         */
+        NetStatistics_t getStatistics(const NetSignal& netsignal) const noexcept;
+
+        /**
+         * @brief Get all net signals which have netlines or vias on the board
+         */
+        QList<const NetSignal*> getNetSignals() const noexcept {return mStatistics.keys();}
+
+        // General Methods
+
+        /**
+         * @brief Update the statistics after an item was added to the board or modified
+         */
+        void itemModified(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Update the statistics after an item was removed from the board
+         */
+        void itemRemoved(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Forget all items (e.g. when the board is removed from the project)
+         */
+        void clear() noexcept;
+
+        // Operator Overloadings
+        BoardNetStatistics& operator=(const BoardNetStatistics& rhs) = delete;
+
+
+    signals:
+
+        /**
+         * @brief The statistics of a net signal have changed
+         */
+        void statisticsChanged(const NetSignal* netsignal);
+
+
+    private:
+
+        // Types
+        struct NetLineContribution_t {
+            const NetSignal* netsignal;
+            int layerId;
+            Length length;
+        };
+
+        // Private Methods
+        void updateNetLine(const BI_NetLine& netline, bool removed) noexcept;
+        void updateVia(const BI_Via& via, bool removed) noexcept;
+        void addNetLineContribution(const NetLineContribution_t& c, int sign) noexcept;
+
+
+        // General
+        Board& mBoard; ///< A reference to the Board object (from the ctor)
+        QHash<const NetSignal*, NetStatistics_t> mStatistics;
+        QHash<const BI_NetLine*, NetLineContribution_t> mNetLines;
+        QHash<const BI_Via*, const NetSignal*> mVias;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDNETSTATISTICS_H
@@ -0,0 +1,290 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/boarddesignrules.h>
+#include "boardonlinedrc.h"
+#include "board.h"
+#include "items/bi_base.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netline.h"
+#include "../erc/ercmsg.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardOnlineDrc::BoardOnlineDrc(Board& board) noexcept :
+    QObject(&board), mBoard(board), mIsAddedToBoard(false), mFullCheckRequired(false)
+{
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(0);
+    connect(&mUpdateTimer, &QTimer::timeout,
+            this, static_cast<void (BoardOnlineDrc::*)()>(&BoardOnlineDrc::processDirtyItems));
+    // the design rules are modified by CmdBoardDesignRulesModify
+    connect(&mBoard, &Board::attributesChanged, this, &BoardOnlineDrc::boardAttributesChanged);
+}
+
+BoardOnlineDrc::~BoardOnlineDrc() noexcept
+{
+    Q_ASSERT(!mIsAddedToBoard);
+    removeAllViolations();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool BoardOnlineDrc::isUpToDate() const noexcept
+{
+    return (!mFullCheckRequired) && mDirtyItems.isEmpty();
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardOnlineDrc::addToBoard() noexcept
+{
+    Q_ASSERT(!mIsAddedToBoard);
+    mIsAddedToBoard = true;
+    mFullCheckRequired = true;
+    mUpdateTimer.start();
+}
+
+void BoardOnlineDrc::removeFromBoard() noexcept
+{
+    Q_ASSERT(mIsAddedToBoard);
+    mUpdateTimer.stop();
+    mIsAddedToBoard = false;
+    mFullCheckRequired = false;
+    mDirtyItems.clear();
+    mDirtyItemsSet.clear();
+    removeAllViolations();
+}
+
+void BoardOnlineDrc::itemModified(const BI_Base& item) noexcept
+{
+    if ((!mIsAddedToBoard) || (!item.isAddedToBoard())) return;
+    if (mFullCheckRequired) return; // the item will be checked anyway
+    foreach (const BI_Base* copperItem, BoardDesignRuleCheck::getCopperItems(item)) {
+        if (!mDirtyItemsSet.contains(copperItem)) {
+            mDirtyItemsSet.insert(copperItem);
+            mDirtyItems.append(copperItem);
+        }
+    }
+    mUpdateTimer.start();
+}
+
+void BoardOnlineDrc::itemRemoved(const BI_Base& item) noexcept
+{
+    if (!mIsAddedToBoard) return;
+    foreach (const BI_Base* copperItem, BoardDesignRuleCheck::getCopperItems(item)) {
+        // the item must not be checked anymore since it is no longer part of the board
+        if (mDirtyItemsSet.remove(copperItem)) {
+            mDirtyItems.removeOne(copperItem);
+        }
+        removeViolationsOfItem(copperItem);
+    }
+}
+
+void BoardOnlineDrc::update() noexcept
+{
+    processDirtyItems(-1);
+}
+
+int BoardOnlineDrc::checkAll() noexcept
+{
+    mUpdateTimer.stop();
+    mFullCheckRequired = false;
+    mDirtyItems.clear();
+    mDirtyItemsSet.clear();
+    removeAllViolations();
+    if (!mIsAddedToBoard) return 0;
+
+    memorizeDesignRules();
+    BoardDesignRuleCheck drc(mBoard, mBoard.getDesignRules());
+    drc.execute();
+    foreach (const BoardDesignRuleCheck::Violation_t& violation, drc.getViolations()) {
+        addViolation(violation);
+    }
+    return mViolations.count();
+}
+
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void BoardOnlineDrc::processDirtyItems() noexcept
+{
+    processDirtyItems(sFrameBudgetMs);
+}
+
+void BoardOnlineDrc::boardAttributesChanged() noexcept
+{
+    if (!mIsAddedToBoard) return;
+    const BoardDesignRules& rules = mBoard.getDesignRules();
+    if ((rules.getCopperClearance() != mCopperClearance) ||
+        (rules.getCopperMinWidth() != mCopperMinWidth) ||
+        (rules.getDrillMinDiameter() != mDrillMinDiameter))
+    {
+        // all violations may have changed
+        mFullCheckRequired = true;
+        mUpdateTimer.start();
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardOnlineDrc::processDirtyItems(int timeLimitMs) noexcept
+{
+    mUpdateTimer.stop();
+    if (!mIsAddedToBoard) return;
+    if (mFullCheckRequired) {
+        checkAll();
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!mDirtyItems.isEmpty()) {
+        if ((timeLimitMs >= 0) && (timer.elapsed() >= timeLimitMs)) {
+            mUpdateTimer.start(); // continue at the next idle time
+            return;
+        }
+        QList<const BI_Base*> items = mDirtyItems.mid(0, sBatchSize);
+        mDirtyItems = mDirtyItems.mid(items.count());
+        foreach (const BI_Base* item, items) {
+            mDirtyItemsSet.remove(item);
+            removeViolationsOfItem(item);
+        }
+        // violations between two items of the batch are found only once
+        BoardDesignRuleCheck drc(mBoard, mBoard.getDesignRules());
+        drc.execute(items);
+        foreach (const BoardDesignRuleCheck::Violation_t& violation, drc.getViolations()) {
+            addViolation(violation);
+        }
+    }
+}
+
+void BoardOnlineDrc::memorizeDesignRules() noexcept
+{
+    const BoardDesignRules& rules = mBoard.getDesignRules();
+    mCopperClearance = rules.getCopperClearance();
+    mCopperMinWidth = rules.getCopperMinWidth();
+    mDrillMinDiameter = rules.getDrillMinDiameter();
+}
+
+void BoardOnlineDrc::addViolation(const BoardDesignRuleCheck::Violation_t& violation) noexcept
+{
+    QString msgKey;
+    switch (violation.type)
+    {
+        case BoardDesignRuleCheck::ViolationType_t::CopperClearance:
+            msgKey = "CopperClearance"; break;
+        case BoardDesignRuleCheck::ViolationType_t::CopperMinWidth:
+            msgKey = "CopperMinWidth"; break;
+        case BoardDesignRuleCheck::ViolationType_t::DrillMinDiameter:
+            msgKey = "DrillMinDiameter"; break;
+        default: Q_ASSERT(false); break;
+    }
+    // the type (message key) and the involved items identify the violation, so ignored
+    // messages stay ignored even if the items are moved (the items are sorted because
+    // their order depends on the spatial index)
+    QStringList itemKeys;
+    foreach (const BI_Base* item, violation.items) {
+        itemKeys.append(getItemKey(*item));
+    }
+    itemKeys.sort();
+    Violation_t* v = new Violation_t();
+    v->items = violation.items;
+    v->ercMsg = new ErcMsg(mBoard.getProject(), mBoard, QString("%1/%2")
+        .arg(mBoard.getUuid().toStr(), itemKeys.join(',')), msgKey,
+        ErcMsg::ErcMsgType_t::BoardError,
+        QString("%1 (Board: %2)").arg(violation.message, mBoard.getName()));
+    v->ercMsg->setVisible(true);
+    mViolations.insert(v);
+    foreach (const BI_Base* item, v->items) {
+        mViolationsOfItems.insert(item, v);
+    }
+}
+
+QString BoardOnlineDrc::getItemKey(const BI_Base& item) noexcept
+{
+    switch (item.getType())
+    {
+        case BI_Base::Type_t::FootprintPad: {
+            // pad UUIDs are only unique within their footprint
+            const BI_FootprintPad& pad = static_cast<const BI_FootprintPad&>(item);
+            return QString("%1:%2").arg(
+                pad.getFootprint().getDeviceInstance().getComponentInstanceUuid().toStr(),
+                pad.getLibPadUuid().toStr());
+        }
+        case BI_Base::Type_t::Via:
+            return static_cast<const BI_Via&>(item).getUuid().toStr();
+        case BI_Base::Type_t::NetLine:
+            return static_cast<const BI_NetLine&>(item).getUuid().toStr();
+        default:
+            Q_ASSERT(false); // the DRC only reports copper items
+            return QString();
+    }
+}
+
+void BoardOnlineDrc::removeViolationsOfItem(const BI_Base* item) noexcept
+{
+    foreach (Violation_t* v, mViolationsOfItems.values(item)) {
+        foreach (const BI_Base* other, v->items) {
+            mViolationsOfItems.remove(other, v);
+        }
+        mViolations.remove(v);
+        delete v->ercMsg;
+        delete v;
+    }
+}
+
+void BoardOnlineDrc::removeAllViolations() noexcept
+{
+    foreach (Violation_t* v, mViolations) {
+        delete v->ercMsg;
+        delete v;
+    }
+    mViolations.clear();
+    mViolationsOfItems.clear();
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
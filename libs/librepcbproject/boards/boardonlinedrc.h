@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDONLINEDRC_H
+#define LIBREPCB_PROJECT_BOARDONLINEDRC_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/units/all_length_units.h>
+#include "boarddesignrulecheck.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Base;
+class ErcMsg;
+
+/*****************************************************************************************
+ *  Class BoardOnlineDrc
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardOnlineDrc class keeps the design rule check (DRC) results of a board
+ *        up to date while the board is edited
+ *
+ * The board reports every added, modified and removed item (which happens in the undo
+ * commands, e.g. #CmdBoardNetPointEdit or #CmdDeviceInstanceEdit). The affected copper
+ * items (pads, vias and netlines) are marked as dirty, and only these items are checked
+ * again (see BoardDesignRuleCheck::execute(const QList<const BI_Base*>&)): Their old
+ * violations are removed, and the new violations against all neighbours within the
+ * clearance are added. Violations between two items which were not modified are kept.
+ *
+ * The dirty items are processed when the event loop becomes idle, in batches which take
+ * at most #sFrameBudgetMs milliseconds. So even if a lot of items were modified at once,
+ * the editor stays responsive (e.g. while drawing traces); the remaining items are
+ * processed at the next idle time.
+ *
+ * The violations are shown as board ERC messages. As long as the board is not added to
+ * the project, nothing is checked at all. When added, and when the design rules have
+ * changed, the whole board is checked once with the (multi-threaded) full check.
+ */
+class BoardOnlineDrc final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        BoardOnlineDrc() = delete;
+        BoardOnlineDrc(const BoardOnlineDrc& other) = delete;
+        explicit BoardOnlineDrc(Board& board) noexcept;
+        ~BoardOnlineDrc() noexcept;
+
+        // Getters
+        int getViolationCount() const noexcept {return mViolations.count();}
+        bool isUpToDate() const noexcept;
+
+        // General Methods
+        void addToBoard() noexcept;
+        void removeFromBoard() noexcept;
+
+        /**
+         * @brief Mark an item as dirty after it was added to the board or modified
+         */
+        void itemModified(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Remove all violations of an item which was removed from the board
+         */
+        void itemRemoved(const BI_Base& item) noexcept;
+
+        /**
+         * @brief Process all dirty items immediately (without any time limit)
+         */
+        void update() noexcept;
+
+        /**
+         * @brief Check the whole board immediately
+         *
+         * @return The number of violations
+         */
+        int checkAll() noexcept;
+
+        // Operator Overloadings
+        BoardOnlineDrc& operator=(const BoardOnlineDrc& rhs) = delete;
+
+
+    private slots:
+
+        void processDirtyItems() noexcept;
+        void boardAttributesChanged() noexcept;
+
+
+    private:
+
+        // Types
+        struct Violation_t {
+            QList<const BI_Base*> items;
+            ErcMsg* ercMsg;
+        };
+
+        // Private Methods
+        void processDirtyItems(int timeLimitMs) noexcept;
+        void memorizeDesignRules() noexcept;
+        void addViolation(const BoardDesignRuleCheck::Violation_t& violation) noexcept;
+        void removeViolationsOfItem(const BI_Base* item) noexcept;
+        void removeAllViolations() noexcept;
+        static QString getItemKey(const BI_Base& item) noexcept;
+
+
+        // General
+        Board& mBoard; ///< A reference to the Board object (from the ctor)
+        bool mIsAddedToBoard;
+        bool mFullCheckRequired;
+        QList<const BI_Base*> mDirtyItems;
+        QSet<const BI_Base*> mDirtyItemsSet;    ///< to avoid duplicates in mDirtyItems
+        QTimer mUpdateTimer;
+
+        // the design rules of the last check, to detect modifications
+        Length mCopperClearance;
+        Length mCopperMinWidth;
+        Length mDrillMinDiameter;
+
+        // Violations
+        QSet<Violation_t*> mViolations;
+        QMultiHash<const BI_Base*, Violation_t*> mViolationsOfItems;
+
+        // Static Variables
+        static constexpr int sFrameBudgetMs = 10;   ///< max. time per batch of dirty items
+        static constexpr int sBatchSize = 50;       ///< dirty items checked together
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDONLINEDRC_H
@@ -0,0 +1,211 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "boardpanel.h"
+#include <librepcbcommon/fileio/xmldomelement.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardPanel::BoardPanel() noexcept :
+    mColumns(1), mRows(1), mSpacingX(2000000), mSpacingY(2000000), mRotation(),
+    mRailWidth(0), mMouseBiteDiameter(500000), mMouseBitePitch(800000), mMouseBiteCount(5)
+{
+}
+
+BoardPanel::BoardPanel(const XmlDomElement& domElement) throw (Exception)
+{
+    mColumns = qMax(int(domElement.getAttribute<uint>("columns", true)), 1);
+    mRows = qMax(int(domElement.getAttribute<uint>("rows", true)), 1);
+    mSpacingX = domElement.getAttribute<Length>("spacing_x", true);
+    mSpacingY = domElement.getAttribute<Length>("spacing_y", true);
+    mRotation = domElement.getAttribute<Angle>("rotation", true);
+    mRailWidth = domElement.getAttribute<Length>("rail_width", true);
+    mMouseBiteDiameter = domElement.getAttribute<Length>("mouse_bite_diameter", true);
+    mMouseBitePitch = domElement.getAttribute<Length>("mouse_bite_pitch", true);
+    mMouseBiteCount = domElement.getAttribute<uint>("mouse_bite_count", true);
+
+    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+}
+
+BoardPanel::BoardPanel(const BoardPanel& other) noexcept
+{
+    *this = other;
+}
+
+BoardPanel::~BoardPanel() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+Point BoardPanel::getPitch(const BoundingBox& outline) const noexcept
+{
+    BoundingBox box = getRotatedOutline(outline);
+    return Point(box.getWidth() + mSpacingX, box.getHeight() + mSpacingY);
+}
+
+QVector<Point> BoardPanel::getInstanceOffsets(const BoundingBox& outline) const noexcept
+{
+    Point pitch = getPitch(outline);
+    QVector<Point> offsets;
+    for (int row = 0; row < mRows; ++row) {
+        for (int column = 0; column < mColumns; ++column) {
+            offsets.append(Point(pitch.getX() * column, pitch.getY() * row));
+        }
+    }
+    return offsets;
+}
+
+Point BoardPanel::getFirstInstanceOffset(const BoundingBox& outline) const noexcept
+{
+    return Point(Length(0), mRailWidth) - getRotatedOutline(outline).getMin();
+}
+
+BoundingBox BoardPanel::getFrame(const BoundingBox& outline) const noexcept
+{
+    BoundingBox box = getRotatedOutline(outline);
+    Point pitch = getPitch(outline);
+    Length width = pitch.getX() * (mColumns - 1) + box.getWidth();
+    Length height = pitch.getY() * (mRows - 1) + box.getHeight() + mRailWidth * 2;
+    return BoundingBox(Point(0, 0), Point(width, height));
+}
+
+QVector<Point> BoardPanel::getMouseBites(const BoundingBox& outline) const noexcept
+{
+    QVector<Point> holes;
+    if ((mMouseBiteCount < 1) || (mMouseBiteDiameter <= 0)) return holes;
+
+    BoundingBox box = getRotatedOutline(outline);
+    Point pitch = getPitch(outline);
+    for (int row = 0; row < mRows; ++row) {
+        for (int column = 0; column < mColumns; ++column) {
+            Point min(pitch.getX() * column, mRailWidth + pitch.getY() * row);
+            Point max = min + Point(box.getWidth(), box.getHeight());
+            Point center = (min + max) / 2;
+            // only edges which face another board or a rail are connected
+            if ((row > 0) || (mRailWidth > 0)) {
+                addMouseBiteRow(holes, Point(center.getX(), min.getY()), Point(1, 0));
+            }
+            if ((row < mRows - 1) || (mRailWidth > 0)) {
+                addMouseBiteRow(holes, Point(center.getX(), max.getY()), Point(1, 0));
+            }
+            if (column > 0) {
+                addMouseBiteRow(holes, Point(min.getX(), center.getY()), Point(0, 1));
+            }
+            if (column < mColumns - 1) {
+                addMouseBiteRow(holes, Point(max.getX(), center.getY()), Point(0, 1));
+            }
+        }
+    }
+    return holes;
+}
+
+XmlDomElement* BoardPanel::serializeToXmlDomElement() const throw (Exception)
+{
+    if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
+
+    QScopedPointer<XmlDomElement> root(new XmlDomElement("panel"));
+    root->setAttribute("columns", mColumns);
+    root->setAttribute("rows", mRows);
+    root->setAttribute("spacing_x", mSpacingX);
+    root->setAttribute("spacing_y", mSpacingY);
+    root->setAttribute("rotation", mRotation);
+    root->setAttribute("rail_width", mRailWidth);
+    root->setAttribute("mouse_bite_diameter", mMouseBiteDiameter);
+    root->setAttribute("mouse_bite_pitch", mMouseBitePitch);
+    root->setAttribute("mouse_bite_count", mMouseBiteCount);
+    return root.take();
+}
+
+/*****************************************************************************************
+ *  Operators
+ ****************************************************************************************/
+
+BoardPanel& BoardPanel::operator=(const BoardPanel& rhs) noexcept
+{
+    mColumns = rhs.mColumns;
+    mRows = rhs.mRows;
+    mSpacingX = rhs.mSpacingX;
+    mSpacingY = rhs.mSpacingY;
+    mRotation = rhs.mRotation;
+    mRailWidth = rhs.mRailWidth;
+    mMouseBiteDiameter = rhs.mMouseBiteDiameter;
+    mMouseBitePitch = rhs.mMouseBitePitch;
+    mMouseBiteCount = rhs.mMouseBiteCount;
+    return *this;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+bool BoardPanel::checkAttributesValidity() const noexcept
+{
+    if (mColumns < 1)                   return false;
+    if (mRows < 1)                      return false;
+    if (mSpacingX < 0)                  return false;
+    if (mSpacingY < 0)                  return false;
+    if (mRailWidth < 0)                 return false;
+    if (mMouseBiteDiameter < 0)         return false;
+    if (mMouseBitePitch < 0)            return false;
+    if (mMouseBiteCount < 0)            return false;
+    return true;
+}
+
+BoundingBox BoardPanel::getRotatedOutline(const BoundingBox& outline) const noexcept
+{
+    const Point& min = outline.getMin();
+    const Point& max = outline.getMax();
+    return BoundingBox(min.rotated(mRotation), max.rotated(mRotation))
+        .united(Point(min.getX(), max.getY()).rotated(mRotation))
+        .united(Point(max.getX(), min.getY()).rotated(mRotation));
+}
+
+void BoardPanel::addMouseBiteRow(QVector<Point>& holes, const Point& center,
+                                 const Point& direction) const noexcept
+{
+    for (int i = 0; i < mMouseBiteCount; ++i) {
+        // i - (count - 1) / 2 in units of half the pitch, to keep the row centered
+        Length distance = mMouseBitePitch * (2 * i - (mMouseBiteCount - 1)) / 2;
+        holes.append(center + Point(direction.getX() * distance.toNm(),
+                                    direction.getY() * distance.toNm()));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,174 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDPANEL_H
+#define LIBREPCB_PROJECT_BOARDPANEL_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/fileio/if_xmlserializableobject.h>
+#include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/geometry/boundingbox.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Class BoardPanel
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardPanel class defines how copies of a board are arranged in a panel
+ *
+ * The panel is an array of columns * rows instances of the board. Every instance is
+ * rotated by the same angle, and the instances are separated by the spacing (the gap
+ * between the bounding boxes of the rotated board outlines). Optionally, rails are
+ * added at the top and bottom of the panel, and mouse-bites (rows of small holes) are
+ * added at the middle of every board edge which faces another board or a rail.
+ *
+ * Panel coordinates: The bottom left corner of the rotated board outline of the first
+ * instance is placed at (0, railWidth), the panel frame starts at (0, 0).
+ *
+ * A panel with a single instance and without rails is disabled (see #isEnabled()).
+ */
+class BoardPanel final : public IF_XmlSerializableObject
+{
+        Q_DECLARE_TR_FUNCTIONS(BoardPanel)
+
+    public:
+
+        // Constructors / Destructor
+        BoardPanel() noexcept;
+        explicit BoardPanel(const XmlDomElement& domElement) throw (Exception);
+        BoardPanel(const BoardPanel& other) noexcept;
+        ~BoardPanel() noexcept;
+
+        // Getters
+        bool isEnabled() const noexcept {
+            return (mColumns > 1) || (mRows > 1) || (mRailWidth > 0);
+        }
+        int getColumns() const noexcept {return mColumns;}
+        int getRows() const noexcept {return mRows;}
+        const Length& getSpacingX() const noexcept {return mSpacingX;}
+        const Length& getSpacingY() const noexcept {return mSpacingY;}
+        const Angle& getRotation() const noexcept {return mRotation;}
+        const Length& getRailWidth() const noexcept {return mRailWidth;}
+        const Length& getMouseBiteDiameter() const noexcept {return mMouseBiteDiameter;}
+        const Length& getMouseBitePitch() const noexcept {return mMouseBitePitch;}
+        int getMouseBiteCount() const noexcept {return mMouseBiteCount;}
+
+        // Setters
+        void setColumns(int columns) noexcept {mColumns = qMax(columns, 1);}
+        void setRows(int rows) noexcept {mRows = qMax(rows, 1);}
+        void setSpacingX(const Length& spacing) noexcept {mSpacingX = qMax(spacing, Length(0));}
+        void setSpacingY(const Length& spacing) noexcept {mSpacingY = qMax(spacing, Length(0));}
+        void setRotation(const Angle& rotation) noexcept {mRotation = rotation;}
+        void setRailWidth(const Length& width) noexcept {mRailWidth = qMax(width, Length(0));}
+        void setMouseBiteDiameter(const Length& diameter) noexcept {
+            mMouseBiteDiameter = qMax(diameter, Length(0));
+        }
+        void setMouseBitePitch(const Length& pitch) noexcept {
+            mMouseBitePitch = qMax(pitch, Length(0));
+        }
+        void setMouseBiteCount(int count) noexcept {mMouseBiteCount = qMax(count, 0);}
+
+        // General Methods
+
+        /**
+         * @brief Get the distance between two instances (columns and rows)
+         *
+         * @param outline   The bounding box of the (not rotated) board outline
+         */
+        Point getPitch(const BoundingBox& outline) const noexcept;
+
+        /**
+         * @brief Get the offset of every instance, relative to the first instance
+         *
+         * @param outline   The bounding box of the (not rotated) board outline
+         */
+        QVector<Point> getInstanceOffsets(const BoundingBox& outline) const noexcept;
+
+        /**
+         * @brief Get the offset which places the first instance in the panel
+         *
+         * @param outline   The bounding box of the (not rotated) board outline
+         *
+         * @return The offset to add after rotating a board coordinate
+         */
+        Point getFirstInstanceOffset(const BoundingBox& outline) const noexcept;
+
+        /**
+         * @brief Get the bounding box of the whole panel (incl. rails)
+         *
+         * @param outline   The bounding box of the (not rotated) board outline
+         */
+        BoundingBox getFrame(const BoundingBox& outline) const noexcept;
+
+        /**
+         * @brief Get the positions of all mouse-bite holes (in panel coordinates)
+         *
+         * @param outline   The bounding box of the (not rotated) board outline
+         */
+        QVector<Point> getMouseBites(const BoundingBox& outline) const noexcept;
+
+        /// @copydoc IF_XmlSerializableObject#serializeToXmlDomElement()
+        XmlDomElement* serializeToXmlDomElement() const throw (Exception) override;
+
+        // Operators
+        BoardPanel& operator=(const BoardPanel& rhs) noexcept;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
+        bool checkAttributesValidity() const noexcept override;
+
+        BoundingBox getRotatedOutline(const BoundingBox& outline) const noexcept;
+        void addMouseBiteRow(QVector<Point>& holes, const Point& center,
+                             const Point& direction) const noexcept;
+
+
+        // Attributes
+        int mColumns;
+        int mRows;
+        Length mSpacingX;           ///< the gap between two columns
+        Length mSpacingY;           ///< the gap between two rows
+        Angle mRotation;            ///< the rotation of every board instance
+        Length mRailWidth;          ///< the width of the top and bottom rails (0 = none)
+        Length mMouseBiteDiameter;
+        Length mMouseBitePitch;     ///< the distance between two holes of a mouse-bite
+        int mMouseBiteCount;        ///< the number of holes per mouse-bite (0 = none)
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDPANEL_H
@@ -0,0 +1,198 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/geometry/ratsnestbuilder.h>
+#include <librepcbcommon/graphics/graphicsscene.h>
+#include "boardratsnest.h"
+#include "board.h"
+#include "boardconnectivity.h"
+#include "graphicsitems/bgi_airwires.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_via.h"
+#include "items/bi_netpoint.h"
+#include "../project.h"
+#include "../circuit/circuit.h"
+#include "../circuit/netsignal.h"
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BoardRatsnest::BoardRatsnest(Board& board) noexcept :
+    QObject(&board), mBoard(board), mGraphicsScene(nullptr)
+{
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(0);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &BoardRatsnest::update);
+    connect(&mBoard.getConnectivity(), &BoardConnectivity::netSignalInvalidated,
+            this, &BoardRatsnest::netSignalInvalidated);
+    connect(&mBoard.getProject().getCircuit(), &Circuit::netSignalRemoved,
+            this, &BoardRatsnest::netSignalRemoved);
+}
+
+BoardRatsnest::~BoardRatsnest() noexcept
+{
+    Q_ASSERT(!mGraphicsScene);
+    qDeleteAll(mGraphicsItems);     mGraphicsItems.clear();
+}
+
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+QList<QPair<Point, Point>> BoardRatsnest::getAirWires(const NetSignal& netsignal) const noexcept
+{
+    BGI_AirWires* item = mGraphicsItems.value(&netsignal, nullptr);
+    return item ? item->getAirWires() : QList<QPair<Point, Point>>();
+}
+
+int BoardRatsnest::getAirWireCount() const noexcept
+{
+    int count = 0;
+    foreach (const BGI_AirWires* item, mGraphicsItems) {
+        count += item->getAirWires().count();
+    }
+    return count;
+}
+
+/*****************************************************************************************
+ *  General Methods
+ ****************************************************************************************/
+
+void BoardRatsnest::addToBoard(GraphicsScene& scene) noexcept
+{
+    Q_ASSERT(!mGraphicsScene);
+    mGraphicsScene = &scene;
+    foreach (const NetSignal* netsignal, mBoard.getProject().getCircuit().getNetSignals()) {
+        mInvalidatedNetSignals.insert(netsignal);
+    }
+    update();
+}
+
+void BoardRatsnest::removeFromBoard(GraphicsScene& scene) noexcept
+{
+    Q_ASSERT(mGraphicsScene == &scene);
+    mUpdateTimer.stop();
+    mInvalidatedNetSignals.clear();
+    foreach (BGI_AirWires* item, mGraphicsItems) {
+        disconnect(&item->getNetSignal(), nullptr, this, nullptr);
+        scene.removeItem(*item);
+        delete item;
+    }
+    mGraphicsItems.clear();
+    mGraphicsScene = nullptr;
+}
+
+void BoardRatsnest::update() noexcept
+{
+    mUpdateTimer.stop();
+    if (!mGraphicsScene) return;
+    foreach (const NetSignal* netsignal, mInvalidatedNetSignals) {
+        updateNetSignal(*netsignal);
+    }
+    mInvalidatedNetSignals.clear();
+}
+
+/*****************************************************************************************
+ *  Private Slots
+ ****************************************************************************************/
+
+void BoardRatsnest::netSignalInvalidated(const NetSignal* netsignal) noexcept
+{
+    if (!mGraphicsScene) return; // will be calculated when added to the board
+    mInvalidatedNetSignals.insert(netsignal);
+    mUpdateTimer.start();
+}
+
+void BoardRatsnest::netSignalRemoved(NetSignal& netsignal) noexcept
+{
+    mInvalidatedNetSignals.remove(&netsignal);
+    BGI_AirWires* item = mGraphicsItems.take(&netsignal);
+    if (item) {
+        disconnect(&netsignal, nullptr, this, nullptr);
+        if (mGraphicsScene) mGraphicsScene->removeItem(*item);
+        delete item;
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void BoardRatsnest::updateNetSignal(const NetSignal& netsignal) noexcept
+{
+    // collect the anchors of all islands
+    QVector<Point> positions;
+    QVector<int> islands;
+    const QList<BoardConnectivity::Island_t>& netIslands =
+        mBoard.getConnectivity().getIslands(netsignal);
+    for (int i = 0; i < netIslands.count(); ++i) {
+        const BoardConnectivity::Island_t& island = netIslands.at(i);
+        foreach (const BI_FootprintPad* pad, island.pads) {
+            positions.append(pad->getPosition());
+            islands.append(i);
+        }
+        foreach (const BI_Via* via, island.vias) {
+            positions.append(via->getPosition());
+            islands.append(i);
+        }
+        foreach (const BI_NetPoint* netpoint, island.netpoints) {
+            positions.append(netpoint->getPosition());
+            islands.append(i);
+        }
+    }
+
+    // connect the islands with a minimum spanning tree
+    QList<QPair<Point, Point>> airwires;
+    for (const QPair<int, int>& airwire : RatsnestBuilder::build(positions, islands)) {
+        airwires.append(qMakePair(positions.at(airwire.first), positions.at(airwire.second)));
+    }
+
+    // update the graphics item (created on demand, most nets never need one)
+    BGI_AirWires* item = mGraphicsItems.value(&netsignal, nullptr);
+    if ((!item) && (!airwires.isEmpty())) {
+        item = new BGI_AirWires(mBoard, netsignal);
+        mGraphicsItems.insert(&netsignal, item);
+        mGraphicsScene->addItem(*item);
+        connect(&netsignal, &NetSignal::highlightedChanged, this, [this, &netsignal](){
+            BGI_AirWires* airWires = mGraphicsItems.value(&netsignal, nullptr);
+            if (airWires) airWires->update();
+        });
+    }
+    if (item) {
+        item->setAirWires(airwires);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDRATSNEST_H
+#define LIBREPCB_PROJECT_BOARDRATSNEST_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/units/all_length_units.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class GraphicsScene;
+
+namespace project {
+
+class Board;
+class NetSignal;
+class BGI_AirWires;
+
+/*****************************************************************************************
+ *  Class BoardRatsnest
+ ****************************************************************************************/
+
+/**
+ * @brief The BoardRatsnest class calculates and shows the air wires of a board
+ *
+ * For every net signal, the islands from #project#BoardConnectivity are connected with
+ * the shortest possible air wires (a minimum spanning tree, see #RatsnestBuilder). The
+ * air wires of a net signal are shown by one #project#BGI_AirWires graphics item.
+ *
+ * The ratsnest is updated incrementally: Only the net signals which were invalidated by
+ * the connectivity are recalculated. As long as the board is not added to the project,
+ * nothing is calculated at all. Several modifications in a row (e.g. when moving a
+ * device) are coalesced and handled together once the event loop becomes idle.
+ */
+class BoardRatsnest final : public QObject
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        BoardRatsnest() = delete;
+        BoardRatsnest(const BoardRatsnest& other) = delete;
+        explicit BoardRatsnest(Board& board) noexcept;
+        ~BoardRatsnest() noexcept;
+
+        // Getters
+        QList<QPair<Point, Point>> getAirWires(const NetSignal& netsignal) const noexcept;
+        int getAirWireCount() const noexcept;
+
+        // General Methods
+        void addToBoard(GraphicsScene& scene) noexcept;
+        void removeFromBoard(GraphicsScene& scene) noexcept;
+
+        /**
+         * @brief Recalculate all invalidated net signals immediately
+         */
+        void update() noexcept;
+
+        // Operator Overloadings
+        BoardRatsnest& operator=(const BoardRatsnest& rhs) = delete;
+
+
+    private slots:
+
+        void netSignalInvalidated(const NetSignal* netsignal) noexcept;
+        void netSignalRemoved(NetSignal& netsignal) noexcept;
+
+
+    private:
+
+        void updateNetSignal(const NetSignal& netsignal) noexcept;
+
+
+        // General
+        Board& mBoard; ///< A reference to the Board object (from the ctor)
+        GraphicsScene* mGraphicsScene; ///< nullptr if not added to the board
+        QSet<const NetSignal*> mInvalidatedNetSignals;
+        QTimer mUpdateTimer;
+        QHash<const NetSignal*, BGI_AirWires*> mGraphicsItems;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BOARDRATSNEST_H
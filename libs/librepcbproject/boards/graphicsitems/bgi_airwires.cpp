@@ -0,0 +1,107 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_airwires.h"
+#include "../board.h"
+#include "../boardlayerstack.h"
+#include "../../circuit/netsignal.h"
+#include <librepcbcommon/boardlayer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+BGI_AirWires::BGI_AirWires(Board& board, const NetSignal& netsignal) noexcept :
+    BGI_Base(), mBoard(board), mNetSignal(netsignal), mLayer(nullptr)
+{
+    setZValue(Board::ZValue_AirWires);
+    mLayer = getBoardLayer(BoardLayer::Unrouted);
+}
+
+BGI_AirWires::~BGI_AirWires() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BGI_AirWires::setAirWires(const QList<QPair<Point, Point>>& airwires) noexcept
+{
+    if (airwires == mAirWires) return;
+    prepareGeometryChange();
+    mAirWires = airwires;
+    mLines.clear();
+    mBoundingRect = QRectF();
+    for (const QPair<Point, Point>& airwire : mAirWires) {
+        QLineF line(airwire.first.toPxQPointF(), airwire.second.toPxQPointF());
+        mLines.append(line);
+        mBoundingRect |= QRectF(line.p1(), line.p2()).normalized();
+    }
+    if (!mLines.isEmpty()) {
+        // the lines are drawn with a cosmetic pen, so add some margin for antialiasing
+        mBoundingRect.adjust(-1, -1, 1, 1);
+    }
+    update();
+}
+
+/*****************************************************************************************
+ *  Inherited from QGraphicsItem
+ ****************************************************************************************/
+
+void BGI_AirWires::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    // air wires are not a part of the physical board, so they are not printed/exported
+    if (mLayer && mLayer->isVisible() && (!mLines.isEmpty()) && (!isPrinting(painter))) {
+        // draw air wires
+        painter->setPen(QPen(mLayer->getColor(mNetSignal.isHighlighted()), 0));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawLines(mLines);
+    }
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+BoardLayer* BGI_AirWires::getBoardLayer(int id) const noexcept
+{
+    return mBoard.getLayerStack().getBoardLayer(id);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,101 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BGI_AIRWIRES_H
+#define LIBREPCB_PROJECT_BGI_AIRWIRES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "bgi_base.h"
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class BoardLayer;
+
+namespace project {
+
+class NetSignal;
+
+/*****************************************************************************************
+ *  Class BGI_AirWires
+ ****************************************************************************************/
+
+/**
+ * @brief The BGI_AirWires class draws all air wires (ratsnest lines) of one net signal
+ *
+ * The air wires are not selectable, they are only a visual hint which pads still need
+ * to be connected. See #project#BoardRatsnest for how they are calculated.
+ */
+class BGI_AirWires final : public BGI_Base
+{
+    public:
+
+        // Constructors / Destructor
+        explicit BGI_AirWires(Board& board, const NetSignal& netsignal) noexcept;
+        ~BGI_AirWires() noexcept;
+
+        // Getters
+        const NetSignal& getNetSignal() const noexcept {return mNetSignal;}
+        const QList<QPair<Point, Point>>& getAirWires() const noexcept {return mAirWires;}
+
+        // Setters
+        void setAirWires(const QList<QPair<Point, Point>>& airwires) noexcept;
+
+        // Inherited from QGraphicsItem
+        QRectF boundingRect() const {return mBoundingRect;}
+        QPainterPath shape() const noexcept {return QPainterPath();}
+        void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+
+    private:
+
+        // make some methods inaccessible...
+        BGI_AirWires() = delete;
+        BGI_AirWires(const BGI_AirWires& other) = delete;
+        BGI_AirWires& operator=(const BGI_AirWires& rhs) = delete;
+
+        // Private Methods
+        BoardLayer* getBoardLayer(int id) const noexcept;
+
+
+        // General Attributes
+        Board& mBoard;
+        const NetSignal& mNetSignal;
+        BoardLayer* mLayer;
+        QList<QPair<Point, Point>> mAirWires;
+
+        // Cached Attributes
+        QVector<QLineF> mLines;
+        QRectF mBoundingRect;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_BGI_AIRWIRES_H
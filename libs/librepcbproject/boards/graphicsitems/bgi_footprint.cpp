@@ -185,7 +185,7 @@ void BGI_Footprint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opt
 
     const BoardLayer* layer = 0;
     const bool selected = mFootprint.isSelected();
-    const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    const bool deviceIsPrinter = isPrinting(painter);
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     // draw all polygons
@@ -93,6 +93,13 @@ void BGI_Polygon::paint(QPainter* painter, const QStyleOptionGraphicsItem* optio
     Q_UNUSED(option);
 
     if (mLayer && mLayer->isVisible()) {
+        // draw copper fill (only available for copper zones)
+        if (!mBiPolygon.getCopperFillScenePx().isEmpty()) {
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(mLayer->getColor(selected));
+            painter->drawPath(mBiPolygon.getCopperFillScenePx());
+        }
+
         // draw polygon outline
         painter->setPen(QPen(mLayer->getColor(selected), mPolygon.getLineWidth().toPx(),
                              Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
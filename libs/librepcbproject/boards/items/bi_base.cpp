@@ -38,7 +38,8 @@ namespace project {
  ****************************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept :
-    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false)
+    QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false),
+    mBoundingBoxCached(false)
 {
 }
 
@@ -61,6 +62,21 @@ Circuit& BI_Base::getCircuit() const noexcept
     return mBoard.getProject().getCircuit();
 }
 
+const BoundingBox& BI_Base::getBoundingBox() const noexcept
+{
+    if (!mBoundingBoxCached) {
+        mBoundingBox = calcBoundingBox();
+        mBoundingBoxCached = true;
+    }
+    return mBoundingBox;
+}
+
+bool BI_Base::isAtScenePos(const Point& pos) const noexcept
+{
+    // fallback for arbitrary shapes, derived classes should provide an exact test
+    return getBoundingBox().contains(pos) && getGrabAreaScenePx().contains(pos.toPxQPointF());
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -100,6 +116,25 @@ void BI_Base::removeFromBoard(GraphicsScene& scene, BGI_Base& item) noexcept
     mIsAddedToBoard = false;
 }
 
+BoundingBox BI_Base::calcBoundingBox() const noexcept
+{
+    try
+    {
+        return BoundingBox::fromPx(getGrabAreaScenePx().boundingRect());
+    }
+    catch (const Exception& e)
+    {
+        qCritical() << "Could not calculate bounding box:" << e.getUserMsg();
+        return BoundingBox();
+    }
+}
+
+void BI_Base::grabAreaChanged() noexcept
+{
+    mBoundingBoxCached = false;
+    mBoard.updateSpatialIndex(*this);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/geometry/boundingbox.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -79,6 +80,8 @@ class BI_Base : public QObject
         virtual const Point& getPosition() const noexcept = 0;
         virtual bool getIsMirrored() const noexcept = 0;
         virtual QPainterPath getGrabAreaScenePx() const noexcept = 0;
+        const BoundingBox& getBoundingBox() const noexcept;
+        virtual bool isAtScenePos(const Point& pos) const noexcept;
         virtual bool isAddedToBoard() const noexcept {return mIsAddedToBoard;}
         virtual bool isSelectable() const noexcept = 0;
         virtual bool isSelected() const noexcept {return mIsSelected;}
@@ -86,6 +89,14 @@ class BI_Base : public QObject
         // Setters
         virtual void setSelected(bool selected) noexcept;
 
+        /**
+         * @brief Change the selection state without repainting the item
+         *
+         * Used by Board::setSelectionRect() to apply many selection changes at once, the
+         * caller is responsible for updating the graphics scene afterwards.
+         */
+        void setSelectedWithoutRepaint(bool selected) noexcept {mIsSelected = selected;}
+
         // General Methods
         virtual void addToBoard(GraphicsScene& scene) throw (Exception) = 0;
         virtual void removeFromBoard(GraphicsScene& scene) throw (Exception) = 0;
@@ -96,6 +107,19 @@ class BI_Base : public QObject
 
     protected:
 
+        /**
+         * @brief Calculate the bounding box of the grab area
+         *
+         * The default implementation uses the bounding rect of #getGrabAreaScenePx(),
+         * items with a simple shape should override this with an exact calculation.
+         */
+        virtual BoundingBox calcBoundingBox() const noexcept;
+
+        /**
+         * @brief Must be called by all derived classes whenever their grab area changed
+         */
+        void grabAreaChanged() noexcept;
+
         // General Methods
         void addToBoard() noexcept;
         void removeFromBoard() noexcept;
@@ -113,6 +137,8 @@ class BI_Base : public QObject
         // General Attributes
         bool mIsAddedToBoard;
         bool mIsSelected;
+        mutable BoundingBox mBoundingBox;   ///< cached result of #calcBoundingBox()
+        mutable bool mBoundingBoxCached;    ///< false if #mBoundingBox is outdated
 };
 
 /*****************************************************************************************
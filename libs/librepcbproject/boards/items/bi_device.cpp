@@ -174,6 +174,7 @@ void BI_Device::setPosition(const Point& pos) noexcept
     if (pos != mPosition) {
         mPosition = pos;
         emit moved(mPosition);
+        grabAreaChanged();
     }
 }
 
@@ -182,6 +183,7 @@ void BI_Device::setRotation(const Angle& rot) noexcept
     if (rot != mRotation) {
         mRotation = rot;
         emit rotated(mRotation);
+        grabAreaChanged();
     }
 }
 
@@ -193,6 +195,7 @@ void BI_Device::setIsMirrored(bool mirror) throw (Exception)
         }
         mIsMirrored = mirror;
         emit mirrored(mIsMirrored);
+        grabAreaChanged();
     }
 }
 
@@ -244,6 +244,7 @@ void BI_Footprint::setSelected(bool selected) noexcept
 void BI_Footprint::deviceInstanceAttributesChanged()
 {
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
     emit attributesChanged();
 }
 
@@ -251,6 +252,7 @@ void BI_Footprint::deviceInstanceMoved(const Point& pos)
 {
     mGraphicsItem->setPos(pos.toPxQPointF());
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
     }
@@ -261,6 +263,7 @@ void BI_Footprint::deviceInstanceRotated(const Angle& rot)
     Q_UNUSED(rot);
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
     }
@@ -271,6 +274,7 @@ void BI_Footprint::deviceInstanceMirrored(bool mirrored)
     Q_UNUSED(mirrored);
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
     foreach (BI_FootprintPad* pad, mPads) {
         pad->updatePosition();
     }
@@ -25,6 +25,7 @@
 #include "bi_footprint.h"
 #include <librepcblibrary/pkg/footprint.h>
 #include <librepcblibrary/pkg/footprintpad.h>
+#include <librepcblibrary/pkg/footprintpadtht.h>
 #include <librepcblibrary/pkg/packagepad.h>
 #include "../board.h"
 #include "../../project.h"
@@ -40,6 +41,9 @@
 #include <librepcbcommon/boardlayer.h>
 #include "../../circuit/netsignal.h"
 #include <librepcblibrary/pkg/package.h>
+#include <librepcbcommon/geometry/hittest.h>
+#include <librepcbcommon/geometry/convexshape.h>
+#include "../boardconnectivity.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -74,6 +78,12 @@ BI_FootprintPad::BI_FootprintPad(BI_Footprint& footprint, const Uuid& padUuid) :
     // connect to the "attributes changed" signal of the footprint
     connect(&mFootprint, &BI_Footprint::attributesChanged,
             this, &BI_FootprintPad::footprintAttributesChanged);
+
+    // connect to the "net signal changed" signal of the component signal instance
+    if (mComponentSignalInstance) {
+        connect(mComponentSignalInstance, &ComponentSignalInstance::netSignalChanged,
+                this, &BI_FootprintPad::componentSignalInstanceNetSignalChanged);
+    }
 }
 
 BI_FootprintPad::~BI_FootprintPad()
@@ -118,6 +128,24 @@ bool BI_FootprintPad::isOnLayer(int layerId) const noexcept
     }
 }
 
+ConvexShape BI_FootprintPad::getCopperShape() const noexcept
+{
+    const Length& width = mFootprintPad->getWidth();
+    const Length& height = mFootprintPad->getHeight();
+    Angle rotation = getSceneRotation();
+    if (mFootprintPad->getTechnology() == library::FootprintPad::Technology_t::THT) {
+        const library::FootprintPadTht* tht =
+            dynamic_cast<const library::FootprintPadTht*>(mFootprintPad);
+        Q_ASSERT(tht);
+        if (tht && (tht->getShape() == library::FootprintPadTht::Shape_t::ROUND)) {
+            return ConvexShape::obround(mPosition, width, height, rotation);
+        } else if (tht && (tht->getShape() == library::FootprintPadTht::Shape_t::OCTAGON)) {
+            return ConvexShape::octagon(mPosition, width, height, rotation);
+        }
+    }
+    return ConvexShape::rect(mPosition, width, height, rotation);
+}
+
 NetSignal* BI_FootprintPad::getCompSigInstNetSignal() const noexcept
 {
     if (mComponentSignalInstance) {
@@ -195,6 +223,7 @@ void BI_FootprintPad::updatePosition() noexcept
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     updateGraphicsItemTransform();
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
     foreach (BI_NetPoint* netpoint, mRegisteredNetPoints) {
         netpoint->setPosition(mPosition);
     }
@@ -214,6 +243,25 @@ QPainterPath BI_FootprintPad::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+bool BI_FootprintPad::isAtScenePos(const Point& pos) const noexcept
+{
+    if (!getBoundingBox().contains(pos)) return false;
+    const Length& width = mFootprintPad->getWidth();
+    const Length& height = mFootprintPad->getHeight();
+    Angle rotation = getSceneRotation();
+    if (mFootprintPad->getTechnology() == library::FootprintPad::Technology_t::THT) {
+        const library::FootprintPadTht* tht =
+            dynamic_cast<const library::FootprintPadTht*>(mFootprintPad);
+        Q_ASSERT(tht);
+        if (tht && (tht->getShape() == library::FootprintPadTht::Shape_t::ROUND)) {
+            return HitTest::isPointInObround(pos, mPosition, width, height, rotation);
+        } else if (tht && (tht->getShape() == library::FootprintPadTht::Shape_t::OCTAGON)) {
+            return HitTest::isPointInOctagon(pos, mPosition, width, height, rotation);
+        }
+    }
+    return HitTest::isPointInRect(pos, mPosition, width, height, rotation);
+}
+
 bool BI_FootprintPad::isSelectable() const noexcept
 {
     return mFootprint.isSelectable() && mGraphicsItem->isSelectable();
@@ -234,10 +282,36 @@ void BI_FootprintPad::footprintAttributesChanged()
     mGraphicsItem->updateCacheAndRepaint();
 }
 
+void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from, NetSignal* to)
+{
+    mGraphicsItem->updateCacheAndRepaint(); // the displayed net name has changed
+    if (!isAddedToBoard()) return;
+    disconnect(mHighlightChangedConnection);
+    if (to) {
+        mHighlightChangedConnection = connect(to, &NetSignal::highlightedChanged,
+                                              [this](){mGraphicsItem->update();});
+    }
+    mBoard.getConnectivity().invalidate(from);
+    mBoard.getConnectivity().invalidate(to);
+    mBoard.itemNetSignalChanged(*this);
+}
+
 /*****************************************************************************************
  *  Private Methods
  ****************************************************************************************/
 
+BoundingBox BI_FootprintPad::calcBoundingBox() const noexcept
+{
+    Point corner(mFootprintPad->getWidth() / 2, mFootprintPad->getHeight() / 2);
+    Point corner2(corner.getX(), -corner.getY());
+    Angle rotation = getSceneRotation();
+    BoundingBox box;
+    foreach (const Point& p, QList<Point>({corner, -corner, corner2, -corner2})) {
+        box = box.united(mPosition + p.rotated(rotation));
+    }
+    return box;
+}
+
 void BI_FootprintPad::updateGraphicsItemTransform() noexcept
 {
     QTransform t;
@@ -246,6 +320,12 @@ void BI_FootprintPad::updateGraphicsItemTransform() noexcept
     mGraphicsItem->setTransform(t);
 }
 
+Angle BI_FootprintPad::getSceneRotation() const noexcept
+{
+    // all pad shapes are symmetric, so mirroring is the same as negating the rotation
+    return mFootprint.getIsMirrored() ? -mRotation : mRotation;
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -32,6 +32,8 @@
  ****************************************************************************************/
 namespace librepcb {
 
+class ConvexShape;
+
 namespace library {
 class FootprintPad;
 class ComponentSignal;
@@ -72,6 +74,7 @@ class BI_FootprintPad final : public BI_Base
         BI_NetPoint* getNetPointOfLayer(int layerId) const noexcept {return mRegisteredNetPoints.value(layerId, nullptr);}
         int getLayerId() const noexcept;
         bool isOnLayer(int layerId) const noexcept;
+        ConvexShape getCopperShape() const noexcept;
         const library::FootprintPad& getLibPad() const noexcept {return *mFootprintPad;}
         ComponentSignalInstance* getComponentSignalInstance() const noexcept {return mComponentSignalInstance;}
         NetSignal* getCompSigInstNetSignal() const noexcept;
@@ -91,6 +94,7 @@ class BI_FootprintPad final : public BI_Base
         const Point& getPosition() const noexcept override {return mPosition;}
         bool getIsMirrored() const noexcept override;
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -100,11 +104,16 @@ class BI_FootprintPad final : public BI_Base
     private slots:
 
         void footprintAttributesChanged();
+        void componentSignalInstanceNetSignalChanged(NetSignal* from, NetSignal* to);
 
 
     private:
 
+        // Inherited from BI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
         void updateGraphicsItemTransform() noexcept;
+        Angle getSceneRotation() const noexcept;
 
 
         // General
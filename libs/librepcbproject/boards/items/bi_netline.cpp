@@ -31,6 +31,8 @@
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include <librepcbcommon/graphics/graphicsscene.h>
 #include <librepcbcommon/scopeguard.h>
+#include <librepcbcommon/geometry/hittest.h>
+#include <librepcbcommon/geometry/convexshape.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -146,6 +148,11 @@ bool BI_NetLine::isAttachedToVia() const noexcept
     return (mStartPoint->isAttachedToVia() || mEndPoint->isAttachedToVia());
 }
 
+ConvexShape BI_NetLine::getCopperShape() const noexcept
+{
+    return ConvexShape::capsule(mStartPoint->getPosition(), mEndPoint->getPosition(), mWidth);
+}
+
 bool BI_NetLine::isAttachedToFootprint() const noexcept
 {
     return (mStartPoint->isAttachedToPad() || mEndPoint->isAttachedToPad());
@@ -161,6 +168,9 @@ void BI_NetLine::setWidth(const Length& width) noexcept
     if ((width != mWidth) && (width >= 0)) {
         mWidth = width;
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
+        mStartPoint->netLineWidthChanged();
+        mEndPoint->netLineWidthChanged();
     }
 }
 
@@ -205,6 +215,7 @@ void BI_NetLine::updateLine() noexcept
 {
     mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
 }
 
 XmlDomElement* BI_NetLine::serializeToXmlDomElement() const throw (Exception)
@@ -228,6 +239,12 @@ QPainterPath BI_NetLine::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->shape();
 }
 
+bool BI_NetLine::isAtScenePos(const Point& pos) const noexcept
+{
+    return getBoundingBox().contains(pos) && HitTest::isPointInCapsule(pos,
+        mStartPoint->getPosition(), mEndPoint->getPosition(), getGrabAreaWidth());
+}
+
 bool BI_NetLine::isSelectable() const noexcept
 {
     return mGraphicsItem->isSelectable();
@@ -243,6 +260,18 @@ void BI_NetLine::setSelected(bool selected) noexcept
  *  Private Methods
  ****************************************************************************************/
 
+BoundingBox BI_NetLine::calcBoundingBox() const noexcept
+{
+    BoundingBox box(mStartPoint->getPosition(), mEndPoint->getPosition());
+    return box.expanded(getGrabAreaWidth() / 2);
+}
+
+Length BI_NetLine::getGrabAreaWidth() const noexcept
+{
+    // very thin traces get a minimum grab area width (see BGI_NetLine)
+    return qMax(mWidth, Length(100000));
+}
+
 bool BI_NetLine::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())         return false;
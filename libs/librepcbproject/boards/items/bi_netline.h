@@ -35,6 +35,7 @@
 namespace librepcb {
 
 class BoardLayer;
+class ConvexShape;
 
 namespace project {
 
@@ -74,6 +75,7 @@ class BI_NetLine final : public BI_Base, public IF_XmlSerializableObject
         bool isAttached() const noexcept;
         bool isAttachedToFootprint() const noexcept;
         bool isAttachedToVia() const noexcept;
+        ConvexShape getCopperShape() const noexcept;
         bool isSelectable() const noexcept override;
 
         // Setters
@@ -93,6 +95,7 @@ class BI_NetLine final : public BI_Base, public IF_XmlSerializableObject
         const Point& getPosition() const noexcept override {return mPosition;}
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -101,6 +104,10 @@ class BI_NetLine final : public BI_Base, public IF_XmlSerializableObject
 
     private:
 
+        // Inherited from BI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
+        Length getGrabAreaWidth() const noexcept;
         void init() throw (Exception);
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
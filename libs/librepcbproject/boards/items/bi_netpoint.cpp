@@ -28,6 +28,7 @@
 #include "bi_device.h"
 #include "bi_via.h"
 #include "../board.h"
+#include "../boardconnectivity.h"
 #include "../boardlayerstack.h"
 #include "../../project.h"
 #include "../../circuit/circuit.h"
@@ -39,6 +40,7 @@
 #include <librepcbcommon/boardlayer.h>
 #include <librepcblibrary/pkg/footprint.h>
 #include <librepcbcommon/scopeguardlist.h>
+#include <librepcbcommon/geometry/hittest.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -208,6 +210,7 @@ void BI_NetPoint::setLayer(BoardLayer& layer) throw (Exception)
             throw LogicError(__FILE__, __LINE__);
         }
         mLayer = &layer;
+        mBoard.getConnectivity().invalidate(mNetSignal);
     }
 }
 
@@ -228,7 +231,9 @@ void BI_NetPoint::setNetSignal(NetSignal& netsignal) throw (Exception)
         netsignal.registerBoardNetPoint(*this); // can throw
         sg.dismiss();
     }
+    mBoard.getConnectivity().invalidate(mNetSignal);
     mNetSignal = &netsignal;
+    mBoard.getConnectivity().invalidate(mNetSignal);
 }
 
 void BI_NetPoint::setPadToAttach(BI_FootprintPad* pad) throw (Exception)
@@ -259,6 +264,7 @@ void BI_NetPoint::setPadToAttach(BI_FootprintPad* pad) throw (Exception)
     }
     mFootprintPad = pad;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.getConnectivity().invalidate(mNetSignal);
 }
 
 void BI_NetPoint::setViaToAttach(BI_Via* via) throw (Exception)
@@ -287,6 +293,7 @@ void BI_NetPoint::setViaToAttach(BI_Via* via) throw (Exception)
     }
     mVia = via;
     mGraphicsItem->updateCacheAndRepaint();
+    mBoard.getConnectivity().invalidate(mNetSignal);
 }
 
 void BI_NetPoint::setPosition(const Point& position) noexcept
@@ -294,6 +301,7 @@ void BI_NetPoint::setPosition(const Point& position) noexcept
     if (position != mPosition) {
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
+        grabAreaChanged();
         updateLines();
     }
 }
@@ -371,6 +379,7 @@ void BI_NetPoint::registerNetLine(BI_NetLine& netline) throw (Exception)
     mRegisteredLines.append(&netline);
     netline.updateLine();
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged(); // the max. line width may have changed
     mErcMsgDeadNetPoint->setVisible(mRegisteredLines.isEmpty());
 }
 
@@ -382,6 +391,7 @@ void BI_NetPoint::unregisterNetLine(BI_NetLine& netline) throw (Exception)
     mRegisteredLines.removeOne(&netline);
     netline.updateLine();
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged(); // the max. line width may have changed
     mErcMsgDeadNetPoint->setVisible(mRegisteredLines.isEmpty());
 }
 
@@ -392,6 +402,13 @@ void BI_NetPoint::updateLines() const noexcept
     }
 }
 
+void BI_NetPoint::netLineWidthChanged() noexcept
+{
+    // the size of the netpoint depends on the width of the registered netlines
+    mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
+}
+
 XmlDomElement* BI_NetPoint::serializeToXmlDomElement() const throw (Exception)
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -424,6 +441,13 @@ QPainterPath BI_NetPoint::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
+bool BI_NetPoint::isAtScenePos(const Point& pos) const noexcept
+{
+    // Note: Don't use the cached bounding box here because the width of the registered
+    // netlines may change without notifying the netpoint.
+    return HitTest::isPointInCircle(pos, mPosition, getMaxLineWidth());
+}
+
 bool BI_NetPoint::isSelectable() const noexcept
 {
     return mGraphicsItem->isSelectable();
@@ -439,6 +463,12 @@ void BI_NetPoint::setSelected(bool selected) noexcept
  *  Private Methods
  ****************************************************************************************/
 
+BoundingBox BI_NetPoint::calcBoundingBox() const noexcept
+{
+    Length radius = getMaxLineWidth() / 2;
+    return BoundingBox(mPosition - Point(radius, radius), mPosition + Point(radius, radius));
+}
+
 bool BI_NetPoint::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -105,6 +105,7 @@ class BI_NetPoint final : public BI_Base, public IF_XmlSerializableObject,
         void registerNetLine(BI_NetLine& netline) throw (Exception);
         void unregisterNetLine(BI_NetLine& netline) throw (Exception);
         void updateLines() const noexcept;
+        void netLineWidthChanged() noexcept;
 
 
         /// @copydoc IF_XmlSerializableObject#serializeToXmlDomElement()
@@ -116,6 +117,7 @@ class BI_NetPoint final : public BI_Base, public IF_XmlSerializableObject,
         const Point& getPosition() const noexcept override {return mPosition;}
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -126,6 +128,9 @@ class BI_NetPoint final : public BI_Base, public IF_XmlSerializableObject,
 
     private:
 
+        // Inherited from BI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
         void init() throw (Exception);
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
@@ -24,9 +24,13 @@
 #include "bi_polygon.h"
 #include "../board.h"
 #include "../../project.h"
+#include "../../circuit/circuit.h"
+#include "../../circuit/netsignal.h"
+#include <librepcbcommon/boardlayer.h>
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include <librepcbcommon/graphics/graphicsscene.h>
 #include <librepcbcommon/geometry/polygon.h>
+#include <librepcbcommon/scopeguardlist.h>
 #include "../graphicsitems/bgi_polygon.h"
 
 /*****************************************************************************************
@@ -40,22 +44,30 @@ namespace project {
  ****************************************************************************************/
 
 BI_Polygon::BI_Polygon(Board& board, const BI_Polygon& other) throw (Exception) :
-    BI_Base(board)
+    BI_Base(board), mNetSignal(other.mNetSignal)
 {
     mPolygon.reset(new Polygon(*other.mPolygon));
     init();
 }
 
 BI_Polygon::BI_Polygon(Board& board, const XmlDomElement& domElement) throw (Exception) :
-    BI_Base(board)
+    BI_Base(board), mNetSignal(nullptr)
 {
     mPolygon.reset(new Polygon(domElement));
+    Uuid netSignalUuid = domElement.getAttribute<Uuid>("netsignal", false);
+    if (!netSignalUuid.isNull()) {
+        mNetSignal = mBoard.getProject().getCircuit().getNetSignalByUuid(netSignalUuid);
+        if(!mNetSignal) {
+            throw RuntimeError(__FILE__, __LINE__, netSignalUuid.toStr(),
+                QString(tr("Invalid net signal UUID: \"%1\"")).arg(netSignalUuid.toStr()));
+        }
+    }
     init();
 }
 
 BI_Polygon::BI_Polygon(Board& board, int layerId, const Length& lineWidth, bool fill,
                        bool isGrabArea, const Point& startPos) throw (Exception) :
-    BI_Base(board)
+    BI_Base(board), mNetSignal(nullptr)
 {
     mPolygon.reset(new Polygon(layerId, lineWidth, fill, isGrabArea, startPos));
     init();
@@ -79,6 +91,60 @@ BI_Polygon::~BI_Polygon() noexcept
     mPolygon.reset();
 }
 
+/*****************************************************************************************
+ *  Getters
+ ****************************************************************************************/
+
+bool BI_Polygon::isCopperZone() const noexcept
+{
+    return mNetSignal && BoardLayer::isCopperLayer(mPolygon->getLayerId())
+        && mPolygon->isClosed();
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void BI_Polygon::setNetSignal(NetSignal* netsignal) throw (Exception)
+{
+    if (netsignal == mNetSignal) {
+        return;
+    }
+    if (netsignal && (netsignal->getCircuit() != getCircuit())) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    if (isAddedToBoard()) {
+        ScopeGuardList sgl;
+        if (mNetSignal) {
+            mNetSignal->unregisterBoardPolygon(*this); // can throw
+            sgl.add([&](){mNetSignal->registerBoardPolygon(*this);});
+        }
+        if (netsignal) {
+            netsignal->registerBoardPolygon(*this); // can throw
+            sgl.add([&](){netsignal->unregisterBoardPolygon(*this);});
+        }
+        sgl.dismiss();
+    }
+    mNetSignal = netsignal;
+    mBoard.itemNetSignalChanged(*this);
+}
+
+void BI_Polygon::setCopperFill(const QList<FillContour_t>& fill) noexcept
+{
+    mCopperFill = fill;
+    mCopperFillScenePx = QPainterPath();
+    mCopperFillScenePx.setFillRule(Qt::OddEvenFill);
+    foreach (const FillContour_t& contour, mCopperFill) {
+        QPolygonF polygon;
+        foreach (const Point& point, contour.points) {
+            polygon.append(point.toPxQPointF());
+        }
+        mCopperFillScenePx.addPolygon(polygon);
+        mCopperFillScenePx.closeSubpath();
+    }
+    mGraphicsItem->update();
+}
+
 /*****************************************************************************************
  *  General Methods
  ****************************************************************************************/
@@ -88,6 +154,9 @@ void BI_Polygon::addToBoard(GraphicsScene& scene) throw (Exception)
     if (isAddedToBoard()) {
         throw LogicError(__FILE__, __LINE__);
     }
+    if (mNetSignal) {
+        mNetSignal->registerBoardPolygon(*this); // can throw
+    }
     BI_Base::addToBoard(scene, *mGraphicsItem);
 }
 
@@ -96,6 +165,9 @@ void BI_Polygon::removeFromBoard(GraphicsScene& scene) throw (Exception)
     if (!isAddedToBoard()) {
         throw LogicError(__FILE__, __LINE__);
     }
+    if (mNetSignal) {
+        mNetSignal->unregisterBoardPolygon(*this); // can throw
+    }
     BI_Base::removeFromBoard(scene, *mGraphicsItem);
 }
 
@@ -104,6 +176,7 @@ XmlDomElement* BI_Polygon::serializeToXmlDomElement() const throw (Exception)
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
     QScopedPointer<XmlDomElement> root(mPolygon->serializeToXmlDomElement());
+    if (mNetSignal) root->setAttribute("netsignal", mNetSignal->getUuid());
     return root.take();
 }
 
@@ -144,6 +217,7 @@ void BI_Polygon::setSelected(bool selected) noexcept
 void BI_Polygon::boardAttributesChanged()
 {
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
 }
 
 /*****************************************************************************************
@@ -39,6 +39,7 @@ namespace project {
 
 class Project;
 class Board;
+class NetSignal;
 class BGI_Polygon;
 
 /*****************************************************************************************
@@ -48,6 +49,10 @@ class BGI_Polygon;
 /**
  * @brief The BI_Polygon class
  *
+ * A closed polygon on a copper layer which is assigned to a net signal is a copper zone:
+ * Its area is filled with copper, except the clearances around all copper items of other
+ * net signals. The fill is calculated by #BoardCopperZones and only stored here.
+ *
  * @author ubruhin
  * @date 2016-01-12
  */
@@ -58,6 +63,12 @@ class BI_Polygon final : public BI_Base, public IF_XmlSerializableObject,
 
     public:
 
+        // Types
+        struct FillContour_t {
+            QVector<Point> points;  ///< the vertices of the (implicitly closed) contour
+            bool isHole;            ///< whether the contour is a hole in the copper
+        };
+
         // Constructors / Destructor
         BI_Polygon() = delete;
         BI_Polygon(const BI_Polygon& other) = delete;
@@ -69,8 +80,22 @@ class BI_Polygon final : public BI_Base, public IF_XmlSerializableObject,
 
         // Getters
         const Polygon& getPolygon() const noexcept {return *mPolygon;}
+        NetSignal* getNetSignal() const noexcept {return mNetSignal;}
+        bool isCopperZone() const noexcept;
         bool isSelectable() const noexcept override;
 
+        /**
+         * @brief Get the copper fill of the zone (empty if it is not a zone)
+         *
+         * @return All contours, sorted by their nesting depth (outer contours first)
+         */
+        const QList<FillContour_t>& getCopperFill() const noexcept {return mCopperFill;}
+        const QPainterPath& getCopperFillScenePx() const noexcept {return mCopperFillScenePx;}
+
+        // Setters
+        void setNetSignal(NetSignal* netsignal) throw (Exception);
+        void setCopperFill(const QList<FillContour_t>& fill) noexcept;
+
         // General Methods
         void addToBoard(GraphicsScene& scene) throw (Exception) override;
         void removeFromBoard(GraphicsScene& scene) throw (Exception) override;
@@ -114,6 +139,11 @@ class BI_Polygon final : public BI_Base, public IF_XmlSerializableObject,
         // General
         QScopedPointer<Polygon> mPolygon;
         QScopedPointer<BGI_Polygon> mGraphicsItem;
+        NetSignal* mNetSignal;  ///< nullptr if the polygon is not a copper zone
+
+        // Copper Fill
+        QList<FillContour_t> mCopperFill;
+        QPainterPath mCopperFillScenePx;
 };
 
 /*****************************************************************************************
@@ -25,6 +25,7 @@
 #include "bi_netpoint.h"
 #include "bi_netline.h"
 #include "../board.h"
+#include "../boardconnectivity.h"
 #include "../boardlayerstack.h"
 #include "../../project.h"
 #include "../../circuit/circuit.h"
@@ -33,6 +34,8 @@
 #include <librepcbcommon/graphics/graphicsscene.h>
 #include <librepcbcommon/boardlayer.h>
 #include <librepcbcommon/scopeguardlist.h>
+#include <librepcbcommon/geometry/hittest.h>
+#include <librepcbcommon/geometry/convexshape.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -119,6 +122,22 @@ bool BI_Via::isOnLayer(int layerId) const noexcept
     return BoardLayer::isCopperLayer(layerId);
 }
 
+ConvexShape BI_Via::getCopperShape() const noexcept
+{
+    switch (mShape)
+    {
+        case Shape::Round:
+            return ConvexShape::circle(mPosition, mSize);
+        case Shape::Square:
+            return ConvexShape::rect(mPosition, mSize, mSize, Angle::deg0());
+        case Shape::Octagon:
+            return ConvexShape::octagon(mPosition, mSize, mSize, Angle::deg0());
+        default:
+            Q_ASSERT(false);
+            return ConvexShape::circle(mPosition, mSize);
+    }
+}
+
 QPainterPath BI_Via::toQPainterPathPx(const Length& clearance, bool hole) const noexcept
 {
     QPainterPath p;
@@ -183,7 +202,10 @@ void BI_Via::setNetSignal(NetSignal* netsignal) throw (Exception)
         }
         sgl.dismiss();
     }
+    mBoard.getConnectivity().invalidate(mNetSignal);
     mNetSignal = netsignal;
+    mBoard.getConnectivity().invalidate(mNetSignal);
+    mBoard.itemNetSignalChanged(*this);
     mGraphicsItem->updateCacheAndRepaint();
 }
 
@@ -192,6 +214,7 @@ void BI_Via::setPosition(const Point& position) noexcept
     if (position != mPosition) {
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
+        grabAreaChanged();
         updateNetPoints();
     }
 }
@@ -201,6 +224,7 @@ void BI_Via::setShape(Shape shape) noexcept
     if (shape != mShape) {
         mShape = shape;
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
     }
 }
 
@@ -209,6 +233,7 @@ void BI_Via::setSize(const Length& size) noexcept
     if (size != mSize) {
         mSize = size;
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
     }
 }
 
@@ -308,6 +333,22 @@ QPainterPath BI_Via::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
+bool BI_Via::isAtScenePos(const Point& pos) const noexcept
+{
+    switch (mShape)
+    {
+        case Shape::Round:
+            return HitTest::isPointInCircle(pos, mPosition, mSize);
+        case Shape::Square:
+            return HitTest::isPointInRect(pos, mPosition, mSize, mSize, Angle::deg0());
+        case Shape::Octagon:
+            return HitTest::isPointInOctagon(pos, mPosition, mSize, mSize, Angle::deg0());
+        default:
+            Q_ASSERT(false);
+            return false;
+    }
+}
+
 bool BI_Via::isSelectable() const noexcept
 {
     return mGraphicsItem->isSelectable();
@@ -328,6 +369,12 @@ void BI_Via::boardAttributesChanged()
     mGraphicsItem->updateCacheAndRepaint();
 }
 
+BoundingBox BI_Via::calcBoundingBox() const noexcept
+{
+    Length radius = mSize / 2;
+    return BoundingBox(mPosition - Point(radius, radius), mPosition + Point(radius, radius));
+}
+
 bool BI_Via::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -37,6 +37,7 @@ class QGraphicsItem;
 namespace librepcb {
 
 class BoardLayer;
+class ConvexShape;
 
 namespace project {
 
@@ -80,6 +81,7 @@ class BI_Via final : public BI_Base, public IF_XmlSerializableObject
         bool isUsed() const noexcept {return (mRegisteredNetPoints.count() > 0);}
         bool isOnLayer(int layerId) const noexcept;
         QPainterPath toQPainterPathPx(const Length& clearance, bool hole) const noexcept;
+        ConvexShape getCopperShape() const noexcept;
         bool isSelectable() const noexcept override;
 
         // Setters
@@ -105,6 +107,7 @@ class BI_Via final : public BI_Base, public IF_XmlSerializableObject
         const Point& getPosition() const noexcept override {return mPosition;}
         bool getIsMirrored() const noexcept override {return false;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -115,6 +118,9 @@ class BI_Via final : public BI_Base, public IF_XmlSerializableObject
 
     private:
 
+        // Inherited from BI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
         void init() throw (Exception);
         void boardAttributesChanged();
 
@@ -182,9 +182,11 @@ void ComponentSignalInstance::setNetSignal(NetSignal* netsignal) throw (Exceptio
                       disconnect(netsignal, &NetSignal::nameChanged,
                       this, &ComponentSignalInstance::netSignalNameChanged);});
     }
+    NetSignal* oldNetSignal = mNetSignal;
     mNetSignal = netsignal;
     updateErcMessages();
     sgl.dismiss();
+    emit netSignalChanged(oldNetSignal, mNetSignal);
 }
 
 /*****************************************************************************************
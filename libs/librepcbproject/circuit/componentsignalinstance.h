@@ -116,6 +116,11 @@ class ComponentSignalInstance final : public QObject, public IF_ErcMsgProvider,
         ComponentSignalInstance& operator=(const ComponentSignalInstance& rhs) = delete;
 
 
+    signals:
+
+        void netSignalChanged(NetSignal* from, NetSignal* to);
+
+
     private slots:
 
         void netSignalNameChanged(const QString& newName) noexcept;
@@ -32,6 +32,7 @@
 #include "../schematics/items/si_netpoint.h"
 #include "../boards/items/bi_netpoint.h"
 #include "../boards/items/bi_via.h"
+#include "../boards/items/bi_polygon.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -86,6 +87,7 @@ int NetSignal::getRegisteredElementsCount() const noexcept
     count += mRegisteredSchematicNetLabels.count();
     count += mRegisteredBoardNetPoints.count();
     count += mRegisteredBoardVias.count();
+    count += mRegisteredBoardPolygons.count();
     return count;
 }
 
@@ -260,6 +262,26 @@ void NetSignal::unregisterBoardVia(BI_Via& via) throw (Exception)
     updateErcMessages();
 }
 
+void NetSignal::registerBoardPolygon(BI_Polygon& polygon) throw (Exception)
+{
+    if ((!mIsAddedToCircuit) || (mRegisteredBoardPolygons.contains(&polygon))
+        || (polygon.getCircuit() != mCircuit))
+    {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    mRegisteredBoardPolygons.append(&polygon);
+    updateErcMessages();
+}
+
+void NetSignal::unregisterBoardPolygon(BI_Polygon& polygon) throw (Exception)
+{
+    if ((!mIsAddedToCircuit) || (!mRegisteredBoardPolygons.contains(&polygon))) {
+        throw LogicError(__FILE__, __LINE__);
+    }
+    mRegisteredBoardPolygons.removeOne(&polygon);
+    updateErcMessages();
+}
+
 XmlDomElement* NetSignal::serializeToXmlDomElement() const throw (Exception)
 {
     if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
@@ -42,6 +42,7 @@ class SI_NetPoint;
 class SI_NetLabel;
 class BI_NetPoint;
 class BI_Via;
+class BI_Polygon;
 class ErcMsg;
 
 /*****************************************************************************************
@@ -80,6 +81,7 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public IF_XmlS
         const QList<SI_NetLabel*>& getSchematicNetLabels() const noexcept {return mRegisteredSchematicNetLabels;}
         const QList<BI_NetPoint*>& getBoardNetPoints() const noexcept {return mRegisteredBoardNetPoints;}
         const QList<BI_Via*>& getBoardVias() const noexcept {return mRegisteredBoardVias;}
+        const QList<BI_Polygon*>& getBoardPolygons() const noexcept {return mRegisteredBoardPolygons;}
         int getRegisteredElementsCount() const noexcept;
         bool isUsed() const noexcept;
         bool isNameForced() const noexcept;
@@ -101,6 +103,8 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public IF_XmlS
         void unregisterBoardNetPoint(BI_NetPoint& netpoint) throw (Exception);
         void registerBoardVia(BI_Via& via) throw (Exception);
         void unregisterBoardVia(BI_Via& via) throw (Exception);
+        void registerBoardPolygon(BI_Polygon& polygon) throw (Exception);
+        void unregisterBoardPolygon(BI_Polygon& polygon) throw (Exception);
 
         /// @copydoc IF_XmlSerializableObject#serializeToXmlDomElement()
         XmlDomElement* serializeToXmlDomElement() const throw (Exception) override;
@@ -140,6 +144,7 @@ class NetSignal final : public QObject, public IF_ErcMsgProvider, public IF_XmlS
         QList<SI_NetLabel*> mRegisteredSchematicNetLabels;
         QList<BI_NetPoint*> mRegisteredBoardNetPoints;
         QList<BI_Via*> mRegisteredBoardVias;
+        QList<BI_Polygon*> mRegisteredBoardPolygons;
 
         // ERC Messages
         /// @brief the ERC message for unused netsignals
@@ -90,6 +90,13 @@ SOURCES += \
     boards/items/bi_polygon.cpp \
     boards/graphicsitems/bgi_polygon.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardconnectivity.cpp \
+    boards/boardratsnest.cpp \
+    boards/boarddesignrulecheck.cpp \
+    boards/boardonlinedrc.cpp \
+    boards/boardcopperzones.cpp \
+    boards/boardnetstatistics.cpp \
+    boards/boardpanel.cpp \
     boards/items/bi_netpoint.cpp \
     boards/items/bi_netline.cpp \
     boards/graphicsitems/bgi_netpoint.cpp \
@@ -101,11 +108,13 @@ SOURCES += \
     boards/cmd/cmdboardnetpointremove.cpp \
     boards/items/bi_via.cpp \
     boards/graphicsitems/bgi_via.cpp \
+    boards/graphicsitems/bgi_airwires.cpp \
     boards/cmd/cmdboardviaadd.cpp \
     boards/cmd/cmdboardviaremove.cpp \
     boards/cmd/cmdboardviaedit.cpp \
     boards/cmd/cmdboarddesignrulesmodify.cpp \
-    boards/boardgerberexport.cpp
+    boards/boardgerberexport.cpp \
+    boards/boardimageexport.cpp
 
 HEADERS += \
     project.h \
@@ -178,6 +187,13 @@ HEADERS += \
     boards/items/bi_polygon.h \
     boards/graphicsitems/bgi_polygon.h \
     boards/boardlayerstack.h \
+    boards/boardconnectivity.h \
+    boards/boardratsnest.h \
+    boards/boarddesignrulecheck.h \
+    boards/boardonlinedrc.h \
+    boards/boardcopperzones.h \
+    boards/boardnetstatistics.h \
+    boards/boardpanel.h \
     boards/items/bi_netpoint.h \
     boards/items/bi_netline.h \
     boards/graphicsitems/bgi_netpoint.h \
@@ -189,10 +205,12 @@ HEADERS += \
     boards/cmd/cmdboardnetpointremove.h \
     boards/items/bi_via.h \
     boards/graphicsitems/bgi_via.h \
+    boards/graphicsitems/bgi_airwires.h \
     boards/cmd/cmdboardviaadd.h \
     boards/cmd/cmdboardviaremove.h \
     boards/cmd/cmdboardviaedit.h \
     boards/cmd/cmdboarddesignrulesmodify.h \
-    boards/boardgerberexport.h
+    boards/boardgerberexport.h \
+    boards/boardimageexport.h
 
 FORMS +=
@@ -121,6 +121,13 @@ Project::Project(const FilePath& filepath, bool create, bool readOnly) throw (Ex
 
         case FileLock::LockStatus_t::StaleLock:
         {
+            if (mIsReadOnly)
+            {
+                // nothing will be saved, so just open the project without the backup
+                // (this must not ask the user, e.g. for the command line interface)
+                mIsRestored = false;
+                break;
+            }
             // the application crashed while this project was open! ask the user what to do
             QMessageBox::StandardButton btn = QMessageBox::question(0, tr("Restore Project?"),
                 tr("It seems that the application was crashed while this project was open. "
@@ -431,8 +438,6 @@ void Project::exportSchematicsAsPdf(const FilePath& filepath) throw (Exception)
         pages.append(i);
 
     printSchematicPages(printer, pages);
-
-    QDesktopServices::openUrl(QUrl::fromLocalFile(filepath.toStr()));
 }
 
 /*****************************************************************************************
@@ -702,8 +707,12 @@ void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) throw (E
     if (pages.isEmpty())
         throw RuntimeError(__FILE__, __LINE__, QString(), tr("No schematic pages selected."));
 
+    // the pages are rendered one after the other in this thread since the graphics
+    // scenes must not be accessed from other threads, scaled to the page size and
+    // aligned at the top left corner (like QGraphicsScene::render() with
+    // Qt::KeepAspectRatio)
     QPainter painter(&printer);
-
+    QRectF pageRect(0, 0, printer.width(), printer.height());
     for (int i = 0; i < pages.count(); i++)
     {
         Schematic* schematic = getSchematicByIndex(pages[i]);
@@ -713,7 +722,18 @@ void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) throw (E
                 QString(tr("No schematic page with the index %1 found.")).arg(pages[i]));
         }
         schematic->clearSelection();
-        schematic->renderToQPainter(painter);
+        QRectF rect = schematic->getPrintRect();
+        if (!rect.isEmpty())
+        {
+            qreal scale = qMin(pageRect.width() / rect.width(),
+                               pageRect.height() / rect.height());
+            painter.save();
+            painter.setClipRect(pageRect);
+            painter.scale(scale, scale);
+            painter.translate(-rect.topLeft());
+            schematic->renderToQPainter(painter, rect);
+            painter.restore();
+        }
 
         if (i != pages.count() - 1)
         {
@@ -89,6 +89,7 @@ class Project final : public QObject, public IF_AttributeProvider,
          *
          * @param filepath      The filepath to the an existing *.lpp project file
          * @param readOnly      It true, the project will be opened in read-only mode
+         *                      (without any message boxes, even if it is locked)
          *
          * @throw Exception     If the project could not be opened successfully
          */
@@ -321,6 +322,9 @@ class Project final : public QObject, public IF_AttributeProvider,
          * @param filepath  The filepath where the PDF should be saved. If the file exists
          *                  already, it will be overwritten.
          *
+         * @note The PDF is not opened automatically, this is up to the caller (the
+         *       command line interface must not open any application).
+         *
          * @throw Exception     On error
          *
          * @todo add more parameters (paper size, orientation, pages to print, ...)
@@ -85,7 +85,7 @@ void SGI_NetPoint::paint(QPainter* painter, const QStyleOptionGraphicsItem* opti
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
-    const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    const bool deviceIsPrinter = isPrinting(painter);
     bool highlight = mNetPoint.isSelected() || mNetPoint.getNetSignal().isHighlighted();
 
     if (mLayer->isVisible() && mIsVisibleJunction) {
@@ -152,7 +152,7 @@ void SGI_Symbol::paint(QPainter* painter, const QStyleOptionGraphicsItem* option
 
     const SchematicLayer* layer = 0;
     const bool selected = mSymbol.isSelected();
-    const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+    const bool deviceIsPrinter = isPrinting(painter);
     const qreal lod = option->levelOfDetailFromTransform(painter->worldTransform());
 
     // draw all polygons
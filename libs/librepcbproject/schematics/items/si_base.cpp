@@ -39,7 +39,7 @@ namespace project {
 
 SI_Base::SI_Base(Schematic& schematic) noexcept :
     QObject(&schematic), mSchematic(schematic),
-    mIsAddedToSchematic(false), mIsSelected(false)
+    mIsAddedToSchematic(false), mIsSelected(false), mBoundingBoxCached(false)
 {
 }
 
@@ -62,6 +62,21 @@ Circuit& SI_Base::getCircuit() const noexcept
     return mSchematic.getProject().getCircuit();
 }
 
+const BoundingBox& SI_Base::getBoundingBox() const noexcept
+{
+    if (!mBoundingBoxCached) {
+        mBoundingBox = calcBoundingBox();
+        mBoundingBoxCached = true;
+    }
+    return mBoundingBox;
+}
+
+bool SI_Base::isAtScenePos(const Point& pos) const noexcept
+{
+    // fallback for arbitrary shapes, derived classes should provide an exact test
+    return getBoundingBox().contains(pos) && getGrabAreaScenePx().contains(pos.toPxQPointF());
+}
+
 /*****************************************************************************************
  *  Setters
  ****************************************************************************************/
@@ -89,6 +104,25 @@ void SI_Base::removeFromSchematic(GraphicsScene& scene, SGI_Base& item) noexcept
     mIsAddedToSchematic = false;
 }
 
+BoundingBox SI_Base::calcBoundingBox() const noexcept
+{
+    try
+    {
+        return BoundingBox::fromPx(getGrabAreaScenePx().boundingRect());
+    }
+    catch (const Exception& e)
+    {
+        qCritical() << "Could not calculate bounding box:" << e.getUserMsg();
+        return BoundingBox();
+    }
+}
+
+void SI_Base::grabAreaChanged() noexcept
+{
+    mBoundingBoxCached = false;
+    mSchematic.updateSpatialIndex(*this);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -26,6 +26,7 @@
 #include <QtCore>
 #include <QtWidgets>
 #include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/geometry/boundingbox.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -76,12 +77,22 @@ class SI_Base : public QObject
         virtual Type_t getType() const noexcept = 0;
         virtual const Point& getPosition() const noexcept = 0;
         virtual QPainterPath getGrabAreaScenePx() const noexcept = 0;
+        const BoundingBox& getBoundingBox() const noexcept;
+        virtual bool isAtScenePos(const Point& pos) const noexcept;
         virtual bool isAddedToSchematic() const noexcept {return mIsAddedToSchematic;}
         virtual bool isSelected() const noexcept {return mIsSelected;}
 
         // Setters
         virtual void setSelected(bool selected) noexcept;
 
+        /**
+         * @brief Change the selection state without repainting the item
+         *
+         * Used by Schematic::setSelectionRect() to apply many selection changes at once, the
+         * caller is responsible for updating the graphics scene afterwards.
+         */
+        void setSelectedWithoutRepaint(bool selected) noexcept {mIsSelected = selected;}
+
         // General Methods
         virtual void addToSchematic(GraphicsScene& scene) throw (Exception) = 0;
         virtual void removeFromSchematic(GraphicsScene& scene) throw (Exception) = 0;
@@ -92,6 +103,19 @@ class SI_Base : public QObject
 
     protected:
 
+        /**
+         * @brief Calculate the bounding box of the grab area
+         *
+         * The default implementation uses the bounding rect of #getGrabAreaScenePx(),
+         * items with a simple shape should override this with an exact calculation.
+         */
+        virtual BoundingBox calcBoundingBox() const noexcept;
+
+        /**
+         * @brief Must be called by all derived classes whenever their grab area changed
+         */
+        void grabAreaChanged() noexcept;
+
         // General Methods
         void addToSchematic(GraphicsScene& scene, SGI_Base& item) noexcept;
         void removeFromSchematic(GraphicsScene& scene, SGI_Base& item) noexcept;
@@ -107,6 +131,8 @@ class SI_Base : public QObject
         // General Attributes
         bool mIsAddedToSchematic;
         bool mIsSelected;
+        mutable BoundingBox mBoundingBox;   ///< cached result of #calcBoundingBox()
+        mutable bool mBoundingBoxCached;    ///< false if #mBoundingBox is outdated
 };
 
 /*****************************************************************************************
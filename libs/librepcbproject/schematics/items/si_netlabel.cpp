@@ -102,6 +102,7 @@ void SI_NetLabel::setNetSignal(NetSignal& netsignal) noexcept
         connect(&netsignal, &NetSignal::nameChanged, this, &SI_NetLabel::netSignalNameChanged);
         mNetSignal = &netsignal;
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
     }
 }
 
@@ -110,6 +111,7 @@ void SI_NetLabel::setPosition(const Point& position) noexcept
     if (position != mPosition) {
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
+        grabAreaChanged();
     }
 }
 
@@ -119,6 +121,7 @@ void SI_NetLabel::setRotation(const Angle& rotation) noexcept
         mRotation = rotation;
         mGraphicsItem->setRotation(-mRotation.toDeg());
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
     }
 }
 
@@ -183,6 +186,7 @@ void SI_NetLabel::netSignalNameChanged(const QString& newName) noexcept
 {
     Q_UNUSED(newName);
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
 }
 
 /*****************************************************************************************
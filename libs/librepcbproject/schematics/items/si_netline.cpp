@@ -31,6 +31,7 @@
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include <librepcbcommon/graphics/graphicsscene.h>
 #include <librepcbcommon/scopeguard.h>
+#include <librepcbcommon/geometry/hittest.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -131,6 +132,7 @@ void SI_NetLine::setWidth(const Length& width) noexcept
     if ((width != mWidth) && (width >= 0)) {
         mWidth = width;
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
     }
 }
 
@@ -169,6 +171,7 @@ void SI_NetLine::updateLine() noexcept
 {
     mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
 }
 
 XmlDomElement* SI_NetLine::serializeToXmlDomElement() const throw (Exception)
@@ -192,6 +195,12 @@ QPainterPath SI_NetLine::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->shape();
 }
 
+bool SI_NetLine::isAtScenePos(const Point& pos) const noexcept
+{
+    return getBoundingBox().contains(pos) && HitTest::isPointInCapsule(pos,
+        mStartPoint->getPosition(), mEndPoint->getPosition(), getGrabAreaWidth());
+}
+
 void SI_NetLine::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
@@ -202,6 +211,18 @@ void SI_NetLine::setSelected(bool selected) noexcept
  *  Private Methods
  ****************************************************************************************/
 
+BoundingBox SI_NetLine::calcBoundingBox() const noexcept
+{
+    BoundingBox box(mStartPoint->getPosition(), mEndPoint->getPosition());
+    return box.expanded(getGrabAreaWidth() / 2);
+}
+
+Length SI_NetLine::getGrabAreaWidth() const noexcept
+{
+    // thin lines get a wider grab area to make it easier to catch them (see SGI_NetLine)
+    return qMax(mWidth, Length(1270000));
+}
+
 bool SI_NetLine::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())         return false;
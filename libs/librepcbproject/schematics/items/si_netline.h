@@ -82,6 +82,7 @@ class SI_NetLine final : public SI_Base, public IF_XmlSerializableObject
         Type_t getType() const noexcept override {return SI_Base::Type_t::NetLine;}
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -90,7 +91,11 @@ class SI_NetLine final : public SI_Base, public IF_XmlSerializableObject
 
     private:
 
+        // Inherited from SI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
         void init() throw (Exception);
+        Length getGrabAreaWidth() const noexcept;
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
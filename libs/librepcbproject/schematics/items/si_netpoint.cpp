@@ -196,6 +196,7 @@ void SI_NetPoint::setPosition(const Point& position) noexcept
     if (position != mPosition) {
         mPosition = position;
         mGraphicsItem->setPos(mPosition.toPxQPointF());
+        grabAreaChanged();
         updateLines();
     }
 }
@@ -307,6 +308,12 @@ QPainterPath SI_NetPoint::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
 }
 
+bool SI_NetPoint::isAtScenePos(const Point& pos) const noexcept
+{
+    // the grab area is a square, so it's equal to the bounding box
+    return getBoundingBox().contains(pos);
+}
+
 void SI_NetPoint::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
@@ -317,6 +324,12 @@ void SI_NetPoint::setSelected(bool selected) noexcept
  *  Private Methods
  ****************************************************************************************/
 
+BoundingBox SI_NetPoint::calcBoundingBox() const noexcept
+{
+    Point delta(Length(600000), Length(600000)); // see SGI_NetPoint
+    return BoundingBox(mPosition - delta, mPosition + delta);
+}
+
 bool SI_NetPoint::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())                             return false;
@@ -96,6 +96,7 @@ class SI_NetPoint final : public SI_Base, public IF_XmlSerializableObject,
         Type_t getType() const noexcept override {return SI_Base::Type_t::NetPoint;}
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -106,6 +107,9 @@ class SI_NetPoint final : public SI_Base, public IF_XmlSerializableObject,
 
     private:
 
+        // Inherited from SI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
         void init() throw (Exception);
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
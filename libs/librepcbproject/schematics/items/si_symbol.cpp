@@ -138,6 +138,7 @@ void SI_Symbol::setPosition(const Point& newPos) noexcept
         mPosition = newPos;
         mGraphicsItem->setPos(newPos.toPxQPointF());
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
         foreach (SI_SymbolPin* pin, mPins) {
             pin->updatePosition();
         }
@@ -150,6 +151,7 @@ void SI_Symbol::setRotation(const Angle& newRotation) noexcept
         mRotation = newRotation;
         mGraphicsItem->setRotation(-newRotation.toDeg());
         mGraphicsItem->updateCacheAndRepaint();
+        grabAreaChanged();
         foreach (SI_SymbolPin* pin, mPins) {
             pin->updatePosition();
         }
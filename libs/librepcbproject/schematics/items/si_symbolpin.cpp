@@ -37,6 +37,7 @@
 #include "../../circuit/netsignal.h"
 #include "../../settings/projectsettings.h"
 #include <librepcbcommon/graphics/graphicsscene.h>
+#include <librepcbcommon/geometry/hittest.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -207,6 +208,7 @@ void SI_SymbolPin::updatePosition() noexcept
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     mGraphicsItem->setRotation(-mRotation.toDeg());
     mGraphicsItem->updateCacheAndRepaint();
+    grabAreaChanged();
     if (mRegisteredNetPoint) {
         mRegisteredNetPoint->setPosition(mPosition);
     }
@@ -221,12 +223,28 @@ QPainterPath SI_SymbolPin::getGrabAreaScenePx() const noexcept
     return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
 }
 
+bool SI_SymbolPin::isAtScenePos(const Point& pos) const noexcept
+{
+    // the grab area is the circle around the pin position (see SGI_SymbolPin)
+    return HitTest::isPointInCircle(pos, mPosition, Length(1200000));
+}
+
 void SI_SymbolPin::setSelected(bool selected) noexcept
 {
     SI_Base::setSelected(selected);
     mGraphicsItem->update();
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+BoundingBox SI_SymbolPin::calcBoundingBox() const noexcept
+{
+    Point delta(Length(600000), Length(600000));
+    return BoundingBox(mPosition - delta, mPosition + delta);
+}
+
 /*****************************************************************************************
  *  Private Slots
  ****************************************************************************************/
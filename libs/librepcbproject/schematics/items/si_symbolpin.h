@@ -91,6 +91,7 @@ class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
         Type_t getType() const noexcept override {return SI_Base::Type_t::SymbolPin;}
         const Point& getPosition() const noexcept override {return mPosition;}
         QPainterPath getGrabAreaScenePx() const noexcept override;
+        bool isAtScenePos(const Point& pos) const noexcept override;
         void setSelected(bool selected) noexcept override;
 
         // Operator Overloadings
@@ -104,6 +105,9 @@ class SI_SymbolPin final : public SI_Base, public IF_ErcMsgProvider
 
     private:
 
+        // Inherited from SI_Base
+        BoundingBox calcBoundingBox() const noexcept override;
+
         // General
         SI_Symbol& mSymbol;
         const library::SymbolPin* mSymbolPin;
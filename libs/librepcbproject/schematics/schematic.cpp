@@ -26,6 +26,7 @@
 #include <librepcbcommon/fileio/xmldomdocument.h>
 #include <librepcbcommon/fileio/xmldomelement.h>
 #include <librepcbcommon/scopeguardlist.h>
+#include <librepcbcommon/geometry/spatialindex.h>
 #include "../project.h"
 #include <librepcblibrary/sym/symbolpin.h>
 #include "items/si_symbol.h"
@@ -51,7 +52,9 @@ namespace project {
 Schematic::Schematic(Project& project, const FilePath& filepath, bool restore,
                      bool readOnly, bool create, const QString& newName) throw (Exception):
     QObject(&project), IF_AttributeProvider(), mProject(project), mFilePath(filepath),
-    mIsAddedToProject(false)
+    mIsAddedToProject(false),
+    mSpatialIndex(new SpatialIndex<SI_Base*>(Length(10160000))), // 4 x 2.54mm cells
+    mAreaSelectionValid(false)
 {
     try
     {
@@ -282,45 +285,57 @@ QList<SI_Base*> Schematic::getSelectedItems(bool symbolPins,
 
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 {
-    QPointF scenePosPx = pos.toPxQPointF();
-    QList<SI_Base*> list;   // Note: The order of adding the items is very important (the
-                            // top most item must appear as the first item in the list)!
-    // visible netpoints
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-    {
-        if (!netpoint->isVisibleJunction()) continue;
-        if (netpoint->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netpoint);
-    }
-    // hidden netpoints
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->isVisibleJunction()) continue;
-        if (netpoint->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netpoint);
-    }
-    // netlines
-    foreach (SI_NetLine* netline, mNetLines)
-    {
-        if (netline->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netline);
-    }
-    // netlabels
-    foreach (SI_NetLabel* netlabel, mNetLabels)
-    {
-        if (netlabel->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(netlabel);
-    }
-    // symbols & pins
-    foreach (SI_Symbol* symbol, mSymbols)
-    {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
+    QList<SI_Base*> candidates = getItemCandidatesAtScenePos(pos);
+    QList<SI_Base*> visibleNetPoints, hiddenNetPoints, netLines, netLabels;
+    QList<SI_Symbol*> symbols; // in the order of their first appearance
+    QHash<SI_Symbol*, QList<SI_Base*>> symbolPins;
+    QSet<SI_Symbol*> hitSymbols;
+    foreach (SI_Base* item, candidates) {
+        switch (item->getType())
         {
-            if (pin->getGrabAreaScenePx().contains(scenePosPx))
-                list.append(pin);
+            case SI_Base::Type_t::NetPoint:
+                if (static_cast<SI_NetPoint*>(item)->isVisibleJunction())
+                    visibleNetPoints.append(item);
+                else
+                    hiddenNetPoints.append(item);
+                break;
+            case SI_Base::Type_t::NetLine:
+                netLines.append(item);
+                break;
+            case SI_Base::Type_t::NetLabel:
+                netLabels.append(item);
+                break;
+            case SI_Base::Type_t::SymbolPin:
+            {
+                SI_Symbol* symbol = &static_cast<SI_SymbolPin*>(item)->getSymbol();
+                if (!symbols.contains(symbol)) symbols.append(symbol);
+                symbolPins[symbol].append(item);
+                break;
+            }
+            case SI_Base::Type_t::Symbol:
+            {
+                SI_Symbol* symbol = static_cast<SI_Symbol*>(item);
+                if (!symbols.contains(symbol)) symbols.append(symbol);
+                hitSymbols.insert(symbol);
+                break;
+            }
+            default:
+                Q_ASSERT(false);
+                break;
         }
-        if (symbol->getGrabAreaScenePx().contains(scenePosPx))
-            list.append(symbol);
+    }
+
+    // Note: The order of adding the items is very important (the top most item must
+    // appear as the first item in the list)!
+    QList<SI_Base*> list;
+    list.reserve(candidates.count());
+    list.append(visibleNetPoints);
+    list.append(hiddenNetPoints);
+    list.append(netLines);
+    list.append(netLabels);
+    foreach (SI_Symbol* symbol, symbols) {
+        list.append(symbolPins.value(symbol));
+        if (hitSymbols.contains(symbol)) list.append(symbol);
     }
     return list;
 }
@@ -328,10 +343,9 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const noexcept
 {
     QList<SI_NetPoint*> list;
-    foreach (SI_NetPoint* netpoint, mNetPoints)
-    {
-        if (netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-            list.append(netpoint);
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        if (item->getType() == SI_Base::Type_t::NetPoint)
+            list.append(static_cast<SI_NetPoint*>(item));
     }
     return list;
 }
@@ -339,10 +353,9 @@ QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const no
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const noexcept
 {
     QList<SI_NetLine*> list;
-    foreach (SI_NetLine* netline, mNetLines)
-    {
-        if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-            list.append(netline);
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        if (item->getType() == SI_Base::Type_t::NetLine)
+            list.append(static_cast<SI_NetLine*>(item));
     }
     return list;
 }
@@ -350,15 +363,36 @@ QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const noex
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const noexcept
 {
     QList<SI_SymbolPin*> list;
-    foreach (SI_Symbol* symbol, mSymbols)
-    {
-        foreach (SI_SymbolPin* pin, symbol->getPins())
+    foreach (SI_Base* item, getItemCandidatesAtScenePos(pos)) {
+        if (item->getType() == SI_Base::Type_t::SymbolPin)
+            list.append(static_cast<SI_SymbolPin*>(item));
+    }
+    return list;
+}
+
+SI_Base* Schematic::getNearestConnectableAnchor(const Point& pos, const Length& radius,
+                                                const QList<SI_Base*>& except) const noexcept
+{
+    Point delta(radius.abs(), radius.abs());
+    SI_Base* nearest = nullptr;
+    qreal nearestDistance = 0;
+    foreach (SI_Base* item, mSpatialIndex->query(pos - delta, pos + delta)) {
+        if ((item->getType() != SI_Base::Type_t::NetPoint) &&
+            (item->getType() != SI_Base::Type_t::SymbolPin))
         {
-            if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-                list.append(pin);
+            continue;
+        }
+        if (except.contains(item)) continue;
+        Point diff = item->getPosition() - pos;
+        qreal distance = qSqrt(qreal(diff.getX().toNm()) * diff.getX().toNm() +
+                               qreal(diff.getY().toNm()) * diff.getY().toNm());
+        if (distance > radius.abs().toNm()) continue;
+        if ((!nearest) || (distance < nearestDistance)) {
+            nearest = item;
+            nearestDistance = distance;
         }
     }
-    return list;
+    return nearest;
 }
 
 QList<SI_Base*> Schematic::getAllItems() const noexcept
@@ -413,6 +447,7 @@ void Schematic::addSymbol(SI_Symbol& symbol) throw (Exception)
     // add to schematic
     symbol.addToSchematic(*mGraphicsScene); // can throw
     mSymbols.append(&symbol);
+    addToSpatialIndex(symbol);
 }
 
 void Schematic::removeSymbol(SI_Symbol& symbol) throw (Exception)
@@ -423,6 +458,7 @@ void Schematic::removeSymbol(SI_Symbol& symbol) throw (Exception)
     // remove from schematic
     symbol.removeFromSchematic(*mGraphicsScene); // can throw
     mSymbols.removeOne(&symbol);
+    removeFromSpatialIndex(symbol);
 }
 
 /*****************************************************************************************
@@ -454,6 +490,7 @@ void Schematic::addNetPoint(SI_NetPoint& netpoint) throw (Exception)
     // add to schematic
     netpoint.addToSchematic(*mGraphicsScene); // can throw
     mNetPoints.append(&netpoint);
+    addToSpatialIndex(netpoint);
 }
 
 void Schematic::removeNetPoint(SI_NetPoint& netpoint) throw (Exception)
@@ -464,6 +501,7 @@ void Schematic::removeNetPoint(SI_NetPoint& netpoint) throw (Exception)
     // remove from schematic
     netpoint.removeFromSchematic(*mGraphicsScene); // can throw an exception
     mNetPoints.removeOne(&netpoint);
+    removeFromSpatialIndex(netpoint);
 }
 
 /*****************************************************************************************
@@ -495,6 +533,7 @@ void Schematic::addNetLine(SI_NetLine& netline) throw (Exception)
     // add to schematic
     netline.addToSchematic(*mGraphicsScene); // can throw
     mNetLines.append(&netline);
+    addToSpatialIndex(netline);
 }
 
 void Schematic::removeNetLine(SI_NetLine& netline) throw (Exception)
@@ -505,6 +544,7 @@ void Schematic::removeNetLine(SI_NetLine& netline) throw (Exception)
     // remove from schematic
     netline.removeFromSchematic(*mGraphicsScene); // can throw
     mNetLines.removeOne(&netline);
+    removeFromSpatialIndex(netline);
 }
 
 /*****************************************************************************************
@@ -536,6 +576,7 @@ void Schematic::addNetLabel(SI_NetLabel& netlabel) throw (Exception)
     // add to schematic
     netlabel.addToSchematic(*mGraphicsScene); // can throw
     mNetLabels.append(&netlabel);
+    addToSpatialIndex(netlabel);
 }
 
 void Schematic::removeNetLabel(SI_NetLabel& netlabel) throw (Exception)
@@ -546,6 +587,7 @@ void Schematic::removeNetLabel(SI_NetLabel& netlabel) throw (Exception)
     // remove from schematic
     netlabel.removeFromSchematic(*mGraphicsScene); // can throw
     mNetLabels.removeOne(&netlabel);
+    removeFromSpatialIndex(netlabel);
 }
 
 /*****************************************************************************************
@@ -564,6 +606,9 @@ void Schematic::addToProject() throw (Exception)
         item->addToSchematic(*mGraphicsScene); // can throw
         sgl.add([this, item](){item->removeFromSchematic(*mGraphicsScene);});
     }
+    foreach (SI_Base* item, items) {
+        addToSpatialIndex(*item);
+    }
     mIsAddedToProject = true;
     updateIcon();
     sgl.dismiss();
@@ -581,6 +626,9 @@ void Schematic::removeFromProject() throw (Exception)
         item->removeFromSchematic(*mGraphicsScene); // can throw
         sgl.add([this, item](){item->addToSchematic(*mGraphicsScene);});
     }
+    mSpatialIndex->clear();
+    mAreaSelection.clear();
+    mAreaSelectionValid = false;
     mIsAddedToProject = false;
     sgl.dismiss();
 }
@@ -619,26 +667,65 @@ void Schematic::showInView(GraphicsView& view) noexcept
 void Schematic::setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept
 {
     mGraphicsScene->setSelectionRect(p1, p2);
-    if (updateItems)
+    if (!updateItems) {
+        // the selection rectangle is finished, other selection changes may follow
+        mAreaSelection.clear();
+        mAreaSelectionValid = false;
+        return;
+    }
+
+    // determine the new selection (the spatial index only compares bounding boxes)
+    BoundingBox rect(p1, p2);
+    QRectF rectPx = rect.toPxQRectF();
+    QSet<SI_Base*> selection;
+    foreach (SI_Base* item, mSpatialIndex->query(rect))
     {
-        QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-        foreach (SI_Symbol* symbol, mSymbols)
+        if (rect.contains(item->getBoundingBox()) ||
+            item->getGrabAreaScenePx().intersects(rectPx))
         {
-            bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
-            symbol->setSelected(selectSymbol);
-            foreach (SI_SymbolPin* pin, symbol->getPins())
-            {
-                bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-                pin->setSelected(selectSymbol || selectPin);
+            selection.insert(item);
+            if (item->getType() == SI_Base::Type_t::Symbol) {
+                foreach (SI_SymbolPin* pin, static_cast<SI_Symbol*>(item)->getPins())
+                    selection.insert(pin);
+            }
+        }
+    }
+
+    // the first time, all selected items need to be determined (e.g. to deselect items
+    // which were selected before the selection rectangle was started)
+    if (!mAreaSelectionValid) {
+        mAreaSelection.clear();
+        foreach (SI_Symbol* symbol, mSymbols) {
+            if (symbol->isSelected()) mAreaSelection.insert(symbol);
+            foreach (SI_SymbolPin* pin, symbol->getPins()) {
+                if (pin->isSelected()) mAreaSelection.insert(pin);
             }
         }
         foreach (SI_NetPoint* netpoint, mNetPoints)
-            netpoint->setSelected(netpoint->getGrabAreaScenePx().intersects(rectPx));
+            if (netpoint->isSelected()) mAreaSelection.insert(netpoint);
         foreach (SI_NetLine* netline, mNetLines)
-            netline->setSelected(netline->getGrabAreaScenePx().intersects(rectPx));
+            if (netline->isSelected()) mAreaSelection.insert(netline);
         foreach (SI_NetLabel* netlabel, mNetLabels)
-            netlabel->setSelected(netlabel->getGrabAreaScenePx().intersects(rectPx));
+            if (netlabel->isSelected()) mAreaSelection.insert(netlabel);
+        mAreaSelectionValid = true;
     }
+
+    // apply only the differences and repaint the scene once for all of them
+    bool changed = false;
+    foreach (SI_Base* item, mAreaSelection) {
+        if (!selection.contains(item)) {
+            item->setSelectedWithoutRepaint(false);
+            changed = true;
+        }
+    }
+    foreach (SI_Base* item, selection) {
+        if (!item->isSelected()) {
+            item->setSelectedWithoutRepaint(true);
+            changed = true;
+        }
+    }
+    mAreaSelection = selection;
+    if (changed) mGraphicsScene->update();
 }
 
 void Schematic::clearSelection() const noexcept
@@ -653,9 +740,21 @@ void Schematic::clearSelection() const noexcept
         netlabel->setSelected(false);
 }
 
-void Schematic::renderToQPainter(QPainter& painter) const noexcept
+QRectF Schematic::getPrintRect() const noexcept
 {
-    mGraphicsScene->render(&painter, QRectF(), mGraphicsScene->itemsBoundingRect(), Qt::KeepAspectRatio);
+    return mGraphicsScene->itemsBoundingRect();
+}
+
+void Schematic::renderToQPainter(QPainter& painter, const QRectF& rect) const noexcept
+{
+    mGraphicsScene->render(&painter, rect, rect, Qt::IgnoreAspectRatio);
+}
+
+void Schematic::updateSpatialIndex(SI_Base& item) noexcept
+{
+    if (mSpatialIndex->contains(&item)) {
+        mSpatialIndex->insert(&item, item.getBoundingBox());
+    }
 }
 
 /*****************************************************************************************
@@ -703,6 +802,40 @@ void Schematic::updateIcon() noexcept
     mIcon = QIcon(pixmap);
 }
 
+void Schematic::addToSpatialIndex(SI_Base& item) noexcept
+{
+    mSpatialIndex->insert(&item, item.getBoundingBox());
+    if (item.getType() == SI_Base::Type_t::Symbol) {
+        // symbol pins are not added separately to the schematic, so add them here
+        foreach (SI_SymbolPin* pin, static_cast<SI_Symbol&>(item).getPins()) {
+            addToSpatialIndex(*pin);
+        }
+    }
+}
+
+void Schematic::removeFromSpatialIndex(SI_Base& item) noexcept
+{
+    mSpatialIndex->remove(&item);
+    mAreaSelection.remove(&item);
+    if (item.getType() == SI_Base::Type_t::Symbol) {
+        foreach (SI_SymbolPin* pin, static_cast<SI_Symbol&>(item).getPins()) {
+            mSpatialIndex->remove(pin);
+            mAreaSelection.remove(pin);
+        }
+    }
+}
+
+QList<SI_Base*> Schematic::getItemCandidatesAtScenePos(const Point& pos) const noexcept
+{
+    // the spatial index only compares bounding boxes, so check the exact shapes too
+    QList<SI_Base*> list;
+    foreach (SI_Base* item, mSpatialIndex->query(pos)) {
+        if (item->isAtScenePos(pos))
+            list.append(item);
+    }
+    return list;
+}
+
 bool Schematic::checkAttributesValidity() const noexcept
 {
     if (mUuid.isNull())     return false;
@@ -41,6 +41,7 @@ class GridProperties;
 class GraphicsView;
 class GraphicsScene;
 class SmartXmlFile;
+template <typename T> class SpatialIndex;
 
 namespace project {
 
@@ -127,6 +128,8 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         QList<SI_NetPoint*> getNetPointsAtScenePos(const Point& pos) const noexcept;
         QList<SI_NetLine*> getNetLinesAtScenePos(const Point& pos) const noexcept;
         QList<SI_SymbolPin*> getPinsAtScenePos(const Point& pos) const noexcept;
+        SI_Base* getNearestConnectableAnchor(const Point& pos, const Length& radius,
+                                             const QList<SI_Base*>& except = QList<SI_Base*>()) const noexcept;
         QList<SI_Base*> getAllItems() const noexcept;
 
         // Setters: General
@@ -166,7 +169,30 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         const QRectF& restoreViewSceneRect() const noexcept {return mViewRect;}
         void setSelectionRect(const Point& p1, const Point& p2, bool updateItems) noexcept;
         void clearSelection() const noexcept;
-        void renderToQPainter(QPainter& painter) const noexcept;
+
+        /**
+         * @brief Get the area of the scene which is printed (the bounding rect of all items)
+         */
+        QRectF getPrintRect() const noexcept;
+
+        /**
+         * @brief Render an area of the scene without scaling (in scene coordinates)
+         *
+         * @param painter   The painter to render to
+         * @param rect      The area to render (see #getPrintRect())
+         */
+        void renderToQPainter(QPainter& painter, const QRectF& rect) const noexcept;
+
+        /**
+         * @brief Update the spatial index after the grab area of an item has changed
+         *
+         * This method is called by SI_Base::grabAreaChanged() whenever the position,
+         * rotation or shape of an item has changed. Items which are not added to the
+         * schematic are ignored.
+         *
+         * @param item  The item which has changed
+         */
+        void updateSpatialIndex(SI_Base& item) noexcept;
 
         // Helper Methods
         bool getAttributeValue(const QString& attrNS, const QString& attrKey,
@@ -193,6 +219,9 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         Schematic(Project& project, const FilePath& filepath, bool restore,
                   bool readOnly, bool create, const QString& newName) throw (Exception);
         void updateIcon() noexcept;
+        void addToSpatialIndex(SI_Base& item) noexcept;
+        void removeFromSpatialIndex(SI_Base& item) noexcept;
+        QList<SI_Base*> getItemCandidatesAtScenePos(const Point& pos) const noexcept;
 
         /// @copydoc IF_XmlSerializableObject#checkAttributesValidity()
         bool checkAttributesValidity() const noexcept override;
@@ -211,6 +240,15 @@ class Schematic final : public QObject, public IF_AttributeProvider,
         QScopedPointer<GridProperties> mGridProperties;
         QRectF mViewRect;
 
+        /// Index over the grab areas of all items (incl. symbol pins) which are added
+        /// to the schematic, used to speed up all "AtScenePos" methods
+        QScopedPointer<SpatialIndex<SI_Base*>> mSpatialIndex;
+
+        /// The items selected by the current selection rectangle, used to apply only the
+        /// differences on every change of the rectangle (see #setSelectionRect())
+        QSet<SI_Base*> mAreaSelection;
+        bool mAreaSelectionValid;
+
         // Attributes
         Uuid mUuid;
         QString mName;
@@ -28,7 +28,9 @@
 #include <librepcbworkspace/workspace.h>
 #include <librepcbworkspace/settings/workspacesettings.h>
 #include <librepcbcommon/undostack.h>
+#include <librepcbcommon/scopeguard.h>
 #include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/boardratsnest.h>
 #include <librepcbproject/circuit/circuit.h>
 #include <librepcbcommon/dialogs/gridsettingsdialog.h>
 #include <librepcbcommon/dialogs/boarddesignrulesdialog.h>
@@ -43,7 +45,10 @@
 #include "fsm/bes_fsm.h"
 #include "../projecteditor.h"
 #include "boardlayersdock.h"
+#include "netstatisticsdock.h"
 #include "fabricationoutputdialog.h"
+#include "../cmd/cmdcleanupboardtraces.h"
+#include "../cmd/cmdautorouteboard.h"
 
 /*****************************************************************************************
  *  Namespace
@@ -60,7 +65,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     mUi(new Ui::BoardEditor),
     mGraphicsView(nullptr), mActiveBoardIndex(-1), mBoardListActionGroup(this),
     mErcMsgDock(nullptr), mUnplacedComponentsDock(nullptr), mBoardLayersDock(nullptr),
-    mFsm(nullptr)
+    mNetStatisticsDock(nullptr), mFsm(nullptr)
 {
     mUi->setupUi(this);
     mUi->actionProjectSave->setEnabled(!mProject.isReadOnly());
@@ -80,6 +85,8 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project) :
     addDockWidget(Qt::RightDockWidgetArea, mUnplacedComponentsDock, Qt::Vertical);
     mBoardLayersDock = new BoardLayersDock(*this);
     addDockWidget(Qt::RightDockWidgetArea, mBoardLayersDock, Qt::Vertical);
+    mNetStatisticsDock = new NetStatisticsDock();
+    addDockWidget(Qt::RightDockWidgetArea, mNetStatisticsDock, Qt::Vertical);
 
     // add graphics view as central widget
     mGraphicsView = new GraphicsView(nullptr, this);
@@ -191,6 +198,7 @@ BoardEditor::~BoardEditor()
 
     delete mFsm;                    mFsm = nullptr;
     qDeleteAll(mBoardListActions);  mBoardListActions.clear();
+    delete mNetStatisticsDock;      mNetStatisticsDock = nullptr;
     delete mBoardLayersDock;        mBoardLayersDock = nullptr;
     delete mUnplacedComponentsDock; mUnplacedComponentsDock = nullptr;
     delete mErcMsgDock;             mErcMsgDock = nullptr;
@@ -246,6 +254,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept
     mActiveBoardIndex = index;
     mUnplacedComponentsDock->setBoard(board);
     mBoardLayersDock->setActiveBoard(board);
+    mNetStatisticsDock->setActiveBoard(board);
     mUi->tabBar->setCurrentIndex(index);
     emit activeBoardChanged(oldIndex, index);
     return true;
@@ -457,6 +466,42 @@ void BoardEditor::on_actionModifyDesignRules_triggered()
     }
 }
 
+void BoardEditor::on_actionRunDesignRuleCheck_triggered()
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    int count = board->runDesignRuleCheck();
+    QApplication::restoreOverrideCursor();
+    if (count > 0) {
+        QMessageBox::warning(this, tr("Design Rule Check"),
+            tr("%1 violation(s) found, see the ERC messages for details.").arg(count));
+    } else {
+        QMessageBox::information(this, tr("Design Rule Check"), tr("No violations found."));
+    }
+}
+
+void BoardEditor::on_actionCleanUpTraces_triggered()
+{
+    cleanUpTraces(false);
+}
+
+void BoardEditor::on_actionCleanUpSelectedTraces_triggered()
+{
+    cleanUpTraces(true);
+}
+
+void BoardEditor::on_actionAutoroute_triggered()
+{
+    autoroute(false);
+}
+
+void BoardEditor::on_actionAutorouteSelected_triggered()
+{
+    autoroute(true);
+}
+
 void BoardEditor::on_tabBar_currentChanged(int index)
 {
     setActiveBoardIndex(index);
@@ -471,6 +516,66 @@ void BoardEditor::boardListActionGroupTriggered(QAction* action)
  *  Private Methods
  ****************************************************************************************/
 
+void BoardEditor::cleanUpTraces(bool selectedOnly) noexcept
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    try {
+        CmdCleanUpBoardTraces* cmd = new CmdCleanUpBoardTraces(*board, selectedOnly);
+        mProjectEditor.getUndoStack().execCmd(cmd); // can throw
+        QApplication::restoreOverrideCursor();
+    } catch (Exception& e) {
+        QApplication::restoreOverrideCursor();
+        QMessageBox::warning(this, tr("Error"), e.getUserMsg());
+    }
+}
+
+void BoardEditor::autoroute(bool selectedOnly) noexcept
+{
+    Board* board = getActiveBoard();
+    if (!board) return;
+
+    QProgressDialog progress(tr("Routing air wires..."), tr("Cancel"), 0, 0, this);
+    progress.setWindowModality(Qt::ApplicationModal);
+    progress.setMinimumDuration(500);
+    UndoStack& undoStack = mProjectEditor.getUndoStack();
+    try {
+        // the active command group rejects all other commands (and undo/redo) of the
+        // project while the progress dialog processes events, so the board can't change
+        // between routing and adding the traces
+        undoStack.beginCmdGroup(tr("Autoroute")); // can throw
+        auto abortGuard = scopeGuard([&](){
+            try { undoStack.abortCmdGroup(); } catch (...) {}
+        });
+        CmdAutorouteBoard::Routes_t routes = CmdAutorouteBoard::route(*board, selectedOnly,
+            [&progress](int finished, int total) {
+                progress.setMaximum(total);
+                progress.setValue(finished);
+                qApp->processEvents();
+                return !progress.wasCanceled();
+            }); // can throw
+        progress.close();
+        undoStack.appendToCmdGroup(new CmdAutorouteBoard(*board, routes)); // can throw
+        undoStack.commitCmdGroup(); // can throw
+        abortGuard.dismiss();
+    } catch (UserCanceled& e) {
+        return;
+    } catch (Exception& e) {
+        progress.close();
+        QMessageBox::warning(this, tr("Error"), e.getUserMsg());
+        return;
+    }
+
+    board->getRatsnest().update(); // update the air wires immediately
+    int count = board->getRatsnest().getAirWireCount();
+    if (count > 0) {
+        QMessageBox::information(this, tr("Autoroute"),
+            tr("%1 air wire(s) could not be routed.").arg(count));
+    }
+}
+
 bool BoardEditor::graphicsViewEventHandler(QEvent* event)
 {
     BEE_RedirectedQEvent* e = new BEE_RedirectedQEvent(BEE_Base::GraphicsViewEvent, event);
@@ -44,6 +44,7 @@ class Board;
 class ErcMsgDock;
 class UnplacedComponentsDock;
 class BoardLayersDock;
+class NetStatisticsDock;
 class BES_FSM;
 class ComponentInstance;
 
@@ -105,6 +106,11 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         void on_actionGenerateFabricationData_triggered();
         void on_actionProjectProperties_triggered();
         void on_actionModifyDesignRules_triggered();
+        void on_actionRunDesignRuleCheck_triggered();
+        void on_actionCleanUpTraces_triggered();
+        void on_actionCleanUpSelectedTraces_triggered();
+        void on_actionAutoroute_triggered();
+        void on_actionAutorouteSelected_triggered();
         void on_tabBar_currentChanged(int index);
         void boardListActionGroupTriggered(QAction* action);
 
@@ -123,6 +129,8 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
 
         // Private Methods
         bool graphicsViewEventHandler(QEvent* event);
+        void cleanUpTraces(bool selectedOnly) noexcept;
+        void autoroute(bool selectedOnly) noexcept;
 
         // General Attributes
         ProjectEditor& mProjectEditor;
@@ -139,6 +147,7 @@ class BoardEditor final : public QMainWindow, public IF_GraphicsViewEventHandler
         ErcMsgDock* mErcMsgDock;
         UnplacedComponentsDock* mUnplacedComponentsDock;
         BoardLayersDock* mBoardLayersDock;
+        NetStatisticsDock* mNetStatisticsDock;
 
         // Finite State Machine
         BES_FSM* mFsm;
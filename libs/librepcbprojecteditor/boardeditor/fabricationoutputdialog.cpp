@@ -26,6 +26,7 @@
 #include <librepcbproject/project.h>
 #include <librepcbproject/boards/board.h>
 #include <librepcbproject/boards/boardgerberexport.h>
+#include <librepcbproject/boards/boardpanel.h>
 
 /*****************************************************************************************
  *  Namespace
@@ -45,6 +46,12 @@ FabricationOutputDialog::FabricationOutputDialog(Board& board, QWidget *parent)
 
     FilePath gerberDir = mProject.getPath().getPathTo("generated/gerber");
     mUi->edtOutputDirPath->setText(gerberDir.toNative());
+
+    for (int i = 0; i < 4; ++i) {
+        Angle rotation = Angle::deg90() * i;
+        mUi->cbxRotation->addItem(QString("%1°").arg(rotation.toDeg()), rotation.toMicroDeg());
+    }
+    loadPanel();
 }
 
 FabricationOutputDialog::~FabricationOutputDialog()
@@ -71,6 +78,7 @@ void FabricationOutputDialog::on_btnGenerate_clicked()
     if (filepath.mkPath()) {
         try
         {
+            applyPanel();
             BoardGerberExport grbExport(mBoard, filepath);
             grbExport.exportAllLayers();
         }
@@ -93,6 +101,40 @@ void FabricationOutputDialog::on_btnBrowseOutputDir_clicked()
     }
 }
 
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void FabricationOutputDialog::loadPanel() noexcept
+{
+    const BoardPanel& panel = mBoard.getPanel();
+    mUi->spbColumns->setValue(panel.getColumns());
+    mUi->spbRows->setValue(panel.getRows());
+    mUi->spbSpacingX->setValue(panel.getSpacingX().toMm());
+    mUi->spbSpacingY->setValue(panel.getSpacingY().toMm());
+    mUi->cbxRotation->setCurrentIndex(mUi->cbxRotation->findData(
+        panel.getRotation().mappedTo0_360deg().toMicroDeg()));
+    mUi->spbRailWidth->setValue(panel.getRailWidth().toMm());
+    mUi->spbMouseBiteCount->setValue(panel.getMouseBiteCount());
+    mUi->spbMouseBiteDiameter->setValue(panel.getMouseBiteDiameter().toMm());
+    mUi->spbMouseBitePitch->setValue(panel.getMouseBitePitch().toMm());
+}
+
+void FabricationOutputDialog::applyPanel() throw (Exception)
+{
+    BoardPanel panel(mBoard.getPanel());
+    panel.setColumns(mUi->spbColumns->value());
+    panel.setRows(mUi->spbRows->value());
+    panel.setSpacingX(Length::fromMm(mUi->spbSpacingX->value()));
+    panel.setSpacingY(Length::fromMm(mUi->spbSpacingY->value()));
+    panel.setRotation(Angle(mUi->cbxRotation->currentData().toInt()));
+    panel.setRailWidth(Length::fromMm(mUi->spbRailWidth->value()));
+    panel.setMouseBiteCount(mUi->spbMouseBiteCount->value());
+    panel.setMouseBiteDiameter(Length::fromMm(mUi->spbMouseBiteDiameter->value()));
+    panel.setMouseBitePitch(Length::fromMm(mUi->spbMouseBitePitch->value()));
+    mBoard.setPanel(panel);
+}
+
 /*****************************************************************************************
  *  End of File
  ****************************************************************************************/
@@ -25,6 +25,7 @@
  ****************************************************************************************/
 #include <QtCore>
 #include <QtWidgets>
+#include <librepcbcommon/exceptions.h>
 
 /*****************************************************************************************
  *  Namespace / Forward Declarations
@@ -71,6 +72,9 @@ class FabricationOutputDialog final : public QDialog
 
     private:
 
+        void loadPanel() noexcept;
+        void applyPanel() throw (Exception);
+
         Project& mProject;
         Board& mBoard;
         Ui::FabricationOutputDialog* mUi;
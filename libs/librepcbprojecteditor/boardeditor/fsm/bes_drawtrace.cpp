@@ -45,6 +45,10 @@
 #include <librepcbcommon/gridproperties.h>
 #include <librepcbproject/boards/boardlayerstack.h>
 #include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/boarddesignrules.h>
+#include <librepcbcommon/geometry/convexshape.h>
+#include <librepcbcommon/geometry/walkaroundrouter.h>
+#include <librepcbproject/boards/items/bi_via.h>
 #include "../../cmd/cmdplaceboardnetpoint.h"
 #include "../../cmd/cmdcombineboardnetpoints.h"
 #include "../../cmd/cmdcombineallitemsunderboardnetpoint.h"
@@ -118,6 +122,10 @@ bool BES_DrawTrace::entry(BEE_Base* event) noexcept
                             QIcon(":/img/command_toolbars/wire4590.png"), ""));
     mWireModeActions.insert(WireMode_Straight, mEditorUi.commandToolbar->addAction(
                             QIcon(":/img/command_toolbars/wireStraight.png"), ""));
+    mWireModeActions.insert(WireMode_Walkaround, mEditorUi.commandToolbar->addAction(
+                            tr("Walkaround")));
+    mWireModeActions.value(WireMode_Walkaround)->setToolTip(
+        tr("Route around pads, vias and traces of other nets"));
     mActionSeparators.append(mEditorUi.commandToolbar->addSeparator());
     updateWireModeActionsCheckedState();
 
@@ -342,6 +350,8 @@ bool BES_DrawTrace::startPositioning(Board& board, const Point& pos,
         Q_ASSERT(mSubState == SubState_Idle);
         mUndoStack.beginCmdGroup(tr("Draw Board Trace"));
         mSubState = SubState_PositioningNetPoint;
+        mWalkaroundNetPoints.clear();
+        mWalkaroundNetLines.clear();
 
         // determine the fixed netpoint (create one if it doesn't exist already)
         if (fixedPoint) {
@@ -423,6 +433,18 @@ bool BES_DrawTrace::addNextNetPoint(Board& board, const Point& pos) noexcept
 
         try
         {
+            // remove unused walkaround netpoints (same position as their neighbour)
+            BI_NetPoint* previous = mPositioningNetPoint1;
+            foreach (BI_NetPoint* netpoint, mWalkaroundNetPoints) {
+                if (netpoint->getPosition() == previous->getPosition()) {
+                    mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*netpoint, *previous));
+                } else if (netpoint->getPosition() == mPositioningNetPoint2->getPosition()) {
+                    mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*netpoint, *mPositioningNetPoint2));
+                } else {
+                    previous = netpoint;
+                }
+            }
+
             // remove p1 if p1 == p0 || p1 == p2
             if (mPositioningNetPoint1->getPosition() == mFixedNetPoint->getPosition()) {
                 mUndoStack.appendToCmdGroup(new CmdCombineBoardNetPoints(*mPositioningNetPoint1, *mFixedNetPoint));
@@ -482,6 +504,8 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept
         mPositioningNetLine2 = nullptr;
         mPositioningNetPoint1 = nullptr;
         mPositioningNetPoint2 = nullptr;
+        mWalkaroundNetPoints.clear();
+        mWalkaroundNetLines.clear();
         mUndoStack.abortCmdGroup(); // can throw
         return true;
     }
@@ -494,11 +518,117 @@ bool BES_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept
 
 void BES_DrawTrace::updateNetpointPositions(const Point& cursorPos) noexcept
 {
+    if (mCurrentWireMode == WireMode_Walkaround) {
+        Board* board = mEditor.getActiveBoard();
+        QVector<Point> path;
+        if (board) path = calcWalkaroundPath(*board, cursorPos);
+        if (path.isEmpty()) {
+            // no path found, draw a straight line to show where the problem is
+            path = {mFixedNetPoint->getPosition(), cursorPos};
+        }
+        updateWalkaroundNetpointPositions(path);
+        return;
+    }
+
     mPositioningNetPoint1->setPosition(calcMiddlePointPos(mFixedNetPoint->getPosition(),
                                                           cursorPos, mCurrentWireMode));
+    foreach (BI_NetPoint* netpoint, mWalkaroundNetPoints) netpoint->setPosition(cursorPos);
     mPositioningNetPoint2->setPosition(cursorPos);
 }
 
+void BES_DrawTrace::updateWalkaroundNetpointPositions(const QVector<Point>& path) noexcept
+{
+    Q_ASSERT(path.count() >= 2);
+    Board* board = mEditor.getActiveBoard();
+
+    // the path p0 -> p1 -> [walkaround netpoints] -> p2 needs enough netpoints; unused
+    // ones are moved to p2 and removed when the trace is fixed (see addNextNetPoint())
+    try
+    {
+        while (board && mPositioningNetLine2 &&
+               (mWalkaroundNetPoints.count() < path.count() - 3)) {
+            // split the last netline (to p2) by inserting a new netpoint
+            BI_NetPoint* lastNetPoint = mWalkaroundNetPoints.isEmpty() ?
+                mPositioningNetPoint1 : mWalkaroundNetPoints.last();
+            mUndoStack.appendToCmdGroup(new CmdBoardNetLineRemove(*mPositioningNetLine2));
+            mPositioningNetLine2 = nullptr;
+            CmdBoardNetPointAdd* cmdNetPointAdd = new CmdBoardNetPointAdd(*board,
+                mPositioningNetPoint2->getLayer(), mPositioningNetPoint2->getNetSignal(),
+                mPositioningNetPoint2->getPosition());
+            mUndoStack.appendToCmdGroup(cmdNetPointAdd);
+            CmdBoardNetLineAdd* cmdNetLineAdd1 = new CmdBoardNetLineAdd(*board,
+                *lastNetPoint, *cmdNetPointAdd->getNetPoint(), mCurrentWidth);
+            mUndoStack.appendToCmdGroup(cmdNetLineAdd1);
+            CmdBoardNetLineAdd* cmdNetLineAdd2 = new CmdBoardNetLineAdd(*board,
+                *cmdNetPointAdd->getNetPoint(), *mPositioningNetPoint2, mCurrentWidth);
+            mUndoStack.appendToCmdGroup(cmdNetLineAdd2);
+            mWalkaroundNetPoints.append(cmdNetPointAdd->getNetPoint());
+            mWalkaroundNetLines.append(cmdNetLineAdd1->getNetLine());
+            mPositioningNetLine2 = cmdNetLineAdd2->getNetLine();
+        }
+    }
+    catch (Exception& e)
+    {
+        qCritical() << "Could not add walkaround netpoints:" << e.getUserMsg();
+    }
+
+    // p1 is at the first bend (or at p0 if there is none)
+    const Point& cursorPos = path.last();
+    mPositioningNetPoint1->setPosition((path.count() > 2) ? path.at(1) : path.first());
+    for (int i = 0; i < mWalkaroundNetPoints.count(); ++i) {
+        int index = i + 2;
+        mWalkaroundNetPoints.at(i)->setPosition(
+            (index < path.count() - 1) ? path.at(index) : cursorPos);
+    }
+    mPositioningNetPoint2->setPosition(cursorPos);
+}
+
+QVector<Point> BES_DrawTrace::calcWalkaroundPath(const Board& board,
+                                                 const Point& cursorPos) const noexcept
+{
+    const Point& start = mFixedNetPoint->getPosition();
+    const NetSignal* netsignal = &mFixedNetPoint->getNetSignal();
+    int layerId = mFixedNetPoint->getLayer().getId();
+    Length margin = mCurrentWidth / 2 + board.getDesignRules().getCopperClearance();
+
+    // the detour may not be bigger than half of the direct distance (plus some space)
+    Point delta = cursorPos - start;
+    Length detour = qMax(delta.getX().abs(), delta.getY().abs()) / 2 + Length(2000000);
+    BoundingBox area = BoundingBox(start, cursorPos).expanded(detour);
+
+    WalkaroundRouter router(board.getGridProperties().getInterval(), margin);
+    foreach (const BI_Base* item, board.getItemsInArea(area.expanded(margin))) {
+        switch (item->getType())
+        {
+            case BI_Base::Type_t::NetLine: {
+                const BI_NetLine* netline = static_cast<const BI_NetLine*>(item);
+                if ((netline->getLayer().getId() == layerId) &&
+                    (&netline->getNetSignal() != netsignal)) {
+                    router.addObstacle(netline->getCopperShape());
+                }
+                break;
+            }
+            case BI_Base::Type_t::Via: {
+                const BI_Via* via = static_cast<const BI_Via*>(item);
+                if (via->isOnLayer(layerId) && (via->getNetSignal() != netsignal)) {
+                    router.addObstacle(via->getCopperShape());
+                }
+                break;
+            }
+            case BI_Base::Type_t::FootprintPad: {
+                const BI_FootprintPad* pad = static_cast<const BI_FootprintPad*>(item);
+                if (pad->isOnLayer(layerId) && (pad->getCompSigInstNetSignal() != netsignal)) {
+                    router.addObstacle(pad->getCopperShape());
+                }
+                break;
+            }
+            default:
+                break; // no copper
+        }
+    }
+    return router.route(start, cursorPos, area);
+}
+
 void BES_DrawTrace::layerComboBoxIndexChanged(int index) noexcept
 {
     mCurrentLayerId = mLayerComboBox->itemData(index).toInt();
@@ -511,6 +641,7 @@ void BES_DrawTrace::wireWidthComboBoxTextChanged(const QString& width) noexcept
     if (mSubState != SubState::SubState_PositioningNetPoint) return;
     if (mPositioningNetLine1) mPositioningNetLine1->setWidth(mCurrentWidth);
     if (mPositioningNetLine2) mPositioningNetLine2->setWidth(mCurrentWidth);
+    foreach (BI_NetLine* netline, mWalkaroundNetLines) netline->setWidth(mCurrentWidth);
 }
 
 void BES_DrawTrace::updateWireModeActionsCheckedState() noexcept
@@ -82,6 +82,7 @@ class BES_DrawTrace final : public BES_Base
             WireMode_9045,      ///< 90° - 45°
             WireMode_4590,      ///< 45° - 90°
             WireMode_Straight,  ///< straight
+            WireMode_Walkaround,///< octilinear path around obstacles of other nets
             WireMode_COUNT      ///< count of wire modes
         };
 
@@ -96,6 +97,9 @@ class BES_DrawTrace final : public BES_Base
         bool addNextNetPoint(Board& board, const Point& pos) noexcept;
         bool abortPositioning(bool showErrMsgBox) noexcept;
         void updateNetpointPositions(const Point& cursorPos) noexcept;
+        void updateWalkaroundNetpointPositions(const QVector<Point>& path) noexcept;
+        QVector<Point> calcWalkaroundPath(const Board& board,
+                                          const Point& cursorPos) const noexcept;
         void layerComboBoxIndexChanged(int index) noexcept;
         void wireWidthComboBoxTextChanged(const QString& width) noexcept;
         void updateWireModeActionsCheckedState() noexcept;
@@ -112,6 +116,8 @@ class BES_DrawTrace final : public BES_Base
         BI_NetPoint* mPositioningNetPoint1; ///< the first netpoint to place
         BI_NetLine* mPositioningNetLine2; ///< line between p1 and p2
         BI_NetPoint* mPositioningNetPoint2; ///< the second netpoint to place
+        QList<BI_NetPoint*> mWalkaroundNetPoints; ///< additional netpoints between p1 and p2
+        QList<BI_NetLine*> mWalkaroundNetLines; ///< additional netlines between p1 and p2
 
         // Widgets for the command toolbar
         QHash<WireMode, QAction*> mWireModeActions;
@@ -0,0 +1,170 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+#include "netstatisticsdock.h"
+#include "ui_netstatisticsdock.h"
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/boardlayerstack.h>
+#include <librepcbproject/boards/boardnetstatistics.h>
+#include <librepcbproject/circuit/netsignal.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+NetStatisticsDock::NetStatisticsDock() noexcept :
+    QDockWidget(nullptr), mUi(new Ui::NetStatisticsDock), mActiveBoard(nullptr)
+{
+    mUi->setupUi(this);
+    mUi->tableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(100);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &NetStatisticsDock::updatePendingRows);
+}
+
+NetStatisticsDock::~NetStatisticsDock() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Setters
+ ****************************************************************************************/
+
+void NetStatisticsDock::setActiveBoard(Board* board)
+{
+    if (mActiveBoard) {
+        disconnect(mActiveBoardConnection);
+    }
+
+    mActiveBoard = board;
+
+    if (mActiveBoard) {
+        mActiveBoardConnection = connect(&mActiveBoard->getNetStatistics(),
+                                         &BoardNetStatistics::statisticsChanged,
+                                         this, &NetStatisticsDock::netStatisticsChanged);
+    }
+
+    updateAllRows();
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void NetStatisticsDock::netStatisticsChanged(const NetSignal* netsignal) noexcept
+{
+    mPendingNetSignals.insert(netsignal);
+    if (!mUpdateTimer.isActive()) mUpdateTimer.start();
+}
+
+void NetStatisticsDock::updatePendingRows() noexcept
+{
+    mUi->tableWidget->setSortingEnabled(false);
+    foreach (const NetSignal* netsignal, mPendingNetSignals) {
+        updateRow(netsignal);
+    }
+    mPendingNetSignals.clear();
+    mUi->tableWidget->setSortingEnabled(true);
+}
+
+void NetStatisticsDock::updateAllRows() noexcept
+{
+    mUpdateTimer.stop();
+    mPendingNetSignals.clear();
+    mRowItems.clear();
+    mUi->tableWidget->setSortingEnabled(false);
+    mUi->tableWidget->setRowCount(0);
+    if (mActiveBoard) {
+        foreach (const NetSignal* netsignal, mActiveBoard->getNetStatistics().getNetSignals()) {
+            updateRow(netsignal);
+        }
+    }
+    mUi->tableWidget->setSortingEnabled(true);
+}
+
+void NetStatisticsDock::updateRow(const NetSignal* netsignal) noexcept
+{
+    // netsignal may be dangling if it was removed in the meantime, so it must not be
+    // dereferenced unless it still has statistics (i.e. items on the board)
+    BoardNetStatistics::NetStatistics_t statistics;
+    if (mActiveBoard) statistics = mActiveBoard->getNetStatistics().getStatistics(*netsignal);
+    QTableWidgetItem* nameItem = mRowItems.value(netsignal, nullptr);
+    if (statistics.isEmpty()) {
+        if (nameItem) mUi->tableWidget->removeRow(nameItem->row());
+        mRowItems.remove(netsignal);
+        return;
+    }
+
+    int row;
+    if (nameItem) {
+        row = nameItem->row();
+    } else {
+        row = mUi->tableWidget->rowCount();
+        mUi->tableWidget->insertRow(row);
+        nameItem = new QTableWidgetItem();
+        mUi->tableWidget->setItem(row, 0, nameItem);
+        for (int column = 1; column < mUi->tableWidget->columnCount(); ++column) {
+            QTableWidgetItem* item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            mUi->tableWidget->setItem(row, column, item);
+        }
+        mRowItems.insert(netsignal, nameItem);
+    }
+
+    // the length per layer is shown as tooltip of the whole row
+    QStringList layerLengths;
+    for (auto it = statistics.lengthPerLayer.constBegin();
+         it != statistics.lengthPerLayer.constEnd(); ++it) {
+        BoardLayer* layer = mActiveBoard->getLayerStack().getBoardLayer(it.key());
+        QString layerName = layer ? layer->getName() : QString::number(it.key());
+        layerLengths.append(QString("%1: %2 mm").arg(layerName)
+                            .arg(it.value().toMm(), 0, 'f', 3));
+    }
+    QString toolTip = layerLengths.join("\n");
+
+    // numeric values are stored as numbers to get them sorted correctly
+    qreal lengthMm = qRound(statistics.getTotalLength().toMm() * 1000) / 1000.0;
+    nameItem->setText(netsignal->getName());
+    mUi->tableWidget->item(row, 1)->setData(Qt::DisplayRole, lengthMm);
+    mUi->tableWidget->item(row, 2)->setData(Qt::DisplayRole, statistics.netLineCount);
+    mUi->tableWidget->item(row, 3)->setData(Qt::DisplayRole, statistics.viaCount);
+    for (int column = 0; column < mUi->tableWidget->columnCount(); ++column) {
+        mUi->tableWidget->item(row, column)->setToolTip(toolTip);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,99 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_NETSTATISTICSDOCK_H
+#define LIBREPCB_PROJECT_NETSTATISTICSDOCK_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+namespace project {
+
+class Board;
+class NetSignal;
+
+namespace Ui {
+class NetStatisticsDock;
+}
+
+/*****************************************************************************************
+ *  Class NetStatisticsDock
+ ****************************************************************************************/
+
+/**
+ * @brief The NetStatisticsDock class shows the routed length, the segment count and the
+ *        via count of every net signal of the active board
+ *
+ * The values are taken from the board's cached project#BoardNetStatistics. Changes are
+ * collected and applied to the table with a short delay, so dragging traces around does
+ * not refresh the table for every single mouse move.
+ */
+class NetStatisticsDock final : public QDockWidget
+{
+        Q_OBJECT
+
+    public:
+
+        // Constructors / Destructor
+        NetStatisticsDock() noexcept;
+        ~NetStatisticsDock() noexcept;
+
+        // Setters
+        void setActiveBoard(Board* board);
+
+
+    private:
+
+        // make some methods inaccessible...
+        NetStatisticsDock(const NetStatisticsDock& other);
+        NetStatisticsDock& operator=(const NetStatisticsDock& rhs);
+
+        // Private Methods
+        void netStatisticsChanged(const NetSignal* netsignal) noexcept;
+        void updatePendingRows() noexcept;
+        void updateAllRows() noexcept;
+        void updateRow(const NetSignal* netsignal) noexcept;
+
+
+        // General
+        QScopedPointer<Ui::NetStatisticsDock> mUi;
+        Board* mActiveBoard;
+        QMetaObject::Connection mActiveBoardConnection;
+        QTimer mUpdateTimer;
+        QSet<const NetSignal*> mPendingNetSignals;
+        QHash<const NetSignal*, QTableWidgetItem*> mRowItems; ///< the item of column 0
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_NETSTATISTICSDOCK_H
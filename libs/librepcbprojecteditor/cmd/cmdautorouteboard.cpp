@@ -0,0 +1,342 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdautorouteboard.h"
+#include <librepcbcommon/scopeguard.h>
+#include <librepcbcommon/boardlayer.h>
+#include <librepcbcommon/boarddesignrules.h>
+#include <librepcbcommon/geometry/gridrouter.h>
+#include <librepcbcommon/geometry/ratsnestbuilder.h>
+#include <librepcbproject/project.h>
+#include <librepcbproject/circuit/circuit.h>
+#include <librepcbproject/circuit/netsignal.h>
+#include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/boardlayerstack.h>
+#include <librepcbproject/boards/boardconnectivity.h>
+#include <librepcbproject/boards/items/bi_device.h>
+#include <librepcbproject/boards/items/bi_footprint.h>
+#include <librepcbproject/boards/items/bi_footprintpad.h>
+#include <librepcbproject/boards/items/bi_via.h>
+#include <librepcbproject/boards/items/bi_netpoint.h>
+#include <librepcbproject/boards/items/bi_netline.h>
+#include <librepcbproject/boards/cmd/cmdboardnetpointadd.h>
+#include <librepcbproject/boards/cmd/cmdboardnetlineadd.h>
+#include <librepcbproject/boards/cmd/cmdboardviaadd.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Struct Anchor_t
+ ****************************************************************************************/
+
+Point CmdAutorouteBoard::Anchor_t::getPosition() const noexcept
+{
+    if (pad) return pad->getPosition();
+    if (via) return via->getPosition();
+    return netpoint->getPosition();
+}
+
+bool CmdAutorouteBoard::Anchor_t::isOnLayer(const BoardLayer& layer) const noexcept
+{
+    if (pad) return pad->isOnLayer(layer.getId());
+    if (via) return via->isOnLayer(layer.getId());
+    return (&netpoint->getLayer() == &layer);
+}
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdAutorouteBoard::CmdAutorouteBoard(Board& board, const Routes_t& routes) noexcept :
+    UndoCommandGroup(tr("Autoroute")), mBoard(board), mRoutes(routes)
+{
+}
+
+CmdAutorouteBoard::~CmdAutorouteBoard() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdAutorouteBoard::performExecute() throw (Exception)
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    // add the traces and vias to the board
+    for (int i = 0; i < mRoutes.results.count(); ++i) {
+        const GridRouter::Result_t& result = mRoutes.results.at(i);
+        const AirWire_t& airwire = mRoutes.airwires.at(i);
+        if (!result.routed) continue; // keep the air wire
+        QVector<BI_Via*> vias(result.vias.count(), nullptr);
+        BI_NetPoint* previous = nullptr;
+        for (int k = 0; k < result.segments.count(); ++k) {
+            const GridRouter::Segment_t& segment = result.segments.at(k);
+            BoardLayer& layer = *mRoutes.layers.at(segment.layer);
+            if ((!previous) || (&previous->getLayer() != &layer) ||
+                (previous->getPosition() != segment.p1)) {
+                previous = &addNetPoint(*airwire.netsignal, layer, segment.p1,
+                                        (k == 0) ? &airwire.start : nullptr, result.vias,
+                                        vias); // can throw
+            }
+            BI_NetPoint& next = addNetPoint(*airwire.netsignal, layer, segment.p2,
+                (k == result.segments.count() - 1) ? &airwire.end : nullptr, result.vias,
+                vias); // can throw
+            execNewChildCmd(new CmdBoardNetLineAdd(mBoard, *previous, next,
+                                                   mRoutes.traceWidth)); // can throw
+            previous = &next;
+        }
+    }
+
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+/*****************************************************************************************
+ *  Static Methods
+ ****************************************************************************************/
+
+CmdAutorouteBoard::Routes_t CmdAutorouteBoard::route(Board& board, bool selectedOnly,
+        const ProgressCallback& progressCallback) throw (Exception)
+{
+    Routes_t routes;
+    const BoardDesignRules& rules = board.getDesignRules();
+    routes.traceWidth = qMax(rules.getCopperMinWidth(), Length(300000));
+    routes.viaDrillDiameter = qMax(rules.getDrillMinDiameter(), Length(300000));
+    routes.viaSize = routes.viaDrillDiameter +
+                     rules.calcViaRestring(routes.viaDrillDiameter) * 2;
+
+    // the copper layers of the board, from top to bottom
+    QList<BoardLayer*>& layers = routes.layers;
+    foreach (int id, board.getLayerStack().getAllBoardLayerIds()) {
+        BoardLayer* layer = board.getLayerStack().getBoardLayer(id);
+        if (layer && layer->isCopperLayer()) layers.append(layer);
+    }
+    auto getLayerMask = [&](const Anchor_t& anchor) {
+        quint32 mask = 0;
+        for (int i = 0; i < layers.count(); ++i) {
+            if (anchor.isOnLayer(*layers.at(i))) mask |= (1u << i);
+        }
+        return mask;
+    };
+
+    // the air wires to route
+    QHash<const NetSignal*, int> netIds;
+    QVector<GridRouter::Connection_t> connections;
+    foreach (NetSignal* netsignal, getNetSignalsToRoute(board, selectedOnly)) {
+        int net = netIds.count();
+        netIds.insert(netsignal, net);
+        foreach (const AirWire_t& airwire, getAirWires(board, *netsignal)) {
+            routes.airwires.append(airwire);
+            connections.append(GridRouter::Connection_t{net,
+                airwire.start.getPosition(), getLayerMask(airwire.start),
+                airwire.end.getPosition(), getLayerMask(airwire.end)});
+        }
+    }
+    if (connections.isEmpty() || layers.isEmpty()) {
+        routes.results.resize(routes.airwires.count()); // nothing routed
+        return routes;
+    }
+
+    // the routing area is limited to the extent of the existing copper
+    auto getNetId = [&](const NetSignal* netsignal) {
+        if (!netsignal) return -1;
+        if (!netIds.contains(netsignal)) netIds.insert(netsignal, netIds.count());
+        return netIds.value(netsignal);
+    };
+    BoundingBox area;
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+        foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+            area = area.united(pad->getCopperShape().getBoundingBox());
+        }
+    }
+    foreach (const BI_Via* via, board.getVias()) {
+        area = area.united(via->getCopperShape().getBoundingBox());
+    }
+    foreach (const BI_NetLine* netline, board.getNetLines()) {
+        area = area.united(netline->getCopperShape().getBoundingBox());
+    }
+
+    // all existing copper is an obstacle for other nets
+    GridRouter router(area, layers.count(), routes.traceWidth, routes.viaSize,
+                      rules.getCopperClearance());
+    foreach (const BI_Base* item, board.getItemsInArea(area)) {
+        switch (item->getType())
+        {
+            case BI_Base::Type_t::NetLine: {
+                const BI_NetLine* netline = static_cast<const BI_NetLine*>(item);
+                int layer = layers.indexOf(&netline->getLayer());
+                if (layer >= 0) {
+                    router.addObstacle(layer, netline->getCopperShape(),
+                                       getNetId(&netline->getNetSignal()));
+                }
+                break;
+            }
+            case BI_Base::Type_t::Via: {
+                const BI_Via* via = static_cast<const BI_Via*>(item);
+                router.addObstacle(-1, via->getCopperShape(), getNetId(via->getNetSignal()));
+                break;
+            }
+            case BI_Base::Type_t::FootprintPad: {
+                const BI_FootprintPad* pad = static_cast<const BI_FootprintPad*>(item);
+                for (int i = 0; i < layers.count(); ++i) {
+                    if (pad->isOnLayer(layers.at(i)->getId())) {
+                        router.addObstacle(i, pad->getCopperShape(),
+                                           getNetId(pad->getCompSigInstNetSignal()));
+                    }
+                }
+                break;
+            }
+            default:
+                break; // no copper
+        }
+    }
+
+    // route all air wires at once (in parallel)
+    bool canceled = false;
+    routes.results = router.route(connections,
+        [&](int finished, int total) {
+            if (progressCallback && (!progressCallback(finished, total))) canceled = true;
+            return !canceled;
+        });
+    if (canceled) {
+        throw UserCanceled(__FILE__, __LINE__);
+    }
+    return routes;
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+QList<NetSignal*> CmdAutorouteBoard::getNetSignalsToRoute(Board& board,
+                                                         bool selectedOnly) noexcept
+{
+    QList<NetSignal*> netsignals;
+    if (!selectedOnly) {
+        netsignals = board.getProject().getCircuit().getNetSignals().values();
+    } else {
+        foreach (const BI_Base* item, board.getSelectedItems(true, true, true, true, true,
+                 true, true, true, true, true, true, true)) {
+            NetSignal* netsignal = nullptr;
+            switch (item->getType())
+            {
+                case BI_Base::Type_t::FootprintPad:
+                    netsignal = static_cast<const BI_FootprintPad*>(item)->getCompSigInstNetSignal();
+                    break;
+                case BI_Base::Type_t::Via:
+                    netsignal = static_cast<const BI_Via*>(item)->getNetSignal();
+                    break;
+                case BI_Base::Type_t::NetPoint:
+                    netsignal = &static_cast<const BI_NetPoint*>(item)->getNetSignal();
+                    break;
+                case BI_Base::Type_t::NetLine:
+                    netsignal = &static_cast<const BI_NetLine*>(item)->getNetSignal();
+                    break;
+                default:
+                    break;
+            }
+            if (netsignal && (!netsignals.contains(netsignal))) netsignals.append(netsignal);
+        }
+    }
+    return netsignals;
+}
+
+QList<CmdAutorouteBoard::AirWire_t> CmdAutorouteBoard::getAirWires(Board& board,
+        NetSignal& netsignal) noexcept
+{
+    // the anchors of all islands, like in the ratsnest
+    QVector<Point> positions;
+    QVector<int> islands;
+    QVector<Anchor_t> anchors;
+    const QList<BoardConnectivity::Island_t>& netIslands =
+        board.getConnectivity().getIslands(netsignal);
+    for (int i = 0; i < netIslands.count(); ++i) {
+        const BoardConnectivity::Island_t& island = netIslands.at(i);
+        foreach (BI_FootprintPad* pad, island.pads) {
+            anchors.append(Anchor_t{pad, nullptr, nullptr});
+            islands.append(i);
+        }
+        foreach (BI_Via* via, island.vias) {
+            anchors.append(Anchor_t{nullptr, via, nullptr});
+            islands.append(i);
+        }
+        foreach (BI_NetPoint* netpoint, island.netpoints) {
+            anchors.append(Anchor_t{nullptr, nullptr, netpoint});
+            islands.append(i);
+        }
+    }
+    foreach (const Anchor_t& anchor, anchors) {
+        positions.append(anchor.getPosition());
+    }
+
+    QList<AirWire_t> airwires;
+    for (const QPair<int, int>& airwire : RatsnestBuilder::build(positions, islands)) {
+        airwires.append(AirWire_t{&netsignal, anchors.at(airwire.first),
+                                  anchors.at(airwire.second)});
+    }
+    return airwires;
+}
+
+BI_NetPoint& CmdAutorouteBoard::addNetPoint(NetSignal& netsignal, BoardLayer& layer,
+        const Point& pos, const Anchor_t* anchor, const QVector<Point>& viaPositions,
+        QVector<BI_Via*>& vias) throw (Exception)
+{
+    CmdBoardNetPointAdd* cmd = nullptr;
+    int viaIndex = viaPositions.indexOf(pos);
+    if (anchor && anchor->netpoint && (&anchor->netpoint->getLayer() == &layer)) {
+        return *anchor->netpoint; // continue the existing trace
+    } else if (anchor && anchor->pad && anchor->isOnLayer(layer)) {
+        cmd = new CmdBoardNetPointAdd(mBoard, layer, netsignal, *anchor->pad);
+    } else if (anchor && anchor->via) {
+        cmd = new CmdBoardNetPointAdd(mBoard, layer, netsignal, *anchor->via);
+    } else if (viaIndex >= 0) {
+        if (!vias.at(viaIndex)) {
+            CmdBoardViaAdd* viaCmd = new CmdBoardViaAdd(mBoard, pos, BI_Via::Shape::Round,
+                                                        mRoutes.viaSize,
+                                                        mRoutes.viaDrillDiameter, &netsignal);
+            execNewChildCmd(viaCmd); // can throw
+            vias[viaIndex] = viaCmd->getVia(); Q_ASSERT(vias.at(viaIndex));
+        }
+        cmd = new CmdBoardNetPointAdd(mBoard, layer, netsignal, *vias.at(viaIndex));
+    } else {
+        cmd = new CmdBoardNetPointAdd(mBoard, layer, netsignal, pos);
+    }
+    execNewChildCmd(cmd); // can throw
+    BI_NetPoint* netpoint = cmd->getNetPoint(); Q_ASSERT(netpoint);
+    return *netpoint;
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,168 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_CMDAUTOROUTEBOARD_H
+#define LIBREPCB_PROJECT_CMDAUTOROUTEBOARD_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+#include <librepcbcommon/undocommandgroup.h>
+#include <librepcbcommon/units/all_length_units.h>
+#include <librepcbcommon/geometry/gridrouter.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+
+class BoardLayer;
+
+namespace project {
+
+class Board;
+class NetSignal;
+class BI_FootprintPad;
+class BI_Via;
+class BI_NetPoint;
+
+/*****************************************************************************************
+ *  Class CmdAutorouteBoard
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdAutorouteBoard class routes the air wires of a board with traces and vias
+ *
+ * The air wires are determined like the ratsnest (a minimum spanning tree over the
+ * islands of every net) and routed with a #GridRouter on all copper layers. All existing
+ * pads, vias and traces are obstacles for the other nets. The traces get the min. width
+ * of the design rules (but at least 0.3mm), the vias the min. drill diameter (but at
+ * least 0.3mm) and the restring of the design rules.
+ *
+ * The routing is done by #route() before the command is created, because it can take
+ * a long time and the progress callback may process events. The command then only adds
+ * the routed traces as child commands, so the whole autorouting is undone in one step.
+ * Air wires which could not be routed are left untouched.
+ */
+class CmdAutorouteBoard final : public UndoCommandGroup
+{
+    public:
+
+        // Types
+
+        /**
+         * @brief Called periodically with the number of finished and total routing passes
+         *
+         * Return false to cancel the autorouting (throws a #UserCanceled exception).
+         */
+        typedef std::function<bool(int, int)> ProgressCallback;
+
+        /// The start or end of an air wire (exactly one of the pointers is set)
+        struct Anchor_t {
+            BI_FootprintPad* pad;
+            BI_Via* via;
+            BI_NetPoint* netpoint;
+            Point getPosition() const noexcept;
+            bool isOnLayer(const BoardLayer& layer) const noexcept;
+        };
+
+        /// An air wire to route
+        struct AirWire_t {
+            NetSignal* netsignal;
+            Anchor_t start;
+            Anchor_t end;
+        };
+
+        /// The result of #route()
+        struct Routes_t {
+            QList<BoardLayer*> layers;              ///< copper layers, from top to bottom
+            QList<AirWire_t> airwires;
+            QVector<GridRouter::Result_t> results;  ///< one result per air wire
+            Length traceWidth;
+            Length viaSize;
+            Length viaDrillDiameter;
+        };
+
+        // Constructors / Destructor
+        CmdAutorouteBoard() = delete;
+        CmdAutorouteBoard(const CmdAutorouteBoard& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param board     The routed board
+         * @param routes    The result of #route() for this board. The board must not have
+         *                  been modified since then.
+         */
+        CmdAutorouteBoard(Board& board, const Routes_t& routes) noexcept;
+        ~CmdAutorouteBoard() noexcept;
+
+        // Operator Overloadings
+        CmdAutorouteBoard& operator=(const CmdAutorouteBoard& rhs) = delete;
+
+        // Static Methods
+
+        /**
+         * @brief Route the air wires of a board (without modifying the board)
+         *
+         * @param board             The board to route
+         * @param selectedOnly      If true, only the nets of the selected items are routed
+         * @param progressCallback  Optional, see #ProgressCallback
+         *
+         * @return The routes to pass to the constructor
+         *
+         * @throw UserCanceled if the progress callback canceled the routing
+         */
+        static Routes_t route(Board& board, bool selectedOnly,
+                              const ProgressCallback& progressCallback = ProgressCallback())
+                              throw (Exception);
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() throw (Exception) override;
+
+        BI_NetPoint& addNetPoint(NetSignal& netsignal, BoardLayer& layer, const Point& pos,
+                                 const Anchor_t* anchor, const QVector<Point>& viaPositions,
+                                 QVector<BI_Via*>& vias) throw (Exception);
+
+        // Static Methods
+        static QList<NetSignal*> getNetSignalsToRoute(Board& board, bool selectedOnly) noexcept;
+        static QList<AirWire_t> getAirWires(Board& board, NetSignal& netsignal) noexcept;
+
+
+        // Attributes from the constructor
+        Board& mBoard;
+        Routes_t mRoutes;
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDAUTOROUTEBOARD_H
@@ -0,0 +1,244 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include "cmdcleanupboardtraces.h"
+#include <librepcbcommon/scopeguard.h>
+#include <librepcbproject/boards/board.h>
+#include <librepcbproject/boards/items/bi_netline.h>
+#include <librepcbproject/boards/items/bi_netpoint.h>
+#include <librepcbproject/boards/cmd/cmdboardnetlineadd.h>
+#include <librepcbproject/boards/cmd/cmdboardnetlineremove.h>
+#include <librepcbproject/boards/cmd/cmdboardnetpointremove.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*****************************************************************************************
+ *  Constructors / Destructor
+ ****************************************************************************************/
+
+CmdCleanUpBoardTraces::CmdCleanUpBoardTraces(Board& board, bool selectedOnly) noexcept :
+    UndoCommandGroup(tr("Clean Up Traces")), mBoard(board), mSelectedOnly(selectedOnly)
+{
+}
+
+CmdCleanUpBoardTraces::~CmdCleanUpBoardTraces() noexcept
+{
+}
+
+/*****************************************************************************************
+ *  Inherited from UndoCommand
+ ****************************************************************************************/
+
+bool CmdCleanUpBoardTraces::performExecute() throw (Exception)
+{
+    // if an error occurs, undo all already executed child commands
+    auto undoScopeGuard = scopeGuard([&](){performUndo();});
+
+    if (mSelectedOnly) {
+        // netlines and their netpoints, but not the netpoints of selected footprints
+        foreach (const BI_Base* item, mBoard.getSelectedItems(false, false, true, true,
+                 true, true, true, true, false, true, true, false)) {
+            mScope.insert(item);
+        }
+    }
+
+    removeZeroLengthNetLines(); // can throw
+    mergeCollinearNetLines(); // can throw
+    removeUnusedNetPoints(); // can throw
+
+    undoScopeGuard.dismiss(); // no undo required
+    return (getChildCount() > 0);
+}
+
+/*****************************************************************************************
+ *  Private Methods
+ ****************************************************************************************/
+
+void CmdCleanUpBoardTraces::removeZeroLengthNetLines() throw (Exception)
+{
+    QList<BI_NetLine*> netlines;
+    foreach (BI_NetLine* netline, mBoard.getNetLines()) {
+        if (isInScope(*netline) && (netline->getStartPoint().getPosition() ==
+                                    netline->getEndPoint().getPosition())) {
+            netlines.append(netline);
+        }
+    }
+
+    while (!netlines.isEmpty()) {
+        BI_NetLine* netline = netlines.takeFirst();
+        if (!netline->isAddedToBoard()) continue; // already removed by a previous step
+
+        // keep the attached netpoint and combine the other one into it
+        BI_NetPoint* keep = &netline->getStartPoint();
+        BI_NetPoint* drop = &netline->getEndPoint();
+        if (drop->isAttached()) qSwap(keep, drop);
+        if (drop == keep) {
+            execNewChildCmd(new CmdBoardNetLineRemove(*netline)); // can throw
+            continue;
+        }
+        if (drop->isAttached() || (!isInScope(*drop))) continue;
+
+        // move all netlines from the dropped netpoint to the kept one
+        foreach (BI_NetLine* line, drop->getLines()) {
+            BI_NetPoint& other = getOtherPoint(*line, *drop);
+            execNewChildCmd(new CmdBoardNetLineRemove(*line)); // can throw
+            if (&other == keep) continue; // the zero length netline itself or a duplicate
+            BI_NetLine* newLine = addNetLine(*keep, other, *line); // can throw
+            if (other.getPosition() == keep->getPosition()) {
+                netlines.append(newLine);
+            }
+        }
+        execNewChildCmd(new CmdBoardNetPointRemove(*drop)); // can throw
+    }
+}
+
+void CmdCleanUpBoardTraces::mergeCollinearNetLines() throw (Exception)
+{
+    struct Chain_t {
+        BI_NetPoint* start;
+        BI_NetPoint* end;
+        QList<BI_NetLine*> netlines;
+        QList<BI_NetPoint*> netpoints;      ///< the netpoints to remove
+    };
+
+    // find all chains by walking from every removable netpoint in both directions
+    QList<Chain_t> chains;
+    QSet<const BI_NetPoint*> visited;
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        if (visited.contains(netpoint) || (!isRemovable(*netpoint))) continue;
+        Chain_t chain;
+        chain.netpoints.append(netpoint);
+        visited.insert(netpoint);
+        BI_NetPoint* ends[2] = {nullptr, nullptr};
+        for (int i = 0; i < 2; ++i) {
+            BI_NetPoint* current = netpoint;
+            BI_NetLine* netline = netpoint->getLines().at(i);
+            forever {
+                chain.netlines.append(netline);
+                BI_NetPoint* next = &getOtherPoint(*netline, *current);
+                if (visited.contains(next) || (!isRemovable(*next))) {
+                    ends[i] = next;
+                    break;
+                }
+                visited.insert(next);
+                chain.netpoints.append(next);
+                const QList<BI_NetLine*>& lines = next->getLines();
+                netline = (lines.at(0) == netline) ? lines.at(1) : lines.at(0);
+                current = next;
+            }
+        }
+        // a removable end means the chain is a closed loop (can only be degenerated)
+        if ((ends[0] == ends[1]) || isRemovable(*ends[0]) || isRemovable(*ends[1])) continue;
+        chain.start = ends[0];
+        chain.end = ends[1];
+        chains.append(chain);
+    }
+
+    // replace every chain by a single netline
+    foreach (const Chain_t& chain, chains) {
+        foreach (BI_NetLine* netline, chain.netlines) {
+            execNewChildCmd(new CmdBoardNetLineRemove(*netline)); // can throw
+        }
+        foreach (BI_NetPoint* netpoint, chain.netpoints) {
+            execNewChildCmd(new CmdBoardNetPointRemove(*netpoint)); // can throw
+        }
+        addNetLine(*chain.start, *chain.end, *chain.netlines.first()); // can throw
+    }
+}
+
+void CmdCleanUpBoardTraces::removeUnusedNetPoints() throw (Exception)
+{
+    foreach (BI_NetPoint* netpoint, mBoard.getNetPoints()) {
+        if ((!netpoint->isUsed()) && isInScope(*netpoint)) {
+            execNewChildCmd(new CmdBoardNetPointRemove(*netpoint)); // can throw
+        }
+    }
+}
+
+BI_NetLine* CmdCleanUpBoardTraces::addNetLine(BI_NetPoint& start, BI_NetPoint& end,
+                                              const BI_NetLine& original) throw (Exception)
+{
+    CmdBoardNetLineAdd* cmd = new CmdBoardNetLineAdd(mBoard, start, end,
+                                                     original.getWidth());
+    execNewChildCmd(cmd); // can throw
+    BI_NetLine* netline = cmd->getNetLine(); Q_ASSERT(netline);
+    if (mSelectedOnly) mScope.insert(netline); // replaces netlines of the scope
+    return netline;
+}
+
+bool CmdCleanUpBoardTraces::isInScope(const BI_Base& item) const noexcept
+{
+    return (!mSelectedOnly) || mScope.contains(&item);
+}
+
+bool CmdCleanUpBoardTraces::isRemovable(const BI_NetPoint& netpoint) const noexcept
+{
+    if (netpoint.isAttached() || (!isInScope(netpoint))) return false;
+    const QList<BI_NetLine*>& lines = netpoint.getLines();
+    if (lines.count() != 2) return false;
+    if ((!isInScope(*lines.at(0))) || (!isInScope(*lines.at(1)))) return false;
+    if (lines.at(0)->getWidth() != lines.at(1)->getWidth()) return false;
+    const BI_NetPoint& p1 = getOtherPoint(*lines.at(0), netpoint);
+    const BI_NetPoint& p2 = getOtherPoint(*lines.at(1), netpoint);
+    if ((&p1 == &p2) || (&p1 == &netpoint) || (&p2 == &netpoint)) return false;
+
+    // the netpoint must lie exactly between its neighbours (with 64 bit integers, which
+    // is exact for all coordinate differences up to 2^31 nanometers)
+    Point d1 = netpoint.getPosition() - p1.getPosition();
+    Point d2 = p2.getPosition() - netpoint.getPosition();
+    qint64 maxDelta = qMax(qMax(d1.getX().abs().toNm(), d1.getY().abs().toNm()),
+                           qMax(d2.getX().abs().toNm(), d2.getY().abs().toNm()));
+    if (maxDelta >= (Q_INT64_C(1) << 31)) return false;
+    qint64 cross = d1.getX().toNm() * d2.getY().toNm() - d1.getY().toNm() * d2.getX().toNm();
+    qint64 dot = d1.getX().toNm() * d2.getX().toNm() + d1.getY().toNm() * d2.getY().toNm();
+    if ((cross != 0) || (dot <= 0)) return false;
+
+    // netpoints within pads or vias may be needed for the connectivity
+    const Point& pos = netpoint.getPosition();
+    const NetSignal* netsignal = &netpoint.getNetSignal();
+    if (!mBoard.getPadsAtScenePos(pos, &netpoint.getLayer(), netsignal).isEmpty()) return false;
+    if (!mBoard.getViasAtScenePos(pos, netsignal).isEmpty()) return false;
+    return true;
+}
+
+BI_NetPoint& CmdCleanUpBoardTraces::getOtherPoint(const BI_NetLine& netline,
+                                                  const BI_NetPoint& netpoint) noexcept
+{
+    if (&netline.getStartPoint() == &netpoint) {
+        return netline.getEndPoint();
+    } else {
+        return netline.getStartPoint();
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
@@ -0,0 +1,114 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_CMDCLEANUPBOARDTRACES_H
+#define LIBREPCB_PROJECT_CMDCLEANUPBOARDTRACES_H
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <librepcbcommon/undocommandgroup.h>
+
+/*****************************************************************************************
+ *  Namespace / Forward Declarations
+ ****************************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class BI_Base;
+class BI_NetPoint;
+class BI_NetLine;
+
+/*****************************************************************************************
+ *  Class CmdCleanUpBoardTraces
+ ****************************************************************************************/
+
+/**
+ * @brief The CmdCleanUpBoardTraces class removes redundant netlines and netpoints
+ *
+ * Interactive routing leaves many short segments behind. This command simplifies the
+ * traces without changing their copper:
+ *  - Netlines of zero length are removed and their netpoints are combined.
+ *  - Chains of collinear netlines with the same width are merged into a single netline,
+ *    i.e. their intermediate netpoints are removed. Netpoints which are attached to (or
+ *    lie within) a pad or via are always kept since they define the connectivity.
+ *  - Netpoints without any netlines are removed.
+ *
+ * All modifications are executed as child commands, so the whole cleanup is undone in
+ * one step. The chains are searched in a single pass over all netpoints, so the costs
+ * are linear in the number of traces.
+ */
+class CmdCleanUpBoardTraces final : public UndoCommandGroup
+{
+    public:
+
+        // Constructors / Destructor
+        CmdCleanUpBoardTraces() = delete;
+        CmdCleanUpBoardTraces(const CmdCleanUpBoardTraces& other) = delete;
+
+        /**
+         * @brief Constructor
+         *
+         * @param board         The board to clean up
+         * @param selectedOnly  If true, only selected netlines and netpoints are modified
+         */
+        CmdCleanUpBoardTraces(Board& board, bool selectedOnly) noexcept;
+        ~CmdCleanUpBoardTraces() noexcept;
+
+        // Operator Overloadings
+        CmdCleanUpBoardTraces& operator=(const CmdCleanUpBoardTraces& rhs) = delete;
+
+
+    private:
+
+        // Private Methods
+
+        /// @copydoc UndoCommand::performExecute()
+        bool performExecute() throw (Exception) override;
+
+        void removeZeroLengthNetLines() throw (Exception);
+        void mergeCollinearNetLines() throw (Exception);
+        void removeUnusedNetPoints() throw (Exception);
+        BI_NetLine* addNetLine(BI_NetPoint& start, BI_NetPoint& end,
+                               const BI_NetLine& original) throw (Exception);
+        bool isInScope(const BI_Base& item) const noexcept;
+        bool isRemovable(const BI_NetPoint& netpoint) const noexcept;
+        static BI_NetPoint& getOtherPoint(const BI_NetLine& netline,
+                                          const BI_NetPoint& netpoint) noexcept;
+
+
+        // Attributes from the constructor
+        Board& mBoard;
+        bool mSelectedOnly;
+
+        // General Attributes
+        QSet<const BI_Base*> mScope;    ///< selected items (only used if mSelectedOnly)
+};
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace project
+} // namespace librepcb
+
+#endif // LIBREPCB_PROJECT_CMDCLEANUPBOARDTRACES_H
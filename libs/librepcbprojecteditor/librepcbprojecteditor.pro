@@ -45,6 +45,7 @@ SOURCES += \
     docks/ercmsgdock.cpp \
     dialogs/addcomponentdialog.cpp \
     boardeditor/boardlayersdock.cpp \
+    boardeditor/netstatisticsdock.cpp \
     cmd/cmdaddcomponenttocircuit.cpp \
     cmd/cmdaddsymboltoschematic.cpp \
     cmd/cmdadddevicetoboard.cpp \
@@ -72,6 +73,8 @@ SOURCES += \
     cmd/cmdremovedevicefromboard.cpp \
     cmd/cmdremoveviafromboard.cpp \
     cmd/cmddetachboardnetpointfromviaorpad.cpp \
+    cmd/cmdcleanupboardtraces.cpp \
+    cmd/cmdautorouteboard.cpp \
     newprojectwizard/newprojectwizard.cpp \
     newprojectwizard/newprojectwizardpage_metadata.cpp \
     newprojectwizard/newprojectwizardpage_initialization.cpp \
@@ -102,6 +105,7 @@ HEADERS += \
     docks/ercmsgdock.h \
     dialogs/addcomponentdialog.h \
     boardeditor/boardlayersdock.h \
+    boardeditor/netstatisticsdock.h \
     cmd/cmdaddcomponenttocircuit.h \
     cmd/cmdaddsymboltoschematic.h \
     cmd/cmdadddevicetoboard.h \
@@ -129,6 +133,8 @@ HEADERS += \
     cmd/cmdremovedevicefromboard.h \
     cmd/cmdremoveviafromboard.h \
     cmd/cmddetachboardnetpointfromviaorpad.h \
+    cmd/cmdcleanupboardtraces.h \
+    cmd/cmdautorouteboard.h \
     newprojectwizard/newprojectwizard.h \
     newprojectwizard/newprojectwizardpage_metadata.h \
     newprojectwizard/newprojectwizardpage_initialization.h \
@@ -146,6 +152,7 @@ FORMS += \
     docks/ercmsgdock.ui \
     dialogs/addcomponentdialog.ui \
     boardeditor/boardlayersdock.ui \
+    boardeditor/netstatisticsdock.ui \
     boardeditor/boardviapropertiesdialog.ui \
     boardeditor/fabricationoutputdialog.ui \
     newprojectwizard/newprojectwizard.ui \
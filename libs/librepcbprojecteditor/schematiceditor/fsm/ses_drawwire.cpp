@@ -257,7 +257,8 @@ SES_Base::ProcRetVal SES_DrawWire::processIdleSceneEvent(SEE_Base* event) noexce
         case QEvent::GraphicsSceneMousePress:
         {
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
-            Point pos = Point::fromPx(sceneEvent->scenePos(), mEditor.getGridProperties().getInterval());
+            Point pos = snapToAnchor(*schematic, Point::fromPx(sceneEvent->scenePos(),
+                                     mEditor.getGridProperties().getInterval()));
 
             switch (sceneEvent->button())
             {
@@ -304,7 +305,8 @@ SES_Base::ProcRetVal SES_DrawWire::processPositioningSceneEvent(SEE_Base* event)
         case QEvent::GraphicsSceneMousePress:
         {
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
-            Point pos = Point::fromPx(sceneEvent->scenePos(), mEditor.getGridProperties().getInterval());
+            Point pos = snapToAnchor(*schematic, Point::fromPx(sceneEvent->scenePos(),
+                                     mEditor.getGridProperties().getInterval()));
             switch (sceneEvent->button())
             {
                 case Qt::LeftButton:
@@ -345,7 +347,8 @@ SES_Base::ProcRetVal SES_DrawWire::processPositioningSceneEvent(SEE_Base* event)
         {
             QGraphicsSceneMouseEvent* sceneEvent = dynamic_cast<QGraphicsSceneMouseEvent*>(qevent);
             Q_ASSERT(sceneEvent);
-            Point pos = Point::fromPx(sceneEvent->scenePos(), mEditor.getGridProperties().getInterval());
+            Point pos = snapToAnchor(*schematic, Point::fromPx(sceneEvent->scenePos(),
+                                     mEditor.getGridProperties().getInterval()));
             updateNetpointPositions(pos);
             return ForceStayInState;
         }
@@ -523,6 +526,17 @@ void SES_DrawWire::updateNetpointPositions(const Point& cursorPos) noexcept
     mPositioningNetPoint2->setPosition(cursorPos);
 }
 
+Point SES_DrawWire::snapToAnchor(const Schematic& schematic, const Point& pos) const noexcept
+{
+    // snap to pins and netpoints which are not placed exactly on the grid
+    QList<SI_Base*> except;
+    if (mPositioningNetPoint1) except.append(mPositioningNetPoint1);
+    if (mPositioningNetPoint2) except.append(mPositioningNetPoint2);
+    Length radius = mEditor.getGridProperties().getInterval() / 2;
+    SI_Base* anchor = schematic.getNearestConnectableAnchor(pos, radius, except);
+    return anchor ? anchor->getPosition() : pos;
+}
+
 void SES_DrawWire::updateWireModeActionsCheckedState() noexcept
 {
     foreach (WireMode key, mWireModeActions.keys()) {
@@ -96,6 +96,7 @@ class SES_DrawWire final : public SES_Base
         bool addNextNetPoint(Schematic& schematic, const Point& pos) noexcept;
         bool abortPositioning(bool showErrMsgBox) noexcept;
         void updateNetpointPositions(const Point& cursorPos) noexcept;
+        Point snapToAnchor(const Schematic& schematic, const Point& pos) const noexcept;
         void updateWireModeActionsCheckedState() noexcept;
         Point calcMiddlePointPos(const Point& p1, const Point p2, WireMode mode) const noexcept;
 
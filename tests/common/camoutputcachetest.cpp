@@ -0,0 +1,113 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/camoutputcache.h>
+#include <librepcbcommon/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class CamOutputCacheTest : public ::testing::Test
+{
+    protected:
+
+        FilePath mTmpDir;
+        FilePath mOutputFile;
+
+        virtual void SetUp() override
+        {
+            mTmpDir = FilePath::getRandomTempPath();
+            mOutputFile = mTmpDir.getPathTo("output/board.gbr");
+            FileUtils::writeFile(mOutputFile, "G04 content*\nM02*\n");
+        }
+
+        virtual void TearDown() override
+        {
+            FileUtils::removeDirRecursively(mTmpDir);
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(CamOutputCacheTest, testNotCached)
+{
+    CamOutputCache cache(mTmpDir.getPathTo("cache"));
+    EXPECT_FALSE(cache.isUpToDate(mOutputFile, "key"));
+}
+
+TEST_F(CamOutputCacheTest, testUpToDate)
+{
+    CamOutputCache cache(mTmpDir.getPathTo("cache"));
+    cache.update(mOutputFile, "key");
+    EXPECT_TRUE(cache.isUpToDate(mOutputFile, "key"));
+    EXPECT_FALSE(cache.isUpToDate(mOutputFile, "other key"));
+    EXPECT_FALSE(cache.isUpToDate(mTmpDir.getPathTo("output/other.gbr"), "key"));
+
+    // the entries are persistent
+    CamOutputCache cache2(mTmpDir.getPathTo("cache"));
+    EXPECT_TRUE(cache2.isUpToDate(mOutputFile, "key"));
+}
+
+TEST_F(CamOutputCacheTest, testModifiedOutputFile)
+{
+    CamOutputCache cache(mTmpDir.getPathTo("cache"));
+    cache.update(mOutputFile, "key");
+    FileUtils::writeFile(mOutputFile, "G04 modified*\nM02*\n");
+    EXPECT_FALSE(cache.isUpToDate(mOutputFile, "key"));
+    cache.update(mOutputFile, "key");
+    EXPECT_TRUE(cache.isUpToDate(mOutputFile, "key"));
+}
+
+TEST_F(CamOutputCacheTest, testRemovedOutputFile)
+{
+    CamOutputCache cache(mTmpDir.getPathTo("cache"));
+    cache.update(mOutputFile, "key");
+    QFile::remove(mOutputFile.toStr());
+    EXPECT_FALSE(cache.isUpToDate(mOutputFile, "key"));
+}
+
+TEST_F(CamOutputCacheTest, testDisabled)
+{
+    CamOutputCache cache((FilePath()));
+    EXPECT_FALSE(cache.isEnabled());
+    cache.update(mOutputFile, "key");
+    EXPECT_FALSE(cache.isUpToDate(mOutputFile, "key"));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,128 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/convexshape.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class ConvexShapeTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(ConvexShapeTest, testBoundingBox)
+{
+    ConvexShape capsule = ConvexShape::capsule(Point(Length(0), Length(0)),
+                                               Point(Length(1000), Length(500)), Length(200));
+    EXPECT_EQ(Point(Length(-100), Length(-100)), capsule.getBoundingBox().getMin());
+    EXPECT_EQ(Point(Length(1100), Length(600)), capsule.getBoundingBox().getMax());
+    EXPECT_FALSE(ConvexShape().isValid());
+    EXPECT_FALSE(ConvexShape().getBoundingBox().isValid());
+}
+
+TEST(ConvexShapeTest, testContains)
+{
+    ConvexShape rect = ConvexShape::rect(Point(Length(0), Length(0)), Length(2000),
+                                         Length(200), Angle::deg90());
+    EXPECT_TRUE(rect.contains(Point(Length(0), Length(1000))));
+    EXPECT_TRUE(rect.contains(Point(Length(-100), Length(-1000))));
+    EXPECT_FALSE(rect.contains(Point(Length(101), Length(0))));
+    ConvexShape obround = ConvexShape::obround(Point(Length(0), Length(0)), Length(2000),
+                                               Length(1000), Angle::deg0());
+    EXPECT_TRUE(obround.contains(Point(Length(700), Length(450))));
+    EXPECT_FALSE(obround.contains(Point(Length(980), Length(480))));
+    ConvexShape octagon = ConvexShape::octagon(Point(Length(0), Length(0)), Length(1000),
+                                               Length(1000), Angle::deg0());
+    EXPECT_TRUE(octagon.contains(Point(Length(500), Length(0))));
+    EXPECT_FALSE(octagon.contains(Point(Length(490), Length(490))));
+}
+
+TEST(ConvexShapeTest, testDistance)
+{
+    ConvexShape circle = ConvexShape::circle(Point(Length(0), Length(0)), Length(1000));
+    ConvexShape capsule = ConvexShape::capsule(Point(Length(-5000), Length(1000)),
+                                               Point(Length(5000), Length(1000)), Length(200));
+    ConvexShape rect = ConvexShape::rect(Point(Length(3000), Length(0)), Length(1000),
+                                         Length(1000), Angle::deg0());
+    EXPECT_EQ(Length(400), circle.getDistanceTo(capsule));
+    EXPECT_EQ(Length(400), capsule.getDistanceTo(circle));
+    EXPECT_EQ(Length(2000), circle.getDistanceTo(rect));
+    EXPECT_EQ(Length(400), rect.getDistanceTo(capsule));
+    EXPECT_EQ(Length(0), circle.getDistanceTo(circle));
+}
+
+TEST(ConvexShapeTest, testDistanceContained)
+{
+    // shapes lying completely within another shape must have a distance of zero
+    ConvexShape big = ConvexShape::rect(Point(Length(0), Length(0)), Length(10000),
+                                        Length(10000), Angle::deg45());
+    ConvexShape small = ConvexShape::circle(Point(Length(100), Length(100)), Length(10));
+    EXPECT_EQ(Length(0), big.getDistanceTo(small));
+    EXPECT_EQ(Length(0), small.getDistanceTo(big));
+}
+
+TEST(ConvexShapeTest, testOutline)
+{
+    // all vertices must lie between the exact outline and the max. error
+    Length radius(200000), maxError(5000);
+    QList<ConvexShape> shapes = {
+        ConvexShape::circle(Point(Length(0), Length(0)), radius * 2),
+        ConvexShape::capsule(Point(Length(0), Length(0)), Point(Length(1000000), Length(300000)),
+                             radius * 2),
+        ConvexShape::rect(Point(Length(0), Length(0)), Length(1000000), Length(500000),
+                          Angle::deg45()).expanded(radius),
+    };
+    foreach (const ConvexShape& shape, shapes) {
+        ConvexShape core(shape.getVertices(), Length(0));
+        QVector<Point> outline = shape.getOutline(maxError);
+        EXPECT_GE(outline.count(), 8);
+        foreach (const Point& vertex, outline) {
+            Length distance = ConvexShape({vertex}, Length(0)).getDistanceTo(core);
+            EXPECT_GE(distance, radius - 1);
+            EXPECT_LE(distance, radius + maxError + 1);
+        }
+    }
+    // without radius, the outline is the polygon itself
+    ConvexShape rect = ConvexShape::rect(Point(Length(0), Length(0)), Length(1000),
+                                         Length(1000), Angle::deg0());
+    EXPECT_EQ(rect.getVertices(), rect.getOutline(Length(1)));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
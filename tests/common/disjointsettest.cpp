@@ -0,0 +1,92 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/disjointset.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class DisjointSetTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(DisjointSetTest, testAdd)
+{
+    DisjointSet<int> set;
+    set.add(1);
+    set.add(2);
+    set.add(1);
+    EXPECT_EQ(2, set.count());
+    EXPECT_EQ(2, set.getSetCount());
+    EXPECT_TRUE(set.contains(2));
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_FALSE(set.isConnected(1, 2));
+    EXPECT_FALSE(set.isConnected(1, 3));
+}
+
+TEST(DisjointSetTest, testUnite)
+{
+    DisjointSet<int> set;
+    for (int i = 0; i < 6; ++i) set.add(i);
+    EXPECT_TRUE(set.unite(0, 3));
+    EXPECT_TRUE(set.unite(4, 3));
+    EXPECT_FALSE(set.unite(0, 4));
+    EXPECT_TRUE(set.unite(5, 2));
+    EXPECT_TRUE(set.unite(7, 6)); // not yet added items
+    EXPECT_EQ(8, set.count());
+    EXPECT_EQ(4, set.getSetCount());
+    EXPECT_TRUE(set.isConnected(4, 0));
+    EXPECT_FALSE(set.isConnected(4, 5));
+    EXPECT_EQ(set.find(0), set.find(4));
+    EXPECT_EQ(QList<QList<int>>({{0, 3, 4}, {1}, {2, 5}, {7, 6}}), set.getSets());
+}
+
+TEST(DisjointSetTest, testLongChain)
+{
+    DisjointSet<int> set;
+    for (int i = 1; i < 10000; ++i) set.unite(i - 1, i);
+    EXPECT_EQ(1, set.getSetCount());
+    EXPECT_TRUE(set.isConnected(0, 9999));
+    set.clear();
+    EXPECT_EQ(0, set.count());
+    EXPECT_EQ(0, set.getSetCount());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,147 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/drillpathoptimizer.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class DrillPathOptimizerTest : public ::testing::Test
+{
+    protected:
+
+        /// Check that the order contains every index exactly once
+        static bool isPermutation(const QVector<int>& order, int count) noexcept
+        {
+            if (order.count() != count) return false;
+            QVector<bool> found(count, false);
+            foreach (int i, order) {
+                if ((i < 0) || (i >= count) || found.at(i)) return false;
+                found[i] = true;
+            }
+            return true;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(DrillPathOptimizerTest, testTrivial)
+{
+    EXPECT_TRUE(DrillPathOptimizer::optimize(QVector<Point>()).isEmpty());
+    EXPECT_EQ(QVector<int>({0}), DrillPathOptimizer::optimize({Point(5, 5)}));
+    EXPECT_EQ(QVector<int>({1, 0}), DrillPathOptimizer::optimize({Point(5, 5), Point(1, 1)}));
+}
+
+TEST_F(DrillPathOptimizerTest, testLine)
+{
+    // shuffled drills on a line must be drilled from one end to the other
+    QVector<Point> positions;
+    for (int i = 0; i < 100; ++i) {
+        positions.append(Point(((i * 37) % 100) * 100000, 0));
+    }
+    QVector<int> order = DrillPathOptimizer::optimize(positions);
+    ASSERT_TRUE(isPermutation(order, positions.count()));
+    EXPECT_EQ(Point(0, 0), positions.at(order.first()));
+    EXPECT_NEAR(99 * 100000, DrillPathOptimizer::calcPathLength(positions, order), 1);
+}
+
+TEST_F(DrillPathOptimizerTest, testGrid)
+{
+    // a regular grid can be drilled row by row (serpentine)
+    QVector<Point> positions;
+    for (int i = 0; i < 400; ++i) {
+        int k = (i * 7919) % 400; // shuffle
+        positions.append(Point((k % 20) * 1000000, (k / 20) * 1000000));
+    }
+    QVector<int> order = DrillPathOptimizer::optimize(positions);
+    ASSERT_TRUE(isPermutation(order, positions.count()));
+    qreal optimum = 399 * 1000000.0;
+    EXPECT_LE(DrillPathOptimizer::calcPathLength(positions, order), optimum * 1.1);
+}
+
+TEST_F(DrillPathOptimizerTest, testRandomIsShorter)
+{
+    qsrand(42);
+    QVector<Point> positions;
+    QVector<int> original;
+    for (int i = 0; i < 5000; ++i) {
+        positions.append(Point((qrand() % 100000) * 1000, (qrand() % 80000) * 1000));
+        original.append(i);
+    }
+    QVector<int> nearestNeighbour = DrillPathOptimizer::optimize(positions, 0);
+    QVector<int> order = DrillPathOptimizer::optimize(positions);
+    ASSERT_TRUE(isPermutation(nearestNeighbour, positions.count()));
+    ASSERT_TRUE(isPermutation(order, positions.count()));
+
+    // for random points, the optimal path is roughly 0.7124 * sqrt(n * area)
+    qreal originalLength = DrillPathOptimizer::calcPathLength(positions, original);
+    qreal length = DrillPathOptimizer::calcPathLength(positions, order);
+    EXPECT_LT(length, originalLength / 20);
+    EXPECT_LT(length, DrillPathOptimizer::calcPathLength(positions, nearestNeighbour));
+    EXPECT_LT(length, 0.7124 * qSqrt(5000 * 1e8 * 8e7) * 1.15);
+}
+
+TEST_F(DrillPathOptimizerTest, testExhaustedBudgetIsDeterministic)
+{
+    qsrand(7);
+    QVector<Point> positions;
+    for (int i = 0; i < 2000; ++i) {
+        positions.append(Point((qrand() % 50000) * 1000, (qrand() % 50000) * 1000));
+    }
+    // the budget is exhausted long before 2-opt converges
+    QVector<int> order1 = DrillPathOptimizer::optimize(positions, 3);
+    QVector<int> order2 = DrillPathOptimizer::optimize(positions, 3);
+    ASSERT_TRUE(isPermutation(order1, positions.count()));
+    EXPECT_EQ(order1, order2);
+    EXPECT_LT(DrillPathOptimizer::calcPathLength(positions, DrillPathOptimizer::optimize(positions)),
+              DrillPathOptimizer::calcPathLength(positions, order1));
+    EXPECT_LT(DrillPathOptimizer::calcPathLength(positions, order1),
+              DrillPathOptimizer::calcPathLength(positions, DrillPathOptimizer::optimize(positions, 0)));
+}
+
+TEST_F(DrillPathOptimizerTest, testDuplicates)
+{
+    QVector<Point> positions(50, Point(1000, 1000));
+    positions.append(Point(0, 0));
+    QVector<int> order = DrillPathOptimizer::optimize(positions);
+    ASSERT_TRUE(isPermutation(order, positions.count()));
+    EXPECT_EQ(50, order.first());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,75 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/gerberaperturelist.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberApertureListTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberApertureListTest, testSameApertureIsReused)
+{
+    GerberApertureList list;
+    int number = list.setCircle(Length(500000), Length(0));
+    EXPECT_EQ(10, number);
+    EXPECT_EQ(number, list.setCircle(Length(500000), Length(0)));
+    EXPECT_EQ(number + 1, list.setCircle(Length(600000), Length(0)));
+}
+
+TEST_F(GerberApertureListTest, testRotationIsNormalized)
+{
+    // e.g. a footprint rotation of 300° plus a pad rotation of 90°
+    GerberApertureList list;
+    Length w(1000000), h(500000);
+    int rect = list.setRect(w, h, Angle(30000000), Length(0));
+    EXPECT_EQ(rect, list.setRect(w, h, Angle(390000000), Length(0)));
+    EXPECT_EQ(rect, list.setRect(w, h, Angle(-330000000), Length(0)));
+    int obround = list.setObround(w, h, Angle(-45000000), Length(0));
+    EXPECT_EQ(obround, list.setObround(w, h, Angle(315000000), Length(0)));
+    int polygon = list.setRegularPolygon(w, 8, Angle(-30000000), Length(0));
+    EXPECT_EQ(polygon, list.setRegularPolygon(w, 8, Angle(330000000), Length(0)));
+    EXPECT_NE(rect, list.setRect(w, h, Angle(60000000), Length(0)));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,320 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <functional>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/gerberprimitivelist.h>
+#include <librepcbcommon/cam/gerbergenerator.h>
+#include <librepcbcommon/cam/polylinebuilder.h>
+#include <librepcbcommon/uuid.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GerberPrimitiveListTest : public ::testing::Test
+{
+    protected:
+
+        typedef GerberPrimitiveList::Primitive_t Primitive_t;
+        typedef QPair<Point, Point> Segment;
+
+        static constexpr int sImageSize = 200;          ///< width and height [px]
+        static constexpr qint64 sNmPerPixel = 10000;    ///< 10µm per pixel
+
+        static Primitive_t region(const QVector<Point>& points, bool negative) noexcept
+        {
+            Primitive_t primitive;
+            primitive.type = Primitive_t::Type_t::Region;
+            primitive.negative = negative;
+            primitive.points = points;
+            return primitive;
+        }
+
+        static Primitive_t polyline(const QVector<Point>& points, const Length& width) noexcept
+        {
+            Primitive_t primitive;
+            primitive.type = Primitive_t::Type_t::Polyline;
+            primitive.width = width;
+            primitive.points = points;
+            return primitive;
+        }
+
+        static Primitive_t flash(Primitive_t::Type_t type, const Point& pos, const Length& w,
+                                 const Length& h) noexcept
+        {
+            Primitive_t primitive;
+            primitive.type = type;
+            primitive.position = pos;
+            primitive.width = w;
+            primitive.height = h;
+            return primitive;
+        }
+
+        static QByteArray generate(const GerberPrimitiveList& list)
+        {
+            GerberGenerator gen("Test", Uuid::createRandom(), "1");
+            list.draw(gen);
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            gen.generate(buffer);
+            return buffer.data();
+        }
+
+        static int countLines(const QByteArray& gerber, const QRegularExpression& re) noexcept
+        {
+            int count = 0;
+            foreach (const QByteArray& line, gerber.split('\n')) {
+                if (re.match(QString::fromLatin1(line)).hasMatch()) ++count;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Rasterize a Gerber file like a Gerber viewer
+         *
+         * Supports the subset of the format which is used by the tested primitives
+         * (circle and rectangle apertures, D01 chains, flashes, regions and polarity). A
+         * pixel belongs to an object if its center is inside the object. All objects are
+         * tested with exact integer arithmetic, so the image does neither depend on the
+         * direction of the lines nor on how connected lines are split into draws.
+         */
+        static QVector<bool> rasterize(const QByteArray& gerber) noexcept
+        {
+            QVector<bool> image(sImageSize * sImageSize, false);
+            QHash<int, QPair<qint64, qint64>> apertures; // width/height, height 0 = circle
+            QRegularExpression apertureRe("^%ADD(\\d+)([CR]),([0-9.]+)(?:X([0-9.]+))?\\*%$");
+            QRegularExpression coordRe("^X(-?\\d+)Y(-?\\d+)D0([123])\\*$");
+            QRegularExpression selectRe("^D(\\d+)\\*$");
+            auto toNm = [](const QString& mm) {return qRound64(mm.toDouble() * 1000000);};
+
+            bool dark = true, regionMode = false;
+            int aperture = -1;
+            qint64 x = 0, y = 0;
+            QVector<QPair<qint64, qint64>> contour;
+            auto paint = [&](std::function<bool(qint64, qint64)> isInside) {
+                for (int py = 0; py < sImageSize; ++py) {
+                    for (int px = 0; px < sImageSize; ++px) {
+                        // pixel centers are odd multiples of half a pixel
+                        if (isInside(px * sNmPerPixel + sNmPerPixel / 2,
+                                     py * sNmPerPixel + sNmPerPixel / 2)) {
+                            image[py * sImageSize + px] = dark;
+                        }
+                    }
+                }
+            };
+            foreach (const QByteArray& bytes, gerber.split('\n')) {
+                QString line = QString::fromLatin1(bytes);
+                QRegularExpressionMatch match;
+                if ((match = apertureRe.match(line)).hasMatch()) {
+                    qint64 w = toNm(match.captured(3));
+                    qint64 h = (match.captured(2) == "R") ? toNm(match.captured(4)) : 0;
+                    apertures.insert(match.captured(1).toInt(), qMakePair(w, h));
+                } else if (line == "%LPD*%") {
+                    dark = true;
+                } else if (line == "%LPC*%") {
+                    dark = false;
+                } else if (line == "G36*") {
+                    regionMode = true;
+                    contour.clear();
+                } else if (line == "G37*") {
+                    regionMode = false;
+                    paint([&](qint64 px, qint64 py) {
+                        bool inside = false; // even-odd rule
+                        for (int i = 0, j = contour.count() - 1; i < contour.count(); j = i++) {
+                            qint64 xi = contour.at(i).first, yi = contour.at(i).second;
+                            qint64 xj = contour.at(j).first, yj = contour.at(j).second;
+                            if (((yi > py) != (yj > py)) &&
+                                ((px - xi) * (yj - yi) * ((yj > yi) ? 1 : -1) <
+                                 (xj - xi) * (py - yi) * ((yj > yi) ? 1 : -1))) {
+                                inside = !inside;
+                            }
+                        }
+                        return inside;
+                    });
+                } else if ((match = selectRe.match(line)).hasMatch()) {
+                    aperture = match.captured(1).toInt();
+                } else if ((match = coordRe.match(line)).hasMatch()) {
+                    qint64 newX = match.captured(1).toLongLong();
+                    qint64 newY = match.captured(2).toLongLong();
+                    int dcode = match.captured(3).toInt();
+                    qint64 w = apertures.value(aperture).first;
+                    qint64 h = apertures.value(aperture).second;
+                    if (regionMode) {
+                        if (dcode == 2) contour.clear();
+                        contour.append(qMakePair(newX, newY));
+                    } else if ((dcode == 1) && (h == 0)) {
+                        qint64 ax = x, ay = y, dx = newX - x, dy = newY - y;
+                        paint([&](qint64 px, qint64 py) {
+                            qint64 len2 = dx * dx + dy * dy;
+                            qint64 dot = (px - ax) * dx + (py - ay) * dy;
+                            qreal d2;
+                            if (dot <= 0) {
+                                d2 = qreal((px - ax) * (px - ax) + (py - ay) * (py - ay));
+                            } else if (dot >= len2) {
+                                d2 = qreal((px - ax - dx) * (px - ax - dx) +
+                                           (py - ay - dy) * (py - ay - dy));
+                            } else {
+                                qreal cross = qreal((px - ax) * dy - (py - ay) * dx);
+                                d2 = cross * cross / qreal(len2);
+                            }
+                            return d2 * 4 <= qreal(w * w);
+                        });
+                    } else if (dcode == 3) {
+                        paint([&](qint64 px, qint64 py) {
+                            if (h == 0) {
+                                return ((px - newX) * (px - newX) + (py - newY) * (py - newY))
+                                        * 4 <= w * w;
+                            } else {
+                                return (qAbs(px - newX) * 2 <= w) && (qAbs(py - newY) * 2 <= h);
+                            }
+                        });
+                    }
+                    x = newX;
+                    y = newY;
+                }
+            }
+            return image;
+        }
+};
+
+constexpr int GerberPrimitiveListTest::sImageSize;
+constexpr qint64 GerberPrimitiveListTest::sNmPerPixel;
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GerberPrimitiveListTest, testPolarity)
+{
+    // a copper zone with a hole, and a pad inside the hole
+    GerberPrimitiveList list;
+    list.append(region({Point(100000, 100000), Point(1900000, 100000),
+                        Point(1900000, 1900000), Point(100000, 1900000)}, false));
+    list.append(region({Point(500000, 500000), Point(1500000, 500000),
+                        Point(1500000, 1500000), Point(500000, 1500000)}, true));
+    list.append(flash(Primitive_t::Type_t::FlashCircle, Point(1000000, 1000000),
+                      Length(200000), Length(0)));
+    list.sortByAperture();
+    QVector<bool> image = rasterize(generate(list));
+    EXPECT_TRUE(image.at(30 * sImageSize + 30));    // zone
+    EXPECT_FALSE(image.at(60 * sImageSize + 60));   // hole
+    EXPECT_TRUE(image.at(100 * sImageSize + 100));  // pad (positive after the regions)
+    EXPECT_FALSE(image.at(5 * sImageSize + 5));     // outside the zone
+}
+
+TEST_F(GerberPrimitiveListTest, testMergedAndSortedImageIsUnchanged)
+{
+    // Compares the Gerber output of the primitives like they were exported before
+    // (one line per netline, in the order of the board items) with the merged and
+    // sorted primitives. The line widths and positions are chosen so that no pixel
+    // center is exactly on the border of an object.
+    qsrand(7);
+    for (int run = 0; run < 10; ++run) {
+        QVector<Primitive_t> regions = {
+            region({Point(200000, 200000), Point(1200000, 200000),
+                    Point(1200000, 1200000), Point(200000, 1200000)}, false),
+            region({Point(400000, 400000), Point(1000000, 600000),
+                    Point(600000, 1000000)}, true)};
+        QVector<Primitive_t> items;
+        QHash<int, QVector<Segment>> segmentsByWidth; // key: width [nm]
+        int count = qrand() % 200;
+        for (int i = 0; i < count; ++i) {
+            Point p1((qrand() % 16) * 100000 + 200000, (qrand() % 16) * 100000 + 200000);
+            switch (qrand() % 4)
+            {
+                case 0: {
+                    items.append(flash(Primitive_t::Type_t::FlashCircle, p1,
+                                       Length(300000), Length(0)));
+                    break;
+                }
+                case 1: {
+                    items.append(flash(Primitive_t::Type_t::FlashRect, p1,
+                                       Length(400000), Length(200000)));
+                    break;
+                }
+                default: {
+                    Point p2 = p1 + Point(((qrand() % 3) - 1) * 100000,
+                                          ((qrand() % 3) - 1) * 100000);
+                    if (p2 == p1) break;
+                    int width = (qrand() % 2) ? 160000 : 300000;
+                    items.append(polyline({p1, p2}, Length(width)));
+                    segmentsByWidth[width].append(Segment(p1, p2));
+                    break;
+                }
+            }
+        }
+
+        GerberPrimitiveList oldList;
+        GerberPrimitiveList newList;
+        foreach (const Primitive_t& primitive, regions) {
+            oldList.append(primitive);
+            newList.append(primitive);
+        }
+        foreach (const Primitive_t& primitive, items) {
+            oldList.append(primitive);
+            if (primitive.type != Primitive_t::Type_t::Polyline) newList.append(primitive);
+        }
+        for (auto it = segmentsByWidth.constBegin(); it != segmentsByWidth.constEnd(); ++it) {
+            foreach (const QVector<Point>& points, PolylineBuilder::build(it.value())) {
+                newList.append(polyline(points, Length(it.key())));
+            }
+        }
+        newList.sortByAperture();
+
+        QByteArray oldGerber = generate(oldList);
+        QByteArray newGerber = generate(newList);
+        QVector<bool> oldImage = rasterize(oldGerber);
+        QVector<bool> newImage = rasterize(newGerber);
+        int differentPixels = 0, darkPixels = 0;
+        for (int i = 0; i < oldImage.count(); ++i) {
+            if (oldImage.at(i) != newImage.at(i)) ++differentPixels;
+            if (oldImage.at(i)) ++darkPixels;
+        }
+        EXPECT_EQ(0, differentPixels) << "run " << run;
+        EXPECT_GT(darkPixels, 0) << "run " << run;
+
+        // every aperture is selected only once, and the lines are drawn as D01 chains
+        QRegularExpression apertureRe("^%ADD\\d+");
+        QRegularExpression selectRe("^D\\d+\\*$");
+        QRegularExpression moveRe("D02\\*$");
+        EXPECT_EQ(countLines(newGerber, apertureRe), countLines(newGerber, selectRe))
+            << "run " << run;
+        EXPECT_LE(countLines(newGerber, moveRe), countLines(oldGerber, moveRe))
+            << "run " << run;
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,235 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/gridrouter.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class GridRouterTest : public ::testing::Test
+{
+    protected:
+
+        static const LengthBase_t sWidth = 200000;
+        static const LengthBase_t sViaSize = 600000;
+        static const LengthBase_t sClearance = 200000;
+        static const LengthBase_t sCell = sWidth + sClearance;
+
+        static Point pos(int x, int y) noexcept {
+            return Point(Length(x * sCell), Length(y * sCell));
+        }
+
+        static GridRouter::Connection_t connection(int net, const Point& start,
+                                                   const Point& end, quint32 startLayers = 3,
+                                                   quint32 endLayers = 3) noexcept {
+            return GridRouter::Connection_t{net, start, startLayers, end, endLayers};
+        }
+
+        /// Check that the segments are a continuous path from start to end
+        static void expectContinuous(const GridRouter::Connection_t& connection,
+                                     const GridRouter::Result_t& result) noexcept
+        {
+            ASSERT_TRUE(result.routed);
+            ASSERT_FALSE(result.segments.isEmpty());
+            EXPECT_EQ(connection.start, result.segments.first().p1);
+            EXPECT_EQ(connection.end, result.segments.last().p2);
+            for (int i = 1; i < result.segments.count(); ++i) {
+                EXPECT_EQ(result.segments.at(i - 1).p2, result.segments.at(i).p1);
+                if (result.segments.at(i - 1).layer != result.segments.at(i).layer) {
+                    EXPECT_TRUE(result.vias.contains(result.segments.at(i).p1));
+                }
+            }
+        }
+
+        /// Check the clearance between the copper of all results of different nets
+        static void expectClearance(const QVector<GridRouter::Connection_t>& connections,
+                                    const QVector<GridRouter::Result_t>& results) noexcept
+        {
+            struct Copper_t {int net; int layer; ConvexShape shape;};
+            QVector<Copper_t> copper;
+            for (int i = 0; i < results.count(); ++i) {
+                int net = connections.at(i).net;
+                foreach (const GridRouter::Segment_t& segment, results.at(i).segments) {
+                    copper.append(Copper_t{net, segment.layer, ConvexShape::capsule(
+                        segment.p1, segment.p2, Length(sWidth))});
+                }
+                foreach (const Point& via, results.at(i).vias) {
+                    copper.append(Copper_t{net, -1, ConvexShape::circle(via, Length(sViaSize))});
+                }
+            }
+            for (int i = 0; i < copper.count(); ++i) {
+                for (int j = i + 1; j < copper.count(); ++j) {
+                    const Copper_t& a = copper.at(i);
+                    const Copper_t& b = copper.at(j);
+                    if (a.net == b.net) continue;
+                    if ((a.layer >= 0) && (b.layer >= 0) && (a.layer != b.layer)) continue;
+                    EXPECT_GE(a.shape.getDistanceTo(b.shape).toNm(), sClearance - 1);
+                }
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(GridRouterTest, testGridSize)
+{
+    GridRouter router(BoundingBox(pos(0, 0), pos(25, 12)), 2, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    EXPECT_EQ(LengthBase_t(sCell), router.getCellSize().toNm());
+    EXPECT_EQ(26, router.getColumnCount());
+    EXPECT_EQ(13, router.getRowCount());
+}
+
+TEST_F(GridRouterTest, testStraightConnection)
+{
+    GridRouter router(BoundingBox(pos(0, 0), pos(20, 20)), 1, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    QVector<GridRouter::Connection_t> connections = {connection(0, pos(2, 5), pos(15, 5))};
+    QVector<GridRouter::Result_t> results = router.route(connections);
+    ASSERT_EQ(1, results.count());
+    expectContinuous(connections.first(), results.first());
+    EXPECT_EQ(1, results.first().segments.count());
+    EXPECT_TRUE(results.first().vias.isEmpty());
+}
+
+TEST_F(GridRouterTest, testAroundObstacle)
+{
+    GridRouter router(BoundingBox(pos(0, 0), pos(30, 30)), 1, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    ConvexShape wall = ConvexShape::capsule(pos(10, 5), pos(10, 20), Length(500000));
+    router.addObstacle(0, wall, -1);
+    QVector<GridRouter::Connection_t> connections = {connection(0, pos(5, 12), pos(15, 12))};
+    QVector<GridRouter::Result_t> results = router.route(connections);
+    expectContinuous(connections.first(), results.first());
+    EXPECT_GT(results.first().segments.count(), 1);
+    foreach (const GridRouter::Segment_t& segment, results.first().segments) {
+        ConvexShape trace = ConvexShape::capsule(segment.p1, segment.p2, Length(sWidth));
+        EXPECT_GE(trace.getDistanceTo(wall).toNm(), LengthBase_t(sClearance));
+    }
+}
+
+TEST_F(GridRouterTest, testObstacleOfSameNet)
+{
+    GridRouter router(BoundingBox(pos(0, 0), pos(20, 20)), 1, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    router.addObstacle(0, ConvexShape::circle(pos(3, 3), Length(1000000)), 7);
+    router.addObstacle(0, ConvexShape::circle(pos(12, 3), Length(1000000)), 7);
+    QVector<GridRouter::Connection_t> connections = {connection(7, pos(3, 3), pos(12, 3))};
+    QVector<GridRouter::Result_t> results = router.route(connections);
+    expectContinuous(connections.first(), results.first());
+    EXPECT_EQ(1, results.first().segments.count());
+
+    // the same pads are obstacles for other nets
+    connections = {connection(8, pos(3, 3), pos(12, 3))};
+    EXPECT_FALSE(router.route(connections).first().routed);
+}
+
+TEST_F(GridRouterTest, testViaToOtherLayer)
+{
+    GridRouter router(BoundingBox(pos(0, 0), pos(20, 20)), 2, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    QVector<GridRouter::Connection_t> connections = {
+        connection(0, pos(5, 10), pos(15, 10), 1, 2)};
+    QVector<GridRouter::Result_t> results = router.route(connections);
+    expectContinuous(connections.first(), results.first());
+    EXPECT_EQ(1, results.first().vias.count());
+    EXPECT_EQ(0, results.first().segments.first().layer);
+}
+
+TEST_F(GridRouterTest, testCrossingConnections)
+{
+    // on a single layer, the two connections cannot both be routed...
+    QVector<GridRouter::Connection_t> connections = {
+        connection(0, pos(0, 15), pos(30, 15)), connection(1, pos(15, 0), pos(15, 30))};
+    BoundingBox area(pos(0, 0), pos(30, 30));
+    {
+        GridRouter router(area, 1, Length(sWidth), Length(sViaSize), Length(sClearance));
+        QVector<GridRouter::Result_t> results = router.route(connections);
+        EXPECT_NE(results.at(0).routed, results.at(1).routed);
+        expectClearance(connections, results);
+    }
+
+    // ...but with two layers, both connections are routed with vias
+    GridRouter router(area, 2, Length(sWidth), Length(sViaSize), Length(sClearance));
+    QVector<GridRouter::Result_t> results = router.route(connections);
+    expectContinuous(connections.at(0), results.at(0));
+    expectContinuous(connections.at(1), results.at(1));
+    expectClearance(connections, results);
+}
+
+TEST_F(GridRouterTest, testManyConnections)
+{
+    // a bus of parallel connections, each crossed by a connection of another net
+    GridRouter router(BoundingBox(pos(0, 0), pos(200, 60)), 2, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    QVector<GridRouter::Connection_t> connections;
+    for (int i = 0; i < 10; ++i) {
+        connections.append(connection(i, pos(5 + 18 * i, 10), pos(15 + 18 * i, 50)));
+        connections.append(connection(100 + i, pos(5 + 18 * i, 30), pos(15 + 18 * i, 30)));
+    }
+    router.setMaxIterations(20);
+    int expectedTotal = connections.count() * 21; // first routing and all iterations
+    int lastFinished = -1;
+    QVector<GridRouter::Result_t> results = router.route(connections, [&](int finished, int total) {
+        EXPECT_EQ(expectedTotal, total);
+        EXPECT_GE(finished, lastFinished);
+        lastFinished = finished;
+        return true;
+    });
+    EXPECT_EQ(expectedTotal, lastFinished);
+    for (int i = 0; i < connections.count(); ++i) {
+        expectContinuous(connections.at(i), results.at(i));
+    }
+    expectClearance(connections, results);
+}
+
+TEST_F(GridRouterTest, testCanceled)
+{
+    GridRouter router(BoundingBox(pos(0, 0), pos(20, 20)), 1, Length(sWidth),
+                      Length(sViaSize), Length(sClearance));
+    QVector<GridRouter::Connection_t> connections = {connection(0, pos(2, 5), pos(15, 5))};
+    QVector<GridRouter::Result_t> results = router.route(connections, [](int, int) {
+        return false;
+    });
+    ASSERT_EQ(1, results.count());
+    EXPECT_FALSE(results.first().routed);
+    EXPECT_TRUE(results.first().segments.isEmpty());
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
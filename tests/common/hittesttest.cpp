@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/hittest.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class HitTestTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(HitTestTest, testDistanceToSegment)
+{
+    Point p1(Length(0), Length(0));
+    Point p2(Length(1000), Length(0));
+    EXPECT_EQ(Length(0), HitTest::getDistanceToSegment(Point(Length(500), Length(0)), p1, p2));
+    EXPECT_EQ(Length(300), HitTest::getDistanceToSegment(Point(Length(500), Length(-300)), p1, p2));
+    EXPECT_EQ(Length(500), HitTest::getDistanceToSegment(Point(Length(-300), Length(400)), p1, p2));
+    EXPECT_EQ(Length(5), HitTest::getDistanceToSegment(Point(Length(1003), Length(4)), p1, p2));
+    EXPECT_EQ(Length(5), HitTest::getDistanceToSegment(Point(Length(3), Length(4)), p1, p1));
+}
+
+TEST(HitTestTest, testSegmentsIntersect)
+{
+    Point p1(Length(0), Length(0));
+    Point p2(Length(1000), Length(1000));
+    EXPECT_TRUE(HitTest::doSegmentsIntersect(p1, p2, Point(Length(0), Length(1000)), Point(Length(1000), Length(0))));
+    EXPECT_TRUE(HitTest::doSegmentsIntersect(p1, p2, Point(Length(500), Length(500)), Point(Length(900), Length(0))));
+    EXPECT_TRUE(HitTest::doSegmentsIntersect(p1, p2, p2, Point(Length(2000), Length(2000))));
+    EXPECT_TRUE(HitTest::doSegmentsIntersect(p1, p2, Point(Length(300), Length(300)), Point(Length(300), Length(300))));
+    EXPECT_FALSE(HitTest::doSegmentsIntersect(p1, p2, Point(Length(1001), Length(1001)), Point(Length(2000), Length(2000))));
+    EXPECT_FALSE(HitTest::doSegmentsIntersect(p1, p2, Point(Length(501), Length(500)), Point(Length(900), Length(0))));
+}
+
+TEST(HitTestTest, testDistanceBetweenSegments)
+{
+    Point p1(Length(0), Length(0));
+    Point p2(Length(1000), Length(0));
+    EXPECT_EQ(Length(0), HitTest::getDistanceBetweenSegments(p1, p2, Point(Length(500), Length(-10)), Point(Length(500), Length(10))));
+    EXPECT_EQ(Length(300), HitTest::getDistanceBetweenSegments(p1, p2, Point(Length(200), Length(300)), Point(Length(900), Length(300))));
+    EXPECT_EQ(Length(5), HitTest::getDistanceBetweenSegments(p1, p2, Point(Length(1003), Length(4)), Point(Length(2000), Length(1000))));
+    EXPECT_EQ(Length(5), HitTest::getDistanceBetweenSegments(p1, p1, Point(Length(3), Length(4)), Point(Length(3), Length(4))));
+}
+
+TEST(HitTestTest, testCircle)
+{
+    Point center(Length(1000), Length(1000));
+    EXPECT_TRUE(HitTest::isPointInCircle(center, center, Length(0)));
+    EXPECT_TRUE(HitTest::isPointInCircle(Point(Length(1300), Length(1400)), center, Length(1000)));
+    EXPECT_FALSE(HitTest::isPointInCircle(Point(Length(1300), Length(1401)), center, Length(1000)));
+    EXPECT_FALSE(HitTest::isPointInCircle(Point(Length(100000000000), Length(0)), center, Length(1000)));
+}
+
+TEST(HitTestTest, testCapsule)
+{
+    Point p1(Length(0), Length(0));
+    Point p2(Length(1000), Length(1000));
+    EXPECT_TRUE(HitTest::isPointInCapsule(Point(Length(500), Length(500)), p1, p2, Length(10)));
+    EXPECT_TRUE(HitTest::isPointInCapsule(Point(Length(-30), Length(-40)), p1, p2, Length(100)));
+    EXPECT_FALSE(HitTest::isPointInCapsule(Point(Length(-30), Length(-41)), p1, p2, Length(100)));
+    EXPECT_FALSE(HitTest::isPointInCapsule(Point(Length(600), Length(400)), p1, p2, Length(100)));
+}
+
+TEST(HitTestTest, testRect)
+{
+    Point center(Length(0), Length(0));
+    Point p(Length(900), Length(0));
+    EXPECT_TRUE(HitTest::isPointInRect(p, center, Length(2000), Length(200), Angle::deg0()));
+    EXPECT_FALSE(HitTest::isPointInRect(p, center, Length(2000), Length(200), Angle::deg90()));
+    EXPECT_TRUE(HitTest::isPointInRect(p, center, Length(200), Length(2000), Angle::deg90()));
+    EXPECT_TRUE(HitTest::isPointInRect(Point(Length(1000), Length(-100)), center,
+                                       Length(2000), Length(200), Angle::deg180()));
+}
+
+TEST(HitTestTest, testObround)
+{
+    Point center(Length(0), Length(0));
+    // corner of the bounding rectangle is outside, end of the straight part is inside
+    EXPECT_FALSE(HitTest::isPointInObround(Point(Length(1000), Length(500)), center,
+                                           Length(2000), Length(1000), Angle::deg0()));
+    EXPECT_TRUE(HitTest::isPointInObround(Point(Length(500), Length(500)), center,
+                                          Length(2000), Length(1000), Angle::deg0()));
+    EXPECT_TRUE(HitTest::isPointInObround(Point(Length(1000), Length(0)), center,
+                                          Length(2000), Length(1000), Angle::deg0()));
+    EXPECT_TRUE(HitTest::isPointInObround(Point(Length(0), Length(1000)), center,
+                                          Length(2000), Length(1000), Angle::deg90()));
+    EXPECT_FALSE(HitTest::isPointInObround(Point(Length(1000), Length(0)), center,
+                                           Length(2000), Length(1000), Angle::deg90()));
+}
+
+TEST(HitTestTest, testOctagon)
+{
+    Point center(Length(0), Length(0));
+    EXPECT_TRUE(HitTest::isPointInOctagon(Point(Length(1000), Length(0)), center,
+                                          Length(2000), Length(2000), Angle::deg0()));
+    EXPECT_FALSE(HitTest::isPointInOctagon(Point(Length(950), Length(950)), center,
+                                           Length(2000), Length(2000), Angle::deg0()));
+    EXPECT_TRUE(HitTest::isPointInOctagon(Point(Length(700), Length(700)), center,
+                                          Length(2000), Length(2000), Angle::deg0()));
+    EXPECT_FALSE(HitTest::isPointInOctagon(Point(Length(1001), Length(0)), center,
+                                           Length(2000), Length(2000), Angle::deg0()));
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,353 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/polygonclipper.h>
+#include <librepcbcommon/geometry/polygon.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PolygonClipperTest : public ::testing::Test
+{
+    protected:
+
+        typedef PolygonClipper::Path Path;
+        typedef PolygonClipper::Paths Paths;
+        typedef PolygonClipper::Operation Operation;
+
+        static Path rect(qint64 x, qint64 y, qint64 w, qint64 h) noexcept
+        {
+            return {Point(Length(x), Length(y)), Point(Length(x + w), Length(y)),
+                    Point(Length(x + w), Length(y + h)), Point(Length(x), Length(y + h))};
+        }
+
+        static qreal getArea(const Paths& paths) noexcept
+        {
+            qreal area = 0;
+            foreach (const Path& path, paths) area += PolygonClipper::calcArea(path);
+            return area;
+        }
+
+        static int getWinding(const Paths& paths, qreal x, qreal y) noexcept
+        {
+            int winding = 0;
+            foreach (const Path& path, paths) {
+                for (int i = 0; i < path.count(); ++i) {
+                    qreal x1 = path.at(i).getX().toNm(), y1 = path.at(i).getY().toNm();
+                    qreal x2 = path.at((i + 1) % path.count()).getX().toNm();
+                    qreal y2 = path.at((i + 1) % path.count()).getY().toNm();
+                    if ((y1 <= y) == (y2 <= y)) continue;
+                    qreal xc = x1 + (y - y1) * (x2 - x1) / (y2 - y1);
+                    if (xc > x) winding += (y2 > y1) ? 1 : -1;
+                }
+            }
+            return winding;
+        }
+
+        static bool isInResult(Operation op, bool s, bool c) noexcept
+        {
+            switch (op)
+            {
+                case Operation::Union:          return s || c;
+                case Operation::Intersection:   return s && c;
+                case Operation::Difference:     return s && (!c);
+                default:                        return s != c;
+            }
+        }
+
+        /// Exact area of a boolean operation of axis aligned rectangles (via a grid)
+        static qreal getRectsArea(Operation op, const Paths& subject, const Paths& clip) noexcept
+        {
+            QList<qint64> xs, ys;
+            foreach (const Path& path, subject + clip) {
+                foreach (const Point& p, path) {
+                    xs.append(p.getX().toNm());
+                    ys.append(p.getY().toNm());
+                }
+            }
+            std::sort(xs.begin(), xs.end());
+            std::sort(ys.begin(), ys.end());
+            qreal area = 0;
+            for (int i = 0; i + 1 < xs.count(); ++i) {
+                for (int k = 0; k + 1 < ys.count(); ++k) {
+                    qreal x = (xs.at(i) + xs.at(i + 1)) / 2.0, y = (ys.at(k) + ys.at(k + 1)) / 2.0;
+                    if (isInResult(op, getWinding(subject, x, y) != 0, getWinding(clip, x, y) != 0)) {
+                        area += qreal(xs.at(i + 1) - xs.at(i)) * qreal(ys.at(k + 1) - ys.at(k));
+                    }
+                }
+            }
+            return area;
+        }
+
+        /// Check whether any two edges of the paths cross each other
+        static bool hasCrossings(const Paths& paths) noexcept
+        {
+            QList<QPair<QPointF, QPointF>> edges;
+            foreach (const Path& path, paths) {
+                for (int i = 0; i < path.count(); ++i) {
+                    const Point& p1 = path.at(i);
+                    const Point& p2 = path.at((i + 1) % path.count());
+                    edges.append(qMakePair(QPointF(p1.getX().toNm(), p1.getY().toNm()),
+                                           QPointF(p2.getX().toNm(), p2.getY().toNm())));
+                }
+            }
+            auto orientation = [](const QPointF& a, const QPointF& b, const QPointF& c) {
+                qreal cross = (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+                return (cross > 0) ? 1 : ((cross < 0) ? -1 : 0);
+            };
+            for (int i = 0; i < edges.count(); ++i) {
+                for (int k = i + 1; k < edges.count(); ++k) {
+                    const QPair<QPointF, QPointF>& e = edges.at(i);
+                    const QPair<QPointF, QPointF>& f = edges.at(k);
+                    if ((orientation(e.first, e.second, f.first) *
+                         orientation(e.first, e.second, f.second) < 0) &&
+                        (orientation(f.first, f.second, e.first) *
+                         orientation(f.first, f.second, e.second) < 0)) return true;
+                }
+            }
+            return false;
+        }
+
+        static Path randomPolygon(qint64 range, qint64 size) noexcept
+        {
+            // star-shaped, so the polygon doesn't intersect itself
+            qint64 cx = (qrand() % range), cy = (qrand() % range);
+            int count = 3 + (qrand() % 6);
+            Path path;
+            for (int i = 0; i < count; ++i) {
+                qreal angle = (2 * M_PI * i) / count;
+                qreal radius = size * (0.2 + 0.8 * (qrand() % 1000) / 1000.0);
+                path.append(Point(Length(cx + qRound64(radius * qCos(angle))),
+                                  Length(cy + qRound64(radius * qSin(angle)))));
+            }
+            return path;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PolygonClipperTest, testEmpty)
+{
+    EXPECT_TRUE(PolygonClipper::execute(Operation::Union, Paths(), Paths()).isEmpty());
+    EXPECT_TRUE(PolygonClipper::execute(Operation::Intersection, {rect(0, 0, 10, 10)},
+                                        Paths()).isEmpty());
+    Paths result = PolygonClipper::execute(Operation::Difference, {rect(0, 0, 10, 10)}, Paths());
+    ASSERT_EQ(1, result.count());
+    EXPECT_EQ(100, PolygonClipper::calcArea(result.first()));
+}
+
+TEST_F(PolygonClipperTest, testTouchingRects)
+{
+    // the common edge disappears and the collinear vertices are removed
+    Paths result = PolygonClipper::unite({rect(0, 0, 1000, 1000), rect(1000, 0, 1000, 1000)});
+    ASSERT_EQ(1, result.count());
+    EXPECT_EQ(4, result.first().count());
+    EXPECT_EQ(2000000, PolygonClipper::calcArea(result.first()));
+
+    // rects touching at a corner stay separated
+    result = PolygonClipper::unite({rect(0, 0, 1000, 1000), rect(1000, 1000, 1000, 1000)});
+    EXPECT_EQ(2, result.count());
+    EXPECT_EQ(2000000, getArea(result));
+}
+
+TEST_F(PolygonClipperTest, testHole)
+{
+    Paths result = PolygonClipper::execute(Operation::Difference, {rect(0, 0, 100, 100)},
+                                           {rect(25, 25, 50, 50)});
+    ASSERT_EQ(2, result.count());
+    QList<qreal> areas = {PolygonClipper::calcArea(result.at(0)),
+                          PolygonClipper::calcArea(result.at(1))};
+    std::sort(areas.begin(), areas.end());
+    EXPECT_EQ(-2500, areas.at(0)); // holes are clockwise
+    EXPECT_EQ(10000, areas.at(1));
+
+    // a clockwise path inside a counterclockwise path is a hole with the non-zero rule
+    Path hole = rect(25, 25, 50, 50);
+    std::reverse(hole.begin(), hole.end());
+    EXPECT_EQ(7500, getArea(PolygonClipper::unite({rect(0, 0, 100, 100), hole})));
+}
+
+TEST_F(PolygonClipperTest, testFillRules)
+{
+    Paths paths = {rect(0, 0, 100, 100), rect(50, 0, 100, 100)};
+    EXPECT_EQ(15000, getArea(PolygonClipper::unite(paths, PolygonClipper::FillRule::NonZero)));
+    EXPECT_EQ(10000, getArea(PolygonClipper::unite(paths, PolygonClipper::FillRule::EvenOdd)));
+}
+
+TEST_F(PolygonClipperTest, testLargeCoordinates)
+{
+    qint64 big = Q_INT64_C(2000000000);
+    Paths result = PolygonClipper::execute(Operation::Intersection,
+        {{Point(Length(-big), Length(-big)), Point(Length(big), Length(big - 1)),
+          Point(Length(-big), Length(big))}}, {rect(-big, 0, 2 * big, big)});
+    ASSERT_EQ(1, result.count());
+    EXPECT_FALSE(hasCrossings(result));
+    EXPECT_NEAR(1.5 * qreal(big) * qreal(big), getArea(result), 4 * big);
+}
+
+TEST_F(PolygonClipperTest, testRandomRects)
+{
+    // small coordinates create lots of collinear and identical edges
+    qsrand(7);
+    QList<Operation> ops = {Operation::Union, Operation::Intersection,
+                            Operation::Difference, Operation::Xor};
+    for (int run = 0; run < 200; ++run) {
+        Paths subject, clip;
+        for (int i = 0; i < 1 + (qrand() % 6); ++i) {
+            subject.append(rect(qrand() % 20, qrand() % 20, 1 + qrand() % 10, 1 + qrand() % 10));
+        }
+        for (int i = 0; i < 1 + (qrand() % 6); ++i) {
+            clip.append(rect(qrand() % 20, qrand() % 20, 1 + qrand() % 10, 1 + qrand() % 10));
+        }
+        foreach (Operation op, ops) {
+            Paths result = PolygonClipper::execute(op, subject, clip);
+            EXPECT_EQ(getRectsArea(op, subject, clip), getArea(result)) << "run " << run;
+            EXPECT_FALSE(hasCrossings(result)) << "run " << run;
+        }
+    }
+}
+
+TEST_F(PolygonClipperTest, testRandomPolygons)
+{
+    qsrand(42);
+    for (int run = 0; run < 200; ++run) {
+        Paths subject, clip;
+        for (int i = 0; i < 1 + (qrand() % 4); ++i) subject.append(randomPolygon(100000, 50000));
+        for (int i = 0; i < 1 + (qrand() % 4); ++i) clip.append(randomPolygon(100000, 50000));
+        Paths united = PolygonClipper::execute(Operation::Union, subject, clip);
+        Paths intersection = PolygonClipper::execute(Operation::Intersection, subject, clip);
+        Paths difference = PolygonClipper::execute(Operation::Difference, subject, clip);
+        Paths xored = PolygonClipper::execute(Operation::Xor, subject, clip);
+        EXPECT_FALSE(hasCrossings(united));
+        EXPECT_FALSE(hasCrossings(intersection));
+        EXPECT_FALSE(hasCrossings(difference));
+        EXPECT_FALSE(hasCrossings(xored));
+
+        // the rounded intersection points change the area only slightly
+        qreal a = getArea(PolygonClipper::unite(subject));
+        qreal b = getArea(PolygonClipper::unite(clip));
+        qreal tolerance = 1e6;
+        EXPECT_NEAR(a + b, getArea(united) + getArea(intersection), tolerance) << "run " << run;
+        EXPECT_NEAR(a, getArea(difference) + getArea(intersection), tolerance) << "run " << run;
+        EXPECT_NEAR(getArea(united) - getArea(intersection), getArea(xored), tolerance);
+
+        // compare with the winding numbers of random points (not close to any edge)
+        for (int i = 0; i < 50; ++i) {
+            qreal x = qrand() % 150000 - 25000 + 0.5, y = qrand() % 150000 - 25000 + 0.5;
+            bool s = getWinding(subject, x, y) != 0, c = getWinding(clip, x, y) != 0;
+            bool s2 = getWinding(subject, x + 10, y + 10) != 0;
+            bool c2 = getWinding(clip, x + 10, y + 10) != 0;
+            if ((s != s2) || (c != c2)) continue; // too close to an edge
+            EXPECT_EQ(s || c, getWinding(united, x, y) != 0) << "run " << run;
+            EXPECT_EQ(s && c, getWinding(intersection, x, y) != 0) << "run " << run;
+            EXPECT_EQ(s && (!c), getWinding(difference, x, y) != 0) << "run " << run;
+            EXPECT_EQ(s != c, getWinding(xored, x, y) != 0) << "run " << run;
+        }
+    }
+}
+
+TEST_F(PolygonClipperTest, testOffset)
+{
+    Paths square = {rect(0, 0, 10000000, 10000000)}; // 10x10mm
+    qreal grown = getArea(PolygonClipper::offset(square, Length(1000000), Length(1000)));
+    EXPECT_NEAR(144e12 - (4 - M_PI) * 1e12, grown, 5e10);
+    Paths shrunk = PolygonClipper::offset(square, Length(-1000000), Length(1000));
+    ASSERT_EQ(1, shrunk.count());
+    EXPECT_NEAR(64e12, getArea(shrunk), 5e10);
+    EXPECT_TRUE(PolygonClipper::offset(square, Length(-5000001), Length(1000)).isEmpty());
+
+    // a hole shrinks when the polygon grows
+    Path hole = rect(2000000, 2000000, 6000000, 6000000);
+    std::reverse(hole.begin(), hole.end());
+    Paths withHole = PolygonClipper::offset({square.first(), hole}, Length(1000000), Length(1000));
+    EXPECT_NEAR(144e12 - (4 - M_PI) * 1e12 - 16e12, getArea(withHole), 5e10);
+}
+
+TEST_F(PolygonClipperTest, testFlatten)
+{
+    // a circle with 1mm radius made of two arcs
+    Polygon circle(0, Length(0), true, false, Point(Length(-1000000), Length(0)));
+    circle.appendSegment(*new PolygonSegment(Point(Length(1000000), Length(0)), Angle::deg180()));
+    circle.appendSegment(*new PolygonSegment(Point(Length(-1000000), Length(0)), Angle::deg180()));
+    Path path = PolygonClipper::flatten(circle, Length(1000));
+    EXPECT_GT(path.count(), 40);
+    EXPECT_LT(path.count(), 100);
+    for (int i = 0; i < path.count(); ++i) {
+        EXPECT_NEAR(1000000, path.at(i).getLength().toNm(), 2);
+        // the chords must not deviate more than the max. error from the arc
+        Point middle = (path.at(i) + path.at((i + 1) % path.count())) / 2;
+        EXPECT_GE(middle.getLength().toNm(), 1000000 - 1002);
+    }
+    EXPECT_NEAR(M_PI * 1e12, qAbs(PolygonClipper::calcArea(path)), 1e10);
+
+    // straight segments are converted back and forth without any modification
+    Path triangle = {Point(Length(0), Length(0)), Point(Length(500), Length(0)),
+                     Point(Length(0), Length(700))};
+    QScopedPointer<Polygon> polygon(PolygonClipper::toPolygon(triangle, 0, Length(0),
+                                                              true, false));
+    EXPECT_TRUE(polygon->isClosed());
+    EXPECT_EQ(triangle, PolygonClipper::flatten(*polygon, Length(1000)));
+}
+
+TEST_F(PolygonClipperTest, benchmarkThousandsOfPolygons)
+{
+    // e.g. all pads and traces of a big board, united to one copper layer
+    qsrand(1);
+    Paths polygons;
+    for (int i = 0; i < 5000; ++i) polygons.append(randomPolygon(100000000, 500000));
+    QElapsedTimer timer;
+    timer.start();
+    Paths united = PolygonClipper::unite(polygons);
+    RecordProperty("unite_ms", int(timer.restart()));
+    Paths shrunk = PolygonClipper::offset(united, Length(-50000), Length(5000));
+    RecordProperty("offset_ms", int(timer.restart()));
+    Paths difference = PolygonClipper::execute(Operation::Difference,
+                                               {rect(0, 0, 100000000, 100000000)}, united);
+    RecordProperty("difference_ms", int(timer.elapsed()));
+
+    qreal area = getArea(united);
+    qreal sum = 0;
+    foreach (const Path& polygon, polygons) sum += PolygonClipper::calcArea(polygon);
+    EXPECT_LT(area, sum);
+    EXPECT_GT(area, 0.5 * sum);
+    EXPECT_LT(getArea(shrunk), area);
+    EXPECT_NEAR(1e16, getArea(difference) + getArea(PolygonClipper::execute(
+        Operation::Intersection, {rect(0, 0, 100000000, 100000000)}, united)), 1e10);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
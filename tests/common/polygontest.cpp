@@ -0,0 +1,150 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/polygon.h>
+#include <librepcbcommon/geometry/ellipse.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PolygonTest : public ::testing::Test
+{
+    protected:
+
+        /// A circle around the origin, made of two 180° arcs
+        static Polygon* createCircle(const Length& radius) noexcept
+        {
+            Polygon* circle = new Polygon(1, Length(0), true, false, Point(-radius, Length(0)));
+            circle->appendSegment(*new PolygonSegment(Point(radius, Length(0)), Angle::deg180()));
+            circle->appendSegment(*new PolygonSegment(Point(-radius, Length(0)), Angle::deg180()));
+            return circle;
+        }
+
+        /// The max. distance between the chord from p1 to p2 and a circle around the origin
+        static qreal getChordError(const Point& p1, const Point& p2, qreal radius) noexcept
+        {
+            Point middle = (p1 + p2) / 2;
+            return radius - middle.getLength().toNm();
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PolygonTest, testChordCount)
+{
+    // 2 * acos(1 - 1000 / 1000000) = 0.0894 rad per chord -> 17.6 chords
+    EXPECT_EQ(18, PolygonSegment::calcChordCount(Length(1000000), Angle::deg90(), Length(1000)));
+    EXPECT_EQ(18, PolygonSegment::calcChordCount(Length(1000000), -Angle::deg90(), Length(1000)));
+    EXPECT_EQ(1, PolygonSegment::calcChordCount(Length(1000), Angle::deg90(), Length(1000)));
+    EXPECT_EQ(1, PolygonSegment::calcChordCount(Length(1000000), Angle::deg0(), Length(1000)));
+    EXPECT_GT(PolygonSegment::calcChordCount(Length(1000000), Angle::deg90(), Length(0)), 18);
+}
+
+TEST_F(PolygonTest, testVerticesOfStraightSegments)
+{
+    QScopedPointer<Polygon> rect(Polygon::createRect(1, Length(0), true, false,
+                                                     Point(Length(0), Length(0)),
+                                                     Length(2000), Length(1000)));
+    QVector<Point> expected = {Point(Length(0), Length(0)), Point(Length(2000), Length(0)),
+                               Point(Length(2000), Length(1000)), Point(Length(0), Length(1000)),
+                               Point(Length(0), Length(0))};
+    EXPECT_EQ(expected, rect->getVertices());
+    EXPECT_EQ(expected, rect->getVertices(Length(1)));
+}
+
+TEST_F(PolygonTest, testVerticesOfArcs)
+{
+    QScopedPointer<Polygon> circle(createCircle(Length(1000000)));
+    const QVector<Point>& vertices = circle->getVertices(Length(1000));
+    ASSERT_EQ(2 * 36 + 1, vertices.count()); // 35.1 chords per half circle
+    EXPECT_EQ(circle->getStartPos(), vertices.first());
+    EXPECT_EQ(circle->getStartPos(), vertices.last());
+    for (int i = 0; i < vertices.count(); ++i) {
+        EXPECT_NEAR(1000000, vertices.at(i).getLength().toNm(), 2);
+        if (i > 0) {
+            qreal error = getChordError(vertices.at(i - 1), vertices.at(i), 1000000);
+            EXPECT_GT(error, 0);
+            EXPECT_LE(error, 1002);
+        }
+    }
+
+    // a finer tolerance needs more vertices
+    EXPECT_GT(circle->getVertices(Length(10)).count(), 2 * 36 + 1);
+}
+
+TEST_F(PolygonTest, testVerticesCacheInvalidation)
+{
+    QScopedPointer<Polygon> circle(createCircle(Length(1000000)));
+    QVector<Point> vertices = circle->getVertices();
+
+    circle->translate(Point(Length(500), Length(0)));
+    QVector<Point> translated = circle->getVertices();
+    ASSERT_EQ(vertices.count(), translated.count());
+    for (int i = 0; i < vertices.count(); ++i) {
+        EXPECT_EQ(vertices.at(i) + Point(Length(500), Length(0)), translated.at(i));
+    }
+
+    circle->appendSegment(*new PolygonSegment(Point(Length(0), Length(0)), Angle::deg0()));
+    EXPECT_EQ(translated.count() + 1, circle->getVertices().count());
+    EXPECT_EQ(Point(Length(0), Length(0)), circle->getVertices().last());
+
+    circle->setStartPos(Point(Length(0), Length(0)));
+    EXPECT_EQ(Point(Length(0), Length(0)), circle->getVertices().first());
+}
+
+TEST_F(PolygonTest, testEllipseVertices)
+{
+    Point center(Length(5000000), Length(0));
+    Ellipse ellipse(1, Length(0), true, false, center, Length(2000000), Length(1000000),
+                    Angle::deg90());
+    const QVector<Point>& vertices = ellipse.getVertices(Length(1000));
+    ASSERT_GT(vertices.count(), 8);
+    EXPECT_EQ(1, vertices.count() % 4); // symmetric and closed
+    EXPECT_EQ(vertices.first(), vertices.last());
+    for (const Point& vertex : vertices) {
+        // rotated by 90°, so the x radius is along the y axis
+        qreal x = (vertex - center).getX().toNm() / 1000000.0;
+        qreal y = (vertex - center).getY().toNm() / 2000000.0;
+        EXPECT_NEAR(1, x * x + y * y, 1e-5);
+    }
+
+    ellipse.setRadiusY(Length(2000000));
+    EXPECT_NEAR(2000000, (ellipse.getVertices(Length(1000)).at(3) - center).getLength().toNm(), 2);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,152 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/cam/polylinebuilder.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class PolylineBuilderTest : public ::testing::Test
+{
+    protected:
+
+        typedef QPair<Point, Point> Segment;
+
+        /// Split polylines into segments with normalized direction, sorted
+        static QVector<Segment> toSegments(const QVector<QVector<Point>>& polylines) noexcept
+        {
+            QVector<Segment> segments;
+            foreach (const QVector<Point>& polyline, polylines) {
+                for (int i = 1; i < polyline.count(); ++i) {
+                    segments.append(normalize(Segment(polyline.at(i - 1), polyline.at(i))));
+                }
+            }
+            std::sort(segments.begin(), segments.end(), isLess);
+            return segments;
+        }
+
+        static QVector<Segment> normalized(QVector<Segment> segments) noexcept
+        {
+            for (Segment& s : segments) s = normalize(s);
+            std::sort(segments.begin(), segments.end(), isLess);
+            return segments;
+        }
+
+        static Segment normalize(const Segment& s) noexcept
+        {
+            return isLess(Segment(s.second, s.first), s) ? Segment(s.second, s.first) : s;
+        }
+
+        static bool isLess(const Segment& a, const Segment& b) noexcept
+        {
+            auto key = [](const Segment& s) {
+                return std::make_tuple(s.first.getX().toNm(), s.first.getY().toNm(),
+                                       s.second.getX().toNm(), s.second.getY().toNm());
+            };
+            return key(a) < key(b);
+        }
+
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(PolylineBuilderTest, testEmpty)
+{
+    EXPECT_TRUE(PolylineBuilder::build(QVector<Segment>()).isEmpty());
+}
+
+TEST_F(PolylineBuilderTest, testChain)
+{
+    // unordered segments with mixed directions
+    QVector<Segment> segments = {Segment(Point(2000, 0), Point(3000, 0)),
+                                 Segment(Point(1000, 0), Point(0, 0)),
+                                 Segment(Point(2000, 0), Point(1000, 0))};
+    QVector<QVector<Point>> polylines = PolylineBuilder::build(segments);
+    ASSERT_EQ(1, polylines.count());
+    QVector<Point> expected = {Point(3000, 0), Point(2000, 0), Point(1000, 0), Point(0, 0)};
+    EXPECT_EQ(expected, polylines.first());
+}
+
+TEST_F(PolylineBuilderTest, testJunction)
+{
+    // a "T" must be split at the junction
+    QVector<Segment> segments = {Segment(Point(0, 0), Point(1000, 0)),
+                                 Segment(Point(1000, 0), Point(2000, 0)),
+                                 Segment(Point(1000, 0), Point(1000, 1000)),
+                                 Segment(Point(1000, 1000), Point(1000, 2000))};
+    QVector<QVector<Point>> polylines = PolylineBuilder::build(segments);
+    EXPECT_EQ(3, polylines.count());
+    EXPECT_EQ(normalized(segments), toSegments(polylines));
+}
+
+TEST_F(PolylineBuilderTest, testClosedLoop)
+{
+    QVector<Segment> segments = {Segment(Point(0, 0), Point(1000, 0)),
+                                 Segment(Point(1000, 1000), Point(1000, 0)),
+                                 Segment(Point(1000, 1000), Point(0, 1000)),
+                                 Segment(Point(0, 1000), Point(0, 0))};
+    QVector<QVector<Point>> polylines = PolylineBuilder::build(segments);
+    ASSERT_EQ(1, polylines.count());
+    EXPECT_EQ(5, polylines.first().count());
+    EXPECT_EQ(polylines.first().first(), polylines.first().last());
+    EXPECT_EQ(normalized(segments), toSegments(polylines));
+}
+
+TEST_F(PolylineBuilderTest, testRandomSegmentsArePreserved)
+{
+    // random segments on a coarse grid to get many junctions, loops and duplicates
+    qsrand(42);
+    for (int run = 0; run < 20; ++run) {
+        QVector<Segment> segments;
+        int count = qrand() % 300;
+        for (int i = 0; i < count; ++i) {
+            Point p1((qrand() % 10) * 1000, (qrand() % 10) * 1000);
+            Point p2 = p1 + Point(((qrand() % 3) - 1) * 1000, ((qrand() % 3) - 1) * 1000);
+            segments.append(Segment(p1, p2));
+        }
+        QVector<QVector<Point>> polylines = PolylineBuilder::build(segments);
+        foreach (const QVector<Point>& polyline, polylines) {
+            EXPECT_GE(polyline.count(), 2);
+        }
+        EXPECT_EQ(normalized(segments), toSegments(polylines));
+        EXPECT_LE(polylines.count(), count);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
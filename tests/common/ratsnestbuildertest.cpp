@@ -0,0 +1,167 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/ratsnestbuilder.h>
+#include <librepcbcommon/disjointset.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class RatsnestBuilderTest : public ::testing::Test
+{
+    protected:
+
+        static qreal getLength(const QVector<Point>& positions, int a, int b) noexcept
+        {
+            Point diff = positions.at(a) - positions.at(b);
+            return qSqrt(qPow(diff.getX().toMm(), 2) + qPow(diff.getY().toMm(), 2));
+        }
+
+        /// Calculate the length of the minimum spanning tree with Prim's algorithm, O(n²)
+        static qreal getMinimumLength(const QVector<Point>& positions,
+                                      const QVector<int>& islands) noexcept
+        {
+            QMap<int, qreal> distances; // island -> distance to the tree
+            foreach (int island, islands) distances.insert(island, -1);
+            QList<int> ids = distances.keys();
+            QSet<int> inTree;
+            qreal length = 0;
+            int current = ids.first();
+            while (true) {
+                inTree.insert(current);
+                for (int i = 0; i < positions.count(); ++i) {
+                    if (islands.at(i) != current) continue;
+                    for (int j = 0; j < positions.count(); ++j) {
+                        if (inTree.contains(islands.at(j))) continue;
+                        qreal d = getLength(positions, i, j);
+                        qreal& best = distances[islands.at(j)];
+                        if ((best < 0) || (d < best)) best = d;
+                    }
+                }
+                int next = -1;
+                foreach (int id, ids) {
+                    if (inTree.contains(id)) continue;
+                    if ((next < 0) || (distances.value(id) < distances.value(next))) next = id;
+                }
+                if (next < 0) break;
+                length += distances.value(next);
+                current = next;
+            }
+            return length;
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(RatsnestBuilderTest, testEmpty)
+{
+    EXPECT_TRUE(RatsnestBuilder::build(QVector<Point>(), QVector<int>()).isEmpty());
+    EXPECT_TRUE(RatsnestBuilder::build({Point(0, 0)}, {0}).isEmpty());
+}
+
+TEST_F(RatsnestBuilderTest, testSingleIsland)
+{
+    QVector<Point> positions = {Point(0, 0), Point(1000, 0), Point(0, 5000)};
+    QVector<int> islands = {3, 3, 3};
+    EXPECT_TRUE(RatsnestBuilder::build(positions, islands).isEmpty());
+}
+
+TEST_F(RatsnestBuilderTest, testNearestAnchors)
+{
+    // two islands with two anchors each, the closest anchors must be connected
+    QVector<Point> positions = {Point(0, 0), Point(10000, 0), Point(0, 3000), Point(25000, 0)};
+    QVector<int> islands = {0, 0, 1, 1};
+    QList<QPair<int, int>> airwires = RatsnestBuilder::build(positions, islands);
+    ASSERT_EQ(1, airwires.count());
+    EXPECT_EQ(qMakePair(2, 0), airwires.first());
+}
+
+TEST_F(RatsnestBuilderTest, testSamePosition)
+{
+    QVector<Point> positions = {Point(500, 500), Point(500, 500), Point(500, 500)};
+    QVector<int> islands = {0, 1, 2};
+    QList<QPair<int, int>> airwires = RatsnestBuilder::build(positions, islands);
+    EXPECT_EQ(2, airwires.count());
+}
+
+TEST_F(RatsnestBuilderTest, testLine)
+{
+    // all anchors on a horizontal line (the grid must not degenerate)
+    QVector<Point> positions;
+    QVector<int> islands;
+    for (int i = 0; i < 100; ++i) {
+        positions.append(Point(i * 100000, 0));
+        islands.append(i);
+    }
+    QList<QPair<int, int>> airwires = RatsnestBuilder::build(positions, islands);
+    EXPECT_EQ(99, airwires.count());
+    for (const QPair<int, int>& airwire : airwires) {
+        EXPECT_EQ(1, qAbs(airwire.first - airwire.second));
+    }
+}
+
+TEST_F(RatsnestBuilderTest, testRandomAgainstPrim)
+{
+    qsrand(42);
+    for (int run = 0; run < 20; ++run) {
+        QVector<Point> positions;
+        QVector<int> islands;
+        int count = 2 + (qrand() % 200);
+        int islandCount = 1 + (qrand() % count);
+        for (int i = 0; i < count; ++i) {
+            positions.append(Point((qrand() % 100000) * 1000, (qrand() % 50000) * 1000));
+            islands.append(qrand() % islandCount);
+        }
+        QList<QPair<int, int>> airwires = RatsnestBuilder::build(positions, islands);
+
+        // the air wires must connect all islands without any cycles...
+        DisjointSet<int> set;
+        foreach (int island, islands) set.add(island);
+        qreal length = 0;
+        for (const QPair<int, int>& airwire : airwires) {
+            EXPECT_TRUE(set.unite(islands.at(airwire.first), islands.at(airwire.second)));
+            length += getLength(positions, airwire.first, airwire.second);
+        }
+        EXPECT_EQ(1, set.getSetCount());
+
+        // ...and have minimal length
+        EXPECT_NEAR(getMinimumLength(positions, islands), length, 1e-6);
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
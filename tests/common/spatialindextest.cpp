@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/spatialindex.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class SpatialIndexTest : public ::testing::Test
+{
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST(SpatialIndexTest, testInsertAndQuery)
+{
+    SpatialIndex<int> index(Length(1000));
+    index.insert(1, Point(Length(0), Length(0)), Point(Length(500), Length(500)));
+    index.insert(2, Point(Length(-3000), Length(-3000)), Point(Length(-2500), Length(-2500)));
+    index.insert(3, Point(Length(400), Length(-100)), Point(Length(5000), Length(100)));
+    EXPECT_EQ(3, index.count());
+    EXPECT_EQ(QList<int>({1, 3}), index.query(Point(Length(450), Length(0))));
+    EXPECT_EQ(QList<int>({2}), index.query(Point(Length(-2500), Length(-2700))));
+    EXPECT_EQ(QList<int>({3}), index.query(Point(Length(4999), Length(0))));
+    EXPECT_EQ(QList<int>(), index.query(Point(Length(5001), Length(0))));
+    EXPECT_EQ(QList<int>({1, 2, 3}), index.query(Point(Length(-5000), Length(-5000)),
+                                                 Point(Length(5000), Length(5000))));
+}
+
+TEST(SpatialIndexTest, testUpdateKeepsInsertionOrder)
+{
+    SpatialIndex<int> index(Length(1000));
+    index.insert(1, Point(Length(0), Length(0)), Point(Length(10), Length(10)));
+    index.insert(2, Point(Length(5000), Length(5000)), Point(Length(5010), Length(5010)));
+    index.update(1, Point(Length(5000), Length(5000)), Point(Length(5010), Length(5010)));
+    index.update(3, Point(Length(5000), Length(5000)), Point(Length(5010), Length(5010)));
+    EXPECT_EQ(2, index.count());
+    EXPECT_EQ(QList<int>(), index.query(Point(Length(5), Length(5))));
+    EXPECT_EQ(QList<int>({1, 2}), index.query(Point(Length(5005), Length(5005))));
+}
+
+TEST(SpatialIndexTest, testRemove)
+{
+    SpatialIndex<int> index(Length(1000));
+    index.insert(1, Point(Length(0), Length(0)), Point(Length(10), Length(10)));
+    index.insert(2, Point(Length(0), Length(0)), Point(Length(100000000), Length(10)));
+    EXPECT_TRUE(index.remove(1));
+    EXPECT_FALSE(index.remove(1));
+    EXPECT_EQ(QList<int>({2}), index.query(Point(Length(5), Length(5))));
+    EXPECT_TRUE(index.remove(2));
+    EXPECT_EQ(QList<int>(), index.query(Point(Length(5), Length(5))));
+    EXPECT_EQ(0, index.count());
+}
+
+TEST(SpatialIndexTest, testCompareWithLinearScan)
+{
+    qsrand(42);
+    SpatialIndex<int> index(Length(2540000));
+    QHash<int, QRect> rects; // QRect is used as reference implementation (in micrometers)
+    for (int i = 0; i < 2000; ++i) {
+        QRect rect(qrand() % 200000 - 100000, qrand() % 200000 - 100000,
+                   qrand() % 20000 + 1, qrand() % 20000 + 1);
+        rects.insert(i, rect);
+        index.insert(i, Point(Length(rect.left() * 1000LL), Length(rect.top() * 1000LL)),
+                        Point(Length(rect.right() * 1000LL), Length(rect.bottom() * 1000LL)));
+    }
+    for (int i = 0; i < 500; ++i) {
+        QRect query(qrand() % 200000 - 100000, qrand() % 200000 - 100000,
+                    qrand() % 50000 + 1, qrand() % 50000 + 1);
+        QList<int> expected;
+        for (int k = 0; k < rects.count(); ++k) {
+            if (rects.value(k).intersects(query)) expected.append(k);
+        }
+        EXPECT_EQ(expected, index.query(
+            Point(Length(query.left() * 1000LL), Length(query.top() * 1000LL)),
+            Point(Length(query.right() * 1000LL), Length(query.bottom() * 1000LL))));
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,221 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <gtest/gtest.h>
+#include <librepcbcommon/fileio/streamingimagewriter.h>
+#include <librepcbcommon/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class StreamingImageWriterTest : public ::testing::Test
+{
+    protected:
+
+        FilePath mTmpDir;
+
+        virtual void SetUp() override
+        {
+            mTmpDir = FilePath::getRandomTempPath();
+        }
+
+        virtual void TearDown() override
+        {
+            FileUtils::removeDirRecursively(mTmpDir);
+        }
+
+        /// An image with large areas of the same color and some noise
+        static QImage createImage(int width, int height, bool alpha) noexcept
+        {
+            QImage image(width, height, alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+            qsrand(42);
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    int red = ((x + y) % 17 == 0) ? (qrand() % 256) : ((x / 50) * 20);
+                    int alphaValue = alpha ? (x % 256) : 255;
+                    image.setPixel(x, y, qRgba(red, 200, (y / 20) * 10, alphaValue));
+                }
+            }
+            return image;
+        }
+
+        static void writeImage(const QImage& image, const FilePath& filepath)
+        {
+            bool alpha = image.hasAlphaChannel();
+            StreamingImageWriter writer(filepath,
+                                        StreamingImageWriter::getFormatFromFilePath(filepath),
+                                        image.size(), alpha, 2400);
+            for (int y = 0; y < image.height(); ++y) {
+                writer.writeRow(image.constScanLine(y));
+            }
+            writer.finish();
+        }
+
+        static void compareImages(const QImage& expected, const QImage& actual) noexcept
+        {
+            ASSERT_EQ(expected.size(), actual.size());
+            QImage converted = actual.convertToFormat(expected.format());
+            for (int y = 0; y < expected.height(); ++y) {
+                for (int x = 0; x < expected.width(); ++x) {
+                    ASSERT_EQ(expected.pixel(x, y), converted.pixel(x, y)) << x << "/" << y;
+                }
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(StreamingImageWriterTest, testPackBits)
+{
+    // example from Apple Technical Note TN1023
+    QByteArray input = QByteArray::fromHex("aaaaaa80002aaaaaaaaa80002a22aaaaaaaaaaaaaaaaaaaa");
+    QByteArray expected = QByteArray::fromHex("feaa0280002afdaa0380002a22f7aa");
+    EXPECT_EQ(expected.toHex(), StreamingImageWriter::compressPackBits(
+        reinterpret_cast<const uchar*>(input.constData()), input.size()).toHex());
+
+    // runs and literals are split after 128 bytes
+    QByteArray run(300, 'x');
+    EXPECT_EQ(QByteArray::fromHex("81788178d578").toHex(), StreamingImageWriter::compressPackBits(
+        reinterpret_cast<const uchar*>(run.constData()), run.size()).toHex());
+}
+
+TEST_F(StreamingImageWriterTest, testPng)
+{
+    for (bool alpha : {false, true}) {
+        QImage image = createImage(523, 311, alpha);
+        FilePath filepath = mTmpDir.getPathTo(alpha ? "rgba.png" : "rgb.png");
+        writeImage(image, filepath);
+        QImage loaded(filepath.toStr(), "PNG");
+        compareImages(image, loaded);
+        EXPECT_EQ(alpha, loaded.hasAlphaChannel());
+        EXPECT_EQ(qRound(2400 / 0.0254), loaded.dotsPerMeterX());
+        EXPECT_LT(QFileInfo(filepath.toStr()).size(), image.byteCount()); // compressed
+    }
+}
+
+TEST_F(StreamingImageWriterTest, testTiff)
+{
+    for (bool alpha : {false, true}) {
+        QImage image = createImage(200, 100, alpha);
+        FilePath filepath = mTmpDir.getPathTo(alpha ? "rgba.tiff" : "rgb.tif");
+        writeImage(image, filepath);
+        EXPECT_EQ(QByteArray("II\x2a\x00", 4), FileUtils::readFile(filepath).left(4));
+        if (QImageReader::supportedImageFormats().contains("tiff")) {
+            compareImages(image, QImage(filepath.toStr(), "TIFF"));
+        }
+    }
+}
+
+TEST_F(StreamingImageWriterTest, testTiledTiff)
+{
+    for (bool alpha : {false, true}) {
+        // 4x3 tiles, the tiles at the right and bottom edges are partial
+        QImage image = createImage(53, 37, alpha);
+        FilePath filepath = mTmpDir.getPathTo(alpha ? "rgba.tiff" : "rgb.tif");
+        StreamingImageWriter writer(filepath, StreamingImageWriter::Format_t::Tiff,
+                                    image.size(), alpha, 2400, 16);
+        int bytesPerPixel = writer.getBytesPerPixel();
+        for (int row = 2; row >= 0; --row) { // any order
+            for (int column = 0; column < 4; ++column) {
+                writer.writeTile(column, row, image.constScanLine(row * 16) +
+                                 (column * 16 * bytesPerPixel), image.bytesPerLine());
+            }
+        }
+        EXPECT_THROW(writer.writeTile(0, 0, image.constBits(), image.bytesPerLine()),
+                     Exception); // already written
+        EXPECT_THROW(writer.writeTile(4, 0, image.constBits(), image.bytesPerLine()),
+                     Exception); // out of range
+        EXPECT_THROW(writer.writeRow(image.constBits()), Exception);
+        writer.finish();
+        EXPECT_EQ(QByteArray("II\x2a\x00", 4), FileUtils::readFile(filepath).left(4));
+        if (QImageReader::supportedImageFormats().contains("tiff")) {
+            compareImages(image, QImage(filepath.toStr(), "TIFF"));
+        }
+    }
+}
+
+TEST_F(StreamingImageWriterTest, testTileCount)
+{
+    FilePath filepath = mTmpDir.getPathTo("image.tiff");
+    EXPECT_THROW(StreamingImageWriter(filepath, StreamingImageWriter::Format_t::Tiff,
+                                      QSize(10, 10), false, 300, 8), Exception);
+    EXPECT_THROW(StreamingImageWriter(mTmpDir.getPathTo("image.png"),
+                                      StreamingImageWriter::Format_t::Png,
+                                      QSize(10, 10), false, 300, 16), Exception);
+    QByteArray tile(3 * 16 * 16, '\0');
+    const uchar* pixels = reinterpret_cast<const uchar*>(tile.constData());
+    {
+        StreamingImageWriter writer(filepath, StreamingImageWriter::Format_t::Tiff,
+                                    QSize(20, 10), false, 300, 16);
+        writer.writeTile(1, 0, pixels, 3 * 16);
+        EXPECT_THROW(writer.finish(), Exception);
+    }
+    EXPECT_FALSE(filepath.isExistingFile()); // not finished
+}
+
+TEST_F(StreamingImageWriterTest, testRowCount)
+{
+    FilePath filepath = mTmpDir.getPathTo("image.png");
+    QByteArray row(3 * 10, '\0');
+    const uchar* pixels = reinterpret_cast<const uchar*>(row.constData());
+    {
+        StreamingImageWriter writer(filepath, StreamingImageWriter::Format_t::Png,
+                                    QSize(10, 2), false, 300);
+        writer.writeRow(pixels);
+        EXPECT_EQ(1, writer.getWrittenRows());
+        EXPECT_THROW(writer.finish(), Exception);
+        writer.writeRow(pixels);
+        EXPECT_THROW(writer.writeRow(pixels), Exception);
+    }
+    EXPECT_FALSE(filepath.isExistingFile()); // not finished
+}
+
+TEST_F(StreamingImageWriterTest, testFormatFromFilePath)
+{
+    EXPECT_EQ(StreamingImageWriter::Format_t::Png,
+              StreamingImageWriter::getFormatFromFilePath(mTmpDir.getPathTo("a.PNG")));
+    EXPECT_EQ(StreamingImageWriter::Format_t::Tiff,
+              StreamingImageWriter::getFormatFromFilePath(mTmpDir.getPathTo("a.tif")));
+    EXPECT_EQ(StreamingImageWriter::Format_t::Tiff,
+              StreamingImageWriter::getFormatFromFilePath(mTmpDir.getPathTo("a.tiff")));
+    EXPECT_THROW(StreamingImageWriter::getFormatFromFilePath(mTmpDir.getPathTo("a.jpg")),
+                 Exception);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -0,0 +1,157 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <gtest/gtest.h>
+#include <librepcbcommon/graphics/tiledimagerenderer.h>
+#include <librepcbcommon/fileio/fileutils.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class TiledImageRendererTest : public ::testing::Test
+{
+    protected:
+
+        FilePath mTmpDir;
+        QPicture mPicture;
+        QRectF mSourceRect;
+
+        virtual void SetUp() override
+        {
+            mTmpDir = FilePath::getRandomTempPath();
+
+            // only integer coordinates and 45° edges, so the antialiasing of every pixel
+            // does not depend on the tile it is rendered in
+            QPainter painter(&mPicture);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(QColor(255, 0, 0));
+            painter.drawRect(QRect(0, 10, 10, 10));
+            painter.setBrush(QColor(0, 0, 255, 128));
+            painter.drawRect(QRect(-20, 0, 45, 12));
+            painter.setBrush(QColor(0, 160, 0, 200));
+            QVector<QPoint> triangle = {QPoint(-5, 30), QPoint(10, 15), QPoint(25, 30)};
+            painter.drawPolygon(QPolygon(triangle));
+            painter.setPen(QPen(QColor(40, 40, 40, 100), 3));
+            painter.setBrush(Qt::NoBrush);
+            painter.drawLine(QPoint(-12, 8), QPoint(22, 42));
+
+            // the size is not a multiple of the tile size and not even an integer
+            mSourceRect = QRectF(-10, 5, 40.5, 27.25);
+        }
+
+        virtual void TearDown() override
+        {
+            FileUtils::removeDirRecursively(mTmpDir);
+        }
+
+        /// Render the whole picture into a single image (at 144 DPI)
+        QImage renderImage(const QColor& background) noexcept
+        {
+            QImage image(81, 55, QImage::Format_ARGB32_Premultiplied);
+            image.fill(background);
+            {
+                QPainter painter(&image);
+                painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                                       QPainter::SmoothPixmapTransform);
+                painter.scale(2, 2);
+                painter.translate(-mSourceRect.topLeft());
+                painter.drawPicture(0, 0, mPicture);
+            }
+            return image.convertToFormat((background.alpha() < 255) ?
+                QImage::Format_RGBA8888 : QImage::Format_RGB888);
+        }
+
+        static void compareImages(const QImage& expected, const QImage& actual) noexcept
+        {
+            ASSERT_EQ(expected.size(), actual.size());
+            QImage converted = actual.convertToFormat(expected.format());
+            for (int y = 0; y < expected.height(); ++y) {
+                for (int x = 0; x < expected.width(); ++x) {
+                    ASSERT_EQ(expected.pixel(x, y), converted.pixel(x, y)) << x << "/" << y;
+                }
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(TiledImageRendererTest, testImageSize)
+{
+    TiledImageRenderer renderer(mPicture, mSourceRect);
+    renderer.setDpi(144);
+    EXPECT_EQ(QSize(81, 55), renderer.getImageSize());
+    renderer.setDpi(INT_MAX);
+    EXPECT_THROW(renderer.getImageSize(), Exception);
+    EXPECT_THROW(renderer.exportToFile(mTmpDir.getPathTo("image.png")), Exception);
+}
+
+TEST_F(TiledImageRendererTest, testSourceRect)
+{
+    // the red rectangle (0,10)..(10,20) covers the pixels (20,10)..(39,29)
+    QImage image = renderImage(Qt::white);
+    EXPECT_EQ(qRgb(255, 255, 255), image.pixel(19, 14));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(20, 14));
+    EXPECT_EQ(qRgb(255, 0, 0), image.pixel(39, 16));
+}
+
+TEST_F(TiledImageRendererTest, testStitching)
+{
+    // 7x7 tiles (TIFF: 16x16) leave partial tiles at the right and bottom edges, and
+    // 3 jobs render every third column (TIFF: every third tile)
+    for (const QColor& background : {QColor(Qt::white), QColor(255, 255, 0, 60)}) {
+        bool alpha = (background.alpha() < 255);
+        QImage expected = renderImage(background);
+        for (const QString& suffix : {QString("png"), QString("tiff")}) {
+            FilePath filepath = mTmpDir.getPathTo(QString("image%1.%2").arg(alpha).arg(suffix));
+            TiledImageRenderer renderer(mPicture, mSourceRect);
+            renderer.setDpi(144);
+            renderer.setBackgroundColor(background);
+            renderer.setTileSize(7);
+            renderer.setJobCount(3);
+            renderer.exportToFile(filepath);
+            if ((suffix == "png") || QImageReader::supportedImageFormats().contains("tiff")) {
+                QImage image(filepath.toStr(), qPrintable(suffix.toUpper()));
+                EXPECT_EQ(alpha, image.hasAlphaChannel());
+                compareImages(expected, image);
+            }
+        }
+    }
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
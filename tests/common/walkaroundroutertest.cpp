@@ -0,0 +1,205 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * http://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*****************************************************************************************
+ *  Includes
+ ****************************************************************************************/
+#include <QtCore>
+#include <gtest/gtest.h>
+#include <librepcbcommon/geometry/walkaroundrouter.h>
+
+/*****************************************************************************************
+ *  Namespace
+ ****************************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*****************************************************************************************
+ *  Test Class
+ ****************************************************************************************/
+
+class WalkaroundRouterTest : public ::testing::Test
+{
+    protected:
+
+        static const LengthBase_t sGrid = 100000;   // 0.1mm
+        static const LengthBase_t sMargin = 200000; // 0.2mm
+
+        static BoundingBox getArea() noexcept
+        {
+            return BoundingBox(Point(-10000000, -10000000), Point(10000000, 10000000));
+        }
+
+        /// Check that the path does not come closer to the obstacles than the margin
+        static void expectClearance(const QVector<Point>& path,
+                                    const QList<ConvexShape>& obstacles) noexcept
+        {
+            for (int i = 1; i < path.count(); ++i) {
+                ConvexShape segment({path.at(i - 1), path.at(i)}, Length(0));
+                foreach (const ConvexShape& obstacle, obstacles) {
+                    EXPECT_GE(segment.getDistanceTo(obstacle).toNm(), LengthBase_t(sMargin));
+                }
+            }
+        }
+
+        /// Check that all segments except the last two are octilinear
+        static void expectOctilinear(const QVector<Point>& path) noexcept
+        {
+            for (int i = 1; i < path.count() - 2; ++i) {
+                Point d = path.at(i) - path.at(i - 1);
+                qint64 dx = qAbs(d.getX().toNm()), dy = qAbs(d.getY().toNm());
+                EXPECT_TRUE((dx == 0) || (dy == 0) || (dx == dy));
+            }
+        }
+};
+
+/*****************************************************************************************
+ *  Test Methods
+ ****************************************************************************************/
+
+TEST_F(WalkaroundRouterTest, testFreeStraightLine)
+{
+    WalkaroundRouter router(sGrid, sMargin);
+    QVector<Point> path = router.route(Point(0, 0), Point(3000000, 0), getArea());
+    QVector<Point> expected = {Point(0, 0), Point(3000000, 0)};
+    EXPECT_EQ(expected, path);
+}
+
+TEST_F(WalkaroundRouterTest, testFreeOffGridEnd)
+{
+    // the end point is not on the grid of the start point
+    WalkaroundRouter router(sGrid, sMargin);
+    QVector<Point> path = router.route(Point(0, 0), Point(3000050, 1000020), getArea());
+    ASSERT_EQ(3, path.count());
+    EXPECT_EQ(Point(0, 0), path.first());
+    EXPECT_EQ(Point(3000050, 1000020), path.last());
+}
+
+TEST_F(WalkaroundRouterTest, testWalkaroundCircle)
+{
+    QList<ConvexShape> obstacles = {ConvexShape::circle(Point(1500000, 0), Length(1000000))};
+    WalkaroundRouter router(sGrid, sMargin);
+    foreach (const ConvexShape& obstacle, obstacles) router.addObstacle(obstacle);
+    QVector<Point> path = router.route(Point(0, 0), Point(3000000, 0), getArea());
+    ASSERT_GT(path.count(), 2);
+    EXPECT_EQ(Point(0, 0), path.first());
+    EXPECT_EQ(Point(3000000, 0), path.last());
+    expectClearance(path, obstacles);
+    expectOctilinear(path);
+}
+
+TEST_F(WalkaroundRouterTest, testWalkaroundWall)
+{
+    // a vertical trace between start and end, open at the top
+    QList<ConvexShape> obstacles = {
+        ConvexShape::capsule(Point(1000000, -5000000), Point(1000000, 2000000), Length(300000))};
+    WalkaroundRouter router(sGrid, sMargin);
+    foreach (const ConvexShape& obstacle, obstacles) router.addObstacle(obstacle);
+    QVector<Point> path = router.route(Point(0, 0), Point(2000000, 0), getArea());
+    ASSERT_GT(path.count(), 2);
+    EXPECT_EQ(Point(2000000, 0), path.last());
+    expectClearance(path, obstacles);
+    expectOctilinear(path);
+    foreach (const Point& vertex, path) {
+        EXPECT_LE(vertex.getY().toNm(), 2000000 + 150000 + sMargin + 2 * sGrid);
+    }
+}
+
+TEST_F(WalkaroundRouterTest, testBlocked)
+{
+    // the end point is enclosed completely
+    QList<ConvexShape> obstacles = {
+        ConvexShape::capsule(Point(1000000, -1000000), Point(3000000, -1000000), Length(100000)),
+        ConvexShape::capsule(Point(3000000, -1000000), Point(3000000, 1000000), Length(100000)),
+        ConvexShape::capsule(Point(3000000, 1000000), Point(1000000, 1000000), Length(100000)),
+        ConvexShape::capsule(Point(1000000, 1000000), Point(1000000, -1000000), Length(100000))};
+    WalkaroundRouter router(sGrid, sMargin);
+    foreach (const ConvexShape& obstacle, obstacles) router.addObstacle(obstacle);
+    EXPECT_TRUE(router.route(Point(0, 0), Point(2000000, 0), getArea()).isEmpty());
+}
+
+TEST_F(WalkaroundRouterTest, testLimitedArea)
+{
+    // the only way around the wall is outside of the allowed area
+    WalkaroundRouter router(sGrid, sMargin);
+    router.addObstacle(ConvexShape::capsule(Point(1000000, -5000000),
+                                            Point(1000000, 5000000), Length(100000)));
+    BoundingBox area(Point(-1000000, -4000000), Point(3000000, 4000000));
+    EXPECT_TRUE(router.route(Point(0, 0), Point(2000000, 0), area).isEmpty());
+}
+
+TEST_F(WalkaroundRouterTest, testLeaveObstacleAtStart)
+{
+    // the start point lies within the clearance of the obstacle behind it
+    WalkaroundRouter router(sGrid, sMargin);
+    router.addObstacle(ConvexShape::circle(Point(-100000, 0), Length(500000)));
+    QVector<Point> path = router.route(Point(0, 0), Point(3000000, 0), getArea());
+    QVector<Point> expected = {Point(0, 0), Point(3000000, 0)};
+    EXPECT_EQ(expected, path);
+}
+
+TEST_F(WalkaroundRouterTest, testObstacleAtStartIsNotCrossed)
+{
+    // the direct path would cross the obstacle which contains the start point
+    QList<ConvexShape> obstacles = {ConvexShape::circle(Point(300000, 0), Length(500000))};
+    WalkaroundRouter router(sGrid, sMargin);
+    foreach (const ConvexShape& obstacle, obstacles) router.addObstacle(obstacle);
+    QVector<Point> path = router.route(Point(0, 0), Point(3000000, 0), getArea());
+    ASSERT_GT(path.count(), 2);
+    EXPECT_EQ(Point(0, 0), path.first());
+    EXPECT_EQ(Point(3000000, 0), path.last());
+    expectOctilinear(path);
+    for (int i = 1; i < path.count(); ++i) {
+        // never closer to the obstacle than the start point
+        ConvexShape segment({path.at(i - 1), path.at(i)}, Length(0));
+        EXPECT_GE(segment.getDistanceTo(obstacles.first()).toNm(), LengthBase_t(50000));
+    }
+}
+
+TEST_F(WalkaroundRouterTest, testEnterObstacleAtEnd)
+{
+    // the end point lies within the clearance of the obstacle behind it
+    WalkaroundRouter router(sGrid, sMargin);
+    router.addObstacle(ConvexShape::circle(Point(3100000, 0), Length(500000)));
+    QVector<Point> path = router.route(Point(0, 0), Point(3000000, 0), getArea());
+    QVector<Point> expected = {Point(0, 0), Point(3000000, 0)};
+    EXPECT_EQ(expected, path);
+}
+
+TEST_F(WalkaroundRouterTest, testExpansionLimit)
+{
+    // an impossible route must not take forever
+    WalkaroundRouter router(sGrid, sMargin);
+    router.addObstacle(ConvexShape::capsule(Point(1000000, -100000000),
+                                            Point(1000000, 100000000), Length(100000)));
+    router.setMaxExpandedNodes(1000);
+    QElapsedTimer timer;
+    timer.start();
+    BoundingBox area(Point(-100000000, -100000000), Point(100000000, 100000000));
+    EXPECT_TRUE(router.route(Point(0, 0), Point(2000000, 0), area).isEmpty());
+    EXPECT_LT(timer.elapsed(), 1000);
+}
+
+/*****************************************************************************************
+ *  End of File
+ ****************************************************************************************/
+
+} // namespace tests
+} // namespace librepcb
@@ -43,6 +43,22 @@ SOURCES += main.cpp \
     common/pointtest.cpp \
     common/scopeguardtest.cpp \
     common/applicationtest.cpp \
-    common/versiontest.cpp
+    common/versiontest.cpp \
+    common/spatialindextest.cpp \
+    common/hittesttest.cpp \
+    common/disjointsettest.cpp \
+    common/ratsnestbuildertest.cpp \
+    common/convexshapetest.cpp \
+    common/polygonclippertest.cpp \
+    common/polygontest.cpp \
+    common/walkaroundroutertest.cpp \
+    common/gridroutertest.cpp \
+    common/drillpathoptimizertest.cpp \
+    common/polylinebuildertest.cpp \
+    common/gerberprimitivelisttest.cpp \
+    common/camoutputcachetest.cpp \
+    common/streamingimagewritertest.cpp \
+    common/tiledimagerenderertest.cpp \
+    common/gerberaperturelisttest.cpp
 
 HEADERS +=